@@ -0,0 +1,46 @@
+#ifndef BRA_GATE_ADJ_FOURIER_TRANSFORM_HPP
+# define BRA_GATE_ADJ_FOURIER_TRANSFORM_HPP
+
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    class adj_fourier_transform final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+
+     private:
+      std::vector<qubit_type> qubits_;
+
+      static std::string const name_;
+
+     public:
+      explicit adj_fourier_transform(std::vector<qubit_type>&& qubits);
+
+      ~adj_fourier_transform() = default;
+      adj_fourier_transform(adj_fourier_transform const&) = delete;
+      adj_fourier_transform& operator=(adj_fourier_transform const&) = delete;
+      adj_fourier_transform(adj_fourier_transform&&) = delete;
+      adj_fourier_transform& operator=(adj_fourier_transform&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class adj_fourier_transform
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_ADJ_FOURIER_TRANSFORM_HPP
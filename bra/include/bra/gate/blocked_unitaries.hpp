@@ -0,0 +1,58 @@
+#ifndef BRA_GATE_BLOCKED_UNITARIES_HPP
+# define BRA_GATE_BLOCKED_UNITARIES_HPP
+
+# include <cstddef>
+# include <string>
+# include <vector>
+# include <utility>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    // generated by ::bra::gates::block, not by any mnemonic
+    class blocked_unitaries final
+      : public ::bra::gate::gate
+    {
+     public:
+      using bit_integer_type = ::bra::state::bit_integer_type;
+      using qubit_type = ::bra::state::qubit_type;
+      using complex_type = ::bra::state::complex_type;
+
+     private:
+      std::vector<std::vector<complex_type>> matrices_;
+      // qubits after swapping qubits in swapped_qubits_
+      std::vector<std::vector<qubit_type>> qubits_list_;
+      // pairs of (upper qubit, unused lower qubit) swapped before and after applying matrices_
+      std::vector<std::pair<qubit_type, qubit_type>> swapped_qubits_;
+      bit_integer_type num_block_qubits_;
+
+      static std::string const name_;
+
+     public:
+      blocked_unitaries(
+        std::vector<std::vector<complex_type>>&& matrices, std::vector<std::vector<qubit_type>>&& qubits_list,
+        std::vector<std::pair<qubit_type, qubit_type>>&& swapped_qubits, bit_integer_type const num_block_qubits);
+
+      ~blocked_unitaries() = default;
+      blocked_unitaries(blocked_unitaries const&) = delete;
+      blocked_unitaries& operator=(blocked_unitaries const&) = delete;
+      blocked_unitaries(blocked_unitaries&&) = delete;
+      blocked_unitaries& operator=(blocked_unitaries&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class blocked_unitaries
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_BLOCKED_UNITARIES_HPP
@@ -0,0 +1,49 @@
+#ifndef BRA_GATE_CONSTANT_ADDITION_ASSIGNMENT_HPP
+# define BRA_GATE_CONSTANT_ADDITION_ASSIGNMENT_HPP
+
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    class constant_addition_assignment final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+      using state_integer_type = ::bra::state::state_integer_type;
+
+     private:
+      std::vector<qubit_type> qubits_;
+      state_integer_type constant_;
+
+      static std::string const name_;
+
+     public:
+      constant_addition_assignment(
+        std::vector<qubit_type>&& qubits, state_integer_type const constant);
+
+      ~constant_addition_assignment() = default;
+      constant_addition_assignment(constant_addition_assignment const&) = delete;
+      constant_addition_assignment& operator=(constant_addition_assignment const&) = delete;
+      constant_addition_assignment(constant_addition_assignment&&) = delete;
+      constant_addition_assignment& operator=(constant_addition_assignment&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class constant_addition_assignment
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_CONSTANT_ADDITION_ASSIGNMENT_HPP
@@ -2,6 +2,7 @@
 # define BRA_GATE_CONTROLLED_EXPONENTIAL_PAULI_Z_HPP
 
 # include <string>
+# include <vector>
 # include <iosfwd>
 
 # include <bra/gate/gate.hpp>
@@ -44,6 +45,7 @@ namespace bra
       std::string const& do_name() const override;
       std::string do_representation(
         std::ostringstream& repr_stream, int const parameter_width) const override;
+      bool do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const override;
     }; // class controlled_exponential_pauli_z
   } // namespace gate
 } // namespace bra
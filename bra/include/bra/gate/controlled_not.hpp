@@ -2,6 +2,7 @@
 # define BRA_GATE_CONTROLLED_NOT_HPP
 
 # include <string>
+# include <vector>
 # include <iosfwd>
 
 # include <bra/gate/gate.hpp>
@@ -30,6 +31,9 @@ namespace bra
         qubit_type const target_qubit,
         control_qubit_type const control_qubit);
 
+      qubit_type const& target_qubit() const { return target_qubit_; }
+      control_qubit_type const& control_qubit() const { return control_qubit_; }
+
       ~controlled_not() = default;
       controlled_not& operator=(controlled_not const&) = delete;
       controlled_not(controlled_not&&) = delete;
@@ -40,6 +44,7 @@ namespace bra
       std::string const& do_name() const override;
       std::string do_representation(
         std::ostringstream& repr_stream, int const parameter_width) const override;
+      bool do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const override;
     }; // class controlled_not
   } // namespace gate
 } // namespace bra
@@ -0,0 +1,46 @@
+#ifndef BRA_GATE_FOURIER_TRANSFORM_HPP
+# define BRA_GATE_FOURIER_TRANSFORM_HPP
+
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    class fourier_transform final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+
+     private:
+      std::vector<qubit_type> qubits_;
+
+      static std::string const name_;
+
+     public:
+      explicit fourier_transform(std::vector<qubit_type>&& qubits);
+
+      ~fourier_transform() = default;
+      fourier_transform(fourier_transform const&) = delete;
+      fourier_transform& operator=(fourier_transform const&) = delete;
+      fourier_transform(fourier_transform&&) = delete;
+      fourier_transform& operator=(fourier_transform&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class fourier_transform
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_FOURIER_TRANSFORM_HPP
@@ -0,0 +1,54 @@
+#ifndef BRA_GATE_FUSED_UNITARY_HPP
+# define BRA_GATE_FUSED_UNITARY_HPP
+
+# include <cstddef>
+# include <string>
+# include <vector>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    // generated by ::bra::gates::fuse, not by any mnemonic
+    class fused_unitary final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+      using complex_type = ::bra::state::complex_type;
+
+     private:
+      std::vector<complex_type> matrix_;
+      std::vector<qubit_type> qubits_;
+      std::size_t num_fused_gates_;
+
+      static std::string const name_;
+
+     public:
+      fused_unitary(
+        std::vector<complex_type>&& matrix, std::vector<qubit_type>&& qubits,
+        std::size_t const num_fused_gates);
+
+      ~fused_unitary() = default;
+      fused_unitary(fused_unitary const&) = delete;
+      fused_unitary& operator=(fused_unitary const&) = delete;
+      fused_unitary(fused_unitary&&) = delete;
+      fused_unitary& operator=(fused_unitary&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+      bool do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const override;
+    }; // class fused_unitary
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_FUSED_UNITARY_HPP
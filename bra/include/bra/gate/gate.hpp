@@ -2,6 +2,7 @@
 # define BRA_GATE_GATE_HPP
 
 # include <string>
+# include <vector>
 # include <iosfwd>
 
 # include <bra/state.hpp>
@@ -14,6 +15,9 @@ namespace bra
     class gate
     {
      public:
+      using qubit_type = ::bra::state::qubit_type;
+      using complex_type = ::bra::state::complex_type;
+
       gate() = default;
       virtual ~gate() = default;
 
@@ -26,11 +30,17 @@ namespace bra
       std::string const& name() const { return do_name(); }
       std::string representation() const;
 
+      // returns false if the gate cannot be represented as a unitary matrix acting on fixed qubits.
+      // See ::bra::state::unitary_matrix for the layout of matrix
+      bool unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+      { return do_unitary_matrix(matrix, qubits); }
+
      protected:
       virtual ::bra::state& do_apply(::bra::state& state) const = 0;
       virtual std::string const& do_name() const = 0;
       virtual std::string do_representation(
         std::ostringstream& repr_stream, int const parameter_width) const = 0;
+      virtual bool do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const;
     }; // class gate
 
     inline ::bra::state& operator<<(::bra::state& state, ::bra::gate::gate const& gate)
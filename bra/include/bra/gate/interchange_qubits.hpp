@@ -0,0 +1,48 @@
+#ifndef BRA_GATE_INTERCHANGE_QUBITS_HPP
+# define BRA_GATE_INTERCHANGE_QUBITS_HPP
+
+# include <string>
+# include <vector>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    // generated by ::bra::gates::plan_permutation, not by any mnemonic
+    class interchange_qubits final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+
+     private:
+      std::vector<qubit_type> global_qubits_;
+      std::vector<qubit_type> local_qubits_;
+
+      static std::string const name_;
+
+     public:
+      interchange_qubits(std::vector<qubit_type>&& global_qubits, std::vector<qubit_type>&& local_qubits);
+
+      ~interchange_qubits() = default;
+      interchange_qubits(interchange_qubits const&) = delete;
+      interchange_qubits& operator=(interchange_qubits const&) = delete;
+      interchange_qubits(interchange_qubits&&) = delete;
+      interchange_qubits& operator=(interchange_qubits&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class interchange_qubits
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_INTERCHANGE_QUBITS_HPP
@@ -0,0 +1,51 @@
+#ifndef BRA_GATE_MODULAR_EXPONENTIATION_ASSIGNMENT_HPP
+# define BRA_GATE_MODULAR_EXPONENTIATION_ASSIGNMENT_HPP
+
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    class modular_exponentiation_assignment final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+      using state_integer_type = ::bra::state::state_integer_type;
+
+     private:
+      std::vector<qubit_type> exponent_qubits_;
+      std::vector<qubit_type> qubits_;
+      state_integer_type base_;
+      state_integer_type divisor_;
+
+      static std::string const name_;
+
+     public:
+      modular_exponentiation_assignment(
+        std::vector<qubit_type>&& exponent_qubits, std::vector<qubit_type>&& qubits, state_integer_type const base, state_integer_type const divisor);
+
+      ~modular_exponentiation_assignment() = default;
+      modular_exponentiation_assignment(modular_exponentiation_assignment const&) = delete;
+      modular_exponentiation_assignment& operator=(modular_exponentiation_assignment const&) = delete;
+      modular_exponentiation_assignment(modular_exponentiation_assignment&&) = delete;
+      modular_exponentiation_assignment& operator=(modular_exponentiation_assignment&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class modular_exponentiation_assignment
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_MODULAR_EXPONENTIATION_ASSIGNMENT_HPP
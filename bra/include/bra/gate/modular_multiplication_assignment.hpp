@@ -0,0 +1,50 @@
+#ifndef BRA_GATE_MODULAR_MULTIPLICATION_ASSIGNMENT_HPP
+# define BRA_GATE_MODULAR_MULTIPLICATION_ASSIGNMENT_HPP
+
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    class modular_multiplication_assignment final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+      using state_integer_type = ::bra::state::state_integer_type;
+
+     private:
+      std::vector<qubit_type> qubits_;
+      state_integer_type multiplier_;
+      state_integer_type divisor_;
+
+      static std::string const name_;
+
+     public:
+      modular_multiplication_assignment(
+        std::vector<qubit_type>&& qubits, state_integer_type const multiplier, state_integer_type const divisor);
+
+      ~modular_multiplication_assignment() = default;
+      modular_multiplication_assignment(modular_multiplication_assignment const&) = delete;
+      modular_multiplication_assignment& operator=(modular_multiplication_assignment const&) = delete;
+      modular_multiplication_assignment(modular_multiplication_assignment&&) = delete;
+      modular_multiplication_assignment& operator=(modular_multiplication_assignment&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class modular_multiplication_assignment
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_MODULAR_MULTIPLICATION_ASSIGNMENT_HPP
@@ -0,0 +1,58 @@
+#ifndef BRA_GATE_QUADRATIC_PHASE_SHIFT_HPP
+# define BRA_GATE_QUADRATIC_PHASE_SHIFT_HPP
+
+# include <cstddef>
+# include <string>
+# include <vector>
+# include <tuple>
+# include <utility>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    // generated by ::bra::gates::accumulate_diagonal_gates, not by any mnemonic
+    class quadratic_phase_shift final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+      using complex_type = ::bra::state::complex_type;
+
+     private:
+      complex_type global_phase_coefficient_;
+      std::vector<std::pair<qubit_type, complex_type>> linear_phase_coefficients_;
+      std::vector<std::tuple<qubit_type, qubit_type, complex_type>> quadratic_phase_coefficients_;
+      std::size_t num_accumulated_gates_;
+
+      static std::string const name_;
+
+     public:
+      quadratic_phase_shift(
+        complex_type const& global_phase_coefficient,
+        std::vector<std::pair<qubit_type, complex_type>>&& linear_phase_coefficients,
+        std::vector<std::tuple<qubit_type, qubit_type, complex_type>>&& quadratic_phase_coefficients,
+        std::size_t const num_accumulated_gates);
+
+      ~quadratic_phase_shift() = default;
+      quadratic_phase_shift(quadratic_phase_shift const&) = delete;
+      quadratic_phase_shift& operator=(quadratic_phase_shift const&) = delete;
+      quadratic_phase_shift(quadratic_phase_shift&&) = delete;
+      quadratic_phase_shift& operator=(quadratic_phase_shift&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class quadratic_phase_shift
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_QUADRATIC_PHASE_SHIFT_HPP
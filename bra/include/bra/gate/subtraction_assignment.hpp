@@ -0,0 +1,48 @@
+#ifndef BRA_GATE_SUBTRACTION_ASSIGNMENT_HPP
+# define BRA_GATE_SUBTRACTION_ASSIGNMENT_HPP
+
+# include <vector>
+# include <string>
+# include <iosfwd>
+
+# include <bra/gate/gate.hpp>
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    class subtraction_assignment final
+      : public ::bra::gate::gate
+    {
+     public:
+      using qubit_type = ::bra::state::qubit_type;
+
+     private:
+      std::vector<qubit_type> lhs_qubits_;
+      std::vector<qubit_type> rhs_qubits_;
+
+      static std::string const name_;
+
+     public:
+      subtraction_assignment(
+        std::vector<qubit_type>&& lhs_qubits, std::vector<qubit_type>&& rhs_qubits);
+
+      ~subtraction_assignment() = default;
+      subtraction_assignment(subtraction_assignment const&) = delete;
+      subtraction_assignment& operator=(subtraction_assignment const&) = delete;
+      subtraction_assignment(subtraction_assignment&&) = delete;
+      subtraction_assignment& operator=(subtraction_assignment&&) = delete;
+
+     private:
+      ::bra::state& do_apply(::bra::state& state) const override;
+      std::string const& do_name() const override;
+      std::string do_representation(
+        std::ostringstream& repr_stream, int const parameter_width) const override;
+    }; // class subtraction_assignment
+  } // namespace gate
+} // namespace bra
+
+
+#endif // BRA_GATE_SUBTRACTION_ASSIGNMENT_HPP
@@ -2,6 +2,8 @@
 # define BRA_GATES_HPP
 
 # include <cassert>
+# include <cstddef>
+# include <cstdint>
 # include <iosfwd>
 # include <vector>
 # include <string>
@@ -56,6 +58,13 @@ namespace bra
     std::string generate_what_string(columns_type const& columns);
   }; // class wrong_mnemonic_error
 
+  class wrong_compiled_gates_error
+    : public std::runtime_error
+  {
+   public:
+    wrong_compiled_gates_error(std::string const& message);
+  }; // class wrong_compiled_gates_error
+
 # ifndef BRA_NO_MPI
   class wrong_mpi_communicator_size_error
     : public std::runtime_error
@@ -70,6 +79,17 @@ namespace bra
   enum class generate_statement : int { events };
   enum class depolarizing_statement : int { channel };
 
+# ifndef BRA_NO_MPI
+  // numbers of interchanges of global qubits and bytes sent by each process in them, predicted by ::bra::gates::plan_permutation
+  struct permutation_plan_prediction
+  {
+    std::size_t num_planned_interchanges;
+    std::size_t num_planned_bytes;
+    std::size_t num_unplanned_interchanges;
+    std::size_t num_unplanned_bytes;
+  }; // struct permutation_plan_prediction
+
+# endif // BRA_NO_MPI
   class gates
   {
     using value_type_ = std::unique_ptr< ::bra::gate::gate >;
@@ -145,9 +165,22 @@ namespace bra
       yampi::rank const root = yampi::rank{},
       yampi::communicator const& communicator = yampi::communicator{::yampi::tags::world_communicator},
       size_type const num_reserved_gates = size_type{0u});
+
+    // reads a binary file written by ::bra::compile_gates
+    gates(
+      std::string const& compiled_filename,
+      bit_integer_type num_uqubits, unsigned int num_processes_per_unit,
+      yampi::environment const& environment,
+      yampi::rank const root = yampi::rank{},
+      yampi::communicator const& communicator = yampi::communicator{::yampi::tags::world_communicator},
+      size_type const num_reserved_gates = size_type{0u});
 # else // BRA_NO_MPI
     explicit gates(std::istream& input_stream);
     gates(std::istream& input_stream, size_type const num_reserved_gates);
+
+    // reads a binary file written by ::bra::compile_gates
+    explicit gates(std::string const& compiled_filename);
+    gates(std::string const& compiled_filename, size_type const num_reserved_gates);
 # endif // BRA_NO_MPI
 
     bool operator==(gates const& other) const;
@@ -189,13 +222,43 @@ namespace bra
       std::istream& input_stream, yampi::environment const& environment,
       yampi::communicator const& communicator = yampi::communicator{yampi::tags::world_communicator},
       size_type const num_reserved_gates = size_type{0u});
+    void assign_compiled(
+      std::string const& compiled_filename, yampi::environment const& environment,
+      yampi::communicator const& communicator = yampi::communicator{yampi::tags::world_communicator},
+      size_type const num_reserved_gates = size_type{0u});
 # else // BRA_NO_MPI
     void assign(
       std::istream& input_stream,
       size_type const num_reserved_gates = size_type{0u});
+    void assign_compiled(
+      std::string const& compiled_filename,
+      size_type const num_reserved_gates = size_type{0u});
 # endif // BRA_NO_MPI
     allocator_type get_allocator() const { return data_.get_allocator(); }
 
+    // merges each run of consecutive unitary gates acting on at most max_num_fused_qubits qubits into one gate.
+    // No gates are merged if max_num_fused_qubits is 0
+    void fuse(bit_integer_type const max_num_fused_qubits);
+
+    // groups each run of consecutive unitary gates into one gate applied block by block,
+    // where each block has 2^num_block_qubits elements. Upper qubits in the run are swapped with unused lower qubits.
+    // No gates are grouped if num_block_qubits is 0
+    void block(bit_integer_type const num_block_qubits);
+
+    // accumulates each run of consecutive diagonal gates acting on at most two qubits, such as Z, S, T, U1, R, CZ, ZZ and eZZ,
+    // into one gate which multiplies each amplitude by the product of per-qubit and pairwise phase coefficients in one pass
+    void accumulate_diagonal_gates();
+
+# ifndef BRA_NO_MPI
+    // inserts interchanges of global qubits before gates which need them in simple mode. Local qubits used latest in the rest of gates
+    // are evicted instead of the uppermost local qubits, and global qubits used within next num_lookahead_gates gates are brought in
+    // by the same interchange if possible. No interchanges are inserted if num_lookahead_gates is 0 or in unit mode.
+    // Planning and prediction stop at the first gate which is not represented as a unitary matrix, such as measurements, QFT and
+    // arithmetic gates, because the permutation after it is unknown.
+    // absorbs_global_permutations should be the same as the one given to ::bra::state
+    ::bra::permutation_plan_prediction plan_permutation(size_type const num_lookahead_gates, bool const absorbs_global_permutations);
+# endif // BRA_NO_MPI
+
     // Element access
     //reference at(size_type const index) { return data_.at(index); }
     const_reference at(size_type const index) const { return data_.at(index); }
@@ -250,6 +313,16 @@ namespace bra
         and BRA_is_nothrow_swappable<qubit_type>::value);
 
    private:
+    // returns false if no more statements should be read
+# ifndef BRA_NO_MPI
+    bool interpret_statement(
+      columns_type& columns, yampi::environment const& environment, yampi::communicator const& communicator);
+# else // BRA_NO_MPI
+    bool interpret_statement(columns_type& columns);
+# endif // BRA_NO_MPI
+    void add_compiled_gate(
+      std::uint16_t const opcode, std::vector<std::uint32_t> const& integers, std::vector<real_type> const& reals);
+
     bit_integer_type read_num_qubits(columns_type const& columns) const;
     state_integer_type read_initial_state_value(columns_type& columns) const;
     bit_integer_type read_num_mpi_processes(columns_type const& columns) const;
@@ -261,6 +334,13 @@ namespace bra
     qubit_type read_target(columns_type const& columns) const;
     std::tuple<qubit_type, qubit_type> read_2targets(columns_type const& columns) const;
     void read_multi_targets(columns_type const& columns, std::vector<qubit_type>& targets) const;
+    void read_fourier_transform_targets(columns_type const& columns, std::vector<qubit_type>& targets) const;
+    void read_register_targets(
+      columns_type const& columns, std::size_t const first_index, std::size_t const last_index,
+      std::vector<qubit_type>& targets) const;
+    void check_modular_arithmetic(
+      columns_type const& columns, std::size_t const num_register_qubits,
+      state_integer_type const multiplier, state_integer_type const divisor) const;
     std::tuple<qubit_type, real_type> read_target_phase(columns_type const& columns) const;
     std::tuple<qubit_type, real_type, real_type> read_target_2phases(columns_type const& columns) const;
     std::tuple<qubit_type, real_type, real_type, real_type> read_target_3phases(columns_type const& columns) const;
@@ -335,11 +415,19 @@ namespace bra
     void add_toffoli(columns_type const& columns);
     void add_m(columns_type const& columns);
     void add_shor_box(columns_type const& columns);
+    void add_qft(columns_type const& columns);
+    void add_iqft(columns_type const& columns);
+    void add_add(columns_type const& columns);
+    void add_sub(columns_type const& columns);
+    void add_addc(columns_type const& columns);
+    void add_mulmod(columns_type const& columns);
+    void add_modexp(columns_type const& columns);
     void add_clear(columns_type const& columns);
     void add_set(columns_type const& columns);
     void add_depolarizing(columns_type const& columns, std::string const& mnemonic);
 
     void interpret_controlled_gates(columns_type const& columns, std::string const& mnemonic);
+    void add_controlled_not(qubit_type const target_qubit, control_qubit_type const control_qubit);
     void add_ch(columns_type const& columns, int const num_control_qubits);
     void add_cnot(columns_type const& columns, int const num_control_qubits);
     void add_cx(columns_type const& columns, int const num_control_qubits);
@@ -391,6 +479,10 @@ namespace bra
     void add_ceswap(columns_type const& columns, int const num_control_qubits);
   }; // class gates
 
+  // writes the statements read from input_stream in the binary format read by ::bra::gates::assign_compiled.
+  // Common gates are stored as opcodes followed by their qubits and parameters, and other statements as text
+  void compile_gates(std::istream& input_stream, std::ostream& output_stream);
+
   inline bool operator!=(::bra::gates const& lhs, ::bra::gates const& rhs)
   { return not (lhs == rhs); }
 
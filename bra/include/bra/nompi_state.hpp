@@ -3,10 +3,20 @@
 
 # ifdef BRA_NO_MPI
 #   include <vector>
+#   include <iterator>
+#   include <algorithm>
+
+#   include <boost/range/iterator_range.hpp>
 
 #   include <ket/gate/projective_measurement.hpp>
 #   include <ket/utility/integer_exp2.hpp>
+#   include <ket/utility/integer_log2.hpp>
 #   include <ket/utility/parallel/loop_n.hpp>
+#   include <ket/utility/mapped_file_allocator.hpp>
+#   include <ket/utility/huge_page_allocator.hpp>
+#   include <ket/utility/zero_page_allocator.hpp>
+#   include <ket/utility/resize_with_zeros.hpp>
+#   include <ket/mpi/qubit_permutation.hpp>
 
 #   include <bra/state.hpp>
 
@@ -18,9 +28,26 @@ namespace bra
   {
     ket::utility::policy::parallel<unsigned int> parallel_policy_;
 
-    using data_type = std::vector<complex_type>;
+    using data_type
+      = std::vector<
+          complex_type,
+          ket::utility::mapped_file_allocator<
+            complex_type, ket::utility::huge_page_allocator<complex_type, ket::utility::zero_page_allocator<complex_type>>>>;
     data_type data_;
 
+    // SWAP gates only exchange qubits in permutation_ instead of moving amplitudes. The other gates are applied to
+    // permutated qubits, and measured values are converted back to unpermutated ones
+    using permutation_type = ket::mpi::qubit_permutation<state_integer_type, bit_integer_type>;
+    permutation_type permutation_;
+
+    // amplitudes outside nonzero_data_, the aligned block of 2^num_nonzero_qubits_ amplitudes including the initial one,
+    // are known to be zeros, so that gates on qubits in the block neither read nor write the rest of data_.
+    // The block is the whole data_ from the beginning unless ket::utility::uses_zero_pages()
+    using nonzero_data_type = boost::iterator_range<data_type::iterator>;
+    state_integer_type initial_integer_;
+    bit_integer_type num_nonzero_qubits_;
+    nonzero_data_type nonzero_data_;
+
    public:
     nompi_state(
       ::bra::state::state_integer_type const initial_integer,
@@ -32,14 +59,65 @@ namespace bra
       ::bra::state::state_integer_type const initial_integer,
       unsigned int const total_num_qubits)
     {
-      auto result
-        = data_type(
-            ket::utility::integer_exp2<state_integer_type>(total_num_qubits),
-            complex_type{real_type{0}});
+      auto const num_amplitudes = ket::utility::integer_exp2<state_integer_type>(total_num_qubits);
+      auto result = data_type{};
+      ket::utility::resize_with_zeros(parallel_policy_, result, num_amplitudes);
+
       result[initial_integer] = complex_type{real_type{1}};
       return result;
     }
 
+    nonzero_data_type& expand_nonzero_data(bit_integer_type const num_qubits)
+    {
+      if (num_qubits <= num_nonzero_qubits_)
+        return nonzero_data_;
+
+      num_nonzero_qubits_ = num_qubits;
+      auto const block_size = ket::utility::integer_exp2<state_integer_type>(num_qubits);
+      auto const block_first = std::begin(data_) + (initial_integer_ bitand compl (block_size - state_integer_type{1u}));
+      nonzero_data_ = boost::make_iterator_range(block_first, block_first + block_size);
+      return nonzero_data_;
+    }
+
+    qubit_type permutated(qubit_type const qubit) const
+    { return permutation_[qubit].qubit(); }
+
+    control_qubit_type permutated(control_qubit_type const control_qubit) const
+    { return permutation_[control_qubit].qubit(); }
+
+    template <typename Qubit>
+    std::vector<Qubit> permutated(std::vector<Qubit> const& qubits) const
+    {
+      auto result = std::vector<Qubit>{};
+      result.reserve(qubits.size());
+      for (auto const& qubit: qubits)
+        result.push_back(permutated(qubit));
+      return result;
+    }
+
+    static bit_integer_type num_operated_qubits(qubit_type const qubit)
+    { return static_cast<bit_integer_type>(qubit) + bit_integer_type{1u}; }
+
+    static bit_integer_type num_operated_qubits(control_qubit_type const control_qubit)
+    { return num_operated_qubits(ket::remove_control(control_qubit)); }
+
+    template <typename Qubit>
+    static bit_integer_type num_operated_qubits(std::vector<Qubit> const& qubits)
+    {
+      auto result = bit_integer_type{0u};
+      for (auto const& qubit: qubits)
+        result = std::max(result, num_operated_qubits(qubit));
+      return result;
+    }
+
+    // returns the amplitudes which may be nonzero after a gate on qubits is applied
+    template <typename... Qubits>
+    nonzero_data_type& nonzero_data(Qubits const&... qubits)
+    { return expand_nonzero_data(std::max({num_operated_qubits(qubits)...})); }
+
+    // returns all amplitudes for operations which may make any of them nonzero
+    data_type& data() { expand_nonzero_data(ket::utility::integer_log2<bit_integer_type>(data_.size())); return data_; }
+
    public:
     ~nompi_state() = default;
     nompi_state(nompi_state const&) = delete;
@@ -48,6 +126,10 @@ namespace bra
     nompi_state& operator=(nompi_state&&) = delete;
 
    private:
+    void do_loop_chunk_size(std::size_t const chunk_size) override;
+    void do_record_busy_times() override;
+    std::vector<double> do_busy_times() const override;
+
     void do_hadamard(qubit_type const qubit) override;
     void do_adj_hadamard(qubit_type const qubit) override;
     void do_not_(qubit_type const qubit) override;
@@ -152,6 +234,19 @@ namespace bra
       state_integer_type const divisor, state_integer_type const base,
       std::vector<qubit_type> const& exponent_qubits,
       std::vector<qubit_type> const& modular_exponentiation_qubits) override;
+    void do_swapped_fourier_transform(std::vector<qubit_type> const& qubits) override;
+    void do_adj_swapped_fourier_transform(std::vector<qubit_type> const& qubits) override;
+    void do_addition_assignment(
+      std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits) override;
+    void do_subtraction_assignment(
+      std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits) override;
+    void do_constant_addition_assignment(
+      std::vector<qubit_type> const& qubits, state_integer_type const constant) override;
+    void do_modular_multiplication_assignment(
+      std::vector<qubit_type> const& qubits, state_integer_type const multiplier, state_integer_type const divisor) override;
+    void do_modular_exponentiation_assignment(
+      std::vector<qubit_type> const& exponent_qubits, std::vector<qubit_type> const& qubits,
+      state_integer_type const base, state_integer_type const divisor) override;
     void do_clear(qubit_type const qubit) override;
     void do_set(qubit_type const qubit) override;
     void do_controlled_hadamard(
@@ -302,6 +397,14 @@ namespace bra
     void do_adj_multi_controlled_exponential_swap(
       real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
       std::vector<control_qubit_type> const& control_qubits) override;
+    void do_unitary_matrix(std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits) override;
+    void do_blocked_unitary_matrices(
+      std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits_list,
+      bit_integer_type const num_block_qubits) override;
+    void do_quadratic_phase_shift(
+      complex_type const& global_phase_coefficient,
+      std::vector<std::pair<qubit_type, complex_type>> const& linear_phase_coefficients,
+      std::vector<std::tuple<qubit_type, qubit_type, complex_type>> const& quadratic_phase_coefficients) override;
   }; // class nompi_state
 
   inline std::unique_ptr< ::bra::state > make_nompi_state(
@@ -6,6 +6,9 @@
 
 #   include <ket/gate/projective_measurement.hpp>
 #   include <ket/utility/parallel/loop_n.hpp>
+#   include <ket/utility/mapped_file_allocator.hpp>
+#   include <ket/utility/huge_page_allocator.hpp>
+#   include <ket/utility/zero_page_allocator.hpp>
 #   include <ket/mpi/utility/simple_mpi.hpp>
 #   include <ket/mpi/state.hpp>
 
@@ -25,7 +28,13 @@ namespace bra
     ket::utility::policy::parallel<unsigned int> parallel_policy_;
     ket::mpi::utility::policy::simple_mpi mpi_policy_;
 
-    using data_type = ket::mpi::state<complex_type, true, yampi::allocator<complex_type>>;
+    using data_type
+      = ket::mpi::state<
+          complex_type, true,
+          ket::utility::mapped_file_allocator<
+            complex_type,
+            ket::utility::huge_page_allocator<
+              complex_type, ket::utility::zero_page_allocator<complex_type, yampi::allocator<complex_type>>>>>;
     data_type data_;
 
    public:
@@ -56,9 +65,15 @@ namespace bra
     paged_simple_mpi_state& operator=(paged_simple_mpi_state&&) = delete;
 
    private:
+    permutated_qubit_type least_global_permutated_qubit() const;
+
     unsigned int do_num_page_qubits() const override;
     unsigned int do_num_pages() const override;
 
+    void do_loop_chunk_size(std::size_t const chunk_size) override;
+    void do_record_busy_times() override;
+    std::vector<double> do_busy_times() const override;
+
     void do_hadamard(qubit_type const qubit) override;
     void do_adj_hadamard(qubit_type const qubit) override;
     void do_not_(qubit_type const qubit) override;
@@ -164,6 +179,19 @@ namespace bra
       state_integer_type const divisor, state_integer_type const base,
       std::vector<qubit_type> const& exponent_qubits,
       std::vector<qubit_type> const& modular_exponentiation_qubits) override;
+    void do_swapped_fourier_transform(std::vector<qubit_type> const& qubits) override;
+    void do_adj_swapped_fourier_transform(std::vector<qubit_type> const& qubits) override;
+    void do_addition_assignment(
+      std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits) override;
+    void do_subtraction_assignment(
+      std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits) override;
+    void do_constant_addition_assignment(
+      std::vector<qubit_type> const& qubits, state_integer_type const constant) override;
+    void do_modular_multiplication_assignment(
+      std::vector<qubit_type> const& qubits, state_integer_type const multiplier, state_integer_type const divisor) override;
+    void do_modular_exponentiation_assignment(
+      std::vector<qubit_type> const& exponent_qubits, std::vector<qubit_type> const& qubits,
+      state_integer_type const base, state_integer_type const divisor) override;
     void do_clear(qubit_type const qubit) override;
     void do_set(qubit_type const qubit) override;
     void do_controlled_hadamard(
@@ -314,6 +342,8 @@ namespace bra
     void do_adj_multi_controlled_exponential_swap(
       real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
       std::vector<control_qubit_type> const& control_qubits) override;
+    void do_unitary_matrix(std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits) override;
+    void do_interchange_qubits(std::vector<qubit_type> const& global_qubits, std::vector<qubit_type> const& local_qubits) override;
   }; // class paged_simple_mpi_state
 } // namespace bra
 
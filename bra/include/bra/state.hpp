@@ -5,6 +5,7 @@
 # include <complex>
 # include <vector>
 # include <array>
+# include <tuple>
 # include <utility>
 # ifdef BRA_NO_MPI
 #   include <chrono>
@@ -106,8 +107,10 @@ namespace bra
     permutation_type permutation_;
     std::vector<complex_type, yampi::allocator<complex_type>> buffer_;
     yampi::datatype real_pair_datatype_;
-    yampi::communicator const& communicator_;
+    yampi::communicator communicator_; // processes are renumbered if NOT gates on global qubits are absorbed
     yampi::environment const& environment_;
+    std::vector<yampi::rank> relabeled_ranks_; // relabeled_ranks_[r]: the present rank of the process of rank r in the given communicator
+    bool absorbs_global_permutations_;
 # endif // BRA_NO_MPI
 
     std::vector<time_and_process_type> finish_times_and_processes_;
@@ -167,8 +170,19 @@ namespace bra
 
     yampi::communicator const& communicator() const { return communicator_; }
     yampi::environment const& environment() const { return environment_; }
+
+    // makes X, CNOT and TOFFOLI gates only on global qubits renumber processes, and SWAP gates permutate qubits,
+    // instead of moving amplitudes. It is applied only in simple mode
+    void absorb_global_permutations(bool const absorbs) { absorbs_global_permutations_ = absorbs; }
 # endif // BRA_NO_MPI
 
+    // sets the number of loop iterations in each chunk which idle threads take from other threads, or 0 for static scheduling
+    void loop_chunk_size(std::size_t const chunk_size) { do_loop_chunk_size(chunk_size); }
+    // starts recording the time which each thread spends in parallel loops, which is not recorded by default
+    void record_busy_times() { do_record_busy_times(); }
+    // returns the time in seconds which each thread has spent in parallel loops, or an empty vector if not recorded
+    std::vector<double> busy_times() const { return do_busy_times(); }
+
     std::size_t num_finish_processes() const { return finish_times_and_processes_.size(); }
     time_and_process_type const& finish_time_and_process(std::size_t const n) const
     { return finish_times_and_processes_[n]; }
@@ -409,6 +423,28 @@ namespace bra
 
     ::bra::state& shor_box(bit_integer_type const num_exponent_qubits, state_integer_type const divisor, state_integer_type const base);
 
+    // QFT: |x> -> 2^(-n/2) sum_y exp(2 pi i x y / 2^n) |y>, where qubits[0] is the least significant bit of x and y
+    ::bra::state& fourier_transform(std::vector<qubit_type> const& qubits);
+    ::bra::state& adj_fourier_transform(std::vector<qubit_type> const& qubits);
+
+    // arithmetic on registers as permutations of basis states, where qubits[0] is the least significant bit of a register.
+    // lhs += rhs and lhs -= rhs modulo 2^n
+    ::bra::state& addition_assignment(std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits)
+    { do_addition_assignment(lhs_qubits, rhs_qubits); return *this; }
+    ::bra::state& subtraction_assignment(std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits)
+    { do_subtraction_assignment(lhs_qubits, rhs_qubits); return *this; }
+    // x += constant modulo 2^n
+    ::bra::state& constant_addition_assignment(std::vector<qubit_type> const& qubits, state_integer_type const constant)
+    { do_constant_addition_assignment(qubits, constant); return *this; }
+    // x = multiplier * x mod divisor, and x = base^e * x mod divisor, if x < divisor
+    ::bra::state& modular_multiplication_assignment(
+      std::vector<qubit_type> const& qubits, state_integer_type const multiplier, state_integer_type const divisor)
+    { do_modular_multiplication_assignment(qubits, multiplier, divisor); return *this; }
+    ::bra::state& modular_exponentiation_assignment(
+      std::vector<qubit_type> const& exponent_qubits, std::vector<qubit_type> const& qubits,
+      state_integer_type const base, state_integer_type const divisor)
+    { do_modular_exponentiation_assignment(exponent_qubits, qubits, base, divisor); return *this; }
+
     ::bra::state& clear(qubit_type const qubit)
     { do_clear(qubit); return *this; }
 
@@ -639,11 +675,11 @@ namespace bra
 
     ::bra::state& controlled_exponential_pauli_y(
       real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_controlled_exponential_pauli_x(phase, target_qubit, control_qubit); return *this; }
+    { do_controlled_exponential_pauli_y(phase, target_qubit, control_qubit); return *this; }
 
     ::bra::state& adj_controlled_exponential_pauli_y(
       real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_adj_controlled_exponential_pauli_x(phase, target_qubit, control_qubit); return *this; }
+    { do_adj_controlled_exponential_pauli_y(phase, target_qubit, control_qubit); return *this; }
 
     ::bra::state& multi_controlled_exponential_pauli_yn(
       real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
@@ -655,11 +691,11 @@ namespace bra
 
     ::bra::state& controlled_exponential_pauli_z(
       real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_controlled_exponential_pauli_x(phase, target_qubit, control_qubit); return *this; }
+    { do_controlled_exponential_pauli_z(phase, target_qubit, control_qubit); return *this; }
 
     ::bra::state& adj_controlled_exponential_pauli_z(
       real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-    { do_adj_controlled_exponential_pauli_x(phase, target_qubit, control_qubit); return *this; }
+    { do_adj_controlled_exponential_pauli_z(phase, target_qubit, control_qubit); return *this; }
 
     ::bra::state& multi_controlled_exponential_pauli_zn(
       real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
@@ -679,12 +715,52 @@ namespace bra
       std::vector<control_qubit_type> const& control_qubits)
     { do_adj_multi_controlled_exponential_swap(phase, target_qubit1, target_qubit2, control_qubits); return *this; }
 
+    // matrix: row-major 2^n x 2^n matrix, where n = qubits.size(). The 0th bit of its indices corresponds to qubits[0]
+    ::bra::state& unitary_matrix(std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits)
+    { do_unitary_matrix(matrix, qubits); return *this; }
+
+    // applies all matrices in order to each block of 2^num_block_qubits consecutive elements of the state before moving to the next block.
+    // Every qubit in qubits_list must be less than num_block_qubits
+    ::bra::state& blocked_unitary_matrices(
+      std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits_list,
+      bit_integer_type const num_block_qubits)
+    { do_blocked_unitary_matrices(matrices, qubits_list, num_block_qubits); return *this; }
+
+    // multiplies the amplitude of |x> by global_phase_coefficient prod_i a_i^{x_i} prod_{ij} b_ij^{x_i x_j},
+    // where (qubit i, a_i) are in linear_phase_coefficients and (qubit i, qubit j, b_ij) are in quadratic_phase_coefficients
+    ::bra::state& quadratic_phase_shift(
+      complex_type const& global_phase_coefficient,
+      std::vector<std::pair<qubit_type, complex_type>> const& linear_phase_coefficients,
+      std::vector<std::tuple<qubit_type, qubit_type, complex_type>> const& quadratic_phase_coefficients)
+    { do_quadratic_phase_shift(global_phase_coefficient, linear_phase_coefficients, quadratic_phase_coefficients); return *this; }
+
+    // exchanges global_qubits[i] with local_qubits[i] for each i in one interchange of global qubits.
+    // Does nothing if some of global_qubits are local or some of local_qubits are global, or if the state cannot be planned
+    ::bra::state& interchange_qubits(std::vector<qubit_type> const& global_qubits, std::vector<qubit_type> const& local_qubits)
+    { do_interchange_qubits(global_qubits, local_qubits); return *this; }
+
+# ifndef BRA_NO_MPI
+   protected:
+    // applies a NOT gate on target_qubit controlled by control_qubits by renumbering processes if global permutations are absorbed
+    // and all the qubits are global, i.e. their permutated qubits are not less than least_global_permutated_qubit.
+    // Returns false if the gate should be applied in the usual way
+    bool maybe_relabel_processes(
+      permutated_qubit_type const least_global_permutated_qubit,
+      qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits);
+    // applies a SWAP gate by permutating qubit1 and qubit2 if global permutations are absorbed
+    bool maybe_permutate_qubits(qubit_type const qubit1, qubit_type const qubit2);
+
+# endif // BRA_NO_MPI
    private:
 # ifndef BRA_NO_MPI
     virtual unsigned int do_num_page_qubits() const = 0;
     virtual unsigned int do_num_pages() const = 0;
 
 # endif
+    virtual void do_loop_chunk_size(std::size_t const chunk_size) = 0;
+    virtual void do_record_busy_times() = 0;
+    virtual std::vector<double> do_busy_times() const = 0;
+
     virtual void do_hadamard(qubit_type const qubit) = 0;
     virtual void do_adj_hadamard(qubit_type const qubit) = 0;
     virtual void do_not_(qubit_type const qubit) = 0;
@@ -797,6 +873,19 @@ namespace bra
       state_integer_type const divisor, state_integer_type const base,
       std::vector<qubit_type> const& exponent_qubits,
       std::vector<qubit_type> const& modular_exponentiation_qubits) = 0;
+    virtual void do_swapped_fourier_transform(std::vector<qubit_type> const& qubits) = 0;
+    virtual void do_adj_swapped_fourier_transform(std::vector<qubit_type> const& qubits) = 0;
+    virtual void do_addition_assignment(
+      std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits) = 0;
+    virtual void do_subtraction_assignment(
+      std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits) = 0;
+    virtual void do_constant_addition_assignment(
+      std::vector<qubit_type> const& qubits, state_integer_type const constant) = 0;
+    virtual void do_modular_multiplication_assignment(
+      std::vector<qubit_type> const& qubits, state_integer_type const multiplier, state_integer_type const divisor) = 0;
+    virtual void do_modular_exponentiation_assignment(
+      std::vector<qubit_type> const& exponent_qubits, std::vector<qubit_type> const& qubits,
+      state_integer_type const base, state_integer_type const divisor) = 0;
     virtual void do_clear(qubit_type const qubit) = 0;
     virtual void do_set(qubit_type const qubit) = 0;
     virtual void do_controlled_hadamard(
@@ -943,6 +1032,15 @@ namespace bra
     virtual void do_adj_multi_controlled_exponential_swap(
       real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
       std::vector<control_qubit_type> const& control_qubits) = 0;
+    virtual void do_unitary_matrix(std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits) = 0;
+    virtual void do_blocked_unitary_matrices(
+      std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits_list,
+      bit_integer_type const num_block_qubits);
+    virtual void do_quadratic_phase_shift(
+      complex_type const& global_phase_coefficient,
+      std::vector<std::pair<qubit_type, complex_type>> const& linear_phase_coefficients,
+      std::vector<std::tuple<qubit_type, qubit_type, complex_type>> const& quadratic_phase_coefficients);
+    virtual void do_interchange_qubits(std::vector<qubit_type> const& global_qubits, std::vector<qubit_type> const& local_qubits);
   }; // class state
 } // namespace bra
 
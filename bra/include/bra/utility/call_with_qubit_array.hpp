@@ -0,0 +1,67 @@
+#ifndef BRA_UTILITY_CALL_WITH_QUBIT_ARRAY_HPP
+# define BRA_UTILITY_CALL_WITH_QUBIT_ARRAY_HPP
+
+# include <cstddef>
+# include <array>
+# include <vector>
+# include <algorithm>
+# include <iterator>
+
+# include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace utility
+  {
+    namespace call_with_qubit_array_detail
+    {
+      template <std::size_t num_qubits, typename Qubit, typename Function>
+      void call_with_qubit_array(std::vector<Qubit> const& qubits, Function& function)
+      {
+        auto qubit_array = std::array<Qubit, num_qubits>{};
+        std::copy(std::begin(qubits), std::end(qubits), std::begin(qubit_array));
+        function(qubit_array);
+      }
+    } // namespace call_with_qubit_array_detail
+
+    // calls function(qubit_array) with std::array of qubits for functions of ket::mpi whose number of qubits is a template parameter
+    template <typename Qubit, typename Function>
+    void call_with_qubit_array(std::vector<Qubit> const& qubits, Function&& function)
+    {
+      auto const num_qubits = qubits.size();
+      switch (num_qubits)
+      {
+       case 1u:
+        ::bra::utility::call_with_qubit_array_detail::call_with_qubit_array<1u>(qubits, function);
+        break;
+
+       case 2u:
+        ::bra::utility::call_with_qubit_array_detail::call_with_qubit_array<2u>(qubits, function);
+        break;
+
+       case 3u:
+        ::bra::utility::call_with_qubit_array_detail::call_with_qubit_array<3u>(qubits, function);
+        break;
+
+       case 4u:
+        ::bra::utility::call_with_qubit_array_detail::call_with_qubit_array<4u>(qubits, function);
+        break;
+
+       case 5u:
+        ::bra::utility::call_with_qubit_array_detail::call_with_qubit_array<5u>(qubits, function);
+        break;
+
+       case 6u:
+        ::bra::utility::call_with_qubit_array_detail::call_with_qubit_array<6u>(qubits, function);
+        break;
+
+       default:
+        throw ::bra::too_many_qubits_error{num_qubits};
+      }
+    }
+  } // namespace utility
+} // namespace bra
+
+
+#endif // BRA_UTILITY_CALL_WITH_QUBIT_ARRAY_HPP
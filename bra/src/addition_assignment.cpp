@@ -0,0 +1,40 @@
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/addition_assignment.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const addition_assignment::name_ = "ADD";
+
+    addition_assignment::addition_assignment(
+      std::vector<qubit_type>&& lhs_qubits, std::vector<qubit_type>&& rhs_qubits)
+      : ::bra::gate::gate{}, lhs_qubits_{std::move(lhs_qubits)}, rhs_qubits_{std::move(rhs_qubits)}
+    { }
+
+    ::bra::state& addition_assignment::do_apply(::bra::state& state) const
+    { return state.addition_assignment(lhs_qubits_, rhs_qubits_); }
+
+    std::string const& addition_assignment::do_name() const { return name_; }
+    std::string addition_assignment::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit: lhs_qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      for (auto&& qubit: rhs_qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
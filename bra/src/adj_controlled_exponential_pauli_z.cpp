@@ -1,10 +1,12 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
 
 #include <ket/qubit_io.hpp>
 #include <ket/control_io.hpp>
+#include <ket/utility/exp_i.hpp>
 
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_controlled_exponential_pauli_z.hpp>
@@ -36,5 +38,16 @@ namespace bra
         << std::setw(parameter_width) << phase_;
       return repr_stream.str();
     }
+
+    bool adj_controlled_exponential_pauli_z::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix = {
+        complex_type{1}, complex_type{0}, complex_type{0}, complex_type{0},
+        complex_type{0}, complex_type{1}, complex_type{0}, complex_type{0},
+        complex_type{0}, complex_type{0}, ::ket::utility::exp_i<complex_type>(-phase_), complex_type{0},
+        complex_type{0}, complex_type{0}, complex_type{0}, ::ket::utility::exp_i<complex_type>(phase_)};
+      qubits = {target_qubit_, control_qubit_.qubit()};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -36,5 +37,16 @@ namespace bra
         << std::setw(parameter_width) << target_qubit_;
       return repr_stream.str();
     }
+
+    bool adj_controlled_not::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix = {
+        complex_type{1}, complex_type{0}, complex_type{0}, complex_type{0},
+        complex_type{0}, complex_type{1}, complex_type{0}, complex_type{0},
+        complex_type{0}, complex_type{0}, complex_type{0}, complex_type{1},
+        complex_type{0}, complex_type{0}, complex_type{1}, complex_type{0}};
+      qubits = {target_qubit_, control_qubit_.qubit()};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
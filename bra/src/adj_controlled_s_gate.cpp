@@ -1,4 +1,6 @@
 #include <string>
+#include <vector>
+#include <complex>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -39,5 +41,17 @@ namespace bra
         << std::setw(parameter_width) << target_qubit_;
       return repr_stream.str();
     }
+
+    bool adj_controlled_s_gate::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      using std::conj;
+      matrix = {
+        complex_type{1}, complex_type{0}, complex_type{0}, complex_type{0},
+        complex_type{0}, complex_type{1}, complex_type{0}, complex_type{0},
+        complex_type{0}, complex_type{0}, complex_type{1}, complex_type{0},
+        complex_type{0}, complex_type{0}, complex_type{0}, conj(phase_coefficient_)};
+      qubits = {target_qubit_, control_qubit_.qubit()};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
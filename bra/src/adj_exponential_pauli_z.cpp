@@ -1,9 +1,11 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
 
 #include <ket/qubit_io.hpp>
+#include <ket/utility/exp_i.hpp>
 
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_exponential_pauli_z.hpp>
@@ -33,5 +35,12 @@ namespace bra
         << std::setw(parameter_width) << phase_;
       return repr_stream.str();
     }
+
+    bool adj_exponential_pauli_z::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix = {::ket::utility::exp_i<complex_type>(-phase_), complex_type{0}, complex_type{0}, ::ket::utility::exp_i<complex_type>(phase_)};
+      qubits = {qubit_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
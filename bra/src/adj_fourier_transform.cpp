@@ -0,0 +1,37 @@
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/adj_fourier_transform.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const adj_fourier_transform::name_ = "IQFT";
+
+    adj_fourier_transform::adj_fourier_transform(std::vector<qubit_type>&& qubits)
+      : ::bra::gate::gate{}, qubits_{std::move(qubits)}
+    { }
+
+    ::bra::state& adj_fourier_transform::do_apply(::bra::state& state) const
+    { return state.adj_fourier_transform(qubits_); }
+
+    std::string const& adj_fourier_transform::do_name() const { return name_; }
+    std::string adj_fourier_transform::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit: qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
@@ -1,4 +1,6 @@
 #include <string>
+#include <vector>
+#include <complex>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -33,5 +35,13 @@ namespace bra
         << std::setw(parameter_width) << qubit_;
       return repr_stream.str();
     }
+
+    bool adj_s_gate::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      using std::conj;
+      matrix = {complex_type{1}, complex_type{0}, complex_type{0}, conj(phase_coefficient_)};
+      qubits = {qubit_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
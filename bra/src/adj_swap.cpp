@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -33,5 +34,16 @@ namespace bra
         << std::setw(parameter_width) << qubit2_;
       return repr_stream.str();
     }
+
+    bool adj_swap::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix = {
+        complex_type{1}, complex_type{0}, complex_type{0}, complex_type{0},
+        complex_type{0}, complex_type{0}, complex_type{1}, complex_type{0},
+        complex_type{0}, complex_type{1}, complex_type{0}, complex_type{0},
+        complex_type{0}, complex_type{0}, complex_type{0}, complex_type{1}};
+      qubits = {qubit1_, qubit2_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
@@ -1,9 +1,13 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
 
+#include <boost/math/constants/constants.hpp>
+
 #include <ket/qubit_io.hpp>
+#include <ket/utility/imaginary_unit.hpp>
 
 #include <bra/gate/gate.hpp>
 #include <bra/gate/adj_x_rotation_half_pi.hpp>
@@ -32,5 +36,15 @@ namespace bra
         << std::setw(parameter_width) << qubit_;
       return repr_stream.str();
     }
+
+    bool adj_x_rotation_half_pi::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      using real_type = ::bra::state::real_type;
+      using boost::math::constants::one_div_root_two;
+      auto const coefficient = -one_div_root_two<real_type>() * ::ket::utility::imaginary_unit<complex_type>();
+      matrix = {complex_type{one_div_root_two<real_type>()}, coefficient, coefficient, complex_type{one_div_root_two<real_type>()}};
+      qubits = {qubit_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
@@ -1,8 +1,11 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
 
+#include <boost/math/constants/constants.hpp>
+
 #include <ket/qubit_io.hpp>
 
 #include <bra/gate/gate.hpp>
@@ -32,5 +35,16 @@ namespace bra
         << std::setw(parameter_width) << qubit_;
       return repr_stream.str();
     }
+
+    bool adj_y_rotation_half_pi::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      using real_type = ::bra::state::real_type;
+      using boost::math::constants::one_div_root_two;
+      matrix = {
+        complex_type{one_div_root_two<real_type>()}, complex_type{-one_div_root_two<real_type>()},
+        complex_type{one_div_root_two<real_type>()}, complex_type{one_div_root_two<real_type>()}};
+      qubits = {qubit_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
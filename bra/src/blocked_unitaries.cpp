@@ -0,0 +1,54 @@
+#include <cstddef>
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/blocked_unitaries.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const blocked_unitaries::name_ = "BLOCKED";
+
+    blocked_unitaries::blocked_unitaries(
+      std::vector<std::vector<complex_type>>&& matrices, std::vector<std::vector<qubit_type>>&& qubits_list,
+      std::vector<std::pair<qubit_type, qubit_type>>&& swapped_qubits, bit_integer_type const num_block_qubits)
+      : ::bra::gate::gate{},
+        matrices_{std::move(matrices)}, qubits_list_{std::move(qubits_list)},
+        swapped_qubits_{std::move(swapped_qubits)}, num_block_qubits_{num_block_qubits}
+    { }
+
+    ::bra::state& blocked_unitaries::do_apply(::bra::state& state) const
+    {
+      for (auto const& qubit_pair: swapped_qubits_)
+        state.swap(qubit_pair.first, qubit_pair.second);
+
+      state.blocked_unitary_matrices(matrices_, qubits_list_, num_block_qubits_);
+
+      for (auto const& qubit_pair: swapped_qubits_)
+        state.swap(qubit_pair.first, qubit_pair.second);
+
+      return state;
+    }
+
+    std::string const& blocked_unitaries::do_name() const { return name_; }
+    std::string blocked_unitaries::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      repr_stream << std::right << std::setw(parameter_width) << num_block_qubits_;
+      for (auto&& qubit_pair: swapped_qubits_)
+        repr_stream << ' ' << qubit_pair.first << "<->" << qubit_pair.second;
+      repr_stream << " (" << matrices_.size() << " gates)";
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
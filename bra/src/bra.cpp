@@ -1,5 +1,6 @@
 #include <cstddef>
 #include <cstdlib>
+#include <array>
 #include <iostream>
 #include <fstream>
 #include <string>
@@ -7,6 +8,8 @@
 #include <random>
 #include <chrono>
 
+#include <sys/resource.h>
+
 #define FMT_HEADER_ONLY
 #include <fmt/core.h>
 
@@ -18,10 +21,24 @@
 # include <yampi/communicator.hpp>
 # include <yampi/rank.hpp>
 # include <yampi/wall_clock.hpp>
+# ifdef KET_USE_COMPRESSED_INTERCHANGE
+#   include <yampi/buffer.hpp>
+#   include <yampi/reduce.hpp>
+#   include <yampi/binary_operation.hpp>
+# endif // KET_USE_COMPRESSED_INTERCHANGE
 #endif
 
 #include <ket/utility/integer_exp2.hpp>
 #include <ket/utility/integer_log2.hpp>
+#include <ket/utility/mapped_file_allocator.hpp>
+#include <ket/utility/huge_page_allocator.hpp>
+#include <ket/utility/zero_page_allocator.hpp>
+#ifndef BRA_NO_MPI
+# include <ket/mpi/utility/make_node_aware_communicator.hpp>
+# ifdef KET_USE_COMPRESSED_INTERCHANGE
+#   include <ket/mpi/utility/compressed_interchange.hpp>
+# endif // KET_USE_COMPRESSED_INTERCHANGE
+#endif
 
 #include <bra/gates.hpp>
 #include <bra/state.hpp>
@@ -91,13 +108,27 @@ int main(int argc, char* argv[])
   options.add_options()
     ("m,mode", "set mode, \"simple\" or \"unit\"", cxxopts::value<std::string>()->default_value("simple"))
     ("f,file", "set the name of input qcx file, or read from standard input if this option is unspecified", cxxopts::value<std::string>())
+    ("compile", "compile the input qcx file into the given binary file and exit", cxxopts::value<std::string>())
+    ("load-compiled", "set the name of binary file written with --compile, which is read instead of a qcx file", cxxopts::value<std::string>())
 #ifdef BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
     ("buffer-size", "set the number of complex numbers in buffer (meaningful only if the value of page-qubits is 0)", cxxopts::value<unsigned int>()->default_value("65536"))
 #endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
+#ifdef KET_USE_COMPRESSED_INTERCHANGE
+    ("compression-tolerance", "set the tolerance of compression in interchanges of qubits: amplitudes whose real and imaginary parts are not larger than it in magnitude are sent as zeros, or compression is lossless if 0", cxxopts::value<double>()->default_value("0"))
+#endif // KET_USE_COMPRESSED_INTERCHANGE
     ("unit-qubits", "set the number of unit qubits (meaningful only for unit mode)", cxxopts::value<unsigned int>())
     ("unit-processes", "set the number of MPI processes for each unit (meaningful only for unit mode)", cxxopts::value<unsigned int>())
+    ("node-aware", "renumber MPI processes so that processes on the same node have consecutive ranks and form units, without sharing memory between them (meaningful only for unit mode)")
     ("threads", "set the number of threads per process", cxxopts::value<unsigned int>()->default_value("1"))
+    ("chunk-size", "set the number of loop iterations in each chunk which idle threads take from other threads, or split loops statically if 0", cxxopts::value<std::size_t>()->default_value("0"))
+    ("busy-times", "print the time which each thread spends in parallel loops")
     ("page-qubits", "set the number of page qubits", cxxopts::value<unsigned int>()->default_value("2"))
+    ("mapped-file-directory", "map the state onto temporary files in the given directory so that it may be larger than memory (meaningful only if the value of page-qubits is not 0)", cxxopts::value<std::string>())
+    ("huge-pages", "allocate the state with huge pages, and initialize it in parallel so that each thread touches its own part first")
+    ("zero-pages", "allocate the state with pages which are filled with zeros when they are touched first, instead of writing zeros into the whole state at initialization")
+    ("fusion-qubits", "set the maximum number of qubits of fused gates, or disable gate fusion if 0 (at most 6)", cxxopts::value<unsigned int>()->default_value("0"))
+    ("lookahead-gates", "plan interchanges of global qubits looking ahead the given number of gates (meaningful only for simple mode), or disable planning if 0", cxxopts::value<std::size_t>()->default_value("0"))
+    ("absorb-global-permutations", "apply X, CNOT and TOFFOLI gates only on global qubits by renumbering MPI processes, and SWAP gates by permutating qubits, instead of moving amplitudes (meaningful only for simple mode)")
     ("seed", "set seed of random number generator", cxxopts::value<seed_type>()->default_value("1"))
     ("h,help", "print this information")
     ;
@@ -105,7 +136,17 @@ int main(int argc, char* argv[])
   auto options = cxxopts::Options{"bra", "Full-state simulator of quantum circuits (single-process ver.)"};
   options.add_options()
     ("f,file", "set the name of input qcx file, or read from standard input if this option is unspecified", cxxopts::value<std::string>())
+    ("compile", "compile the input qcx file into the given binary file and exit", cxxopts::value<std::string>())
+    ("load-compiled", "set the name of binary file written with --compile, which is read instead of a qcx file", cxxopts::value<std::string>())
     ("threads", "set the number of threads", cxxopts::value<unsigned int>()->default_value("1"))
+    ("chunk-size", "set the number of loop iterations in each chunk which idle threads take from other threads, or split loops statically if 0", cxxopts::value<std::size_t>()->default_value("0"))
+    ("busy-times", "print the time which each thread spends in parallel loops")
+    ("fusion-qubits", "set the maximum number of qubits of fused gates, or disable gate fusion if 0 (at most 10)", cxxopts::value<unsigned int>()->default_value("0"))
+    ("block-qubits", "set the number of qubits of each cache block to which consecutive gates are applied together, or disable cache blocking if 0", cxxopts::value<unsigned int>()->default_value("0"))
+    ("accumulate-diagonal-gates", "apply each run of consecutive diagonal gates on at most two qubits, such as Z, T, U1, CZ and eZZ, in one pass over the state")
+    ("mapped-file-directory", "map the state onto a temporary file in the given directory so that it may be larger than memory", cxxopts::value<std::string>())
+    ("huge-pages", "allocate the state with huge pages, and initialize it in parallel so that each thread touches its own part first")
+    ("zero-pages", "allocate the state with pages which are filled with zeros when they are touched first, instead of writing zeros into the whole state at initialization")
     ("seed", "set seed of random number generator", cxxopts::value<seed_type>()->default_value("1"))
     ("h,help", "print this information")
     ;
@@ -146,6 +187,9 @@ int main(int argc, char* argv[])
     std::exit(EXIT_FAILURE);
   }
 #endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
+#ifdef KET_USE_COMPRESSED_INTERCHANGE
+  ket::mpi::utility::compressed_interchange_tolerance() = parse_result["compression-tolerance"].as<double>();
+#endif // KET_USE_COMPRESSED_INTERCHANGE
 
   auto num_unit_qubits = 0u;
   auto num_processes_per_unit = 1u;
@@ -161,6 +205,9 @@ int main(int argc, char* argv[])
         std::cerr << "Error: wrong argument\n" << options.help() << std::flush;
       std::exit(EXIT_FAILURE);
     }
+
+    if (parse_result.count("node-aware"))
+      communicator = ket::mpi::utility::make_node_aware_communicator(communicator, environment);
   }
   else if (not is_simple)
   {
@@ -170,8 +217,30 @@ int main(int argc, char* argv[])
   }
 #endif // BRA_NO_MPI
 
+  if (parse_result.count("mapped-file-directory"))
+    ket::utility::mapped_file_directory() = parse_result["mapped-file-directory"].as<std::string>();
+  ket::utility::uses_huge_pages() = parse_result.count("huge-pages") > 0u;
+  ket::utility::uses_zero_pages() = parse_result.count("zero-pages") > 0u;
+
   auto const num_threads_per_process = parse_result["threads"].as<unsigned int>();
   auto const seed = parse_result["seed"].as<seed_type>();
+  auto const num_fusion_qubits = parse_result["fusion-qubits"].as<unsigned int>();
+#ifndef BRA_NO_MPI
+  // qubits of fused gates are interchanged as a compile-time sized array in MPI versions
+  constexpr auto max_num_fusion_qubits = 6u;
+#else // BRA_NO_MPI
+  constexpr auto max_num_fusion_qubits = 10u;
+#endif // BRA_NO_MPI
+  if (num_fusion_qubits > max_num_fusion_qubits)
+  {
+#ifndef BRA_NO_MPI
+    if (is_io_root_rank)
+      std::cerr << "Error: wrong argument\n" << options.help() << std::flush;
+#else // BRA_NO_MPI
+    std::cerr << "Error: wrong argument\n" << options.help() << std::flush;
+#endif // BRA_NO_MPI
+    std::exit(EXIT_FAILURE);
+  }
 
   std::ifstream possible_input_stream;
   if (parse_result.count("file"))
@@ -193,8 +262,50 @@ int main(int argc, char* argv[])
     }
   }
 
+  if (parse_result.count("compile"))
+  {
+    auto const compiled_filename = parse_result["compile"].as<std::string>();
+#ifndef BRA_NO_MPI
+    if (is_io_root_rank)
+    {
+      std::ofstream compiled_stream{compiled_filename, std::ios::binary};
+      bra::compile_gates(parse_result.count("file") ? possible_input_stream : std::cin, compiled_stream);
+      if (not compiled_stream)
+      {
+        std::cerr << "ERROR: cannot write a compiled file " << compiled_filename << std::endl;
+        std::exit(EXIT_FAILURE);
+      }
+    }
+#else // BRA_NO_MPI
+    std::ofstream compiled_stream{compiled_filename, std::ios::binary};
+    bra::compile_gates(parse_result.count("file") ? possible_input_stream : std::cin, compiled_stream);
+    if (not compiled_stream)
+    {
+      std::cerr << "ERROR: cannot write a compiled file " << compiled_filename << std::endl;
+      std::exit(EXIT_FAILURE);
+    }
+#endif // BRA_NO_MPI
+    std::exit(EXIT_SUCCESS);
+  }
+
 #ifndef BRA_NO_MPI
-  auto gates = bra::gates{parse_result.count("file") ? possible_input_stream : std::cin, num_unit_qubits, num_processes_per_unit, environment, root_rank, communicator};
+  auto gates
+    = parse_result.count("load-compiled")
+      ? bra::gates{parse_result["load-compiled"].as<std::string>(), num_unit_qubits, num_processes_per_unit, environment, root_rank, communicator}
+      : bra::gates{parse_result.count("file") ? possible_input_stream : std::cin, num_unit_qubits, num_processes_per_unit, environment, root_rank, communicator};
+  gates.fuse(num_fusion_qubits);
+  auto const num_lookahead_gates = parse_result["lookahead-gates"].as<std::size_t>();
+  if (is_simple and num_lookahead_gates > std::size_t{0u})
+  {
+    auto const prediction = gates.plan_permutation(num_lookahead_gates, parse_result.count("absorb-global-permutations") > 0u);
+    if (is_io_root_rank)
+      std::cout
+        << "Planned interchanges of global qubits: " << prediction.num_planned_interchanges
+        << " (" << prediction.num_planned_bytes << " bytes sent by each process), "
+        << prediction.num_unplanned_interchanges
+        << " (" << prediction.num_unplanned_bytes << " bytes sent by each process) without planning"
+        << std::endl;
+  }
 # ifndef BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
   auto state_ptr
     = is_unit
@@ -215,11 +326,27 @@ int main(int argc, char* argv[])
           num_threads_per_process, seed, num_elements_in_buffer, communicator, environment);
 # endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
 #else // BRA_NO_MPI
-  auto gates = bra::gates{parse_result.count("file") ? possible_input_stream : std::cin};
+  auto gates
+    = parse_result.count("load-compiled")
+      ? bra::gates{parse_result["load-compiled"].as<std::string>()}
+      : bra::gates{parse_result.count("file") ? possible_input_stream : std::cin};
+  if (parse_result.count("accumulate-diagonal-gates"))
+    gates.accumulate_diagonal_gates();
+  gates.fuse(num_fusion_qubits);
+  gates.block(parse_result["block-qubits"].as<unsigned int>());
   auto state_ptr
     = bra::make_nompi_state(gates.initial_state_value(), gates.num_qubits(), num_threads_per_process, seed);
 #endif // BRA_NO_MPI
+  state_ptr->loop_chunk_size(parse_result["chunk-size"].as<std::size_t>());
+  if (parse_result.count("busy-times"))
+    state_ptr->record_busy_times();
+#ifndef BRA_NO_MPI
+  state_ptr->absorb_global_permutations(parse_result.count("absorb-global-permutations") > 0u);
+#endif // BRA_NO_MPI
 
+  // block I/O and major page faults of this process are measured to show the storage traffic of mapped states
+  auto start_usage = rusage{};
+  getrusage(RUSAGE_SELF, &start_usage);
 #ifndef BRA_NO_MPI
   auto const start_time = BRA_clock::now(environment);
 #else
@@ -228,8 +355,28 @@ int main(int argc, char* argv[])
   auto last_processed_time = start_time;
 
   *state_ptr << gates;
+#ifndef BRA_NO_MPI
+  auto const operations_finish_time = BRA_clock::now(environment);
+#else
+  auto const operations_finish_time = BRA_clock::now();
+#endif
+  auto operations_finish_usage = rusage{};
+  getrusage(RUSAGE_SELF, &operations_finish_usage);
 
 #ifndef BRA_NO_MPI
+# ifdef KET_USE_COMPRESSED_INTERCHANGE
+  {
+    auto const& statistics = ket::mpi::utility::compressed_interchange_statistics();
+    auto const local_num_bytes = std::array<std::size_t, 2u>{statistics.num_compressed_bytes, statistics.num_uncompressed_bytes};
+    auto num_bytes = std::array<std::size_t, 2u>{};
+    yampi::reduce(
+      yampi::make_buffer(std::begin(local_num_bytes), std::end(local_num_bytes)), std::begin(num_bytes),
+      yampi::binary_operation(yampi::plus_t()), root_rank, communicator, environment);
+    if (is_io_root_rank)
+      std::cout
+        << "Interchanged bytes: " << num_bytes[0u] << " (compressed), " << num_bytes[1u] << " (uncompressed)" << std::endl;
+  }
+# endif // KET_USE_COMPRESSED_INTERCHANGE
   if (not is_io_root_rank)
     return EXIT_SUCCESS;
 #endif
@@ -298,6 +445,29 @@ int main(int argc, char* argv[])
       break;
     }
   }
+
+  if (parse_result.count("mapped-file-directory"))
+  {
+    // ru_inblock and ru_oublock are counted in 512-byte blocks. Pages written are counted when they get dirty,
+    // and pages read are not counted if they are still in the page cache
+    auto const num_read_bytes = 512.0 * static_cast<double>(operations_finish_usage.ru_inblock - start_usage.ru_inblock);
+    auto const num_written_bytes = 512.0 * static_cast<double>(operations_finish_usage.ru_oublock - start_usage.ru_oublock);
+    auto const operations_time = duration_to_second(start_time, operations_finish_time);
+    std::cout
+      << "Storage I/O of mapped state: "
+      << 1.0e-9 * num_read_bytes << " GB read, " << 1.0e-9 * num_written_bytes << " GB written ("
+      << 1.0e-9 * (num_read_bytes + num_written_bytes) / operations_time << " GB/s), "
+      << (operations_finish_usage.ru_majflt - start_usage.ru_majflt) << " major page faults"
+      << std::endl;
+  }
+
+  if (parse_result.count("busy-times"))
+  {
+    std::cout << "Busy times of threads:";
+    for (auto const busy_time: state_ptr->busy_times())
+      std::cout << ' ' << busy_time;
+    std::cout << std::endl;
+  }
 }
 
 
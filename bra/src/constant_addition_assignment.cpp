@@ -0,0 +1,39 @@
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/constant_addition_assignment.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const constant_addition_assignment::name_ = "ADDC";
+
+    constant_addition_assignment::constant_addition_assignment(
+      std::vector<qubit_type>&& qubits, state_integer_type const constant)
+      : ::bra::gate::gate{}, qubits_{std::move(qubits)}, constant_{constant}
+    { }
+
+    ::bra::state& constant_addition_assignment::do_apply(::bra::state& state) const
+    { return state.constant_addition_assignment(qubits_, constant_); }
+
+    std::string const& constant_addition_assignment::do_name() const { return name_; }
+    std::string constant_addition_assignment::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit: qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      repr_stream << std::right << std::setw(parameter_width) << constant_;
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
@@ -1,9 +1,11 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
 
 #include <ket/qubit_io.hpp>
+#include <ket/utility/exp_i.hpp>
 
 #include <bra/gate/gate.hpp>
 #include <bra/gate/exponential_pauli_zz.hpp>
@@ -34,5 +36,16 @@ namespace bra
         << std::setw(parameter_width) << phase_;
       return repr_stream.str();
     }
+
+    bool exponential_pauli_zz::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix = {
+        ::ket::utility::exp_i<complex_type>(phase_), complex_type{0}, complex_type{0}, complex_type{0},
+        complex_type{0}, ::ket::utility::exp_i<complex_type>(-phase_), complex_type{0}, complex_type{0},
+        complex_type{0}, complex_type{0}, ::ket::utility::exp_i<complex_type>(-phase_), complex_type{0},
+        complex_type{0}, complex_type{0}, complex_type{0}, ::ket::utility::exp_i<complex_type>(phase_)};
+      qubits = {qubit1_, qubit2_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
@@ -0,0 +1,49 @@
+#include <cstddef>
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/fused_unitary.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const fused_unitary::name_ = "FUSED";
+
+    fused_unitary::fused_unitary(
+      std::vector<complex_type>&& matrix, std::vector<qubit_type>&& qubits,
+      std::size_t const num_fused_gates)
+      : ::bra::gate::gate{},
+        matrix_{std::move(matrix)}, qubits_{std::move(qubits)}, num_fused_gates_{num_fused_gates}
+    { }
+
+    ::bra::state& fused_unitary::do_apply(::bra::state& state) const
+    { return state.unitary_matrix(matrix_, qubits_); }
+
+    std::string const& fused_unitary::do_name() const { return name_; }
+    std::string fused_unitary::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit: qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      repr_stream << " (" << num_fused_gates_ << " gates)";
+      return repr_stream.str();
+    }
+
+    bool fused_unitary::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix = matrix_;
+      qubits = qubits_;
+      return true;
+    }
+  } // namespace gate
+} // namespace bra
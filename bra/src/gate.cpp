@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -16,5 +17,9 @@ namespace bra
       repr_stream << std::left << std::setw(10) << this->name();
       return this->do_representation(repr_stream, 4);
     }
+
+
+    bool gate::do_unitary_matrix(std::vector<complex_type>&, std::vector<qubit_type>&) const
+    { return false; }
   } // namespace gate
 } // namespace bra
@@ -1,12 +1,19 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <istream>
+#include <ostream>
 #include <string>
 #include <vector>
+#include <map>
 #include <tuple>
 #include <utility>
 #include <algorithm>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <stdexcept>
+#include <numeric>
 # if __cplusplus >= 201703L
 #   include <type_traits>
 # else
@@ -23,6 +30,11 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/classification.hpp>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #ifndef BRA_NO_MPI
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
@@ -33,6 +45,10 @@
 #include <ket/utility/integer_log2.hpp>
 #include <ket/utility/integer_exp2.hpp>
 #include <ket/utility/generate_phase_coefficients.hpp>
+#ifndef BRA_NO_MPI
+# include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/utility/interchange_qubits_in_permutation.hpp>
+#endif // BRA_NO_MPI
 
 #include <bra/gates.hpp>
 #include <bra/state.hpp>
@@ -41,6 +57,7 @@
 #include <bra/gate/hadamard.hpp>
 #include <bra/gate/not_.hpp>
 #include <bra/gate/pauli_x.hpp>
+#include <bra/gate/adj_pauli_x.hpp>
 #include <bra/gate/pauli_xx.hpp>
 #include <bra/gate/pauli_xn.hpp>
 #include <bra/gate/pauli_y.hpp>
@@ -50,6 +67,7 @@
 #include <bra/gate/pauli_zz.hpp>
 #include <bra/gate/pauli_zn.hpp>
 #include <bra/gate/swap.hpp>
+#include <bra/gate/adj_swap.hpp>
 #include <bra/gate/s_gate.hpp>
 #include <bra/gate/adj_s_gate.hpp>
 #include <bra/gate/t_gate.hpp>
@@ -78,10 +96,18 @@
 #include <bra/gate/exponential_pauli_zn.hpp>
 #include <bra/gate/exponential_swap.hpp>
 #include <bra/gate/toffoli.hpp>
+#include <bra/gate/adj_toffoli.hpp>
 #include <bra/gate/projective_measurement.hpp>
 #include <bra/gate/measurement.hpp>
 #include <bra/gate/generate_events.hpp>
 #include <bra/gate/shor_box.hpp>
+#include <bra/gate/fourier_transform.hpp>
+#include <bra/gate/adj_fourier_transform.hpp>
+#include <bra/gate/addition_assignment.hpp>
+#include <bra/gate/subtraction_assignment.hpp>
+#include <bra/gate/constant_addition_assignment.hpp>
+#include <bra/gate/modular_multiplication_assignment.hpp>
+#include <bra/gate/modular_exponentiation_assignment.hpp>
 #include <bra/gate/clear.hpp>
 #include <bra/gate/set.hpp>
 #include <bra/gate/depolarizing_channel.hpp>
@@ -89,6 +115,7 @@
 #include <bra/gate/controlled_hadamard.hpp>
 #include <bra/gate/multi_controlled_hadamard.hpp>
 #include <bra/gate/controlled_not.hpp>
+#include <bra/gate/adj_controlled_not.hpp>
 #include <bra/gate/multi_controlled_not.hpp>
 #include <bra/gate/controlled_pauli_x.hpp>
 #include <bra/gate/multi_controlled_pauli_xn.hpp>
@@ -136,6 +163,10 @@
 #include <bra/gate/controlled_exponential_pauli_z.hpp>
 #include <bra/gate/multi_controlled_exponential_pauli_zn.hpp>
 #include <bra/gate/multi_controlled_exponential_swap.hpp>
+#include <bra/gate/fused_unitary.hpp>
+#include <bra/gate/blocked_unitaries.hpp>
+#include <bra/gate/quadratic_phase_shift.hpp>
+#include <bra/gate/interchange_qubits.hpp>
 
 # if __cplusplus >= 201703L
 #   define BRA_is_nothrow_swappable std::is_nothrow_swappable
@@ -168,12 +199,162 @@ namespace bra
     return result;
   }
 
+  wrong_compiled_gates_error::wrong_compiled_gates_error(std::string const& message)
+    : std::runtime_error{message.c_str()}
+  { }
+
 #ifndef BRA_NO_MPI
   wrong_mpi_communicator_size_error::wrong_mpi_communicator_size_error()
     : std::runtime_error{"communicator size is wrong"}
   { }
 #endif // BRA_NO_MPI
 
+  namespace gates_detail
+  {
+    // removes a comment and surrounding spaces from line, and splits it into columns whose first one is an upper-case mnemonic.
+    // Returns false if line has no statement
+    bool split_statement(std::string& line, ::bra::gates::columns_type& columns)
+    {
+      if (line.empty())
+        return false;
+
+      line.erase(std::find(line.begin(), line.end(), '!'), line.end());
+      boost::algorithm::trim(line);
+      if (line.empty())
+        return false;
+
+      boost::algorithm::split(
+        columns, line, boost::algorithm::is_space(),
+        boost::algorithm::token_compress_on);
+
+      if (boost::empty(columns))
+        return false;
+
+      boost::algorithm::to_upper(columns.front());
+      return true;
+    }
+
+    // A compiled file starts with compiled_magic, the version and sizeof(real_type) as std::uint32_t, and the number of records
+    // and the size of the whole file in bytes as std::uint64_t, followed by records.
+    // Each record starts with a std::uint16_t opcode. A gate record is followed by its operands in the order of the signature
+    // of the opcode, where 'q' is a qubit and 'e' is a phase exponent stored as std::uint32_t, and 'r' is a phase stored as real_type.
+    // A statement record is followed by the length of the text as std::uint32_t and the text of a statement without gate records
+    constexpr char compiled_magic[8] = {'B', 'R', 'A', 'Q', 'C', 'X', '\0', '\0'};
+    constexpr std::uint32_t compiled_version = 2u;
+
+    enum class compiled_opcode : std::uint16_t
+    {
+      statement,
+      h, not_, x, y, z, s, adj_s, t, adj_t, u1, u2, u3, r, adj_r, rotx, adj_rotx, roty, adj_roty, swap, ex, ey, ez, toffoli, m,
+      ch, cnot, cx, cy, cz, cs, adj_cs, ct, adj_ct, cu1, cu2, cu3, cr, adj_cr
+    }; // enum class compiled_opcode
+
+    struct compiled_gate_format
+    {
+      char const* mnemonic;
+      compiled_opcode opcode;
+      char const* signature;
+    }; // struct compiled_gate_format
+
+    // statements with other mnemonics or other numbers of operands are stored as statement records
+    compiled_gate_format const compiled_gate_formats[]
+      = {
+          {"H", compiled_opcode::h, "q"}, {"NOT", compiled_opcode::not_, "q"},
+          {"X", compiled_opcode::x, "q"}, {"Y", compiled_opcode::y, "q"}, {"Z", compiled_opcode::z, "q"},
+          {"S", compiled_opcode::s, "q"}, {"S+", compiled_opcode::adj_s, "q"},
+          {"T", compiled_opcode::t, "q"}, {"T+", compiled_opcode::adj_t, "q"},
+          {"U1", compiled_opcode::u1, "qr"}, {"U2", compiled_opcode::u2, "qrr"}, {"U3", compiled_opcode::u3, "qrrr"},
+          {"R", compiled_opcode::r, "qe"}, {"+R", compiled_opcode::r, "qe"}, {"-R", compiled_opcode::adj_r, "qe"},
+          {"+X", compiled_opcode::rotx, "q"}, {"-X", compiled_opcode::adj_rotx, "q"},
+          {"+Y", compiled_opcode::roty, "q"}, {"-Y", compiled_opcode::adj_roty, "q"},
+          {"SWAP", compiled_opcode::swap, "qq"},
+          {"EX", compiled_opcode::ex, "qr"}, {"EY", compiled_opcode::ey, "qr"}, {"EZ", compiled_opcode::ez, "qr"},
+          {"TOFFOLI", compiled_opcode::toffoli, "qqq"}, {"M", compiled_opcode::m, "q"},
+          {"CH", compiled_opcode::ch, "qq"}, {"CNOT", compiled_opcode::cnot, "qq"},
+          {"CX", compiled_opcode::cx, "qq"}, {"CY", compiled_opcode::cy, "qq"}, {"CZ", compiled_opcode::cz, "qq"},
+          {"CS", compiled_opcode::cs, "qq"}, {"CS+", compiled_opcode::adj_cs, "qq"},
+          {"CT", compiled_opcode::ct, "qq"}, {"CT+", compiled_opcode::adj_ct, "qq"},
+          {"CU1", compiled_opcode::cu1, "qqr"}, {"CU2", compiled_opcode::cu2, "qqrr"}, {"CU3", compiled_opcode::cu3, "qqrrr"},
+          {"CR", compiled_opcode::cr, "qqe"}, {"C+R", compiled_opcode::cr, "qqe"}, {"C-R", compiled_opcode::adj_cr, "qqe"}
+        };
+
+    char const* compiled_signature(std::uint16_t const opcode)
+    {
+      for (auto const& format: compiled_gate_formats)
+        if (static_cast<std::uint16_t>(format.opcode) == opcode)
+          return format.signature;
+
+      throw ::bra::wrong_compiled_gates_error{"unknown opcode " + std::to_string(opcode)};
+    }
+
+    template <typename Value>
+    void write_compiled_value(std::string& output, Value const value)
+    { output.append(reinterpret_cast<char const*>(std::addressof(value)), sizeof(Value)); }
+
+    template <typename Value>
+    Value read_compiled_value(char const*& position, char const* const last)
+    {
+      if (static_cast<std::size_t>(last - position) < sizeof(Value))
+        throw ::bra::wrong_compiled_gates_error{"compiled gates are truncated"};
+
+      auto result = Value{};
+      std::memcpy(std::addressof(result), position, sizeof(Value));
+      position += sizeof(Value);
+      return result;
+    }
+
+    // read-only mapping of a whole file
+    class mapped_file
+    {
+      char const* data_;
+      std::size_t size_;
+
+     public:
+      explicit mapped_file(std::string const& filename)
+        : data_{nullptr}, size_{0u}
+      {
+        auto const file_descriptor = ::open(filename.c_str(), O_RDONLY);
+        if (file_descriptor < 0)
+          throw ::bra::wrong_compiled_gates_error{"cannot open " + filename};
+
+        struct ::stat file_status;
+        if (::fstat(file_descriptor, std::addressof(file_status)) != 0)
+        {
+          ::close(file_descriptor);
+          throw ::bra::wrong_compiled_gates_error{"cannot read " + filename};
+        }
+
+        size_ = static_cast<std::size_t>(file_status.st_size);
+        if (size_ > 0u)
+        {
+          auto const address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+          if (address == MAP_FAILED)
+          {
+            ::close(file_descriptor);
+            throw ::bra::wrong_compiled_gates_error{"cannot map " + filename};
+          }
+          ::madvise(address, size_, MADV_SEQUENTIAL);
+          data_ = static_cast<char const*>(address);
+        }
+        ::close(file_descriptor);
+      }
+
+      ~mapped_file() noexcept
+      {
+        if (data_ != nullptr)
+          ::munmap(const_cast<char*>(data_), size_);
+      }
+
+      mapped_file(mapped_file const&) = delete;
+      mapped_file& operator=(mapped_file const&) = delete;
+      mapped_file(mapped_file&&) = delete;
+      mapped_file& operator=(mapped_file&&) = delete;
+
+      char const* begin() const noexcept { return data_; }
+      char const* end() const noexcept { return data_ + size_; }
+    }; // class mapped_file
+  } // namespace gates_detail
+
 #ifndef BRA_NO_MPI
   gates::gates()
     : data_{}, num_qubits_{}, num_lqubits_{}, num_uqubits_{}, num_processes_per_unit_{1u},
@@ -229,6 +410,20 @@ namespace bra
     assert(num_processes_per_unit >= 1u);
     assign(input_stream, environment, communicator, num_reserved_gates);
   }
+
+  gates::gates(
+    std::string const& compiled_filename,
+    bit_integer_type num_uqubits, unsigned int num_processes_per_unit,
+    yampi::environment const& environment,
+    yampi::rank const root, yampi::communicator const& communicator,
+    size_type const num_reserved_gates)
+    : data_{}, num_qubits_{}, num_lqubits_{},
+      num_uqubits_{num_uqubits}, num_processes_per_unit_{num_processes_per_unit},
+      initial_state_value_{}, initial_permutation_{}, phase_coefficients_{}, root_{root}
+  {
+    assert(num_processes_per_unit >= 1u);
+    assign_compiled(compiled_filename, environment, communicator, num_reserved_gates);
+  }
 #else // BRA_NO_MPI
   gates::gates(std::istream& input_stream)
     : data_{}, num_qubits_{},
@@ -239,6 +434,16 @@ namespace bra
     : data_{}, num_qubits_{},
       initial_state_value_{}, phase_coefficients_{}
   { assign(input_stream, num_reserved_gates); }
+
+  gates::gates(std::string const& compiled_filename)
+    : data_{}, num_qubits_{},
+      initial_state_value_{}, phase_coefficients_{}
+  { assign_compiled(compiled_filename, size_type{0u}); }
+
+  gates::gates(std::string const& compiled_filename, size_type const num_reserved_gates)
+    : data_{}, num_qubits_{},
+      initial_state_value_{}, phase_coefficients_{}
+  { assign_compiled(compiled_filename, num_reserved_gates); }
 #endif // BRA_NO_MPI
 
   bool gates::operator==(gates const& other) const
@@ -330,290 +535,564 @@ namespace bra
 
     while (std::getline(input_stream, line))
     {
-      if (line.empty())
+      if (not ::bra::gates_detail::split_statement(line, columns))
         continue;
 
-      line.erase(std::find(line.begin(), line.end(), '!'), line.end());
-      boost::algorithm::trim(line);
-      if (line.empty())
-        continue;
-
-      boost::algorithm::split(
-        columns, line, boost::algorithm::is_space(),
-        boost::algorithm::token_compress_on);
-
-      if (boost::empty(columns))
-        continue;
+#ifndef BRA_NO_MPI
+      if (not interpret_statement(columns, environment, communicator))
+        break;
+#else // BRA_NO_MPI
+      if (not interpret_statement(columns))
+        break;
+#endif // BRA_NO_MPI
+    }
+  }
 
-      boost::algorithm::to_upper(columns.front());
-      auto const& mnemonic = columns.front();
-      if (mnemonic == "QUBITS")
-      {
 #ifndef BRA_NO_MPI
-        num_qubits(
-          static_cast< ::bra::state::bit_integer_type >(read_num_qubits(columns)),
-          communicator, environment);
+  bool gates::interpret_statement(
+    columns_type& columns, yampi::environment const& environment, yampi::communicator const& communicator)
 #else // BRA_NO_MPI
-        num_qubits(
-          static_cast< ::bra::state::bit_integer_type >(read_num_qubits(columns)));
+  bool gates::interpret_statement(columns_type& columns)
 #endif // BRA_NO_MPI
-      }
-      else if (mnemonic == "INITIAL") // INITIAL STATE
-        initial_state_value_
-          = static_cast< ::bra::state::state_integer_type >(read_initial_state_value(columns));
-      else if (mnemonic == "MPIPROCESSES")
-      {
-        read_num_mpi_processes(columns);
-        // ignore this statement
-      }
-      else if (mnemonic == "MPISWAPBUFFER")
-      {
-        read_mpi_buffer_size(columns);
-        // ignore this statement
-      }
-      else if (mnemonic == "BIT") // BIT ASSIGNMENT
-      {
-        if (boost::size(columns) <= 1u)
-          throw wrong_mnemonics_error{columns};
-        boost::algorithm::to_upper(columns[1u]);
+  {
+    auto const& mnemonic = columns.front();
+    if (mnemonic == "QUBITS")
+    {
+#ifndef BRA_NO_MPI
+      num_qubits(
+        static_cast< ::bra::state::bit_integer_type >(read_num_qubits(columns)),
+        communicator, environment);
+#else // BRA_NO_MPI
+      num_qubits(
+        static_cast< ::bra::state::bit_integer_type >(read_num_qubits(columns)));
+#endif // BRA_NO_MPI
+    }
+    else if (mnemonic == "INITIAL") // INITIAL STATE
+      initial_state_value_
+        = static_cast< ::bra::state::state_integer_type >(read_initial_state_value(columns));
+    else if (mnemonic == "MPIPROCESSES")
+    {
+      read_num_mpi_processes(columns);
+      // ignore this statement
+    }
+    else if (mnemonic == "MPISWAPBUFFER")
+    {
+      read_mpi_buffer_size(columns);
+      // ignore this statement
+    }
+    else if (mnemonic == "BIT") // BIT ASSIGNMENT
+    {
+      if (boost::size(columns) <= 1u)
+        throw wrong_mnemonics_error{columns};
+      boost::algorithm::to_upper(columns[1u]);
 
-        auto const statement = read_bit_statement(columns);
+      auto const statement = read_bit_statement(columns);
 
-        if (statement == ::bra::bit_statement::assignment)
-        {
+      if (statement == ::bra::bit_statement::assignment)
+      {
 #ifndef BRA_NO_MPI
-          initial_permutation_ = read_initial_permutation(columns);
+        initial_permutation_ = read_initial_permutation(columns);
 #endif
-        }
       }
-      else if (mnemonic == "PERMUTATION")
-        throw unsupported_mnemonic_error{mnemonic};
-      else if (mnemonic == "RANDOM") // RANDOM PERMUTATION
-        throw unsupported_mnemonic_error{mnemonic};
-      else if (mnemonic == "I")
-        continue;
-      else if (mnemonic == "H")
-        add_h(columns);
-      else if (mnemonic == "NOT")
-        add_not(columns);
-      else if (mnemonic == "X")
-        add_x(columns);
-      else if (mnemonic == "XX")
-        add_xx(columns);
-      else if (mnemonic.size() >= 3u
-               and std::all_of(
-                     std::begin(mnemonic), std::end(mnemonic),
-                     [](char const character) { return character == 'X'; }))
-        add_xs(columns, mnemonic);
-      else if (mnemonic.size() >= 2u and mnemonic.front() == 'X')
-        add_xn(columns, mnemonic);
-      else if (mnemonic == "Y")
-        add_y(columns);
-      else if (mnemonic == "YY")
-        add_yy(columns);
-      else if (mnemonic.size() >= 3u
-               and std::all_of(
-                     std::begin(mnemonic), std::end(mnemonic),
-                     [](char const character) { return character == 'Y'; }))
-        add_ys(columns, mnemonic);
-      else if (mnemonic.size() >= 2u and mnemonic.front() == 'Y')
-        add_yn(columns, mnemonic);
-      else if (mnemonic == "Z")
-        add_z(columns);
-      else if (mnemonic == "ZZ")
-        add_zz(columns);
-      else if (mnemonic.size() >= 3u
-               and std::all_of(
-                     std::begin(mnemonic), std::end(mnemonic),
-                     [](char const character) { return character == 'Z'; }))
-        add_zs(columns, mnemonic);
-      else if (mnemonic.size() >= 2u and mnemonic.front() == 'Z')
-        add_zn(columns, mnemonic);
-      else if (mnemonic == "SWAP")
-        add_swap(columns);
-      else if (mnemonic == "S")
-        add_s(columns);
-      else if (mnemonic == "S+")
-        add_adj_s(columns);
-      else if (mnemonic == "T")
-        add_t(columns);
-      else if (mnemonic == "T+")
-        add_adj_t(columns);
-      else if (mnemonic == "U1")
-        add_u1(columns);
-      else if (mnemonic == "U2")
-        add_u2(columns);
-      else if (mnemonic == "U3")
-        add_u3(columns);
-      else if (mnemonic == "R" or mnemonic == "+R")
-        add_r(columns);
-      else if (mnemonic == "-R")
-        add_adj_r(columns);
-      else if (mnemonic == "+X")
-        add_rotx(columns);
-      else if (mnemonic == "-X")
-        add_adj_rotx(columns);
-      else if (mnemonic == "+Y")
-        add_roty(columns);
-      else if (mnemonic == "-Y")
-        add_adj_roty(columns);
-      else if (mnemonic == "U")
-        add_u(columns);
-      else if (mnemonic == "V")
-        add_v(columns);
-      else if (mnemonic == "EX")
-        add_ex(columns);
-      else if (mnemonic == "EXX")
-        add_exx(columns);
-      else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
-               and std::all_of(
-                     std::next(std::begin(mnemonic)), std::end(mnemonic),
-                     [](char const character) { return character == 'X'; }))
-        add_exs(columns, mnemonic);
-      else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'X')
-        add_exn(columns, mnemonic);
-      else if (mnemonic == "EY")
-        add_ey(columns);
-      else if (mnemonic == "EYY")
-        add_eyy(columns);
-      else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
-               and std::all_of(
-                     std::next(std::begin(mnemonic)), std::end(mnemonic),
-                     [](char const character) { return character == 'Y'; }))
-        add_eys(columns, mnemonic);
-      else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'Y')
-        add_eyn(columns, mnemonic);
-      else if (mnemonic == "EZ")
-        add_ez(columns);
-      else if (mnemonic == "EZZ")
-        add_ezz(columns);
-      else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
-               and std::all_of(
-                     std::next(std::begin(mnemonic)), std::end(mnemonic),
-                     [](char const character) { return character == 'Z'; }))
-        add_ezs(columns, mnemonic);
-      else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'Z')
-        add_ezn(columns, mnemonic);
-      else if (mnemonic == "ESWAP")
-        add_eswap(columns);
-      else if (mnemonic == "TOFFOLI")
-        add_toffoli(columns);
-      else if (mnemonic == "M")
-        add_m(columns);
-      else if (mnemonic == "SHORBOX")
-        add_shor_box(columns);
-      else if (mnemonic == "BEGIN") // BEGIN MEASUREMENT/LEARNING MACHINE
-      {
-        if (columns.size() <= 1u)
-          throw wrong_mnemonics_error{columns};
+    }
+    else if (mnemonic == "PERMUTATION")
+      throw unsupported_mnemonic_error{mnemonic};
+    else if (mnemonic == "RANDOM") // RANDOM PERMUTATION
+      throw unsupported_mnemonic_error{mnemonic};
+    else if (mnemonic == "I")
+      return true;
+    else if (mnemonic == "H")
+      add_h(columns);
+    else if (mnemonic == "NOT")
+      add_not(columns);
+    else if (mnemonic == "X")
+      add_x(columns);
+    else if (mnemonic == "XX")
+      add_xx(columns);
+    else if (mnemonic.size() >= 3u
+             and std::all_of(
+                   std::begin(mnemonic), std::end(mnemonic),
+                   [](char const character) { return character == 'X'; }))
+      add_xs(columns, mnemonic);
+    else if (mnemonic.size() >= 2u and mnemonic.front() == 'X')
+      add_xn(columns, mnemonic);
+    else if (mnemonic == "Y")
+      add_y(columns);
+    else if (mnemonic == "YY")
+      add_yy(columns);
+    else if (mnemonic.size() >= 3u
+             and std::all_of(
+                   std::begin(mnemonic), std::end(mnemonic),
+                   [](char const character) { return character == 'Y'; }))
+      add_ys(columns, mnemonic);
+    else if (mnemonic.size() >= 2u and mnemonic.front() == 'Y')
+      add_yn(columns, mnemonic);
+    else if (mnemonic == "Z")
+      add_z(columns);
+    else if (mnemonic == "ZZ")
+      add_zz(columns);
+    else if (mnemonic.size() >= 3u
+             and std::all_of(
+                   std::begin(mnemonic), std::end(mnemonic),
+                   [](char const character) { return character == 'Z'; }))
+      add_zs(columns, mnemonic);
+    else if (mnemonic.size() >= 2u and mnemonic.front() == 'Z')
+      add_zn(columns, mnemonic);
+    else if (mnemonic == "SWAP")
+      add_swap(columns);
+    else if (mnemonic == "S")
+      add_s(columns);
+    else if (mnemonic == "S+")
+      add_adj_s(columns);
+    else if (mnemonic == "T")
+      add_t(columns);
+    else if (mnemonic == "T+")
+      add_adj_t(columns);
+    else if (mnemonic == "U1")
+      add_u1(columns);
+    else if (mnemonic == "U2")
+      add_u2(columns);
+    else if (mnemonic == "U3")
+      add_u3(columns);
+    else if (mnemonic == "R" or mnemonic == "+R")
+      add_r(columns);
+    else if (mnemonic == "-R")
+      add_adj_r(columns);
+    else if (mnemonic == "+X")
+      add_rotx(columns);
+    else if (mnemonic == "-X")
+      add_adj_rotx(columns);
+    else if (mnemonic == "+Y")
+      add_roty(columns);
+    else if (mnemonic == "-Y")
+      add_adj_roty(columns);
+    else if (mnemonic == "U")
+      add_u(columns);
+    else if (mnemonic == "V")
+      add_v(columns);
+    else if (mnemonic == "EX")
+      add_ex(columns);
+    else if (mnemonic == "EXX")
+      add_exx(columns);
+    else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
+             and std::all_of(
+                   std::next(std::begin(mnemonic)), std::end(mnemonic),
+                   [](char const character) { return character == 'X'; }))
+      add_exs(columns, mnemonic);
+    else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'X')
+      add_exn(columns, mnemonic);
+    else if (mnemonic == "EY")
+      add_ey(columns);
+    else if (mnemonic == "EYY")
+      add_eyy(columns);
+    else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
+             and std::all_of(
+                   std::next(std::begin(mnemonic)), std::end(mnemonic),
+                   [](char const character) { return character == 'Y'; }))
+      add_eys(columns, mnemonic);
+    else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'Y')
+      add_eyn(columns, mnemonic);
+    else if (mnemonic == "EZ")
+      add_ez(columns);
+    else if (mnemonic == "EZZ")
+      add_ezz(columns);
+    else if (mnemonic.size() >= 4u and mnemonic.front() == 'E'
+             and std::all_of(
+                   std::next(std::begin(mnemonic)), std::end(mnemonic),
+                   [](char const character) { return character == 'Z'; }))
+      add_ezs(columns, mnemonic);
+    else if (mnemonic.size() >= 3u and mnemonic[0] == 'E' and mnemonic[1] == 'Z')
+      add_ezn(columns, mnemonic);
+    else if (mnemonic == "ESWAP")
+      add_eswap(columns);
+    else if (mnemonic == "TOFFOLI")
+      add_toffoli(columns);
+    else if (mnemonic == "M")
+      add_m(columns);
+    else if (mnemonic == "SHORBOX")
+      add_shor_box(columns);
+    else if (mnemonic == "QFT")
+      add_qft(columns);
+    else if (mnemonic == "IQFT")
+      add_iqft(columns);
+    else if (mnemonic == "ADD")
+      add_add(columns);
+    else if (mnemonic == "SUB")
+      add_sub(columns);
+    else if (mnemonic == "ADDC")
+      add_addc(columns);
+    else if (mnemonic == "MULMOD")
+      add_mulmod(columns);
+    else if (mnemonic == "MODEXP")
+      add_modexp(columns);
+    else if (mnemonic == "BEGIN") // BEGIN MEASUREMENT/LEARNING MACHINE
+    {
+      if (columns.size() <= 1u)
+        throw wrong_mnemonics_error{columns};
 
-        std::for_each(
-          std::next(std::begin(columns)), std::end(columns),
-          [](std::string& str) { boost::algorithm::to_upper(str); });
+      std::for_each(
+        std::next(std::begin(columns)), std::end(columns),
+        [](std::string& str) { boost::algorithm::to_upper(str); });
 
-        auto const statement = read_begin_statement(columns);
+      auto const statement = read_begin_statement(columns);
 
-        if (statement == ::bra::begin_statement::measurement)
-        {
+      if (statement == ::bra::begin_statement::measurement)
+      {
 #ifndef BRA_NO_MPI
-          data_.push_back(
-            std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::measurement{root_}});
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::measurement{root_}});
 #else // BRA_NO_MPI
-          data_.push_back(
-            std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::measurement{}});
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::measurement{}});
 #endif // BRA_NO_MPI
-        }
-        else if (statement == ::bra::begin_statement::learning_machine)
-          throw unsupported_mnemonic_error{mnemonic};
       }
-      else if (mnemonic == "DO") // DO MEASUREMENT
-      {
-        /*
-        auto const statement = read_do_statement(columns);
+      else if (statement == ::bra::begin_statement::learning_machine)
+        throw unsupported_mnemonic_error{mnemonic};
+    }
+    else if (mnemonic == "DO") // DO MEASUREMENT
+    {
+      /*
+      auto const statement = read_do_statement(columns);
 
-        if (statement == do_statement::error)
-          throw wrong_mnemonics_error{columns};
-        else if (statement == do_statement::measurement)
-          throw unsupported_mnemonic_error{mnemonic};
-          */
+      if (statement == do_statement::error)
+        throw wrong_mnemonics_error{columns};
+      else if (statement == do_statement::measurement)
         throw unsupported_mnemonic_error{mnemonic};
-      }
-      else if (mnemonic == "END") // END MEASUREMENT/LEARNING MACHINE
-      {
-        /*
-        auto const statement = read_end_statement(columns);
+        */
+      throw unsupported_mnemonic_error{mnemonic};
+    }
+    else if (mnemonic == "END") // END MEASUREMENT/LEARNING MACHINE
+    {
+      /*
+      auto const statement = read_end_statement(columns);
 
-        if (statement == ::bra::end_statement::measurement)
-        {
+      if (statement == ::bra::end_statement::measurement)
+      {
 #ifndef BRA_NO_MPI
-          data_.push_back(std::make_unique< ::bra::gate::measurement >(root_));
+        data_.push_back(std::make_unique< ::bra::gate::measurement >(root_));
 #else // BRA_NO_MPI
-          data_.push_back(std::make_unique< ::bra::gate::measurement >());
+        data_.push_back(std::make_unique< ::bra::gate::measurement >());
 #endif // BRA_NO_MPI
-        }
-        else if (statement == ::bra::end_statement::learning_machine)
-          throw unsupported_mnemonic_error{mnemonic};
-*/
-        throw unsupported_mnemonic_error{mnemonic};
       }
-      else if (mnemonic == "GENERATE") // GENERATE EVENTS
-      {
-        if (boost::size(columns) != 4u)
-          throw wrong_mnemonics_error{columns};
+      else if (statement == ::bra::end_statement::learning_machine)
+        throw unsupported_mnemonic_error{mnemonic};
+*/
+      throw unsupported_mnemonic_error{mnemonic};
+    }
+    else if (mnemonic == "GENERATE") // GENERATE EVENTS
+    {
+      if (boost::size(columns) != 4u)
+        throw wrong_mnemonics_error{columns};
 
-        boost::algorithm::to_upper(columns[1u]);
+      boost::algorithm::to_upper(columns[1u]);
 
-        auto statement = ::bra::generate_statement{};
-        auto num_events = int{};
-        auto seed = int{};
-        std::tie(statement, num_events, seed) = read_generate_statement(columns);
+      auto statement = ::bra::generate_statement{};
+      auto num_events = int{};
+      auto seed = int{};
+      std::tie(statement, num_events, seed) = read_generate_statement(columns);
 
-        if (statement == ::bra::generate_statement::events)
-        {
+      if (statement == ::bra::generate_statement::events)
+      {
 #ifndef BRA_NO_MPI
-          data_.push_back(
-            std::unique_ptr< ::bra::gate::gate >{
-              new ::bra::gate::generate_events{root_, num_events, seed}});
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{
+            new ::bra::gate::generate_events{root_, num_events, seed}});
 #else // BRA_NO_MPI
-          data_.push_back(
-            std::unique_ptr< ::bra::gate::gate >{
-              new ::bra::gate::generate_events{num_events, seed}});
+        data_.push_back(
+          std::unique_ptr< ::bra::gate::gate >{
+            new ::bra::gate::generate_events{num_events, seed}});
 #endif // BRA_NO_MPI
-          break;
-        }
+        return false;
       }
-      else if (mnemonic == "CLEAR")
-        add_clear(columns);
-      else if (mnemonic == "SET")
-        add_set(columns);
-      else if (mnemonic == "DEPOLARIZING")
+    }
+    else if (mnemonic == "CLEAR")
+      add_clear(columns);
+    else if (mnemonic == "SET")
+      add_set(columns);
+    else if (mnemonic == "DEPOLARIZING")
+    {
+      if (boost::size(columns) <= 2u)
+        throw wrong_mnemonics_error{columns};
+
+      boost::algorithm::to_upper(columns[1u]);
+
+      add_depolarizing(columns, mnemonic);
+    }
+    else if (mnemonic == "EXIT")
+    {
+      if (boost::size(columns) != 1u)
+        throw wrong_mnemonics_error{columns};
+
+#ifndef BRA_NO_MPI
+      data_.push_back(
+        std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exit{root_}});
+#else // BRA_NO_MPI
+      data_.push_back(
+        std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exit{}});
+#endif // BRA_NO_MPI
+      return false;
+    }
+    else if (mnemonic.size() >= 2u and mnemonic.front() == 'C') // controlled gates
+      interpret_controlled_gates(columns, mnemonic);
+    else
+      throw unsupported_mnemonic_error{mnemonic};
+
+    return true;
+  }
+
+#ifndef BRA_NO_MPI
+  void gates::assign_compiled(
+    std::string const& compiled_filename, yampi::environment const& environment,
+    yampi::communicator const& communicator, size_type const num_reserved_gates)
+#else // BRA_NO_MPI
+  void gates::assign_compiled(std::string const& compiled_filename, size_type const num_reserved_gates)
+#endif // BRA_NO_MPI
+  {
+    data_.clear();
+    data_.reserve(num_reserved_gates);
+
+    auto const file = ::bra::gates_detail::mapped_file{compiled_filename};
+    auto position = file.begin();
+    auto const last = file.end();
+
+    auto const magic_last = std::end(::bra::gates_detail::compiled_magic);
+    if (static_cast<std::size_t>(last - position) < sizeof(::bra::gates_detail::compiled_magic)
+        or not std::equal(std::begin(::bra::gates_detail::compiled_magic), magic_last, position))
+      throw wrong_compiled_gates_error{compiled_filename + " is not a compiled circuit"};
+    position += sizeof(::bra::gates_detail::compiled_magic);
+
+    if (::bra::gates_detail::read_compiled_value<std::uint32_t>(position, last) != ::bra::gates_detail::compiled_version)
+      throw wrong_compiled_gates_error{compiled_filename + " was compiled by another version of bra"};
+    if (::bra::gates_detail::read_compiled_value<std::uint32_t>(position, last) != sizeof(real_type))
+      throw wrong_compiled_gates_error{compiled_filename + " was compiled with another floating-point type"};
+    auto const num_records = ::bra::gates_detail::read_compiled_value<std::uint64_t>(position, last);
+    if (::bra::gates_detail::read_compiled_value<std::uint64_t>(position, last)
+        != static_cast<std::uint64_t>(last - file.begin()))
+      throw wrong_compiled_gates_error{compiled_filename + " does not have the size written in its header"};
+
+    auto line = std::string{};
+    auto columns = columns_type{};
+    columns.reserve(10u);
+    auto integers = std::vector<std::uint32_t>{};
+    auto reals = std::vector<real_type>{};
+
+    auto record_count = std::uint64_t{0u};
+    while (position != last)
+    {
+      if (record_count == num_records)
+        throw wrong_compiled_gates_error{compiled_filename + " has more records than its header says"};
+      ++record_count;
+
+      auto const opcode = ::bra::gates_detail::read_compiled_value<std::uint16_t>(position, last);
+      if (opcode == static_cast<std::uint16_t>(::bra::gates_detail::compiled_opcode::statement))
       {
-        if (boost::size(columns) <= 2u)
-          throw wrong_mnemonics_error{columns};
+        auto const length = ::bra::gates_detail::read_compiled_value<std::uint32_t>(position, last);
+        if (static_cast<std::size_t>(last - position) < length)
+          throw wrong_compiled_gates_error{compiled_filename + " is truncated"};
 
-        boost::algorithm::to_upper(columns[1u]);
+        line.assign(position, position + length);
+        position += length;
+        if (not ::bra::gates_detail::split_statement(line, columns))
+          continue;
 
-        add_depolarizing(columns, mnemonic);
+#ifndef BRA_NO_MPI
+        if (not interpret_statement(columns, environment, communicator))
+          break;
+#else // BRA_NO_MPI
+        if (not interpret_statement(columns))
+          break;
+#endif // BRA_NO_MPI
+        continue;
       }
-      else if (mnemonic == "EXIT")
-      {
-        if (boost::size(columns) != 1u)
-          throw wrong_mnemonics_error{columns};
 
+      integers.clear();
+      reals.clear();
+      for (auto signature = ::bra::gates_detail::compiled_signature(opcode); *signature != '\0'; ++signature)
+        if (*signature == 'r')
+          reals.push_back(::bra::gates_detail::read_compiled_value<real_type>(position, last));
+        else
+          integers.push_back(::bra::gates_detail::read_compiled_value<std::uint32_t>(position, last));
+
+      add_compiled_gate(opcode, integers, reals);
+    }
+
+    if (position == last and record_count != num_records)
+      throw wrong_compiled_gates_error{compiled_filename + " is truncated"};
+  }
+
+  void gates::add_compiled_gate(
+    std::uint16_t const opcode, std::vector<std::uint32_t> const& integers, std::vector<real_type> const& reals)
+  {
+    using ::bra::gates_detail::compiled_opcode;
+    auto const qubit
+      = [&integers](std::size_t const index)
+        { return ket::make_qubit<state_integer_type>(static_cast<bit_integer_type>(integers[index])); };
+    auto const control
+      = [&qubit](std::size_t const index) { return ket::make_control(qubit(index)); };
+    auto const add
+      = [this](::bra::gate::gate* gate_ptr) { data_.push_back(std::unique_ptr< ::bra::gate::gate >{gate_ptr}); };
+
+    switch (static_cast<compiled_opcode>(opcode))
+    {
+     case compiled_opcode::h: add(new ::bra::gate::hadamard{qubit(0u)}); break;
+     case compiled_opcode::not_: add(new ::bra::gate::not_{qubit(0u)}); break;
+     case compiled_opcode::x: add(new ::bra::gate::pauli_x{qubit(0u)}); break;
+     case compiled_opcode::y: add(new ::bra::gate::pauli_y{qubit(0u)}); break;
+     case compiled_opcode::z: add(new ::bra::gate::pauli_z{qubit(0u)}); break;
+     case compiled_opcode::s: add(new ::bra::gate::s_gate{phase_coefficients_[2u], qubit(0u)}); break;
+     case compiled_opcode::adj_s: add(new ::bra::gate::adj_s_gate{phase_coefficients_[2u], qubit(0u)}); break;
+     case compiled_opcode::t: add(new ::bra::gate::t_gate{phase_coefficients_[3u], qubit(0u)}); break;
+     case compiled_opcode::adj_t: add(new ::bra::gate::adj_t_gate{phase_coefficients_[3u], qubit(0u)}); break;
+     case compiled_opcode::u1: add(new ::bra::gate::u1{reals[0u], qubit(0u)}); break;
+     case compiled_opcode::u2: add(new ::bra::gate::u2{reals[0u], reals[1u], qubit(0u)}); break;
+     case compiled_opcode::u3: add(new ::bra::gate::u3{reals[0u], reals[1u], reals[2u], qubit(0u)}); break;
+     case compiled_opcode::r:
+     {
+       auto const phase_exponent = static_cast<int>(static_cast<std::int32_t>(integers[1u]));
+       if (phase_exponent >= 0)
+         add(new ::bra::gate::phase_shift{phase_exponent, phase_coefficients_[phase_exponent], qubit(0u)});
+       else
+         add(new ::bra::gate::adj_phase_shift{-phase_exponent, phase_coefficients_[-phase_exponent], qubit(0u)});
+       break;
+     }
+     case compiled_opcode::adj_r:
+     {
+       auto const phase_exponent = static_cast<int>(static_cast<std::int32_t>(integers[1u]));
+       if (phase_exponent >= 0)
+         add(new ::bra::gate::adj_phase_shift{phase_exponent, phase_coefficients_[phase_exponent], qubit(0u)});
+       else
+         add(new ::bra::gate::phase_shift{-phase_exponent, phase_coefficients_[-phase_exponent], qubit(0u)});
+       break;
+     }
+     case compiled_opcode::rotx: add(new ::bra::gate::x_rotation_half_pi{qubit(0u)}); break;
+     case compiled_opcode::adj_rotx: add(new ::bra::gate::adj_x_rotation_half_pi{qubit(0u)}); break;
+     case compiled_opcode::roty: add(new ::bra::gate::y_rotation_half_pi{qubit(0u)}); break;
+     case compiled_opcode::adj_roty: add(new ::bra::gate::adj_y_rotation_half_pi{qubit(0u)}); break;
+     case compiled_opcode::swap: add(new ::bra::gate::swap{qubit(0u), qubit(1u)}); break;
+     case compiled_opcode::ex: add(new ::bra::gate::exponential_pauli_x{reals[0u], qubit(0u)}); break;
+     case compiled_opcode::ey: add(new ::bra::gate::exponential_pauli_y{reals[0u], qubit(0u)}); break;
+     case compiled_opcode::ez: add(new ::bra::gate::exponential_pauli_z{reals[0u], qubit(0u)}); break;
+     case compiled_opcode::toffoli: add(new ::bra::gate::toffoli{qubit(2u), control(0u), control(1u)}); break;
 #ifndef BRA_NO_MPI
-        data_.push_back(
-          std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exit{root_}});
+     case compiled_opcode::m: add(new ::bra::gate::projective_measurement{qubit(0u), root_}); break;
 #else // BRA_NO_MPI
-        data_.push_back(
-          std::unique_ptr< ::bra::gate::gate >{new ::bra::gate::exit{}});
+     case compiled_opcode::m: add(new ::bra::gate::projective_measurement{qubit(0u)}); break;
 #endif // BRA_NO_MPI
-        break;
+     case compiled_opcode::ch: add(new ::bra::gate::controlled_hadamard{qubit(1u), control(0u)}); break;
+     case compiled_opcode::cnot: add_controlled_not(qubit(1u), control(0u)); break;
+     case compiled_opcode::cx: add(new ::bra::gate::controlled_pauli_x{qubit(1u), control(0u)}); break;
+     case compiled_opcode::cy: add(new ::bra::gate::controlled_pauli_y{qubit(1u), control(0u)}); break;
+     case compiled_opcode::cz: add(new ::bra::gate::controlled_pauli_z{qubit(1u), control(0u)}); break;
+     case compiled_opcode::cs: add(new ::bra::gate::controlled_s_gate{phase_coefficients_[2u], qubit(1u), control(0u)}); break;
+     case compiled_opcode::adj_cs:
+       add(new ::bra::gate::adj_controlled_s_gate{phase_coefficients_[2u], qubit(1u), control(0u)});
+       break;
+     case compiled_opcode::ct: add(new ::bra::gate::controlled_t_gate{phase_coefficients_[3u], qubit(1u), control(0u)}); break;
+     case compiled_opcode::adj_ct:
+       add(new ::bra::gate::adj_controlled_t_gate{phase_coefficients_[3u], qubit(1u), control(0u)});
+       break;
+     case compiled_opcode::cu1: add(new ::bra::gate::controlled_u1{reals[0u], qubit(1u), control(0u)}); break;
+     case compiled_opcode::cu2: add(new ::bra::gate::controlled_u2{reals[0u], reals[1u], qubit(1u), control(0u)}); break;
+     case compiled_opcode::cu3:
+       add(new ::bra::gate::controlled_u3{reals[0u], reals[1u], reals[2u], qubit(1u), control(0u)});
+       break;
+     case compiled_opcode::cr:
+     {
+       auto const phase_exponent = static_cast<int>(static_cast<std::int32_t>(integers[2u]));
+       if (phase_exponent >= 0)
+         add(new ::bra::gate::controlled_phase_shift_{
+           phase_exponent, phase_coefficients_[phase_exponent], qubit(1u), control(0u)});
+       else
+         add(new ::bra::gate::adj_controlled_phase_shift_{
+           -phase_exponent, phase_coefficients_[-phase_exponent], qubit(1u), control(0u)});
+       break;
+     }
+     case compiled_opcode::adj_cr:
+     {
+       auto const phase_exponent = static_cast<int>(static_cast<std::int32_t>(integers[2u]));
+       if (phase_exponent >= 0)
+         add(new ::bra::gate::adj_controlled_phase_shift{
+           phase_exponent, phase_coefficients_[phase_exponent], qubit(1u), control(0u)});
+       else
+         add(new ::bra::gate::controlled_phase_shift{
+           -phase_exponent, phase_coefficients_[-phase_exponent], qubit(1u), control(0u)});
+       break;
+     }
+     default:
+       throw wrong_compiled_gates_error{"unknown opcode " + std::to_string(opcode)};
+    }
+  }
+
+  void compile_gates(std::istream& input_stream, std::ostream& output_stream)
+  {
+    auto output = std::string{
+      std::begin(::bra::gates_detail::compiled_magic), std::end(::bra::gates_detail::compiled_magic)};
+    ::bra::gates_detail::write_compiled_value(output, ::bra::gates_detail::compiled_version);
+    ::bra::gates_detail::write_compiled_value(output, static_cast<std::uint32_t>(sizeof(::bra::gates::real_type)));
+    // the number of records and the file size are filled in after all records are written
+    auto const num_records_position = output.size();
+    ::bra::gates_detail::write_compiled_value(output, std::uint64_t{0u});
+    ::bra::gates_detail::write_compiled_value(output, std::uint64_t{0u});
+    auto num_records = std::uint64_t{0u};
+
+    auto line = std::string{};
+    auto columns = ::bra::gates::columns_type{};
+    columns.reserve(10u);
+    auto operands = std::string{};
+
+    while (std::getline(input_stream, line))
+    {
+      if (not ::bra::gates_detail::split_statement(line, columns))
+        continue;
+
+      auto const format_iter
+        = std::find_if(
+            std::begin(::bra::gates_detail::compiled_gate_formats), std::end(::bra::gates_detail::compiled_gate_formats),
+            [&columns](::bra::gates_detail::compiled_gate_format const& format)
+            { return columns.front() == format.mnemonic and columns.size() == std::strlen(format.signature) + 1u; });
+
+      // operands are converted in the same way as ::bra::gates::read_*. Statements with wrong operands are left to them
+      auto is_gate_record = format_iter != std::end(::bra::gates_detail::compiled_gate_formats);
+      if (is_gate_record)
+      {
+        operands.clear();
+        try
+        {
+          auto column_iter = std::next(std::begin(columns));
+          for (auto signature = format_iter->signature; *signature != '\0'; ++signature, ++column_iter)
+            if (*signature == 'q')
+              ::bra::gates_detail::write_compiled_value(
+                operands, static_cast<std::uint32_t>(boost::lexical_cast< ::bra::gates::bit_integer_type >(*column_iter)));
+            else if (*signature == 'e')
+              ::bra::gates_detail::write_compiled_value(
+                operands, static_cast<std::uint32_t>(boost::lexical_cast<int>(*column_iter)));
+            else
+              ::bra::gates_detail::write_compiled_value(
+                operands, boost::lexical_cast< ::bra::gates::real_type >(*column_iter));
+        }
+        catch (boost::bad_lexical_cast const&)
+        { is_gate_record = false; }
       }
-      else if (mnemonic.size() >= 2u and mnemonic.front() == 'C') // controlled gates
-        interpret_controlled_gates(columns, mnemonic);
-      else
-        throw unsupported_mnemonic_error{mnemonic};
+
+      ++num_records;
+      if (is_gate_record)
+      {
+        ::bra::gates_detail::write_compiled_value(output, static_cast<std::uint16_t>(format_iter->opcode));
+        output += operands;
+        continue;
+      }
+
+      ::bra::gates_detail::write_compiled_value(
+        output, static_cast<std::uint16_t>(::bra::gates_detail::compiled_opcode::statement));
+      ::bra::gates_detail::write_compiled_value(output, static_cast<std::uint32_t>(line.size()));
+      output += line;
     }
+
+    auto const file_size = static_cast<std::uint64_t>(output.size());
+    std::memcpy(std::addressof(output[num_records_position]), std::addressof(num_records), sizeof(std::uint64_t));
+    std::memcpy(
+      std::addressof(output[num_records_position + sizeof(std::uint64_t)]), std::addressof(file_size), sizeof(std::uint64_t));
+    output_stream.write(output.data(), output.size());
   }
 
   void gates::swap(gates& other)
@@ -640,6 +1119,604 @@ namespace bra
 #endif // BRA_NO_MPI
   }
 
+  namespace gates_detail
+  {
+    // from_qubits should be a subset of to_qubits
+    std::vector< ::bra::state::complex_type > expand_unitary_matrix(
+      std::vector< ::bra::state::complex_type > const& matrix,
+      std::vector< ::bra::state::qubit_type > const& from_qubits,
+      std::vector< ::bra::state::qubit_type > const& to_qubits)
+    {
+      auto const from_dimension = std::size_t{1u} << from_qubits.size();
+      auto const to_dimension = std::size_t{1u} << to_qubits.size();
+
+      auto bit_positions = std::vector<std::size_t>{};
+      bit_positions.reserve(from_qubits.size());
+      auto from_bits_mask = std::size_t{0u};
+      for (auto const& qubit: from_qubits)
+      {
+        auto const bit_position
+          = static_cast<std::size_t>(std::find(to_qubits.begin(), to_qubits.end(), qubit) - to_qubits.begin());
+        bit_positions.push_back(bit_position);
+        from_bits_mask |= std::size_t{1u} << bit_position;
+      }
+
+      auto const to_from_index
+        = [&bit_positions](std::size_t const to_index)
+          {
+            auto result = std::size_t{0u};
+            for (auto index = std::size_t{0u}; index < bit_positions.size(); ++index)
+              result |= ((to_index >> bit_positions[index]) bitand std::size_t{1u}) << index;
+            return result;
+          };
+
+      auto result = std::vector< ::bra::state::complex_type >(to_dimension * to_dimension);
+      for (auto row = std::size_t{0u}; row < to_dimension; ++row)
+        for (auto column = std::size_t{0u}; column < to_dimension; ++column)
+          if (((row xor column) bitand compl from_bits_mask) == std::size_t{0u})
+            result[row * to_dimension + column] = matrix[to_from_index(row) * from_dimension + to_from_index(column)];
+
+      return result;
+    }
+
+    // returns lhs * rhs, which means the operation of rhs is followed by that of lhs
+    std::vector< ::bra::state::complex_type > multiply_unitary_matrices(
+      std::vector< ::bra::state::complex_type > const& lhs, std::vector< ::bra::state::complex_type > const& rhs,
+      std::size_t const dimension)
+    {
+      auto result = std::vector< ::bra::state::complex_type >(dimension * dimension);
+      for (auto row = std::size_t{0u}; row < dimension; ++row)
+        for (auto index = std::size_t{0u}; index < dimension; ++index)
+        {
+          auto const lhs_element = lhs[row * dimension + index];
+          for (auto column = std::size_t{0u}; column < dimension; ++column)
+            result[row * dimension + column] += lhs_element * rhs[index * dimension + column];
+        }
+
+      return result;
+    }
+  } // namespace gates_detail
+
+  void gates::fuse(bit_integer_type const max_num_fused_qubits)
+  {
+    if (max_num_fused_qubits == bit_integer_type{0u})
+      return;
+
+    auto result = data_type{data_.get_allocator()};
+    result.reserve(data_.size());
+
+    auto fused_matrix = std::vector<complex_type>{};
+    auto fused_qubits = std::vector<qubit_type>{};
+    auto num_fused_gates = std::size_t{0u};
+    // kept to be reused if no other gate is merged
+    auto first_fused_gate = value_type_{};
+
+    auto const flush
+      = [&result, &fused_matrix, &fused_qubits, &num_fused_gates, &first_fused_gate]()
+        {
+          if (num_fused_gates == std::size_t{1u})
+            result.push_back(std::move(first_fused_gate));
+          else if (num_fused_gates > std::size_t{1u})
+            result.push_back(
+              std::unique_ptr< ::bra::gate::gate >{
+                new ::bra::gate::fused_unitary{std::move(fused_matrix), std::move(fused_qubits), num_fused_gates}});
+
+          fused_matrix.clear();
+          fused_qubits.clear();
+          num_fused_gates = std::size_t{0u};
+          first_fused_gate.reset();
+        };
+
+    auto matrix = std::vector<complex_type>{};
+    auto qubits = std::vector<qubit_type>{};
+    for (auto& gate_ptr: data_)
+    {
+      if ((not gate_ptr->unitary_matrix(matrix, qubits)) or qubits.size() > max_num_fused_qubits)
+      {
+        flush();
+        result.push_back(std::move(gate_ptr));
+        continue;
+      }
+
+      auto united_qubits = fused_qubits;
+      for (auto const& qubit: qubits)
+        if (std::find(united_qubits.begin(), united_qubits.end(), qubit) == united_qubits.end())
+          united_qubits.push_back(qubit);
+
+      if (united_qubits.size() > max_num_fused_qubits)
+      {
+        flush();
+        united_qubits = qubits;
+      }
+
+      if (num_fused_gates == std::size_t{0u})
+      {
+        fused_matrix = std::move(matrix);
+        fused_qubits = std::move(united_qubits);
+        num_fused_gates = std::size_t{1u};
+        first_fused_gate = std::move(gate_ptr);
+        continue;
+      }
+
+      fused_matrix
+        = ::bra::gates_detail::multiply_unitary_matrices(
+            ::bra::gates_detail::expand_unitary_matrix(matrix, qubits, united_qubits),
+            ::bra::gates_detail::expand_unitary_matrix(fused_matrix, fused_qubits, united_qubits),
+            std::size_t{1u} << united_qubits.size());
+      fused_qubits = std::move(united_qubits);
+      ++num_fused_gates;
+    }
+    flush();
+
+    data_ = std::move(result);
+  }
+
+  void gates::block(bit_integer_type const num_block_qubits)
+  {
+    if (num_block_qubits == bit_integer_type{0u} or num_block_qubits >= num_qubits_)
+      return;
+
+    auto result = data_type{data_.get_allocator()};
+    result.reserve(data_.size());
+
+    auto blocked_gates = data_type{data_.get_allocator()};
+    auto blocked_matrices = std::vector<std::vector<complex_type>>{};
+    auto blocked_qubits_list = std::vector<std::vector<qubit_type>>{};
+    // qubits used in blocked gates
+    auto is_used = std::vector<bool>(num_qubits_, false);
+    auto num_used_lower_qubits = bit_integer_type{0u};
+    auto num_used_upper_qubits = bit_integer_type{0u};
+
+    auto const flush
+      = [this, num_block_qubits, &result, &blocked_gates, &blocked_matrices, &blocked_qubits_list,
+         &is_used, &num_used_lower_qubits, &num_used_upper_qubits]()
+        {
+          // each swap of qubits sweeps the state once as well as each gate does
+          auto const num_sweeps = std::size_t{1u} + std::size_t{2u} * num_used_upper_qubits;
+          if (blocked_gates.size() <= num_sweeps)
+            std::move(blocked_gates.begin(), blocked_gates.end(), std::back_inserter(result));
+          else
+          {
+            // upper qubit => unused lower qubit, beginning from the most significant unused lower qubit
+            auto swapped_qubits = std::vector<std::pair<qubit_type, qubit_type>>{};
+            auto lower_bit = num_block_qubits;
+            for (auto upper_bit = num_block_qubits; upper_bit < num_qubits_; ++upper_bit)
+            {
+              if (not is_used[upper_bit])
+                continue;
+
+              do
+                --lower_bit;
+              while (is_used[lower_bit]);
+
+              swapped_qubits.emplace_back(
+                ket::make_qubit<state_integer_type>(upper_bit), ket::make_qubit<state_integer_type>(lower_bit));
+            }
+
+            for (auto& qubits: blocked_qubits_list)
+              for (auto& qubit: qubits)
+              {
+                auto const found
+                  = std::find_if(
+                      swapped_qubits.begin(), swapped_qubits.end(),
+                      [qubit](std::pair<qubit_type, qubit_type> const& qubit_pair) { return qubit_pair.first == qubit; });
+                if (found != swapped_qubits.end())
+                  qubit = found->second;
+              }
+
+            result.push_back(
+              std::unique_ptr< ::bra::gate::gate >{
+                new ::bra::gate::blocked_unitaries{
+                  std::move(blocked_matrices), std::move(blocked_qubits_list), std::move(swapped_qubits), num_block_qubits}});
+          }
+
+          blocked_gates.clear();
+          blocked_matrices.clear();
+          blocked_qubits_list.clear();
+          std::fill(is_used.begin(), is_used.end(), false);
+          num_used_lower_qubits = bit_integer_type{0u};
+          num_used_upper_qubits = bit_integer_type{0u};
+        };
+
+    auto matrix = std::vector<complex_type>{};
+    auto qubits = std::vector<qubit_type>{};
+    for (auto& gate_ptr: data_)
+    {
+      if ((not gate_ptr->unitary_matrix(matrix, qubits)) or qubits.size() > num_block_qubits)
+      {
+        flush();
+        result.push_back(std::move(gate_ptr));
+        continue;
+      }
+
+      auto new_num_used_lower_qubits = num_used_lower_qubits;
+      auto new_num_used_upper_qubits = num_used_upper_qubits;
+      for (auto const& qubit: qubits)
+        if (not is_used[static_cast<bit_integer_type>(qubit)])
+        {
+          if (static_cast<bit_integer_type>(qubit) < num_block_qubits)
+            ++new_num_used_lower_qubits;
+          else
+            ++new_num_used_upper_qubits;
+        }
+
+      // every upper qubit needs its own unused lower qubit
+      if (new_num_used_lower_qubits + new_num_used_upper_qubits > num_block_qubits)
+      {
+        flush();
+        new_num_used_lower_qubits = bit_integer_type{0u};
+        new_num_used_upper_qubits = bit_integer_type{0u};
+        for (auto const& qubit: qubits)
+        {
+          if (static_cast<bit_integer_type>(qubit) < num_block_qubits)
+            ++new_num_used_lower_qubits;
+          else
+            ++new_num_used_upper_qubits;
+        }
+      }
+
+      for (auto const& qubit: qubits)
+        is_used[static_cast<bit_integer_type>(qubit)] = true;
+      num_used_lower_qubits = new_num_used_lower_qubits;
+      num_used_upper_qubits = new_num_used_upper_qubits;
+
+      blocked_matrices.push_back(std::move(matrix));
+      blocked_qubits_list.push_back(std::move(qubits));
+      blocked_gates.push_back(std::move(gate_ptr));
+      matrix.clear();
+      qubits.clear();
+    }
+    flush();
+
+    data_ = std::move(result);
+  }
+
+  void gates::accumulate_diagonal_gates()
+  {
+    auto result = data_type{data_.get_allocator()};
+    result.reserve(data_.size());
+
+    // diagonal gates on at most two qubits are accumulated into
+    // global_coefficient prod_i linear_coefficients[i]^{x_i} prod_{i<j} quadratic_coefficients[(i, j)]^{x_i x_j}
+    auto accumulated_gates = data_type{data_.get_allocator()};
+    auto global_coefficient = complex_type{1};
+    auto linear_coefficients = std::map<bit_integer_type, complex_type>{};
+    auto quadratic_coefficients = std::map<std::pair<bit_integer_type, bit_integer_type>, complex_type>{};
+
+    auto const flush
+      = [&result, &accumulated_gates, &global_coefficient, &linear_coefficients, &quadratic_coefficients]()
+        {
+          if (accumulated_gates.size() <= std::size_t{1u})
+            std::move(accumulated_gates.begin(), accumulated_gates.end(), std::back_inserter(result));
+          else
+          {
+            auto linear_phase_coefficients = std::vector<std::pair<qubit_type, complex_type>>{};
+            linear_phase_coefficients.reserve(linear_coefficients.size());
+            for (auto const& bit_coefficient: linear_coefficients)
+              if (bit_coefficient.second != complex_type{1})
+                linear_phase_coefficients.emplace_back(
+                  ket::make_qubit<state_integer_type>(bit_coefficient.first), bit_coefficient.second);
+
+            auto quadratic_phase_coefficients = std::vector<std::tuple<qubit_type, qubit_type, complex_type>>{};
+            quadratic_phase_coefficients.reserve(quadratic_coefficients.size());
+            for (auto const& bits_coefficient: quadratic_coefficients)
+              if (bits_coefficient.second != complex_type{1})
+                quadratic_phase_coefficients.emplace_back(
+                  ket::make_qubit<state_integer_type>(bits_coefficient.first.first),
+                  ket::make_qubit<state_integer_type>(bits_coefficient.first.second), bits_coefficient.second);
+
+            result.push_back(
+              std::unique_ptr< ::bra::gate::gate >{
+                new ::bra::gate::quadratic_phase_shift{
+                  global_coefficient, std::move(linear_phase_coefficients), std::move(quadratic_phase_coefficients),
+                  accumulated_gates.size()}});
+          }
+
+          accumulated_gates.clear();
+          global_coefficient = complex_type{1};
+          linear_coefficients.clear();
+          quadratic_coefficients.clear();
+        };
+
+    auto matrix = std::vector<complex_type>{};
+    auto qubits = std::vector<qubit_type>{};
+    for (auto& gate_ptr: data_)
+    {
+      auto is_diagonal = gate_ptr->unitary_matrix(matrix, qubits) and qubits.size() <= std::size_t{2u};
+      auto const dimension = std::size_t{1u} << qubits.size();
+      for (auto index = std::size_t{0u}; index < matrix.size() and is_diagonal; ++index)
+        is_diagonal = index / dimension == index % dimension or matrix[index] == complex_type{0};
+
+      if (not is_diagonal)
+      {
+        flush();
+        result.push_back(std::move(gate_ptr));
+        continue;
+      }
+
+      // the 0th bit of indices of matrix corresponds to qubits[0]
+      auto const diagonal0 = matrix[0u];
+      global_coefficient *= diagonal0;
+      if (qubits.size() == std::size_t{1u})
+      {
+        auto const found = linear_coefficients.emplace(static_cast<bit_integer_type>(qubits[0u]), complex_type{1}).first;
+        found->second *= matrix[3u] / diagonal0;
+      }
+      else
+      {
+        auto const diagonal1 = matrix[dimension + 1u];
+        auto const diagonal2 = matrix[2u * dimension + 2u];
+        auto const diagonal3 = matrix[3u * dimension + 3u];
+        linear_coefficients.emplace(static_cast<bit_integer_type>(qubits[0u]), complex_type{1}).first->second *= diagonal1 / diagonal0;
+        linear_coefficients.emplace(static_cast<bit_integer_type>(qubits[1u]), complex_type{1}).first->second *= diagonal2 / diagonal0;
+        auto const bits
+          = std::make_pair(
+              static_cast<bit_integer_type>(std::min(qubits[0u], qubits[1u])),
+              static_cast<bit_integer_type>(std::max(qubits[0u], qubits[1u])));
+        quadratic_coefficients.emplace(bits, complex_type{1}).first->second *= diagonal3 * diagonal0 / (diagonal1 * diagonal2);
+      }
+
+      accumulated_gates.push_back(std::move(gate_ptr));
+    }
+    flush();
+
+    data_ = std::move(result);
+  }
+
+#ifndef BRA_NO_MPI
+  namespace gates_detail
+  {
+    // ::bra::state::interchange_qubits supports up to this number of qubits
+    constexpr std::size_t max_num_interchanged_qubits = 4u;
+
+    // same as ::bra::state::interchange_qubits in simple mode: local_qubits are moved to the uppermost local qubits, and then
+    // ::ket::mpi::utility::maybe_interchange_qubits interchanges them with global_qubits
+    void interchange_qubits(
+      ::bra::state::permutation_type& permutation, ::bra::gates::permutated_qubit_type const least_global_permutated_qubit,
+      std::vector< ::bra::gates::qubit_type > const& global_qubits, std::vector< ::bra::gates::qubit_type > const& local_qubits)
+    {
+      using ::ket::mpi::inverse;
+      using ::ket::mpi::permutate;
+      auto const num_qubits = global_qubits.size();
+      for (auto index = std::size_t{0u}; index < num_qubits; ++index)
+      {
+        auto const permutated_swap_qubit
+          = least_global_permutated_qubit - static_cast< ::bra::gates::bit_integer_type >(index + 1u);
+        if (permutation[local_qubits[index]] != permutated_swap_qubit)
+          permutate(permutation, local_qubits[index], inverse(permutation)[permutated_swap_qubit]);
+      }
+
+      ::ket::mpi::utility::interchange_qubits_in_permutation(permutation, least_global_permutated_qubit, global_qubits);
+    }
+
+    // gates which ::bra::state applies by permutating qubits if it absorbs global permutations
+    bool is_permutating(::bra::gate::gate const& gate)
+    {
+      return dynamic_cast< ::bra::gate::swap const* >(&gate) != nullptr
+        or dynamic_cast< ::bra::gate::adj_swap const* >(&gate) != nullptr;
+    }
+
+    // gates which ::bra::state applies by relabeling processes if it absorbs global permutations and all their qubits are global
+    bool is_relabeling(::bra::gate::gate const& gate)
+    {
+      return dynamic_cast< ::bra::gate::pauli_x const* >(&gate) != nullptr
+        or dynamic_cast< ::bra::gate::adj_pauli_x const* >(&gate) != nullptr
+        or dynamic_cast< ::bra::gate::not_ const* >(&gate) != nullptr
+        or dynamic_cast< ::bra::gate::controlled_not const* >(&gate) != nullptr
+        or dynamic_cast< ::bra::gate::adj_controlled_not const* >(&gate) != nullptr
+        or dynamic_cast< ::bra::gate::toffoli const* >(&gate) != nullptr
+        or dynamic_cast< ::bra::gate::adj_toffoli const* >(&gate) != nullptr
+        or dynamic_cast< ::bra::gate::multi_controlled_not const* >(&gate) != nullptr;
+    }
+
+    // bytes sent by each process to interchange num_interchanged_qubits global qubits
+    std::size_t num_interchanged_bytes(
+      ::bra::gates::bit_integer_type const num_local_qubits, std::size_t const num_interchanged_qubits)
+    {
+      return ((std::size_t{1u} << num_interchanged_qubits) - std::size_t{1u})
+        * (std::size_t{1u} << (num_local_qubits - num_interchanged_qubits)) * sizeof(::bra::state::complex_type);
+    }
+  } // namespace gates_detail
+
+  ::bra::permutation_plan_prediction gates::plan_permutation(
+    size_type const num_lookahead_gates, bool const absorbs_global_permutations)
+  {
+    auto result = ::bra::permutation_plan_prediction{0u, 0u, 0u, 0u};
+    if (num_lookahead_gates == size_type{0u} or num_uqubits_ > bit_integer_type{0u} or num_lqubits_ >= num_qubits_)
+      return result;
+
+    // Gates which are not represented as unitary matrices, such as measurements, QFT and arithmetic gates, may change the permutation
+    // in ways unknown here, so that gates are planned only up to the first of them and the rest are left as they are
+    auto const num_gates = data_.size();
+    auto num_planned_gates = num_gates;
+
+    // qubits which have to be local for each gate. Gates which are diagonal in KET_USE_DIAGONAL_LOOP need no local qubits.
+    // If global permutations are absorbed, SWAP gates need no local qubits and only permutate qubits
+    auto qubits_list = std::vector<std::vector<qubit_type>>(num_gates);
+    auto is_permutating_list = std::vector<bool>(num_gates, false);
+    auto is_relabeling_list = std::vector<bool>(num_gates, false);
+    // indices of gates using each qubit
+    auto gate_indices_list = std::vector<std::vector<size_type>>(num_qubits_);
+    auto matrix = std::vector<complex_type>{};
+    for (auto gate_index = size_type{0u}; gate_index < num_gates; ++gate_index)
+    {
+      auto& qubits = qubits_list[gate_index];
+      if (not data_[gate_index]->unitary_matrix(matrix, qubits))
+      {
+        num_planned_gates = gate_index;
+        break;
+      }
+
+      if (absorbs_global_permutations and ::bra::gates_detail::is_permutating(*data_[gate_index]))
+      {
+        is_permutating_list[gate_index] = true;
+        continue;
+      }
+      is_relabeling_list[gate_index] = absorbs_global_permutations and ::bra::gates_detail::is_relabeling(*data_[gate_index]);
+
+# ifdef KET_USE_DIAGONAL_LOOP
+      auto const dimension = std::size_t{1u} << qubits.size();
+      auto is_diagonal = true;
+      for (auto index = std::size_t{0u}; index < matrix.size() and is_diagonal; ++index)
+        is_diagonal = index / dimension == index % dimension or matrix[index] == complex_type{0};
+      if (is_diagonal)
+      {
+        qubits.clear();
+        continue;
+      }
+# endif // KET_USE_DIAGONAL_LOOP
+
+      for (auto const qubit: qubits)
+        gate_indices_list[static_cast<bit_integer_type>(qubit)].push_back(gate_index);
+    }
+
+    auto next_gate_index_positions = std::vector<std::size_t>(num_qubits_, std::size_t{0u});
+    constexpr auto never = std::numeric_limits<size_type>::max();
+    // the index of the first gate using qubit after gate_index. gate_index must not decrease between calls
+    auto const next_gate_index
+      = [&gate_indices_list, &next_gate_index_positions, never](qubit_type const qubit, size_type const gate_index)
+        {
+          auto const bit = static_cast<bit_integer_type>(qubit);
+          auto const& gate_indices = gate_indices_list[bit];
+          auto& position = next_gate_index_positions[bit];
+          while (position < gate_indices.size() and gate_indices[position] <= gate_index)
+            ++position;
+          return position < gate_indices.size() ? gate_indices[position] : never;
+        };
+
+    // both permutations are changed in the same way as the permutation of ::bra::state in simple mode
+    auto planned_permutation = ::bra::state::permutation_type{initial_permutation_.begin(), initial_permutation_.end()};
+    auto unplanned_permutation = planned_permutation;
+    auto const least_global_permutated_qubit = permutated_qubit_type{num_lqubits_};
+    auto const is_local
+      = [least_global_permutated_qubit](::bra::state::permutation_type const& permutation, qubit_type const qubit)
+        { return permutation[qubit] < least_global_permutated_qubit; };
+
+    auto new_data = data_type{data_.get_allocator()};
+    new_data.reserve(num_gates);
+    auto global_qubits = std::vector<qubit_type>{};
+    auto local_qubits = std::vector<qubit_type>{};
+    auto candidate_qubits = std::vector<qubit_type>{};
+    auto lookahead_qubits = std::vector<qubit_type>{};
+    for (auto gate_index = size_type{0u}; gate_index < num_planned_gates; ++gate_index)
+    {
+      auto const& qubits = qubits_list[gate_index];
+
+      if (is_permutating_list[gate_index])
+      {
+        using ::ket::mpi::permutate;
+        permutate(unplanned_permutation, qubits[0u], qubits[1u]);
+        permutate(planned_permutation, qubits[0u], qubits[1u]);
+        new_data.push_back(std::move(data_[gate_index]));
+        continue;
+      }
+
+      auto const is_all_global
+        = [&qubits, &is_local](::bra::state::permutation_type const& permutation)
+          {
+            return std::none_of(
+              qubits.begin(), qubits.end(),
+              [&permutation, &is_local](qubit_type const qubit) { return is_local(permutation, qubit); });
+          };
+
+      if (not (is_relabeling_list[gate_index] and is_all_global(unplanned_permutation)))
+      {
+        auto const num_unplanned_interchanged_qubits
+          = ::ket::mpi::utility::interchange_qubits_in_permutation(unplanned_permutation, least_global_permutated_qubit, qubits);
+        if (num_unplanned_interchanged_qubits > std::size_t{0u})
+        {
+          ++result.num_unplanned_interchanges;
+          result.num_unplanned_bytes += ::bra::gates_detail::num_interchanged_bytes(num_lqubits_, num_unplanned_interchanged_qubits);
+        }
+      }
+
+      global_qubits.clear();
+      if (not (is_relabeling_list[gate_index] and is_all_global(planned_permutation)))
+        for (auto const qubit: qubits)
+          if (not is_local(planned_permutation, qubit))
+            global_qubits.push_back(qubit);
+
+      auto const is_used
+        = [&qubits](qubit_type const qubit) { return std::find(qubits.begin(), qubits.end(), qubit) != qubits.end(); };
+
+      // local qubits which are not used in this gate, from the one used latest. Ties are broken by permutated qubits
+      // so that local qubits already placed at the uppermost local qubits are chosen
+      candidate_qubits.clear();
+      for (auto bit = bit_integer_type{0u}; bit < num_qubits_; ++bit)
+      {
+        auto const qubit = ket::make_qubit<state_integer_type>(bit);
+        if (is_local(planned_permutation, qubit) and not is_used(qubit))
+          candidate_qubits.push_back(qubit);
+      }
+      std::sort(
+        candidate_qubits.begin(), candidate_qubits.end(),
+        [gate_index, &next_gate_index, &planned_permutation](qubit_type const lhs, qubit_type const rhs)
+        {
+          auto const lhs_gate_index = next_gate_index(lhs, gate_index);
+          auto const rhs_gate_index = next_gate_index(rhs, gate_index);
+          return lhs_gate_index != rhs_gate_index
+            ? lhs_gate_index > rhs_gate_index
+            : planned_permutation[lhs] > planned_permutation[rhs];
+        });
+
+      if (global_qubits.empty())
+        ;
+      else if (global_qubits.size() > ::bra::gates_detail::max_num_interchanged_qubits or global_qubits.size() > candidate_qubits.size())
+      {
+        // left to ::ket::mpi::utility::maybe_interchange_qubits
+        ::ket::mpi::utility::interchange_qubits_in_permutation(planned_permutation, least_global_permutated_qubit, qubits);
+        ++result.num_planned_interchanges;
+        result.num_planned_bytes += ::bra::gates_detail::num_interchanged_bytes(num_lqubits_, global_qubits.size());
+      }
+      else
+      {
+        local_qubits.assign(candidate_qubits.begin(), candidate_qubits.begin() + global_qubits.size());
+
+        // global qubits used soon are also brought in if they are used earlier than the local qubits evicted for them
+        lookahead_qubits.clear();
+        for (auto bit = bit_integer_type{0u}; bit < num_qubits_; ++bit)
+        {
+          auto const qubit = ket::make_qubit<state_integer_type>(bit);
+          if ((not is_local(planned_permutation, qubit)) and (not is_used(qubit))
+              and next_gate_index(qubit, gate_index) - gate_index <= num_lookahead_gates)
+            lookahead_qubits.push_back(qubit);
+        }
+        std::sort(
+          lookahead_qubits.begin(), lookahead_qubits.end(),
+          [gate_index, &next_gate_index](qubit_type const lhs, qubit_type const rhs)
+          { return next_gate_index(lhs, gate_index) < next_gate_index(rhs, gate_index); });
+
+        for (auto const lookahead_qubit: lookahead_qubits)
+        {
+          if (global_qubits.size() == ::bra::gates_detail::max_num_interchanged_qubits or local_qubits.size() == candidate_qubits.size())
+            break;
+
+          auto const candidate_qubit = candidate_qubits[local_qubits.size()];
+          if (next_gate_index(candidate_qubit, gate_index) <= next_gate_index(lookahead_qubit, gate_index))
+            break;
+
+          global_qubits.push_back(lookahead_qubit);
+          local_qubits.push_back(candidate_qubit);
+        }
+
+        ::bra::gates_detail::interchange_qubits(planned_permutation, least_global_permutated_qubit, global_qubits, local_qubits);
+        ++result.num_planned_interchanges;
+        result.num_planned_bytes += ::bra::gates_detail::num_interchanged_bytes(num_lqubits_, global_qubits.size());
+
+        new_data.push_back(
+          std::unique_ptr< ::bra::gate::gate >{
+            new ::bra::gate::interchange_qubits{std::vector<qubit_type>(global_qubits), std::vector<qubit_type>(local_qubits)}});
+      }
+
+      new_data.push_back(std::move(data_[gate_index]));
+    }
+    std::move(data_.begin() + num_planned_gates, data_.end(), std::back_inserter(new_data));
+
+    data_.swap(new_data);
+    return result;
+  }
+#endif // BRA_NO_MPI
+
   gates::bit_integer_type gates::read_num_qubits(gates::columns_type const& columns) const
   {
     if (boost::size(columns) != 2u)
@@ -737,6 +1814,56 @@ namespace bra
     }
   }
 
+  void gates::read_fourier_transform_targets(gates::columns_type const& columns, std::vector<gates::qubit_type>& targets) const
+  {
+    if (boost::size(columns) < 2u)
+      throw wrong_mnemonics_error{columns};
+
+    targets.clear();
+    targets.reserve(boost::size(columns) - 1u);
+    for (auto iter = std::next(std::begin(columns)); iter != std::end(columns); ++iter)
+    {
+      auto const target = boost::lexical_cast<bit_integer_type>(*iter);
+      if (target >= num_qubits_
+          or std::find(std::begin(targets), std::end(targets), ket::make_qubit<state_integer_type>(target)) != std::end(targets))
+        throw wrong_mnemonics_error{columns};
+
+      targets.push_back(ket::make_qubit<state_integer_type>(target));
+    }
+  }
+
+  // appends the qubits in columns[first_index, last_index) to targets. All registers of an arithmetic gate are read into the same targets
+  // to reject overlapping registers
+  void gates::read_register_targets(
+    gates::columns_type const& columns, std::size_t const first_index, std::size_t const last_index,
+    std::vector<gates::qubit_type>& targets) const
+  {
+    if (first_index >= last_index or last_index > boost::size(columns))
+      throw wrong_mnemonics_error{columns};
+
+    for (auto iter = std::next(std::begin(columns), first_index); iter != std::next(std::begin(columns), last_index); ++iter)
+    {
+      auto const target = boost::lexical_cast<bit_integer_type>(*iter);
+      if (target >= num_qubits_
+          or std::find(std::begin(targets), std::end(targets), ket::make_qubit<state_integer_type>(target)) != std::end(targets))
+        throw wrong_mnemonics_error{columns};
+
+      targets.push_back(ket::make_qubit<state_integer_type>(target));
+    }
+  }
+
+  // divisor should fit in the register, and multiplier (or base) * x mod divisor should not overflow for x < divisor
+  void gates::check_modular_arithmetic(
+    gates::columns_type const& columns, std::size_t const num_register_qubits,
+    gates::state_integer_type const multiplier, gates::state_integer_type const divisor) const
+  {
+    if (divisor == state_integer_type{0u}
+        or divisor - state_integer_type{1u} > ket::utility::integer_exp2<state_integer_type>(num_register_qubits) - state_integer_type{1u}
+        or divisor - state_integer_type{1u} > std::numeric_limits<state_integer_type>::max() / divisor
+        or std::gcd(multiplier, divisor) != state_integer_type{1u})
+      throw wrong_mnemonics_error{columns};
+  }
+
   std::tuple<gates::qubit_type, gates::real_type>
   gates::read_target_phase(gates::columns_type const& columns) const
   {
@@ -1941,6 +3068,115 @@ namespace bra
         new ::bra::gate::shor_box{num_exponent_qubits, divisor, base}});
   }
 
+  void gates::add_qft(gates::columns_type const& columns)
+  {
+    auto targets = std::vector<qubit_type>{};
+    read_fourier_transform_targets(columns, targets);
+
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::fourier_transform{std::move(targets)}});
+  }
+
+  void gates::add_iqft(gates::columns_type const& columns)
+  {
+    auto targets = std::vector<qubit_type>{};
+    read_fourier_transform_targets(columns, targets);
+
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::adj_fourier_transform{std::move(targets)}});
+  }
+
+  void gates::add_add(gates::columns_type const& columns)
+  {
+    // ADD i1 ... in j1 ... jn
+    if (boost::size(columns) < 3u or boost::size(columns) % 2u == 0u)
+      throw wrong_mnemonics_error{columns};
+
+    auto const num_register_qubits = (boost::size(columns) - 1u) / 2u;
+    auto targets = std::vector<qubit_type>{};
+    read_register_targets(columns, 1u, boost::size(columns), targets);
+    auto rhs_qubits = std::vector<qubit_type>(std::next(std::begin(targets), num_register_qubits), std::end(targets));
+    targets.resize(num_register_qubits);
+
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::addition_assignment{std::move(targets), std::move(rhs_qubits)}});
+  }
+
+  void gates::add_sub(gates::columns_type const& columns)
+  {
+    // SUB i1 ... in j1 ... jn
+    if (boost::size(columns) < 3u or boost::size(columns) % 2u == 0u)
+      throw wrong_mnemonics_error{columns};
+
+    auto const num_register_qubits = (boost::size(columns) - 1u) / 2u;
+    auto targets = std::vector<qubit_type>{};
+    read_register_targets(columns, 1u, boost::size(columns), targets);
+    auto rhs_qubits = std::vector<qubit_type>(std::next(std::begin(targets), num_register_qubits), std::end(targets));
+    targets.resize(num_register_qubits);
+
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::subtraction_assignment{std::move(targets), std::move(rhs_qubits)}});
+  }
+
+  void gates::add_addc(gates::columns_type const& columns)
+  {
+    // ADDC i1 ... in a
+    if (boost::size(columns) < 3u)
+      throw wrong_mnemonics_error{columns};
+
+    auto targets = std::vector<qubit_type>{};
+    read_register_targets(columns, 1u, boost::size(columns) - 1u, targets);
+    auto const constant = boost::lexical_cast<state_integer_type>(columns.back());
+
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::constant_addition_assignment{std::move(targets), constant}});
+  }
+
+  void gates::add_mulmod(gates::columns_type const& columns)
+  {
+    // MULMOD i1 ... in a N
+    if (boost::size(columns) < 4u)
+      throw wrong_mnemonics_error{columns};
+
+    auto targets = std::vector<qubit_type>{};
+    read_register_targets(columns, 1u, boost::size(columns) - 2u, targets);
+    auto const multiplier = boost::lexical_cast<state_integer_type>(columns[boost::size(columns) - 2u]);
+    auto const divisor = boost::lexical_cast<state_integer_type>(columns.back());
+    check_modular_arithmetic(columns, targets.size(), multiplier, divisor);
+
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::modular_multiplication_assignment{std::move(targets), multiplier, divisor}});
+  }
+
+  void gates::add_modexp(gates::columns_type const& columns)
+  {
+    // MODEXP m e1 ... em i1 ... in a N
+    if (boost::size(columns) < 6u)
+      throw wrong_mnemonics_error{columns};
+
+    auto const num_exponent_qubits = boost::lexical_cast<std::size_t>(columns[1u]);
+    if (num_exponent_qubits == 0u or num_exponent_qubits + 5u > boost::size(columns))
+      throw wrong_mnemonics_error{columns};
+
+    auto targets = std::vector<qubit_type>{};
+    read_register_targets(columns, 2u, boost::size(columns) - 2u, targets);
+    auto exponent_qubits = std::vector<qubit_type>(std::begin(targets), std::next(std::begin(targets), num_exponent_qubits));
+    targets.erase(std::begin(targets), std::next(std::begin(targets), num_exponent_qubits));
+    auto const base = boost::lexical_cast<state_integer_type>(columns[boost::size(columns) - 2u]);
+    auto const divisor = boost::lexical_cast<state_integer_type>(columns.back());
+    check_modular_arithmetic(columns, targets.size(), base, divisor);
+
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::modular_exponentiation_assignment{std::move(exponent_qubits), std::move(targets), base, divisor}});
+  }
+
   void gates::add_clear(gates::columns_type const& columns)
   {
     data_.push_back(
@@ -2121,6 +3357,40 @@ namespace bra
     }
   }
 
+#ifdef BRA_NO_MPI
+  namespace gates_detail
+  {
+    bool is_controlled_not(
+      ::bra::gate::gate const& gate, ::bra::state::qubit_type const target_qubit, ::bra::state::qubit_type const control_qubit)
+    {
+      auto const controlled_not_ptr = dynamic_cast< ::bra::gate::controlled_not const* >(&gate);
+      return controlled_not_ptr != nullptr
+        and controlled_not_ptr->target_qubit() == target_qubit
+        and controlled_not_ptr->control_qubit().qubit() == control_qubit;
+    }
+  } // namespace gates_detail
+
+#endif // BRA_NO_MPI
+  void gates::add_controlled_not(qubit_type const target_qubit, control_qubit_type const control_qubit)
+  {
+#ifdef BRA_NO_MPI
+    // CNOT a b; CNOT b a; CNOT a b is SWAP a b, which the nompi state applies by permutating qubits
+    auto const num_gates = data_.size();
+    if (num_gates >= 2u
+        and ::bra::gates_detail::is_controlled_not(*data_[num_gates - 1u], control_qubit.qubit(), target_qubit)
+        and ::bra::gates_detail::is_controlled_not(*data_[num_gates - 2u], target_qubit, control_qubit.qubit()))
+    {
+      data_.pop_back();
+      data_.back().reset(new ::bra::gate::swap{target_qubit, control_qubit.qubit()});
+      return;
+    }
+
+#endif // BRA_NO_MPI
+    data_.push_back(
+      std::unique_ptr< ::bra::gate::gate >{
+        new ::bra::gate::controlled_not{target_qubit, control_qubit}});
+  }
+
   void gates::add_cnot(gates::columns_type const& columns, int const num_control_qubits)
   {
     if (num_control_qubits == 1)
@@ -2129,9 +3399,7 @@ namespace bra
       auto target = qubit_type{};
       std::tie(control, target) = read_control_target(columns);
 
-      data_.push_back(
-        std::unique_ptr< ::bra::gate::gate >{
-          new ::bra::gate::controlled_not{target, control}});
+      add_controlled_not(target, control);
     }
     else // num_control_qubits >= 2
     {
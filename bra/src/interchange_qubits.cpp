@@ -0,0 +1,37 @@
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/interchange_qubits.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const interchange_qubits::name_ = "INTERCHANGE";
+
+    interchange_qubits::interchange_qubits(std::vector<qubit_type>&& global_qubits, std::vector<qubit_type>&& local_qubits)
+      : ::bra::gate::gate{}, global_qubits_{std::move(global_qubits)}, local_qubits_{std::move(local_qubits)}
+    { }
+
+    ::bra::state& interchange_qubits::do_apply(::bra::state& state) const
+    { return state.interchange_qubits(global_qubits_, local_qubits_); }
+
+    std::string const& interchange_qubits::do_name() const { return name_; }
+    std::string interchange_qubits::do_representation(
+      std::ostringstream& repr_stream, int const) const
+    {
+      auto const num_qubits = global_qubits_.size();
+      for (auto index = std::size_t{0u}; index < num_qubits; ++index)
+        repr_stream << (index == std::size_t{0u} ? "" : " ") << global_qubits_[index] << "<->" << local_qubits_[index];
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
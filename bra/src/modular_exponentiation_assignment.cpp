@@ -0,0 +1,42 @@
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/modular_exponentiation_assignment.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const modular_exponentiation_assignment::name_ = "MODEXP";
+
+    modular_exponentiation_assignment::modular_exponentiation_assignment(
+      std::vector<qubit_type>&& exponent_qubits, std::vector<qubit_type>&& qubits, state_integer_type const base, state_integer_type const divisor)
+      : ::bra::gate::gate{}, exponent_qubits_{std::move(exponent_qubits)}, qubits_{std::move(qubits)}, base_{base}, divisor_{divisor}
+    { }
+
+    ::bra::state& modular_exponentiation_assignment::do_apply(::bra::state& state) const
+    { return state.modular_exponentiation_assignment(exponent_qubits_, qubits_, base_, divisor_); }
+
+    std::string const& modular_exponentiation_assignment::do_name() const { return name_; }
+    std::string modular_exponentiation_assignment::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit: exponent_qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      for (auto&& qubit: qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      repr_stream << std::right << std::setw(parameter_width) << base_;
+      repr_stream << std::right << std::setw(parameter_width) << divisor_;
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
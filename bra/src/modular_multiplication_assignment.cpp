@@ -0,0 +1,40 @@
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/modular_multiplication_assignment.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const modular_multiplication_assignment::name_ = "MULMOD";
+
+    modular_multiplication_assignment::modular_multiplication_assignment(
+      std::vector<qubit_type>&& qubits, state_integer_type const multiplier, state_integer_type const divisor)
+      : ::bra::gate::gate{}, qubits_{std::move(qubits)}, multiplier_{multiplier}, divisor_{divisor}
+    { }
+
+    ::bra::state& modular_multiplication_assignment::do_apply(::bra::state& state) const
+    { return state.modular_multiplication_assignment(qubits_, multiplier_, divisor_); }
+
+    std::string const& modular_multiplication_assignment::do_name() const { return name_; }
+    std::string modular_multiplication_assignment::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit: qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      repr_stream << std::right << std::setw(parameter_width) << multiplier_;
+      repr_stream << std::right << std::setw(parameter_width) << divisor_;
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
@@ -1,5 +1,16 @@
 #ifdef BRA_NO_MPI
+# include <cstddef>
+# include <cassert>
+# include <array>
 # include <vector>
+# include <tuple>
+# include <utility>
+# include <iterator>
+# include <chrono>
+# include <algorithm>
+
+# include <boost/math/constants/constants.hpp>
+# include <boost/range/size.hpp>
 
 # include <ket/gate/hadamard.hpp>
 # include <ket/gate/not_.hpp>
@@ -20,10 +31,23 @@
 # include <ket/gate/projective_measurement.hpp>
 # include <ket/gate/clear.hpp>
 # include <ket/gate/set.hpp>
+# include <ket/gate/unitary_matrix.hpp>
+# include <ket/gate/quadratic_phase_shift.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+# include <ket/utility/integer_log2.hpp>
+# include <ket/utility/exp_i.hpp>
 # include <ket/all_spin_expectation_values.hpp>
 # include <ket/measure.hpp>
 # include <ket/generate_events.hpp>
 # include <ket/shor_box.hpp>
+# include <ket/swapped_fourier_transform.hpp>
+# include <ket/addition_assignment.hpp>
+# include <ket/subtraction_assignment.hpp>
+# include <ket/constant_addition_assignment.hpp>
+# include <ket/modular_multiplication_assignment.hpp>
+# include <ket/modular_exponentiation_assignment.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
 
 # include <bra/nompi_state.hpp>
 # include <bra/state.hpp>
@@ -37,54 +61,105 @@ namespace bra
     unsigned int num_threads, ::bra::state::seed_type const seed)
     : ::bra::state{total_num_qubits, seed},
       parallel_policy_{num_threads},
-      data_{make_initial_data(initial_integer, total_num_qubits)}
-  { }
+      data_{make_initial_data(initial_integer, total_num_qubits)},
+      permutation_{total_num_qubits},
+      initial_integer_{initial_integer},
+      num_nonzero_qubits_{0u},
+      nonzero_data_{boost::make_iterator_range(std::begin(data_) + initial_integer, std::begin(data_) + (initial_integer + 1u))}
+  {
+    if (not ket::utility::uses_zero_pages())
+      expand_nonzero_data(static_cast<bit_integer_type>(total_num_qubits));
+  }
 
-  void nompi_state::do_hadamard(qubit_type const qubit)
-  { ket::gate::ranges::hadamard(parallel_policy_, data_, qubit); }
+  void nompi_state::do_loop_chunk_size(std::size_t const chunk_size)
+  { parallel_policy_.chunk_size(chunk_size); }
 
-  void nompi_state::do_adj_hadamard(qubit_type const qubit)
-  { ket::gate::ranges::adj_hadamard(parallel_policy_, data_, qubit); }
+  void nompi_state::do_record_busy_times()
+  { parallel_policy_.record_busy_times(); }
 
-  void nompi_state::do_not_(qubit_type const qubit)
-  { ket::gate::ranges::not_(parallel_policy_, data_, qubit); }
+  std::vector<double> nompi_state::do_busy_times() const
+  {
+    auto result = std::vector<double>{};
+    if (parallel_policy_.busy_times() == nullptr)
+      return result;
 
-  void nompi_state::do_adj_not_(qubit_type const qubit)
-  { ket::gate::ranges::adj_not_(parallel_policy_, data_, qubit); }
+    for (auto const& busy_time: parallel_policy_.busy_times()->durations())
+      result.push_back(std::chrono::duration<double>(busy_time).count());
+    return result;
+  }
 
-  void nompi_state::do_pauli_x(qubit_type const qubit)
-  { ket::gate::ranges::pauli_x(parallel_policy_, data_, qubit); }
+  void nompi_state::do_hadamard(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::hadamard(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_adj_pauli_x(qubit_type const qubit)
-  { ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, qubit); }
+  void nompi_state::do_adj_hadamard(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_hadamard(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_pauli_xx(qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::pauli_x(parallel_policy_, data_, qubit1, qubit2); }
+  void nompi_state::do_not_(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::not_(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_adj_pauli_xx(qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, qubit1, qubit2); }
+  void nompi_state::do_adj_not_(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_not_(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_pauli_xn(std::vector<qubit_type> const& qubits)
+  void nompi_state::do_pauli_x(qubit_type const unpermutated_qubit)
   {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(qubit), qubit);
+  }
+
+  void nompi_state::do_adj_pauli_x(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(qubit), qubit);
+  }
+
+  void nompi_state::do_pauli_xx(qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(qubit1, qubit2), qubit1, qubit2);
+  }
+
+  void nompi_state::do_adj_pauli_xx(qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(qubit1, qubit2), qubit1, qubit2);
+  }
+
+  void nompi_state::do_pauli_xn(std::vector<qubit_type> const& unpermutated_qubits)
+  {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::pauli_x(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::pauli_x(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::pauli_x(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::pauli_x(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -92,27 +167,28 @@ namespace bra
     }
   }
 
-  void nompi_state::do_adj_pauli_xn(std::vector<qubit_type> const& qubits)
+  void nompi_state::do_adj_pauli_xn(std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -120,39 +196,54 @@ namespace bra
     }
   }
 
-  void nompi_state::do_pauli_y(qubit_type const qubit)
-  { ket::gate::ranges::pauli_y(parallel_policy_, data_, qubit); }
+  void nompi_state::do_pauli_y(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_adj_pauli_y(qubit_type const qubit)
-  { ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, qubit); }
+  void nompi_state::do_adj_pauli_y(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_pauli_yy(qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::pauli_y(parallel_policy_, data_, qubit1, qubit2); }
+  void nompi_state::do_pauli_yy(qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(qubit1, qubit2), qubit1, qubit2);
+  }
 
-  void nompi_state::do_adj_pauli_yy(qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, qubit1, qubit2); }
+  void nompi_state::do_adj_pauli_yy(qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(qubit1, qubit2), qubit1, qubit2);
+  }
 
-  void nompi_state::do_pauli_yn(std::vector<qubit_type> const& qubits)
+  void nompi_state::do_pauli_yn(std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::pauli_y(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::pauli_y(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::pauli_y(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::pauli_y(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -160,27 +251,28 @@ namespace bra
     }
   }
 
-  void nompi_state::do_adj_pauli_yn(std::vector<qubit_type> const& qubits)
+  void nompi_state::do_adj_pauli_yn(std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -188,39 +280,54 @@ namespace bra
     }
   }
 
-  void nompi_state::do_pauli_z(qubit_type const qubit)
-  { ket::gate::ranges::pauli_z(parallel_policy_, data_, qubit); }
+  void nompi_state::do_pauli_z(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_adj_pauli_z(qubit_type const qubit)
-  { ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, qubit); }
+  void nompi_state::do_adj_pauli_z(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_pauli_zz(qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::pauli_z(parallel_policy_, data_, qubit1, qubit2); }
+  void nompi_state::do_pauli_zz(qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(qubit1, qubit2), qubit1, qubit2);
+  }
 
-  void nompi_state::do_adj_pauli_zz(qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, qubit1, qubit2); }
+  void nompi_state::do_adj_pauli_zz(qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(qubit1, qubit2), qubit1, qubit2);
+  }
 
-  void nompi_state::do_pauli_zn(std::vector<qubit_type> const& qubits)
+  void nompi_state::do_pauli_zn(std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::pauli_z(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::pauli_z(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::pauli_z(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::pauli_z(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -228,27 +335,28 @@ namespace bra
     }
   }
 
-  void nompi_state::do_adj_pauli_zn(std::vector<qubit_type> const& qubits)
+  void nompi_state::do_adj_pauli_zn(std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(qubits), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -256,107 +364,163 @@ namespace bra
     }
   }
 
+  // amplitudes are not moved, and the following gates are applied to the exchanged permutated qubits
   void nompi_state::do_swap(qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::swap(parallel_policy_, data_, qubit1, qubit2); }
+  { ket::mpi::permutate(permutation_, qubit1, qubit2); }
 
   void nompi_state::do_adj_swap(qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::adj_swap(parallel_policy_, data_, qubit1, qubit2); }
+  { ket::mpi::permutate(permutation_, qubit1, qubit2); }
 
-  void nompi_state::do_u1(real_type const phase, qubit_type const qubit)
-  { ket::gate::ranges::phase_shift(parallel_policy_, data_, phase, qubit); }
+  void nompi_state::do_u1(real_type const phase, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::phase_shift(parallel_policy_, nonzero_data(qubit), phase, qubit);
+  }
 
-  void nompi_state::do_adj_u1(real_type const phase, qubit_type const qubit)
-  { ket::gate::ranges::adj_phase_shift(parallel_policy_, data_, phase, qubit); }
+  void nompi_state::do_adj_u1(real_type const phase, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_phase_shift(parallel_policy_, nonzero_data(qubit), phase, qubit);
+  }
 
   void nompi_state::do_u2(
-    real_type const phase1, real_type const phase2, qubit_type const qubit)
-  { ket::gate::ranges::phase_shift2(parallel_policy_, data_, phase1, phase2, qubit); }
+    real_type const phase1, real_type const phase2, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::phase_shift2(parallel_policy_, nonzero_data(qubit), phase1, phase2, qubit);
+  }
 
   void nompi_state::do_adj_u2(
-    real_type const phase1, real_type const phase2, qubit_type const qubit)
-  { ket::gate::ranges::adj_phase_shift2(parallel_policy_, data_, phase1, phase2, qubit); }
+    real_type const phase1, real_type const phase2, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_phase_shift2(parallel_policy_, nonzero_data(qubit), phase1, phase2, qubit);
+  }
 
   void nompi_state::do_u3(
     real_type const phase1, real_type const phase2, real_type const phase3,
-    qubit_type const qubit)
-  { ket::gate::ranges::phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, qubit); }
+    qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::phase_shift3(parallel_policy_, nonzero_data(qubit), phase1, phase2, phase3, qubit);
+  }
 
   void nompi_state::do_adj_u3(
     real_type const phase1, real_type const phase2, real_type const phase3,
-    qubit_type const qubit)
-  { ket::gate::ranges::adj_phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, qubit); }
+    qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_phase_shift3(parallel_policy_, nonzero_data(qubit), phase1, phase2, phase3, qubit);
+  }
 
   void nompi_state::do_phase_shift(
-    complex_type const& phase_coefficient, qubit_type const qubit)
-  { ket::gate::ranges::phase_shift_coeff(parallel_policy_, data_, phase_coefficient, qubit); }
+    complex_type const& phase_coefficient, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::phase_shift_coeff(parallel_policy_, nonzero_data(qubit), phase_coefficient, qubit);
+  }
 
   void nompi_state::do_adj_phase_shift(
-    complex_type const& phase_coefficient, qubit_type const qubit)
-  { ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, data_, phase_coefficient, qubit); }
+    complex_type const& phase_coefficient, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, nonzero_data(qubit), phase_coefficient, qubit);
+  }
 
-  void nompi_state::do_x_rotation_half_pi(qubit_type const qubit)
-  { ket::gate::ranges::x_rotation_half_pi(parallel_policy_, data_, qubit); }
+  void nompi_state::do_x_rotation_half_pi(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::x_rotation_half_pi(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_adj_x_rotation_half_pi(qubit_type const qubit)
-  { ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, data_, qubit); }
+  void nompi_state::do_adj_x_rotation_half_pi(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_y_rotation_half_pi(qubit_type const qubit)
-  { ket::gate::ranges::y_rotation_half_pi(parallel_policy_, data_, qubit); }
+  void nompi_state::do_y_rotation_half_pi(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::y_rotation_half_pi(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_adj_y_rotation_half_pi(qubit_type const qubit)
-  { ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, data_, qubit); }
+  void nompi_state::do_adj_y_rotation_half_pi(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
   void nompi_state::do_controlled_v(
     complex_type const& phase_coefficient,
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
     ket::gate::ranges::controlled_v_coeff(
       parallel_policy_,
-      data_, phase_coefficient, target_qubit, control_qubit);
+      nonzero_data(target_qubit, control_qubit), phase_coefficient, target_qubit, control_qubit);
   }
 
   void nompi_state::do_adj_controlled_v(
     complex_type const& phase_coefficient,
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
     ket::gate::ranges::adj_controlled_v_coeff(
       parallel_policy_,
-      data_, phase_coefficient, target_qubit, control_qubit);
+      nonzero_data(target_qubit, control_qubit), phase_coefficient, target_qubit, control_qubit);
   }
 
-  void nompi_state::do_exponential_pauli_x(real_type const phase, qubit_type const qubit)
-  { ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, qubit); }
+  void nompi_state::do_exponential_pauli_x(real_type const phase, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(qubit), phase, qubit);
+  }
 
-  void nompi_state::do_adj_exponential_pauli_x(real_type const phase, qubit_type const qubit)
-  { ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, qubit); }
+  void nompi_state::do_adj_exponential_pauli_x(real_type const phase, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(qubit), phase, qubit);
+  }
 
-  void nompi_state::do_exponential_pauli_xx(real_type const phase, qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, qubit1, qubit2); }
+  void nompi_state::do_exponential_pauli_xx(real_type const phase, qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(qubit1, qubit2), phase, qubit1, qubit2);
+  }
 
-  void nompi_state::do_adj_exponential_pauli_xx(real_type const phase, qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, qubit1, qubit2); }
+  void nompi_state::do_adj_exponential_pauli_xx(real_type const phase, qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(qubit1, qubit2), phase, qubit1, qubit2);
+  }
 
-  void nompi_state::do_exponential_pauli_xn(real_type const phase, std::vector<qubit_type> const& qubits)
+  void nompi_state::do_exponential_pauli_xn(real_type const phase, std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -364,27 +528,28 @@ namespace bra
     }
   }
 
-  void nompi_state::do_adj_exponential_pauli_xn(real_type const phase, std::vector<qubit_type> const& qubits)
+  void nompi_state::do_adj_exponential_pauli_xn(real_type const phase, std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -392,39 +557,54 @@ namespace bra
     }
   }
 
-  void nompi_state::do_exponential_pauli_y(real_type const phase, qubit_type const qubit)
-  { ket::gate::ranges::exponential_pauli_y(parallel_policy_, data_, phase, qubit); }
+  void nompi_state::do_exponential_pauli_y(real_type const phase, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::exponential_pauli_y(parallel_policy_, nonzero_data(qubit), phase, qubit);
+  }
 
-  void nompi_state::do_adj_exponential_pauli_y(real_type const phase, qubit_type const qubit)
-  { ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, qubit); }
+  void nompi_state::do_adj_exponential_pauli_y(real_type const phase, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(qubit), phase, qubit);
+  }
 
-  void nompi_state::do_exponential_pauli_yy(real_type const phase, qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::exponential_pauli_y(parallel_policy_, data_, phase, qubit1, qubit2); }
+  void nompi_state::do_exponential_pauli_yy(real_type const phase, qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::exponential_pauli_y(parallel_policy_, nonzero_data(qubit1, qubit2), phase, qubit1, qubit2);
+  }
 
-  void nompi_state::do_adj_exponential_pauli_yy(real_type const phase, qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, qubit1, qubit2); }
+  void nompi_state::do_adj_exponential_pauli_yy(real_type const phase, qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(qubit1, qubit2), phase, qubit1, qubit2);
+  }
 
-  void nompi_state::do_exponential_pauli_yn(real_type const phase, std::vector<qubit_type> const& qubits)
+  void nompi_state::do_exponential_pauli_yn(real_type const phase, std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::exponential_pauli_y(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::exponential_pauli_y(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::exponential_pauli_y(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::exponential_pauli_y(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::exponential_pauli_y(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::exponential_pauli_y(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::exponential_pauli_y(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::exponential_pauli_y(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -432,27 +612,28 @@ namespace bra
     }
   }
 
-  void nompi_state::do_adj_exponential_pauli_yn(real_type const phase, std::vector<qubit_type> const& qubits)
+  void nompi_state::do_adj_exponential_pauli_yn(real_type const phase, std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -460,39 +641,54 @@ namespace bra
     }
   }
 
-  void nompi_state::do_exponential_pauli_z(real_type const phase, qubit_type const qubit)
-  { ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, qubit); }
+  void nompi_state::do_exponential_pauli_z(real_type const phase, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(qubit), phase, qubit);
+  }
 
-  void nompi_state::do_adj_exponential_pauli_z(real_type const phase, qubit_type const qubit)
-  { ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, qubit); }
+  void nompi_state::do_adj_exponential_pauli_z(real_type const phase, qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(qubit), phase, qubit);
+  }
 
-  void nompi_state::do_exponential_pauli_zz(real_type const phase, qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, qubit1, qubit2); }
+  void nompi_state::do_exponential_pauli_zz(real_type const phase, qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(qubit1, qubit2), phase, qubit1, qubit2);
+  }
 
-  void nompi_state::do_adj_exponential_pauli_zz(real_type const phase, qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, qubit1, qubit2); }
+  void nompi_state::do_adj_exponential_pauli_zz(real_type const phase, qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(qubit1, qubit2), phase, qubit1, qubit2);
+  }
 
-  void nompi_state::do_exponential_pauli_zn(real_type const phase, std::vector<qubit_type> const& qubits)
+  void nompi_state::do_exponential_pauli_zn(real_type const phase, std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -500,27 +696,28 @@ namespace bra
     }
   }
 
-  void nompi_state::do_adj_exponential_pauli_zn(real_type const phase, std::vector<qubit_type> const& qubits)
+  void nompi_state::do_adj_exponential_pauli_zn(real_type const phase, std::vector<qubit_type> const& unpermutated_qubits)
   {
+    auto const qubits = permutated(unpermutated_qubits);
     auto const num_qubits = qubits.size();
     assert(num_qubits > 2u);
 
     switch (num_qubits)
     {
      case 3u:
-      ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u]);
+      ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
       break;
 
      case 6u:
-      ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(qubits), phase, qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
       break;
 
      default:
@@ -528,226 +725,375 @@ namespace bra
     }
   }
 
-  void nompi_state::do_exponential_swap(real_type const phase, qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::exponential_swap(parallel_policy_, data_, phase, qubit1, qubit2); }
+  void nompi_state::do_exponential_swap(real_type const phase, qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::exponential_swap(parallel_policy_, nonzero_data(qubit1, qubit2), phase, qubit1, qubit2);
+  }
 
-  void nompi_state::do_adj_exponential_swap(real_type const phase, qubit_type const qubit1, qubit_type const qubit2)
-  { ket::gate::ranges::adj_exponential_swap(parallel_policy_, data_, phase, qubit1, qubit2); }
+  void nompi_state::do_adj_exponential_swap(real_type const phase, qubit_type const unpermutated_qubit1, qubit_type const unpermutated_qubit2)
+  {
+    auto const qubit1 = permutated(unpermutated_qubit1);
+    auto const qubit2 = permutated(unpermutated_qubit2);
+    ket::gate::ranges::adj_exponential_swap(parallel_policy_, nonzero_data(qubit1, qubit2), phase, qubit1, qubit2);
+  }
 
   void nompi_state::do_toffoli(
-    qubit_type const target_qubit,
-    control_qubit_type const control_qubit1,
-    control_qubit_type const control_qubit2)
+    qubit_type const unpermutated_target_qubit,
+    control_qubit_type const unpermutated_control_qubit1,
+    control_qubit_type const unpermutated_control_qubit2)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit1 = permutated(unpermutated_control_qubit1);
+    auto const control_qubit2 = permutated(unpermutated_control_qubit2);
     ket::gate::ranges::toffoli(
       parallel_policy_,
-      data_, target_qubit, control_qubit1, control_qubit2);
+      nonzero_data(target_qubit, control_qubit1, control_qubit2), target_qubit, control_qubit1, control_qubit2);
   }
 
   void nompi_state::do_adj_toffoli(
-    qubit_type const target_qubit,
-    control_qubit_type const control_qubit1,
-    control_qubit_type const control_qubit2)
+    qubit_type const unpermutated_target_qubit,
+    control_qubit_type const unpermutated_control_qubit1,
+    control_qubit_type const unpermutated_control_qubit2)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit1 = permutated(unpermutated_control_qubit1);
+    auto const control_qubit2 = permutated(unpermutated_control_qubit2);
     ket::gate::ranges::adj_toffoli(
       parallel_policy_,
-      data_, target_qubit, control_qubit1, control_qubit2);
+      nonzero_data(target_qubit, control_qubit1, control_qubit2), target_qubit, control_qubit1, control_qubit2);
   }
 
-  ket::gate::outcome nompi_state::do_projective_measurement(qubit_type const qubit)
+  ket::gate::outcome nompi_state::do_projective_measurement(qubit_type const unpermutated_qubit)
   {
+    auto const qubit = permutated(unpermutated_qubit);
     return ket::gate::ranges::projective_measurement(
-      parallel_policy_, data_, qubit, random_number_generator_);
+      parallel_policy_, nonzero_data(qubit), qubit, random_number_generator_);
   }
 
   void nompi_state::do_expectation_values()
   {
-    maybe_expectation_values_
+    auto const permutated_expectation_values
       = ket::ranges::all_spin_expectation_values<qubit_type>(
           parallel_policy_, data_);
+
+    maybe_expectation_values_ = spins_type{};
+    maybe_expectation_values_->reserve(total_num_qubits_);
+    auto const last_qubit = ket::make_qubit<state_integer_type>(total_num_qubits_);
+    for (auto qubit = ket::make_qubit<state_integer_type>(bit_integer_type{0u}); qubit < last_qubit; ++qubit)
+      maybe_expectation_values_->push_back(permutated_expectation_values[static_cast<bit_integer_type>(permutated(qubit))]);
   }
 
   void nompi_state::do_measure()
   {
     measured_value_
-      = ket::ranges::measure(
-          ket::utility::policy::make_sequential(), // parallel_policy_,
-          data_, random_number_generator_);
+      = ket::mpi::inverse_permutate_bits(
+          permutation_,
+          static_cast<state_integer_type>(
+            ket::ranges::measure(
+              ket::utility::policy::make_sequential(), // parallel_policy_,
+              data(), random_number_generator_)));
   }
 
   void nompi_state::do_generate_events(int const num_events, int const seed)
   {
     if (seed < 0)
       ket::ranges::generate_events(
-        ket::utility::policy::make_sequential(), // parallel_policy_,
+        parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_);
     else
       ket::ranges::generate_events(
-        ket::utility::policy::make_sequential(), // parallel_policy_,
+        parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, static_cast<seed_type>(seed));
+
+    for (auto& event: generated_events_)
+      event = ket::mpi::inverse_permutate_bits(permutation_, event);
   }
 
   void nompi_state::do_shor_box(
     state_integer_type const divisor, state_integer_type const base,
-    std::vector<qubit_type> const& exponent_qubits,
-    std::vector<qubit_type> const& modular_exponentiation_qubits)
+    std::vector<qubit_type> const& unpermutated_exponent_qubits,
+    std::vector<qubit_type> const& unpermutated_modular_exponentiation_qubits)
   {
+    auto const exponent_qubits = permutated(unpermutated_exponent_qubits);
+    auto const modular_exponentiation_qubits = permutated(unpermutated_modular_exponentiation_qubits);
     ket::ranges::shor_box(
       parallel_policy_,
-      data_, base, divisor, exponent_qubits, modular_exponentiation_qubits);
+      data(), base, divisor, exponent_qubits, modular_exponentiation_qubits);
+  }
+
+  void nompi_state::do_swapped_fourier_transform(std::vector<qubit_type> const& unpermutated_qubits)
+  {
+    auto const qubits = permutated(unpermutated_qubits);
+    ket::ranges::swapped_fourier_transform(parallel_policy_, nonzero_data(qubits), qubits);
+  }
+
+  void nompi_state::do_adj_swapped_fourier_transform(std::vector<qubit_type> const& unpermutated_qubits)
+  {
+    auto const qubits = permutated(unpermutated_qubits);
+    ket::ranges::adj_swapped_fourier_transform(parallel_policy_, nonzero_data(qubits), qubits);
+  }
+
+  void nompi_state::do_addition_assignment(
+    std::vector<qubit_type> const& unpermutated_lhs_qubits, std::vector<qubit_type> const& unpermutated_rhs_qubits)
+  {
+    auto const lhs_qubits = permutated(unpermutated_lhs_qubits);
+    auto const rhs_qubits = permutated(unpermutated_rhs_qubits);
+    ket::ranges::addition_assignment(
+      parallel_policy_, nonzero_data(lhs_qubits, rhs_qubits),
+      lhs_qubits, std::vector<std::vector<qubit_type>>{rhs_qubits});
+  }
+
+  void nompi_state::do_subtraction_assignment(
+    std::vector<qubit_type> const& unpermutated_lhs_qubits, std::vector<qubit_type> const& unpermutated_rhs_qubits)
+  {
+    auto const lhs_qubits = permutated(unpermutated_lhs_qubits);
+    auto const rhs_qubits = permutated(unpermutated_rhs_qubits);
+    ket::ranges::subtraction_assignment(
+      parallel_policy_, nonzero_data(lhs_qubits, rhs_qubits),
+      lhs_qubits, std::vector<std::vector<qubit_type>>{rhs_qubits});
+  }
+
+  void nompi_state::do_constant_addition_assignment(
+    std::vector<qubit_type> const& unpermutated_qubits, state_integer_type const constant)
+  {
+    auto const qubits = permutated(unpermutated_qubits);
+    ket::ranges::constant_addition_assignment(parallel_policy_, nonzero_data(qubits), qubits, constant);
+  }
+
+  void nompi_state::do_modular_multiplication_assignment(
+    std::vector<qubit_type> const& unpermutated_qubits, state_integer_type const multiplier, state_integer_type const divisor)
+  {
+    auto const qubits = permutated(unpermutated_qubits);
+    ket::ranges::modular_multiplication_assignment(parallel_policy_, nonzero_data(qubits), qubits, multiplier, divisor);
+  }
+
+  void nompi_state::do_modular_exponentiation_assignment(
+    std::vector<qubit_type> const& unpermutated_exponent_qubits, std::vector<qubit_type> const& unpermutated_qubits,
+    state_integer_type const base, state_integer_type const divisor)
+  {
+    auto const exponent_qubits = permutated(unpermutated_exponent_qubits);
+    auto const qubits = permutated(unpermutated_qubits);
+    ket::ranges::modular_exponentiation_assignment(
+      parallel_policy_, nonzero_data(exponent_qubits, qubits), exponent_qubits, qubits, base, divisor);
   }
 
-  void nompi_state::do_clear(qubit_type const qubit)
-  { ket::gate::ranges::clear(parallel_policy_, data_, qubit); }
+  void nompi_state::do_clear(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::clear(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
-  void nompi_state::do_set(qubit_type const qubit)
-  { ket::gate::ranges::set(parallel_policy_, data_, qubit); }
+  void nompi_state::do_set(qubit_type const unpermutated_qubit)
+  {
+    auto const qubit = permutated(unpermutated_qubit);
+    ket::gate::ranges::set(parallel_policy_, nonzero_data(qubit), qubit);
+  }
 
   void nompi_state::do_controlled_hadamard(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::hadamard(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_hadamard(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_hadamard(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_hadamard(
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::hadamard(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::hadamard(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::hadamard(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::hadamard(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
-      throw bra::too_many_qubits_error{num_control_qubits + std::size_t{1u}};
+    {
+      auto const one_div_root_two = boost::math::constants::one_div_root_two<real_type>();
+      auto const matrix = std::array<complex_type, 4u>{
+        complex_type{one_div_root_two}, complex_type{one_div_root_two},
+        complex_type{one_div_root_two}, complex_type{-one_div_root_two}};
+      ket::gate::ranges::unitary_matrix(parallel_policy_, nonzero_data(target_qubit, control_qubits), std::begin(matrix), std::vector<qubit_type>{target_qubit}, control_qubits);
+      break;
+    }
     }
   }
 
   void nompi_state::do_adj_multi_controlled_hadamard(
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::adj_hadamard(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_hadamard(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_hadamard(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_hadamard(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::adj_hadamard(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
-      throw bra::too_many_qubits_error{num_control_qubits + std::size_t{1u}};
+    {
+      auto const one_div_root_two = boost::math::constants::one_div_root_two<real_type>();
+      auto const matrix = std::array<complex_type, 4u>{
+        complex_type{one_div_root_two}, complex_type{one_div_root_two},
+        complex_type{one_div_root_two}, complex_type{-one_div_root_two}};
+      ket::gate::ranges::adj_unitary_matrix(parallel_policy_, nonzero_data(target_qubit, control_qubits), std::begin(matrix), std::vector<qubit_type>{target_qubit}, control_qubits);
+      break;
+    }
     }
   }
 
   void nompi_state::do_controlled_not(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::not_(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::not_(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_not(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_not_(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_not_(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_not(
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::not_(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::not_(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::not_(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::not_(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::not_(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::not_(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::not_(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::not_(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
-      throw bra::too_many_qubits_error{num_control_qubits + std::size_t{1u}};
+    {
+      auto const matrix = std::array<complex_type, 4u>{
+        complex_type{0}, complex_type{1},
+        complex_type{1}, complex_type{0}};
+      ket::gate::ranges::unitary_matrix(parallel_policy_, nonzero_data(target_qubit, control_qubits), std::begin(matrix), std::vector<qubit_type>{target_qubit}, control_qubits);
+      break;
+    }
     }
   }
 
   void nompi_state::do_adj_multi_controlled_not(
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::adj_not_(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_not_(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_not_(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_not_(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_not_(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_not_(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_not_(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::adj_not_(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
-      throw bra::too_many_qubits_error{num_control_qubits + std::size_t{1u}};
+    {
+      auto const matrix = std::array<complex_type, 4u>{
+        complex_type{0}, complex_type{1},
+        complex_type{1}, complex_type{0}};
+      ket::gate::ranges::adj_unitary_matrix(parallel_policy_, nonzero_data(target_qubit, control_qubits), std::begin(matrix), std::vector<qubit_type>{target_qubit}, control_qubits);
+      break;
+    }
     }
   }
 
   void nompi_state::do_controlled_pauli_x(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_pauli_x(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
   {
-    ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubit, control_qubit);
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
   }
 
   void nompi_state::do_multi_controlled_pauli_xn(
-    std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -761,19 +1107,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -785,19 +1131,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -809,15 +1155,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -829,11 +1175,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -845,7 +1191,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -859,8 +1205,10 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_pauli_xn(
-    std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -874,19 +1222,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -898,19 +1246,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -922,15 +1270,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -942,11 +1290,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -958,7 +1306,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_x(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -972,16 +1320,26 @@ namespace bra
   }
 
   void nompi_state::do_controlled_pauli_y(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_pauli_y(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_pauli_yn(
-    std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -995,19 +1353,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -1019,19 +1377,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -1043,15 +1401,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -1063,11 +1421,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -1079,7 +1437,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -1093,8 +1451,10 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_pauli_yn(
-    std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -1108,19 +1468,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -1132,19 +1492,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -1156,15 +1516,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -1176,11 +1536,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -1192,7 +1552,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_y(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -1206,16 +1566,26 @@ namespace bra
   }
 
   void nompi_state::do_controlled_pauli_z(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_pauli_z(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_pauli_zn(
-    std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -1229,19 +1599,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -1253,19 +1623,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -1277,15 +1647,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -1297,11 +1667,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -1313,7 +1683,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -1327,8 +1697,10 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_pauli_zn(
-    std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -1342,19 +1714,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -1366,19 +1738,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -1390,15 +1762,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -1410,11 +1782,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -1426,7 +1798,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_pauli_z(parallel_policy_, data_, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::adj_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -1440,28 +1812,31 @@ namespace bra
   }
 
   void nompi_state::do_multi_controlled_swap(
-    qubit_type const target_qubit1, qubit_type const target_qubit2,
-    std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit1, qubit_type const unpermutated_target_qubit2,
+    std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit1 = permutated(unpermutated_target_qubit1);
+    auto const target_qubit2 = permutated(unpermutated_target_qubit2);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 0u);
 
     switch (num_control_qubits)
     {
      case 1u:
-      ket::gate::ranges::swap(parallel_policy_, data_, target_qubit1, target_qubit2, control_qubits[0u]);
+      ket::gate::ranges::swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), target_qubit1, target_qubit2, control_qubits[0u]);
       break;
 
      case 2u:
-      ket::gate::ranges::swap(parallel_policy_, data_, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::swap(parallel_policy_, data_, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::swap(parallel_policy_, data_, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      default:
@@ -1470,28 +1845,31 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_swap(
-    qubit_type const target_qubit1, qubit_type const target_qubit2,
-    std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit1, qubit_type const unpermutated_target_qubit2,
+    std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit1 = permutated(unpermutated_target_qubit1);
+    auto const target_qubit2 = permutated(unpermutated_target_qubit2);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 0u);
 
     switch (num_control_qubits)
     {
      case 1u:
-      ket::gate::ranges::adj_swap(parallel_policy_, data_, target_qubit1, target_qubit2, control_qubits[0u]);
+      ket::gate::ranges::adj_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), target_qubit1, target_qubit2, control_qubits[0u]);
       break;
 
      case 2u:
-      ket::gate::ranges::adj_swap(parallel_policy_, data_, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_swap(parallel_policy_, data_, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_swap(parallel_policy_, data_, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      default:
@@ -1501,170 +1879,228 @@ namespace bra
 
   void nompi_state::do_controlled_phase_shift(
     complex_type const& phase_coefficient,
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase_coefficient, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_phase_shift(
     complex_type const& phase_coefficient,
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase_coefficient, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_phase_shift(
     complex_type const& phase_coefficient,
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
-      throw bra::too_many_qubits_error{num_control_qubits + 1u};
+    {
+      auto const matrix = std::array<complex_type, 4u>{
+        complex_type{1}, complex_type{0},
+        complex_type{0}, phase_coefficient};
+      ket::gate::ranges::unitary_matrix(parallel_policy_, nonzero_data(target_qubit, control_qubits), std::begin(matrix), std::vector<qubit_type>{target_qubit}, control_qubits);
+      break;
+    }
     }
   }
 
   void nompi_state::do_adj_multi_controlled_phase_shift(
     complex_type const& phase_coefficient,
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::adj_phase_shift_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
-      throw bra::too_many_qubits_error{num_control_qubits + 1u};
+    {
+      auto const matrix = std::array<complex_type, 4u>{
+        complex_type{1}, complex_type{0},
+        complex_type{0}, phase_coefficient};
+      ket::gate::ranges::adj_unitary_matrix(parallel_policy_, nonzero_data(target_qubit, control_qubits), std::begin(matrix), std::vector<qubit_type>{target_qubit}, control_qubits);
+      break;
+    }
     }
   }
 
   void nompi_state::do_controlled_u1(
-    real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubit); }
+    real_type const phase, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_u1(
-    real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubit); }
+    real_type const phase, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_u1(
-    real_type const phase, qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
-      throw bra::too_many_qubits_error{num_control_qubits + 1u};
+    {
+      auto const matrix = std::array<complex_type, 4u>{
+        complex_type{1}, complex_type{0},
+        complex_type{0}, ket::utility::exp_i<complex_type>(phase)};
+      ket::gate::ranges::unitary_matrix(parallel_policy_, nonzero_data(target_qubit, control_qubits), std::begin(matrix), std::vector<qubit_type>{target_qubit}, control_qubits);
+      break;
+    }
     }
   }
 
   void nompi_state::do_adj_multi_controlled_u1(
-    real_type const phase, qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::adj_phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_phase_shift(parallel_policy_, data_, phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::adj_phase_shift(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
-      throw bra::too_many_qubits_error{num_control_qubits + 1u};
+    {
+      auto const matrix = std::array<complex_type, 4u>{
+        complex_type{1}, complex_type{0},
+        complex_type{0}, ket::utility::exp_i<complex_type>(phase)};
+      ket::gate::ranges::adj_unitary_matrix(parallel_policy_, nonzero_data(target_qubit, control_qubits), std::begin(matrix), std::vector<qubit_type>{target_qubit}, control_qubits);
+      break;
+    }
     }
   }
 
   void nompi_state::do_controlled_u2(
-    real_type const phase1, real_type const phase2, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubit); }
+    real_type const phase1, real_type const phase2, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase1, phase2, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_u2(
-    real_type const phase1, real_type const phase2, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubit); }
+    real_type const phase1, real_type const phase2, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase1, phase2, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_u2(
-    real_type const phase1, real_type const phase2, qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase1, real_type const phase2, qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1673,27 +2109,29 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_u2(
-    real_type const phase1, real_type const phase2, qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase1, real_type const phase2, qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::adj_phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_phase_shift2(parallel_policy_, data_, phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::adj_phase_shift2(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1703,37 +2141,47 @@ namespace bra
 
   void nompi_state::do_controlled_u3(
     real_type const phase1, real_type const phase2, real_type const phase3,
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase1, phase2, phase3, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_u3(
     real_type const phase1, real_type const phase2, real_type const phase3,
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase1, phase2, phase3, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_u3(
     real_type const phase1, real_type const phase2, real_type const phase3,
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1743,27 +2191,29 @@ namespace bra
 
   void nompi_state::do_adj_multi_controlled_u3(
     real_type const phase1, real_type const phase2, real_type const phase3,
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::adj_phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_phase_shift3(parallel_policy_, data_, phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::adj_phase_shift3(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase1, phase2, phase3, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1772,35 +2222,45 @@ namespace bra
   }
 
   void nompi_state::do_controlled_x_rotation_half_pi(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_x_rotation_half_pi(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_x_rotation_half_pi(
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1809,27 +2269,29 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_x_rotation_half_pi(
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::adj_x_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1838,35 +2300,45 @@ namespace bra
   }
 
   void nompi_state::do_controlled_y_rotation_half_pi(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_y_rotation_half_pi(
-    qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubit); }
+    qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubit), target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_y_rotation_half_pi(
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1875,27 +2347,29 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_y_rotation_half_pi(
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, data_, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::adj_y_rotation_half_pi(parallel_policy_, nonzero_data(target_qubit, control_qubits), target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1905,27 +2379,29 @@ namespace bra
 
   void nompi_state::do_multi_controlled_v(
     complex_type const& phase_coefficient,
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::controlled_v_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::controlled_v_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::controlled_v_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::controlled_v_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::controlled_v_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::controlled_v_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::controlled_v_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::controlled_v_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1935,27 +2411,29 @@ namespace bra
 
   void nompi_state::do_adj_multi_controlled_v(
     complex_type const& phase_coefficient,
-    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+    qubit_type const unpermutated_target_qubit, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
     switch (num_control_qubits)
     {
      case 2u:
-      ket::gate::ranges::adj_controlled_v_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_controlled_v_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_controlled_v_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_controlled_v_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_controlled_v_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_controlled_v_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      case 5u:
-      ket::gate::ranges::adj_controlled_v_coeff(parallel_policy_, data_, phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+      ket::gate::ranges::adj_controlled_v_coeff(parallel_policy_, nonzero_data(target_qubit, control_qubits), phase_coefficient, target_qubit, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
       break;
 
      default:
@@ -1964,16 +2442,26 @@ namespace bra
   }
 
   void nompi_state::do_controlled_exponential_pauli_x(
-    real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubit, control_qubit); }
+    real_type const phase, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_exponential_pauli_x(
-    real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubit, control_qubit); }
+    real_type const phase, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_exponential_pauli_xn(
-    real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -1987,19 +2475,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -2011,19 +2499,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -2035,15 +2523,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -2055,11 +2543,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -2071,7 +2559,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -2085,8 +2573,10 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_exponential_pauli_xn(
-    real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -2100,19 +2590,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -2124,19 +2614,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -2148,15 +2638,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -2168,11 +2658,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -2184,7 +2674,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_x(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -2198,16 +2688,26 @@ namespace bra
   }
 
   void nompi_state::do_controlled_exponential_pauli_y(
-    real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::exponential_pauli_y(parallel_policy_, data_, phase, target_qubit, control_qubit); }
+    real_type const phase, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::exponential_pauli_y(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_exponential_pauli_y(
-    real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubit, control_qubit); }
+    real_type const phase, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_exponential_pauli_yn(
-    real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -2223,25 +2723,25 @@ namespace bra
        case 2u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -2255,25 +2755,25 @@ namespace bra
        case 1u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -2287,19 +2787,19 @@ namespace bra
        case 1u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -2313,13 +2813,13 @@ namespace bra
        case 1u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -2333,7 +2833,7 @@ namespace bra
        case 1u:
         ket::gate::ranges::exponential_pauli_y(
           parallel_policy_,
-          data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+          nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -2347,8 +2847,10 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_exponential_pauli_yn(
-    real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -2362,19 +2864,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -2386,19 +2888,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -2410,15 +2912,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -2430,11 +2932,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -2446,7 +2948,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_y(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -2460,16 +2962,26 @@ namespace bra
   }
 
   void nompi_state::do_controlled_exponential_pauli_z(
-    real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubit, control_qubit); }
+    real_type const phase, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_adj_controlled_exponential_pauli_z(
-    real_type const phase, qubit_type const target_qubit, control_qubit_type const control_qubit)
-  { ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubit, control_qubit); }
+    real_type const phase, qubit_type const unpermutated_target_qubit, control_qubit_type const unpermutated_control_qubit)
+  {
+    auto const target_qubit = permutated(unpermutated_target_qubit);
+    auto const control_qubit = permutated(unpermutated_control_qubit);
+    ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubit, control_qubit), phase, target_qubit, control_qubit);
+  }
 
   void nompi_state::do_multi_controlled_exponential_pauli_zn(
-    real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -2483,19 +2995,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -2507,19 +3019,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -2531,15 +3043,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -2551,11 +3063,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -2567,7 +3079,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -2581,8 +3093,10 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_exponential_pauli_zn(
-    real_type const phase, std::vector<qubit_type> const& target_qubits, std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, std::vector<qubit_type> const& unpermutated_target_qubits, std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubits = permutated(unpermutated_target_qubits);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_target_qubits = target_qubits.size();
     auto const num_control_qubits = control_qubits.size();
     auto const num_qubits = num_target_qubits + num_control_qubits;
@@ -2596,19 +3110,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        case 5u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u], control_qubits[4u]);
         break;
 
        default:
@@ -2620,19 +3134,19 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        case 4u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
         break;
 
        default:
@@ -2644,15 +3158,15 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u]);
         break;
 
        case 3u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], control_qubits[0u], control_qubits[1u], control_qubits[2u]);
         break;
 
        default:
@@ -2664,11 +3178,11 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u]);
         break;
 
        case 2u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], control_qubits[0u], control_qubits[1u]);
         break;
 
        default:
@@ -2680,7 +3194,7 @@ namespace bra
       switch (num_control_qubits)
       {
        case 1u:
-        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, data_, phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
+        ket::gate::ranges::adj_exponential_pauli_z(parallel_policy_, nonzero_data(target_qubits, control_qubits), phase, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u], target_qubits[4u], control_qubits[0u]);
         break;
 
        default:
@@ -2694,28 +3208,31 @@ namespace bra
   }
 
   void nompi_state::do_multi_controlled_exponential_swap(
-    real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
-    std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, qubit_type const unpermutated_target_qubit1, qubit_type const unpermutated_target_qubit2,
+    std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit1 = permutated(unpermutated_target_qubit1);
+    auto const target_qubit2 = permutated(unpermutated_target_qubit2);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 0u);
 
     switch (num_control_qubits)
     {
      case 1u:
-      ket::gate::ranges::exponential_swap(parallel_policy_, data_, phase, target_qubit1, target_qubit2, control_qubits[0u]);
+      ket::gate::ranges::exponential_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), phase, target_qubit1, target_qubit2, control_qubits[0u]);
       break;
 
      case 2u:
-      ket::gate::ranges::exponential_swap(parallel_policy_, data_, phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::exponential_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::exponential_swap(parallel_policy_, data_, phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::exponential_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::exponential_swap(parallel_policy_, data_, phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::exponential_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      default:
@@ -2724,34 +3241,135 @@ namespace bra
   }
 
   void nompi_state::do_adj_multi_controlled_exponential_swap(
-    real_type const phase, qubit_type const target_qubit1, qubit_type const target_qubit2,
-    std::vector<control_qubit_type> const& control_qubits)
+    real_type const phase, qubit_type const unpermutated_target_qubit1, qubit_type const unpermutated_target_qubit2,
+    std::vector<control_qubit_type> const& unpermutated_control_qubits)
   {
+    auto const target_qubit1 = permutated(unpermutated_target_qubit1);
+    auto const target_qubit2 = permutated(unpermutated_target_qubit2);
+    auto const control_qubits = permutated(unpermutated_control_qubits);
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 0u);
 
     switch (num_control_qubits)
     {
      case 1u:
-      ket::gate::ranges::adj_exponential_swap(parallel_policy_, data_, phase, target_qubit1, target_qubit2, control_qubits[0u]);
+      ket::gate::ranges::adj_exponential_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), phase, target_qubit1, target_qubit2, control_qubits[0u]);
       break;
 
      case 2u:
-      ket::gate::ranges::adj_exponential_swap(parallel_policy_, data_, phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u]);
+      ket::gate::ranges::adj_exponential_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u]);
       break;
 
      case 3u:
-      ket::gate::ranges::adj_exponential_swap(parallel_policy_, data_, phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
+      ket::gate::ranges::adj_exponential_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u]);
       break;
 
      case 4u:
-      ket::gate::ranges::adj_exponential_swap(parallel_policy_, data_, phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
+      ket::gate::ranges::adj_exponential_swap(parallel_policy_, nonzero_data(target_qubit1, target_qubit2, control_qubits), phase, target_qubit1, target_qubit2, control_qubits[0u], control_qubits[1u], control_qubits[2u], control_qubits[3u]);
       break;
 
      default:
       throw bra::too_many_qubits_error{num_control_qubits + 2u};
     }
   }
+
+  void nompi_state::do_unitary_matrix(std::vector<complex_type> const& matrix, std::vector<qubit_type> const& unpermutated_qubits)
+  {
+    auto const qubits = permutated(unpermutated_qubits);
+    assert(not qubits.empty());
+    assert(matrix.size() == (std::size_t{1u} << (qubits.size() + qubits.size())));
+    ket::gate::ranges::unitary_matrix(parallel_policy_, nonzero_data(qubits), std::begin(matrix), qubits);
+  }
+
+  void nompi_state::do_blocked_unitary_matrices(
+    std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& unpermutated_qubits_list,
+    bit_integer_type const num_block_qubits)
+  {
+    assert(matrices.size() == unpermutated_qubits_list.size());
+
+    // SWAP gates around blocked gates only permutate qubits, so the layout is materialized here:
+    // each permutated qubit not in a block is moved to an unused permutated qubit in the block
+    auto const num_lower_qubits = std::min(num_block_qubits, total_num_qubits_);
+    auto is_used = std::vector<bool>(total_num_qubits_, false);
+    for (auto const& unpermutated_qubits: unpermutated_qubits_list)
+      for (auto const unpermutated_qubit: unpermutated_qubits)
+        is_used[static_cast<bit_integer_type>(permutated(unpermutated_qubit))] = true;
+
+    auto lower_bit = bit_integer_type{0u};
+    for (auto upper_bit = num_lower_qubits; upper_bit < total_num_qubits_; ++upper_bit)
+    {
+      if (not is_used[upper_bit])
+        continue;
+
+      while (lower_bit < num_lower_qubits and is_used[lower_bit])
+        ++lower_bit;
+      if (lower_bit == num_lower_qubits)
+        throw bra::too_many_qubits_error{num_block_qubits + 1u};
+
+      auto const upper_qubit = ket::make_qubit<state_integer_type>(upper_bit);
+      auto const lower_qubit = ket::make_qubit<state_integer_type>(lower_bit);
+      ket::gate::ranges::swap(parallel_policy_, nonzero_data(upper_qubit, lower_qubit), upper_qubit, lower_qubit);
+      ket::mpi::permutate(
+        permutation_,
+        ket::mpi::inverse(permutation_)[ket::mpi::make_permutated(upper_qubit)],
+        ket::mpi::inverse(permutation_)[ket::mpi::make_permutated(lower_qubit)]);
+      is_used[lower_bit] = true;
+    }
+
+    auto const qubits_list = permutated(unpermutated_qubits_list);
+
+    auto& data = nonzero_data(qubits_list);
+    auto const num_qubits = ket::utility::integer_log2<bit_integer_type>(boost::size(data));
+    auto const block_size = ket::utility::integer_exp2<state_integer_type>(std::min(num_block_qubits, num_qubits));
+    auto const num_blocks = static_cast<state_integer_type>(boost::size(data)) / block_size;
+    auto const num_matrices = matrices.size();
+
+    // each thread should have its own blocks
+    if (num_blocks < static_cast<state_integer_type>(ket::utility::num_threads(parallel_policy_)))
+    {
+      for (auto index = std::size_t{0u}; index < num_matrices; ++index)
+        ket::gate::ranges::unitary_matrix(parallel_policy_, data, std::begin(matrices[index]), qubits_list[index]);
+      return;
+    }
+
+    auto const first = std::begin(data);
+    using ket::utility::loop_n;
+    loop_n(
+      parallel_policy_, num_blocks,
+      [first, block_size, num_matrices, &matrices, &qubits_list](state_integer_type const block_index, int const)
+      {
+        auto const block_first = first + block_index * block_size;
+        for (auto index = std::size_t{0u}; index < num_matrices; ++index)
+          ket::gate::unitary_matrix(block_first, block_first + block_size, std::begin(matrices[index]), qubits_list[index]);
+      });
+  }
+
+  void nompi_state::do_quadratic_phase_shift(
+    complex_type const& global_phase_coefficient,
+    std::vector<std::pair<qubit_type, complex_type>> const& unpermutated_linear_phase_coefficients,
+    std::vector<std::tuple<qubit_type, qubit_type, complex_type>> const& unpermutated_quadratic_phase_coefficients)
+  {
+    auto linear_phase_coefficients = unpermutated_linear_phase_coefficients;
+    auto num_qubits = bit_integer_type{0u};
+    for (auto& qubit_coefficient: linear_phase_coefficients)
+    {
+      qubit_coefficient.first = permutated(qubit_coefficient.first);
+      num_qubits = std::max(num_qubits, num_operated_qubits(qubit_coefficient.first));
+    }
+
+    auto quadratic_phase_coefficients = unpermutated_quadratic_phase_coefficients;
+    for (auto& qubits_coefficient: quadratic_phase_coefficients)
+    {
+      std::get<0u>(qubits_coefficient) = permutated(std::get<0u>(qubits_coefficient));
+      std::get<1u>(qubits_coefficient) = permutated(std::get<1u>(qubits_coefficient));
+      num_qubits
+        = std::max({num_qubits, num_operated_qubits(std::get<0u>(qubits_coefficient)), num_operated_qubits(std::get<1u>(qubits_coefficient))});
+    }
+
+    ket::gate::ranges::quadratic_phase_shift_coeff(
+      parallel_policy_, expand_nonzero_data(num_qubits),
+      global_phase_coefficient, linear_phase_coefficients, quadratic_phase_coefficients);
+  }
 } // namespace bra
 
 
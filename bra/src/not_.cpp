@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -32,5 +33,12 @@ namespace bra
         << std::setw(parameter_width) << qubit_;
       return repr_stream.str();
     }
+
+    bool not_::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix = {complex_type{0}, complex_type{1}, complex_type{1}, complex_type{0}};
+      qubits = {qubit_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
@@ -1,5 +1,10 @@
 #ifndef BRA_NO_MPI
+# include <cstddef>
+# include <cassert>
 # include <vector>
+# include <array>
+# include <iterator>
+# include <chrono>
 
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
@@ -22,13 +27,24 @@
 # include <ket/mpi/gate/projective_measurement.hpp>
 # include <ket/mpi/gate/clear.hpp>
 # include <ket/mpi/gate/set.hpp>
+# include <ket/mpi/gate/unitary_matrix.hpp>
+# include <ket/mpi/permutated.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/utility/detail/swap_permutated_local_qubits.hpp>
 # include <ket/mpi/all_spin_expectation_values.hpp>
 # include <ket/mpi/measure.hpp>
 # include <ket/mpi/generate_events.hpp>
 # include <ket/mpi/shor_box.hpp>
+# include <ket/mpi/swapped_fourier_transform.hpp>
+# include <ket/mpi/addition_assignment.hpp>
+# include <ket/mpi/subtraction_assignment.hpp>
+# include <ket/mpi/constant_addition_assignment.hpp>
+# include <ket/mpi/modular_multiplication_assignment.hpp>
+# include <ket/mpi/modular_exponentiation_assignment.hpp>
 
 # include <bra/paged_simple_mpi_state.hpp>
 # include <bra/state.hpp>
+# include <bra/utility/call_with_qubit_array.hpp>
 
 
 namespace bra
@@ -39,6 +55,9 @@ namespace bra
   unsigned int paged_simple_mpi_state::do_num_pages() const
   { return data_.num_pages(); }
 
+  ::bra::state::permutated_qubit_type paged_simple_mpi_state::least_global_permutated_qubit() const
+  { return permutated_qubit_type{ket::mpi::utility::policy::num_local_qubits(mpi_policy_, data_, communicator_, environment_)}; }
+
   paged_simple_mpi_state::paged_simple_mpi_state(
     ::bra::state::state_integer_type const initial_integer,
     unsigned int const num_local_qubits,
@@ -73,6 +92,23 @@ namespace bra
         permutation_, communicator, environment}
   { }
 
+  void paged_simple_mpi_state::do_loop_chunk_size(std::size_t const chunk_size)
+  { parallel_policy_.chunk_size(chunk_size); }
+
+  void paged_simple_mpi_state::do_record_busy_times()
+  { parallel_policy_.record_busy_times(); }
+
+  std::vector<double> paged_simple_mpi_state::do_busy_times() const
+  {
+    auto result = std::vector<double>{};
+    if (parallel_policy_.busy_times() == nullptr)
+      return result;
+
+    for (auto const& busy_time: parallel_policy_.busy_times()->durations())
+      result.push_back(std::chrono::duration<double>(busy_time).count());
+    return result;
+  }
+
   void paged_simple_mpi_state::do_hadamard(qubit_type const qubit)
   {
     ket::mpi::gate::hadamard(
@@ -89,6 +125,9 @@ namespace bra
 
   void paged_simple_mpi_state::do_not_(qubit_type const qubit)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), qubit, {}))
+      return;
+
     ket::mpi::gate::not_(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, qubit);
@@ -96,6 +135,9 @@ namespace bra
 
   void paged_simple_mpi_state::do_adj_not_(qubit_type const qubit)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), qubit, {}))
+      return;
+
     ket::mpi::gate::adj_not_(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, qubit);
@@ -103,6 +145,9 @@ namespace bra
 
   void paged_simple_mpi_state::do_pauli_x(qubit_type const qubit)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), qubit, {}))
+      return;
+
     ket::mpi::gate::pauli_x(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, qubit);
@@ -110,6 +155,9 @@ namespace bra
 
   void paged_simple_mpi_state::do_adj_pauli_x(qubit_type const qubit)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), qubit, {}))
+      return;
+
     ket::mpi::gate::adj_pauli_x(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, qubit);
@@ -403,6 +451,9 @@ namespace bra
 
   void paged_simple_mpi_state::do_swap(qubit_type const qubit1, qubit_type const qubit2)
   {
+    if (maybe_permutate_qubits(qubit1, qubit2))
+      return;
+
     ket::mpi::gate::swap(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, qubit1, qubit2);
@@ -410,6 +461,9 @@ namespace bra
 
   void paged_simple_mpi_state::do_adj_swap(qubit_type const qubit1, qubit_type const qubit2)
   {
+    if (maybe_permutate_qubits(qubit1, qubit2))
+      return;
+
     ket::mpi::gate::adj_swap(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, qubit1, qubit2);
@@ -857,6 +911,9 @@ namespace bra
     qubit_type const target_qubit,
     control_qubit_type const control_qubit1, control_qubit_type const control_qubit2)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), target_qubit, {control_qubit1, control_qubit2}))
+      return;
+
     ket::mpi::gate::toffoli(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, target_qubit, control_qubit1, control_qubit2);
@@ -866,6 +923,9 @@ namespace bra
     qubit_type const target_qubit,
     control_qubit_type const control_qubit1, control_qubit_type const control_qubit2)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), target_qubit, {control_qubit1, control_qubit2}))
+      return;
+
     ket::mpi::gate::adj_toffoli(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, target_qubit, control_qubit1, control_qubit2);
@@ -899,12 +959,12 @@ namespace bra
   {
     if (seed < 0)
       ket::mpi::generate_events(
-        mpi_policy_, ket::utility::policy::make_sequential(), // parallel_policy_,
+        mpi_policy_, parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, permutation_,
         communicator_, environment_);
     else
       ket::mpi::generate_events(
-        mpi_policy_, ket::utility::policy::make_sequential(), // parallel_policy_,
+        mpi_policy_, parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, static_cast<seed_type>(seed), permutation_,
         communicator_, environment_);
   }
@@ -920,6 +980,88 @@ namespace bra
       permutation_, communicator_, environment_);
   }
 
+  void paged_simple_mpi_state::do_swapped_fourier_transform(std::vector<qubit_type> const& qubits)
+  {
+    ket::mpi::swapped_fourier_transform(
+      mpi_policy_, parallel_policy_,
+      data_, qubits, permutation_, buffer_, communicator_, environment_);
+  }
+
+  void paged_simple_mpi_state::do_adj_swapped_fourier_transform(std::vector<qubit_type> const& qubits)
+  {
+    ket::mpi::adj_swapped_fourier_transform(
+      mpi_policy_, parallel_policy_,
+      data_, qubits, permutation_, buffer_, communicator_, environment_);
+  }
+
+  void paged_simple_mpi_state::do_addition_assignment(
+    std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits)
+  {
+    bra::utility::call_with_qubit_array(
+      lhs_qubits,
+      [this, &rhs_qubits](auto const& lhs_qubit_array)
+      {
+        ket::mpi::addition_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, lhs_qubit_array, std::vector<std::vector<qubit_type>>{rhs_qubits},
+          permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
+  void paged_simple_mpi_state::do_subtraction_assignment(
+    std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits)
+  {
+    bra::utility::call_with_qubit_array(
+      lhs_qubits,
+      [this, &rhs_qubits](auto const& lhs_qubit_array)
+      {
+        ket::mpi::subtraction_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, lhs_qubit_array, std::vector<std::vector<qubit_type>>{rhs_qubits},
+          permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
+  void paged_simple_mpi_state::do_constant_addition_assignment(
+    std::vector<qubit_type> const& qubits, state_integer_type const constant)
+  {
+    bra::utility::call_with_qubit_array(
+      qubits,
+      [this, constant](auto const& qubit_array)
+      {
+        ket::mpi::constant_addition_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, qubit_array, constant, permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
+  void paged_simple_mpi_state::do_modular_multiplication_assignment(
+    std::vector<qubit_type> const& qubits, state_integer_type const multiplier, state_integer_type const divisor)
+  {
+    bra::utility::call_with_qubit_array(
+      qubits,
+      [this, multiplier, divisor](auto const& qubit_array)
+      {
+        ket::mpi::modular_multiplication_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, qubit_array, multiplier, divisor, permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
+  void paged_simple_mpi_state::do_modular_exponentiation_assignment(
+    std::vector<qubit_type> const& exponent_qubits, std::vector<qubit_type> const& qubits,
+    state_integer_type const base, state_integer_type const divisor)
+  {
+    bra::utility::call_with_qubit_array(
+      qubits,
+      [this, &exponent_qubits, base, divisor](auto const& qubit_array)
+      {
+        ket::mpi::modular_exponentiation_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, exponent_qubits, qubit_array, base, divisor, permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
   void paged_simple_mpi_state::do_clear(qubit_type const qubit)
   {
     ket::mpi::gate::clear(
@@ -1027,6 +1169,9 @@ namespace bra
   void paged_simple_mpi_state::do_controlled_not(
     qubit_type const target_qubit, control_qubit_type const control_qubit)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), target_qubit, {control_qubit}))
+      return;
+
     ket::mpi::gate::not_(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, target_qubit, control_qubit);
@@ -1035,6 +1180,9 @@ namespace bra
   void paged_simple_mpi_state::do_adj_controlled_not(
     qubit_type const target_qubit, control_qubit_type const control_qubit)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), target_qubit, {control_qubit}))
+      return;
+
     ket::mpi::gate::adj_not_(
       mpi_policy_, parallel_policy_,
       data_, permutation_, buffer_, communicator_, environment_, target_qubit, control_qubit);
@@ -1043,6 +1191,9 @@ namespace bra
   void paged_simple_mpi_state::do_multi_controlled_not(
     qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), target_qubit, control_qubits))
+      return;
+
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
@@ -1080,6 +1231,9 @@ namespace bra
   void paged_simple_mpi_state::do_adj_multi_controlled_not(
     qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
   {
+    if (maybe_relabel_processes(least_global_permutated_qubit(), target_qubit, control_qubits))
+      return;
+
     auto const num_control_qubits = control_qubits.size();
     assert(num_control_qubits > 1u);
 
@@ -3677,6 +3831,121 @@ namespace bra
       throw bra::too_many_qubits_error{num_control_qubits + 2u};
     }
   }
+
+  void paged_simple_mpi_state::do_unitary_matrix(std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits)
+  {
+    auto const num_qubits = qubits.size();
+    assert(num_qubits > 0u);
+    assert(matrix.size() == (std::size_t{1u} << (num_qubits + num_qubits)));
+
+    switch (num_qubits)
+    {
+     case 1u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u]);
+      break;
+
+     case 2u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u]);
+      break;
+
+     case 3u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u], qubits[2u]);
+      break;
+
+     case 4u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      break;
+
+     case 5u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      break;
+
+     case 6u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      break;
+
+     default:
+      throw bra::too_many_qubits_error{num_qubits};
+    }
+  }
+
+  void paged_simple_mpi_state::do_interchange_qubits(std::vector<qubit_type> const& global_qubits, std::vector<qubit_type> const& local_qubits)
+  {
+    auto const num_qubits = global_qubits.size();
+    assert(local_qubits.size() == num_qubits);
+
+    // the plan may be out of date if some gates have interchanged qubits in other ways
+    auto const least_global_permutated_qubit
+      = permutated_qubit_type{ket::mpi::utility::policy::num_local_qubits(mpi_policy_, data_, communicator_, environment_)};
+    for (auto index = std::size_t{0u}; index < num_qubits; ++index)
+      if (permutation_[global_qubits[index]] < least_global_permutated_qubit
+          or permutation_[local_qubits[index]] >= least_global_permutated_qubit)
+        return;
+
+    // ket::mpi::utility::maybe_interchange_qubits exchanges the index-th global qubit with the local qubit at
+    // least_global_permutated_qubit - (index + 1), so local_qubits are moved there in advance
+    auto const num_data_blocks
+      = static_cast<state_integer_type>(ket::mpi::utility::policy::num_data_blocks(mpi_policy_, communicator_, environment_));
+    auto const data_block_size
+      = static_cast<state_integer_type>(ket::mpi::utility::policy::data_block_size(mpi_policy_, data_, communicator_, environment_));
+    for (auto index = std::size_t{0u}; index < num_qubits; ++index)
+    {
+      auto const permutated_swap_qubit = least_global_permutated_qubit - static_cast<bit_integer_type>(index + 1u);
+      auto const permutated_local_qubit = permutation_[local_qubits[index]];
+      if (permutated_local_qubit == permutated_swap_qubit)
+        continue;
+
+      ket::mpi::utility::detail::swap_permutated_local_qubits(
+        parallel_policy_, data_, permutated_local_qubit, permutated_swap_qubit,
+        num_data_blocks, data_block_size, communicator_, environment_);
+      using ket::mpi::inverse;
+      using ket::mpi::permutate;
+      permutate(permutation_, local_qubits[index], inverse(permutation_)[permutated_swap_qubit]);
+    }
+
+    switch (num_qubits)
+    {
+     case 1u:
+      ket::mpi::utility::maybe_interchange_qubits(
+        mpi_policy_, parallel_policy_, data_, std::array<qubit_type, 1u>{global_qubits[0u]},
+        permutation_, buffer_, communicator_, environment_);
+      break;
+
+     case 2u:
+      ket::mpi::utility::maybe_interchange_qubits(
+        mpi_policy_, parallel_policy_, data_, std::array<qubit_type, 2u>{global_qubits[0u], global_qubits[1u]},
+        permutation_, buffer_, communicator_, environment_);
+      break;
+
+     case 3u:
+      ket::mpi::utility::maybe_interchange_qubits(
+        mpi_policy_, parallel_policy_, data_, std::array<qubit_type, 3u>{global_qubits[0u], global_qubits[1u], global_qubits[2u]},
+        permutation_, buffer_, communicator_, environment_);
+      break;
+
+     case 4u:
+      ket::mpi::utility::maybe_interchange_qubits(
+        mpi_policy_, parallel_policy_, data_,
+        std::array<qubit_type, 4u>{global_qubits[0u], global_qubits[1u], global_qubits[2u], global_qubits[3u]},
+        permutation_, buffer_, communicator_, environment_);
+      break;
+
+     default:
+      throw bra::too_many_qubits_error{num_qubits};
+    }
+  }
 } // namespace bra
 
 
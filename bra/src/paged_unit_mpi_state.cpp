@@ -1,5 +1,9 @@
 #ifndef BRA_NO_MPI
+# include <cstddef>
+# include <cassert>
 # include <vector>
+# include <iterator>
+# include <chrono>
 
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
@@ -23,13 +27,21 @@
 # include <ket/mpi/gate/projective_measurement.hpp>
 # include <ket/mpi/gate/clear.hpp>
 # include <ket/mpi/gate/set.hpp>
+# include <ket/mpi/gate/unitary_matrix.hpp>
 # include <ket/mpi/all_spin_expectation_values.hpp>
 # include <ket/mpi/measure.hpp>
 # include <ket/mpi/generate_events.hpp>
 # include <ket/mpi/shor_box.hpp>
+# include <ket/mpi/swapped_fourier_transform.hpp>
+# include <ket/mpi/addition_assignment.hpp>
+# include <ket/mpi/subtraction_assignment.hpp>
+# include <ket/mpi/constant_addition_assignment.hpp>
+# include <ket/mpi/modular_multiplication_assignment.hpp>
+# include <ket/mpi/modular_exponentiation_assignment.hpp>
 
 # include <bra/paged_unit_mpi_state.hpp>
 # include <bra/state.hpp>
+# include <bra/utility/call_with_qubit_array.hpp>
 
 
 namespace bra
@@ -78,6 +90,23 @@ namespace bra
         permutation_, communicator, environment}
   { }
 
+  void paged_unit_mpi_state::do_loop_chunk_size(std::size_t const chunk_size)
+  { parallel_policy_.chunk_size(chunk_size); }
+
+  void paged_unit_mpi_state::do_record_busy_times()
+  { parallel_policy_.record_busy_times(); }
+
+  std::vector<double> paged_unit_mpi_state::do_busy_times() const
+  {
+    auto result = std::vector<double>{};
+    if (parallel_policy_.busy_times() == nullptr)
+      return result;
+
+    for (auto const& busy_time: parallel_policy_.busy_times()->durations())
+      result.push_back(std::chrono::duration<double>(busy_time).count());
+    return result;
+  }
+
   void paged_unit_mpi_state::do_hadamard(qubit_type const qubit)
   {
     ket::mpi::gate::hadamard(
@@ -904,12 +933,12 @@ namespace bra
   {
     if (seed < 0)
       ket::mpi::generate_events(
-        mpi_policy_, ket::utility::policy::make_sequential(), // parallel_policy_,
+        mpi_policy_, parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, permutation_,
         communicator_, environment_);
     else
       ket::mpi::generate_events(
-        mpi_policy_, ket::utility::policy::make_sequential(), // parallel_policy_,
+        mpi_policy_, parallel_policy_,
         generated_events_, data_, num_events, random_number_generator_, static_cast<seed_type>(seed), permutation_,
         communicator_, environment_);
   }
@@ -925,6 +954,88 @@ namespace bra
       permutation_, communicator_, environment_);
   }
 
+  void paged_unit_mpi_state::do_swapped_fourier_transform(std::vector<qubit_type> const& qubits)
+  {
+    ket::mpi::swapped_fourier_transform(
+      mpi_policy_, parallel_policy_,
+      data_, qubits, permutation_, buffer_, communicator_, environment_);
+  }
+
+  void paged_unit_mpi_state::do_adj_swapped_fourier_transform(std::vector<qubit_type> const& qubits)
+  {
+    ket::mpi::adj_swapped_fourier_transform(
+      mpi_policy_, parallel_policy_,
+      data_, qubits, permutation_, buffer_, communicator_, environment_);
+  }
+
+  void paged_unit_mpi_state::do_addition_assignment(
+    std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits)
+  {
+    bra::utility::call_with_qubit_array(
+      lhs_qubits,
+      [this, &rhs_qubits](auto const& lhs_qubit_array)
+      {
+        ket::mpi::addition_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, lhs_qubit_array, std::vector<std::vector<qubit_type>>{rhs_qubits},
+          permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
+  void paged_unit_mpi_state::do_subtraction_assignment(
+    std::vector<qubit_type> const& lhs_qubits, std::vector<qubit_type> const& rhs_qubits)
+  {
+    bra::utility::call_with_qubit_array(
+      lhs_qubits,
+      [this, &rhs_qubits](auto const& lhs_qubit_array)
+      {
+        ket::mpi::subtraction_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, lhs_qubit_array, std::vector<std::vector<qubit_type>>{rhs_qubits},
+          permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
+  void paged_unit_mpi_state::do_constant_addition_assignment(
+    std::vector<qubit_type> const& qubits, state_integer_type const constant)
+  {
+    bra::utility::call_with_qubit_array(
+      qubits,
+      [this, constant](auto const& qubit_array)
+      {
+        ket::mpi::constant_addition_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, qubit_array, constant, permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
+  void paged_unit_mpi_state::do_modular_multiplication_assignment(
+    std::vector<qubit_type> const& qubits, state_integer_type const multiplier, state_integer_type const divisor)
+  {
+    bra::utility::call_with_qubit_array(
+      qubits,
+      [this, multiplier, divisor](auto const& qubit_array)
+      {
+        ket::mpi::modular_multiplication_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, qubit_array, multiplier, divisor, permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
+  void paged_unit_mpi_state::do_modular_exponentiation_assignment(
+    std::vector<qubit_type> const& exponent_qubits, std::vector<qubit_type> const& qubits,
+    state_integer_type const base, state_integer_type const divisor)
+  {
+    bra::utility::call_with_qubit_array(
+      qubits,
+      [this, &exponent_qubits, base, divisor](auto const& qubit_array)
+      {
+        ket::mpi::modular_exponentiation_assignment(
+          mpi_policy_, parallel_policy_,
+          data_, exponent_qubits, qubit_array, base, divisor, permutation_, buffer_, communicator_, environment_);
+      });
+  }
+
   void paged_unit_mpi_state::do_clear(qubit_type const qubit)
   {
     ket::mpi::gate::clear(
@@ -3682,6 +3793,55 @@ namespace bra
       throw bra::too_many_qubits_error{num_control_qubits + 2u};
     }
   }
+
+  void paged_unit_mpi_state::do_unitary_matrix(std::vector<complex_type> const& matrix, std::vector<qubit_type> const& qubits)
+  {
+    auto const num_qubits = qubits.size();
+    assert(num_qubits > 0u);
+    assert(matrix.size() == (std::size_t{1u} << (num_qubits + num_qubits)));
+
+    switch (num_qubits)
+    {
+     case 1u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u]);
+      break;
+
+     case 2u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u]);
+      break;
+
+     case 3u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u], qubits[2u]);
+      break;
+
+     case 4u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u], qubits[2u], qubits[3u]);
+      break;
+
+     case 5u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u]);
+      break;
+
+     case 6u:
+      ket::mpi::gate::unitary_matrix(
+        mpi_policy_, parallel_policy_,
+        data_, permutation_, buffer_, communicator_, environment_, std::begin(matrix), qubits[0u], qubits[1u], qubits[2u], qubits[3u], qubits[4u], qubits[5u]);
+      break;
+
+     default:
+      throw bra::too_many_qubits_error{num_qubits};
+    }
+  }
 } // namespace bra
 
 
@@ -1,9 +1,11 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
 
 #include <ket/qubit_io.hpp>
+#include <ket/utility/imaginary_unit.hpp>
 
 #include <bra/gate/gate.hpp>
 #include <bra/gate/pauli_y.hpp>
@@ -32,5 +34,12 @@ namespace bra
         << std::setw(parameter_width) << qubit_;
       return repr_stream.str();
     }
+
+    bool pauli_y::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix = {complex_type{0}, -::ket::utility::imaginary_unit<complex_type>(), ::ket::utility::imaginary_unit<complex_type>(), complex_type{0}};
+      qubits = {qubit_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -35,5 +36,12 @@ namespace bra
         << std::setw(parameter_width) << phase_exponent_;
       return repr_stream.str();
     }
+
+    bool phase_shift::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix = {complex_type{1}, complex_type{0}, complex_type{0}, phase_coefficient_};
+      qubits = {qubit_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
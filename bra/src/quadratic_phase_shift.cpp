@@ -0,0 +1,50 @@
+#include <cstddef>
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/quadratic_phase_shift.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const quadratic_phase_shift::name_ = "DIAGONAL";
+
+    quadratic_phase_shift::quadratic_phase_shift(
+      complex_type const& global_phase_coefficient,
+      std::vector<std::pair<qubit_type, complex_type>>&& linear_phase_coefficients,
+      std::vector<std::tuple<qubit_type, qubit_type, complex_type>>&& quadratic_phase_coefficients,
+      std::size_t const num_accumulated_gates)
+      : ::bra::gate::gate{},
+        global_phase_coefficient_{global_phase_coefficient},
+        linear_phase_coefficients_{std::move(linear_phase_coefficients)},
+        quadratic_phase_coefficients_{std::move(quadratic_phase_coefficients)},
+        num_accumulated_gates_{num_accumulated_gates}
+    { }
+
+    ::bra::state& quadratic_phase_shift::do_apply(::bra::state& state) const
+    { return state.quadratic_phase_shift(global_phase_coefficient_, linear_phase_coefficients_, quadratic_phase_coefficients_); }
+
+    std::string const& quadratic_phase_shift::do_name() const { return name_; }
+    std::string quadratic_phase_shift::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit_coefficient: linear_phase_coefficients_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit_coefficient.first;
+      for (auto&& qubits_coefficient: quadratic_phase_coefficients_)
+        repr_stream << ' ' << std::get<0u>(qubits_coefficient) << '-' << std::get<1u>(qubits_coefficient);
+      repr_stream << " (" << num_accumulated_gates_ << " gates)";
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
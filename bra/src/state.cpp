@@ -1,6 +1,11 @@
+#include <cstddef>
+#include <cassert>
 #include <vector>
+#include <tuple>
+#include <utility>
 #include <random>
 #include <iterator>
+#include <algorithm>
 #ifdef BRA_NO_MPI
 # include <chrono>
 # include <memory>
@@ -8,6 +13,7 @@
 #include <stdexcept>
 
 #ifndef BRA_NO_MPI
+# include <yampi/rank.hpp>
 # include <yampi/communicator.hpp>
 # include <yampi/environment.hpp>
 # include <yampi/wall_clock.hpp>
@@ -15,6 +21,9 @@
 #endif // BRA_NO_MPI
 
 #include <ket/qubit.hpp>
+#ifndef BRA_NO_MPI
+# include <ket/mpi/qubit_permutation.hpp>
+#endif // BRA_NO_MPI
 
 #include <bra/state.hpp>
 #include <bra/utility/closest_floating_point_of.hpp>
@@ -33,6 +42,20 @@ namespace bra
   { }
 
 #ifndef BRA_NO_MPI
+  namespace state_detail
+  {
+    inline std::vector<yampi::rank> identity_ranks(
+      yampi::communicator const& communicator, yampi::environment const& environment)
+    {
+      auto const num_processes = communicator.size(environment);
+      auto result = std::vector<yampi::rank>{};
+      result.reserve(num_processes);
+      for (auto rank = 0; rank < num_processes; ++rank)
+        result.push_back(yampi::rank{rank});
+      return result;
+    }
+  } // namespace state_detail
+
   state::state(
     bit_integer_type const total_num_qubits,
     seed_type const seed,
@@ -47,8 +70,10 @@ namespace bra
       permutation_{static_cast<permutation_type::size_type>(total_num_qubits)},
       buffer_{},
       real_pair_datatype_{yampi::predefined_datatype<real_type>(), yampi::count{2}, environment},
-      communicator_{communicator},
+      communicator_{communicator, yampi::color{0}, communicator.rank(environment).mpi_rank(), environment},
       environment_{environment},
+      relabeled_ranks_{::bra::state_detail::identity_ranks(communicator, environment)},
+      absorbs_global_permutations_{false},
       finish_times_and_processes_{}
   { finish_times_and_processes_.reserve(2u); }
 
@@ -67,8 +92,10 @@ namespace bra
       permutation_{static_cast<permutation_type::size_type>(total_num_qubits)},
       buffer_(num_elements_in_buffer),
       real_pair_datatype_{yampi::predefined_datatype<real_type>(), yampi::count{2}, environment},
-      communicator_{communicator},
+      communicator_{communicator, yampi::color{0}, communicator.rank(environment).mpi_rank(), environment},
       environment_{environment},
+      relabeled_ranks_{::bra::state_detail::identity_ranks(communicator, environment)},
+      absorbs_global_permutations_{false},
       finish_times_and_processes_{}
   { finish_times_and_processes_.reserve(2u); }
 
@@ -87,8 +114,10 @@ namespace bra
         std::begin(initial_permutation), std::end(initial_permutation)},
       buffer_{},
       real_pair_datatype_{yampi::predefined_datatype<real_type>(), yampi::count{2}, environment},
-      communicator_{communicator},
+      communicator_{communicator, yampi::color{0}, communicator.rank(environment).mpi_rank(), environment},
       environment_{environment},
+      relabeled_ranks_{::bra::state_detail::identity_ranks(communicator, environment)},
+      absorbs_global_permutations_{false},
       finish_times_and_processes_{}
   { finish_times_and_processes_.reserve(2u); }
 
@@ -108,8 +137,10 @@ namespace bra
         std::begin(initial_permutation), std::end(initial_permutation)},
       buffer_(num_elements_in_buffer),
       real_pair_datatype_{yampi::predefined_datatype<real_type>(), yampi::count{2}, environment},
-      communicator_{communicator},
+      communicator_{communicator, yampi::color{0}, communicator.rank(environment).mpi_rank(), environment},
       environment_{environment},
+      relabeled_ranks_{::bra::state_detail::identity_ranks(communicator, environment)},
+      absorbs_global_permutations_{false},
       finish_times_and_processes_{}
   { finish_times_and_processes_.reserve(2u); }
 #else // BRA_NO_MPI
@@ -128,7 +159,7 @@ namespace bra
   ::bra::state& state::projective_measurement(qubit_type const qubit, yampi::rank const root)
   {
     last_outcomes_[static_cast<bit_integer_type>(qubit)]
-      = do_projective_measurement(qubit, root);
+      = do_projective_measurement(qubit, relabeled_ranks_[root.mpi_rank()]);
     return *this;
   }
 
@@ -138,7 +169,7 @@ namespace bra
       std::make_pair(
         BRA_clock::now(environment_), ::bra::finished_process::operations));
 
-    do_expectation_values(root);
+    do_expectation_values(relabeled_ranks_[root.mpi_rank()]);
     finish_times_and_processes_.push_back(
       std::make_pair(
         BRA_clock::now(environment_), ::bra::finished_process::begin_measurement));
@@ -152,7 +183,7 @@ namespace bra
       std::make_pair(
         BRA_clock::now(environment_), ::bra::finished_process::operations));
 
-    do_generate_events(root, num_events, seed);
+    do_generate_events(relabeled_ranks_[root.mpi_rank()], num_events, seed);
     finish_times_and_processes_.push_back(
       std::make_pair(
         BRA_clock::now(environment_), ::bra::finished_process::generate_events));
@@ -166,13 +197,55 @@ namespace bra
       std::make_pair(
         BRA_clock::now(environment_), ::bra::finished_process::operations));
 
-    do_measure(root);
+    do_measure(relabeled_ranks_[root.mpi_rank()]);
     finish_times_and_processes_.push_back(
       std::make_pair(
         BRA_clock::now(environment_), ::bra::finished_process::ket_measure));
 
     return *this;
   }
+
+  bool state::maybe_relabel_processes(
+    permutated_qubit_type const least_global_permutated_qubit,
+    qubit_type const target_qubit, std::vector<control_qubit_type> const& control_qubits)
+  {
+    if (not absorbs_global_permutations_
+        or permutation_[target_qubit] < least_global_permutated_qubit
+        or std::any_of(
+             std::begin(control_qubits), std::end(control_qubits),
+             [this, least_global_permutated_qubit](control_qubit_type const control_qubit)
+             { return permutation_[control_qubit.qubit()] < least_global_permutated_qubit; }))
+      return false;
+
+    // The rank of a process is the value of global qubits of its amplitudes. After the gate, the amplitudes of the process of rank r
+    // should be in the process of rank relabel(r), so that the process of rank r is renumbered to relabel(r)
+    auto const num_local_qubits = static_cast<bit_integer_type>(least_global_permutated_qubit.qubit());
+    auto const rank_mask
+      = [this, num_local_qubits](qubit_type const qubit)
+        { return 1 << (static_cast<bit_integer_type>(permutation_[qubit].qubit()) - num_local_qubits); };
+    auto const target_mask = rank_mask(target_qubit);
+    auto control_mask = 0;
+    for (auto const control_qubit: control_qubits)
+      control_mask |= rank_mask(control_qubit.qubit());
+    auto const relabel
+      = [target_mask, control_mask](yampi::rank const rank)
+        { return (rank.mpi_rank() bitand control_mask) == control_mask ? rank.mpi_rank() xor target_mask : rank.mpi_rank(); };
+
+    communicator_ = yampi::communicator{communicator_, yampi::color{0}, relabel(communicator_.rank(environment_)), environment_};
+    for (auto& rank: relabeled_ranks_)
+      rank = yampi::rank{relabel(rank)};
+    return true;
+  }
+
+  bool state::maybe_permutate_qubits(qubit_type const qubit1, qubit_type const qubit2)
+  {
+    if (not absorbs_global_permutations_)
+      return false;
+
+    using ket::mpi::permutate;
+    permutate(permutation_, qubit1, qubit2);
+    return true;
+  }
 #else // BRA_NO_MPI
   ::bra::state& state::projective_measurement(qubit_type const qubit)
   {
@@ -241,6 +314,29 @@ namespace bra
     return *this;
   }
 
+  // The swapped Fourier transform leaves the order of qubits reversed, which is restored by swaps
+  ::bra::state& state::fourier_transform(std::vector<qubit_type> const& qubits)
+  {
+    do_swapped_fourier_transform(qubits);
+
+    auto const num_qubits = qubits.size();
+    for (auto index = decltype(num_qubits){0u}; index < num_qubits / 2u; ++index)
+      do_swap(qubits[index], qubits[num_qubits - index - 1u]);
+
+    return *this;
+  }
+
+  ::bra::state& state::adj_fourier_transform(std::vector<qubit_type> const& qubits)
+  {
+    auto const num_qubits = qubits.size();
+    for (auto index = decltype(num_qubits){0u}; index < num_qubits / 2u; ++index)
+      do_swap(qubits[index], qubits[num_qubits - index - 1u]);
+
+    do_adj_swapped_fourier_transform(qubits);
+
+    return *this;
+  }
+
   ::bra::state& state::depolarizing_channel(real_type const px, real_type const py, real_type const pz, int const seed)
   {
     using floating_point_type = typename ::bra::utility::closest_floating_point_of<real_type>::type;
@@ -274,6 +370,54 @@ namespace bra
 
     return *this;
   }
+
+  // applies the matrices one by one to the whole state if blocking is not supported
+  void state::do_blocked_unitary_matrices(
+    std::vector<std::vector<complex_type>> const& matrices, std::vector<std::vector<qubit_type>> const& qubits_list,
+    bit_integer_type const)
+  {
+    assert(matrices.size() == qubits_list.size());
+
+    auto const num_matrices = matrices.size();
+    for (auto index = std::size_t{0u}; index < num_matrices; ++index)
+      do_unitary_matrix(matrices[index], qubits_list[index]);
+  }
+
+  // applies each term as a diagonal matrix if the state has no one-pass implementation.
+  // The global phase is merged into the first term, or applied to qubit 0 if there are no terms
+  void state::do_quadratic_phase_shift(
+    complex_type const& global_phase_coefficient,
+    std::vector<std::pair<qubit_type, complex_type>> const& linear_phase_coefficients,
+    std::vector<std::tuple<qubit_type, qubit_type, complex_type>> const& quadratic_phase_coefficients)
+  {
+    auto first_coefficient = global_phase_coefficient;
+    for (auto const& qubit_coefficient: linear_phase_coefficients)
+    {
+      do_unitary_matrix(
+        {first_coefficient, complex_type{0}, complex_type{0}, first_coefficient * qubit_coefficient.second},
+        {qubit_coefficient.first});
+      first_coefficient = complex_type{1};
+    }
+
+    for (auto const& qubits_coefficient: quadratic_phase_coefficients)
+    {
+      do_unitary_matrix(
+        {first_coefficient, complex_type{0}, complex_type{0}, complex_type{0},
+         complex_type{0}, first_coefficient, complex_type{0}, complex_type{0},
+         complex_type{0}, complex_type{0}, first_coefficient, complex_type{0},
+         complex_type{0}, complex_type{0}, complex_type{0}, first_coefficient * std::get<2u>(qubits_coefficient)},
+        {std::get<0u>(qubits_coefficient), std::get<1u>(qubits_coefficient)});
+      first_coefficient = complex_type{1};
+    }
+
+    if (linear_phase_coefficients.empty() and quadratic_phase_coefficients.empty())
+      do_unitary_matrix(
+        {global_phase_coefficient, complex_type{0}, complex_type{0}, global_phase_coefficient},
+        {ket::make_qubit<state_integer_type>(bit_integer_type{0u})});
+  }
+
+  void state::do_interchange_qubits(std::vector<qubit_type> const&, std::vector<qubit_type> const&)
+  { }
 } // namespace bra
 
 
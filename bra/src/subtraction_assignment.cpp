@@ -0,0 +1,40 @@
+#include <ios>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <ket/qubit_io.hpp>
+
+#include <bra/gate/gate.hpp>
+#include <bra/gate/subtraction_assignment.hpp>
+#include <bra/state.hpp>
+
+
+namespace bra
+{
+  namespace gate
+  {
+    std::string const subtraction_assignment::name_ = "SUB";
+
+    subtraction_assignment::subtraction_assignment(
+      std::vector<qubit_type>&& lhs_qubits, std::vector<qubit_type>&& rhs_qubits)
+      : ::bra::gate::gate{}, lhs_qubits_{std::move(lhs_qubits)}, rhs_qubits_{std::move(rhs_qubits)}
+    { }
+
+    ::bra::state& subtraction_assignment::do_apply(::bra::state& state) const
+    { return state.subtraction_assignment(lhs_qubits_, rhs_qubits_); }
+
+    std::string const& subtraction_assignment::do_name() const { return name_; }
+    std::string subtraction_assignment::do_representation(
+      std::ostringstream& repr_stream, int const parameter_width) const
+    {
+      for (auto&& qubit: lhs_qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      for (auto&& qubit: rhs_qubits_)
+        repr_stream << std::right << std::setw(parameter_width) << qubit;
+      return repr_stream.str();
+    }
+  } // namespace gate
+} // namespace bra
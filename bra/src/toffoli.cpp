@@ -1,4 +1,5 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
@@ -37,5 +38,16 @@ namespace bra
         << std::setw(parameter_width) << target_qubit_;
       return repr_stream.str();
     }
+
+    bool toffoli::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      matrix.assign(64u, complex_type{0});
+      for (auto index = 0u; index < 6u; ++index)
+        matrix[index * 8u + index] = complex_type{1};
+      matrix[6u * 8u + 7u] = complex_type{1};
+      matrix[7u * 8u + 6u] = complex_type{1};
+      qubits = {target_qubit_, control_qubit1_.qubit(), control_qubit2_.qubit()};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
@@ -1,9 +1,13 @@
 #include <string>
+#include <vector>
 #include <ios>
 #include <iomanip>
 #include <sstream>
 
+#include <boost/math/constants/constants.hpp>
+
 #include <ket/qubit_io.hpp>
+#include <ket/utility/exp_i.hpp>
 
 #include <bra/gate/gate.hpp>
 #include <bra/gate/u2.hpp>
@@ -35,5 +39,18 @@ namespace bra
         << std::setw(parameter_width) << phase2_;
       return repr_stream.str();
     }
+
+    bool u2::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      using real_type = ::bra::state::real_type;
+      using boost::math::constants::one_div_root_two;
+      matrix = {
+        complex_type{one_div_root_two<real_type>()},
+        -one_div_root_two<real_type>() * ::ket::utility::exp_i<complex_type>(phase2_),
+        one_div_root_two<real_type>() * ::ket::utility::exp_i<complex_type>(phase1_),
+        one_div_root_two<real_type>() * ::ket::utility::exp_i<complex_type>(phase1_ + phase2_)};
+      qubits = {qubit_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
@@ -1,9 +1,12 @@
 #include <string>
+#include <vector>
+#include <cmath>
 #include <ios>
 #include <iomanip>
 #include <sstream>
 
 #include <ket/qubit_io.hpp>
+#include <ket/utility/exp_i.hpp>
 
 #include <bra/gate/gate.hpp>
 #include <bra/gate/u3.hpp>
@@ -36,5 +39,21 @@ namespace bra
         << std::setw(parameter_width) << phase3_;
       return repr_stream.str();
     }
+
+    bool u3::do_unitary_matrix(std::vector<complex_type>& matrix, std::vector<qubit_type>& qubits) const
+    {
+      using real_type = ::bra::state::real_type;
+      using std::cos;
+      using std::sin;
+      auto const cosine = cos(real_type{0.5} * phase1_);
+      auto const sine = sin(real_type{0.5} * phase1_);
+      matrix = {
+        complex_type{cosine},
+        -sine * ::ket::utility::exp_i<complex_type>(phase3_),
+        sine * ::ket::utility::exp_i<complex_type>(phase2_),
+        cosine * ::ket::utility::exp_i<complex_type>(phase2_ + phase3_)};
+      qubits = {qubit_};
+      return true;
+    }
   } // namespace gate
 } // namespace bra
@@ -7,52 +7,90 @@
 # include <iterator>
 # include <type_traits>
 
+# include <boost/range/size.hpp>
 # include <boost/range/value_type.hpp>
 
-# include <ket/control.hpp>
-# include <ket/swapped_fourier_transform.hpp>
-# include <ket/gate/controlled_phase_shift.hpp>
+# include <ket/qubit.hpp>
+# include <ket/register_permutation.hpp>
 # include <ket/meta/state_integer_of.hpp>
 # include <ket/meta/bit_integer_of.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
 # include <ket/utility/generate_phase_coefficients.hpp>
+# include <ket/utility/bit_gatherer.hpp>
 
 
 namespace ket
 {
-  // lhs += rhs
+  // lhs += rhs, where rhs is the sum of the values of registers in rhs_qubits_range, modulo 2^n for n lhs qubits.
+  // The kth qubit of a register is its kth bit. Addition is a permutation of basis states, so that each amplitude is moved once
+  // by ::ket::permutate_register instead of the Fourier transform and O(n^2) controlled phase shifts.
+  // phase_coefficients is only generated for compatibility with the implementation by the Fourier transform
   namespace addition_assignment_detail
   {
-    template <
-      typename ParallelPolicy,
-      typename RandomAccessIterator, typename Iterator1, typename Iterator2,
-      typename PhaseCoefficientsAllocator>
+    template <typename StateInteger>
+    class addition_mapping
+    {
+      StateInteger addend_;
+      StateInteger register_mask_;
+
+     public:
+      addition_mapping(StateInteger const addend, StateInteger const register_mask)
+        : addend_{addend bitand register_mask}, register_mask_{register_mask}
+      { }
+
+      StateInteger operator()(StateInteger const value) const
+      { return (value + addend_) bitand register_mask_; }
+    }; // class addition_mapping<StateInteger>
+
+    // returns the mapping of lhs for each qubit value, which subtracts rhs if is_subtraction is true
+    template <typename StateInteger, typename BitInteger>
+    class addition_mappings
+    {
+      std::vector< ::ket::utility::bit_gatherer<StateInteger, BitInteger> > rhs_gatherers_;
+      StateInteger register_mask_;
+      bool is_subtraction_;
+
+     public:
+      template <typename QubitsRange>
+      addition_mappings(BitInteger const num_lhs_qubits, QubitsRange const& rhs_qubits_range, bool const is_subtraction)
+        : rhs_gatherers_{},
+          register_mask_{::ket::utility::integer_exp2<StateInteger>(num_lhs_qubits) - StateInteger{1u}},
+          is_subtraction_{is_subtraction}
+      {
+        for (auto const& rhs_qubits: rhs_qubits_range)
+          rhs_gatherers_.push_back(::ket::utility::make_bit_gatherer(rhs_qubits));
+      }
+
+      ::ket::addition_assignment_detail::addition_mapping<StateInteger> operator()(StateInteger const qubit_value) const
+      {
+        auto addend = StateInteger{0u};
+        for (auto const& rhs_gatherer: rhs_gatherers_)
+          addend += rhs_gatherer(qubit_value);
+
+        if (is_subtraction_)
+          addend = StateInteger{0u} - addend;
+
+        return {addend, register_mask_};
+      }
+    }; // class addition_mappings<StateInteger, BitInteger>
+
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename Qubits, typename QubitsRange>
     inline void addition_assignment(
       ParallelPolicy const parallel_policy,
       RandomAccessIterator const first, RandomAccessIterator const last,
-      Iterator1 const& lhs_qubits_first, Iterator2 const& rhs_qubits_first,
-      std::size_t const num_qubits,
-      std::vector<
-        typename std::iterator_traits<RandomAccessIterator>::value_type,
-        PhaseCoefficientsAllocator>& phase_coefficients)
+      Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range, bool const is_subtraction)
     {
-      for (auto phase_exponent = std::size_t{1u};
-           phase_exponent <= num_qubits; ++phase_exponent)
-      {
-        auto const phase_coefficient = phase_coefficients[phase_exponent];
-
-        for (auto control_bit_index = std::size_t{0u};
-             control_bit_index <= num_qubits - phase_exponent; ++control_bit_index)
-        {
-          auto const target_bit_index
-            = control_bit_index + (phase_exponent - std::size_t{1u});
-
-          ::ket::gate::controlled_phase_shift_coeff(
-            parallel_policy,
-            first, last, phase_coefficient,
-            lhs_qubits_first[target_bit_index],
-            ::ket::make_control(rhs_qubits_first[control_bit_index]));
-        }
-      }
+      using qubit_type = typename boost::range_value<Qubits>::type;
+      using state_integer_type = typename ::ket::meta::state_integer_of<qubit_type>::type;
+      using bit_integer_type = typename ::ket::meta::bit_integer_of<qubit_type>::type;
+      static_assert(std::is_unsigned<state_integer_type>::value, "StateInteger should be unsigned");
+      static_assert(std::is_unsigned<bit_integer_type>::value, "BitInteger should be unsigned");
+
+      ::ket::permutate_register(
+        parallel_policy, first, last, lhs_qubits,
+        ::ket::addition_assignment_detail::addition_mappings<state_integer_type, bit_integer_type>{
+          static_cast<bit_integer_type>(boost::size(lhs_qubits)), rhs_qubits_range, is_subtraction});
     }
   } // namespace addition_assignment_detail
 
@@ -69,31 +107,9 @@ namespace ket
       typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
-    auto const num_qubits = std::distance(std::begin(lhs_qubits), std::end(rhs_qubits));
-    assert(
-      std::all_of(
-        std::begin(rhs_qubits_range), std::end(rhs_qubits_range),
-        [num_qubits](typename boost::range_value<QubitsRange const>::type const& rhs_qubits)
-        { return num_qubits == std::distance(std::begin(rhs_qubits), std::end(rhs_qubits)); }));
-
-    ::ket::utility::generate_phase_coefficients(phase_coefficients, num_qubits);
-
-    using qubit_type = typename boost::range_value<Qubits>::type;
-    static_assert(
-      std::is_unsigned<typename ::ket::meta::state_integer_of<qubit_type>::type>::value,
-      "StateInteger should be unsigned");
-    static_assert(
-      std::is_unsigned<typename ::ket::meta::bit_integer_of<qubit_type>::type>::value,
-      "BitInteger should be unsigned");
-
-    ::ket::swapped_fourier_transform(parallel_policy, first, last, lhs_qubits, phase_coefficients);
-
-    for (auto const& rhs_qubits: rhs_qubits_range)
-      ::ket::addition_assignment_detail::addition_assignment(
-        parallel_policy,
-        first, last, std::begin(lhs_qubits), std::begin(rhs_qubits), num_qubits, phase_coefficients);
-
-    ::ket::adj_swapped_fourier_transform(parallel_policy, first, last, lhs_qubits, phase_coefficients);
+    ::ket::utility::generate_phase_coefficients(phase_coefficients, boost::size(lhs_qubits));
+    ::ket::addition_assignment_detail::addition_assignment(
+      parallel_policy, first, last, lhs_qubits, rhs_qubits_range, false);
   }
 
   template <
@@ -125,14 +141,8 @@ namespace ket
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range)
   {
-    using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
-    auto phase_coefficients
-      = ::ket::utility::generate_phase_coefficients<complex_type>(
-          std::distance(std::begin(lhs_qubits), std::end(lhs_qubits)));
-
-    ::ket::addition_assignment(
-      parallel_policy,
-      first, last, lhs_qubits, rhs_qubits_range, phase_coefficients);
+    ::ket::addition_assignment_detail::addition_assignment(
+      parallel_policy, first, last, lhs_qubits, rhs_qubits_range, false);
   }
 
   template <
@@ -215,43 +225,6 @@ namespace ket
   } // namespace ranges
 
 
-  namespace addition_assignment_detail
-  {
-    template <
-      typename ParallelPolicy, typename RandomAccessIterator,
-      typename Iterator1, typename Iterator2,
-      typename PhaseCoefficientsAllocator>
-    inline void adj_addition_assignment(
-      ParallelPolicy const parallel_policy,
-      RandomAccessIterator const first, RandomAccessIterator const last,
-      Iterator1 const& lhs_qubits_first, Iterator2 const& rhs_qubits_first,
-      std::size_t const num_qubits,
-      std::vector<
-        typename boost::range_value<RandomAccessRange>::type,
-        PhaseCoefficientsAllocator>& phase_coefficients)
-    {
-      for (auto index = std::size_t{0u}; index < num_qubits; ++index)
-      {
-        auto const phase_exponent = num_qubits - index;
-        auto const phase_coefficient = phase_coefficients[phase_exponent];
-
-        for (auto control_bit_index = std::size_t{0u};
-             control_bit_index <= num_qubits - phase_exponent; ++control_bit_index)
-        {
-          auto const target_bit_index
-            = control_bit_index + (phase_exponent - std::size_t{1u});
-
-          ::ket::gate::adj_controlled_phase_shift_coeff(
-            parallel_policy,
-            first, last, phase_coefficient,
-            lhs_qubits_first[target_bit_index],
-            ::ket::make_control(rhs_qubits_first[control_bit_index]));
-        }
-      }
-    }
-  } // namespace addition_assignment_detail
-
-
   template <
     typename ParallelPolicy, typename RandomAccessIterator,
     typename Qubits, typename QubitsRange,
@@ -260,35 +233,13 @@ namespace ket
     ParallelPolicy const parallel_policy,
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range,
-    std::vector
-      typename boost::range_value<RandomAccessRange>::type,
+    std::vector<
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
-    auto const num_qubits = std::distance(std::begin(lhs_qubits), std::end(rhs_qubits));
-    assert(
-      std::all_of(
-        std::begin(rhs_qubits_range), std::end(rhs_qubits_range),
-        [num_qubits](typename boost::range_value<QubitsRange const>::type const& rhs_qubits)
-        { return num_qubits == std::distance(std::begin(rhs_qubits), std::end(rhs_qubits)); }));
-
-    ::ket::utility::generate_phase_coefficients(phase_coefficients, num_qubits);
-
-    using qubit_type = typename boost::range_value<Qubits>::type;
-    static_assert(
-      std::is_unsigned<typename ::ket::meta::state_integer_of<qubit_type>::type>::value,
-      "StateInteger should be unsigned");
-    static_assert(
-      std::is_unsigned<typename ::ket::meta::bit_integer_of<qubit_type>::type>::value,
-      "BitInteger should be unsigned");
-
-    ::ket::swapped_fourier_transform(parallel_policy, first, last, lhs_qubits, phase_coefficients);
-
-    for (auto const& rhs_qubits: rhs_qubits_range)
-      ::ket::addition_assignment_detail::adj_addition_assignment(
-        parallel_policy,
-        first, last, std::begin(lhs_qubits), std::begin(rhs_qubits), num_qubits, phase_coefficients);
-
-    ::ket::adj_swapped_fourier_transform(parallel_policy, first, last, lhs_qubits, phase_coefficients);
+    ::ket::utility::generate_phase_coefficients(phase_coefficients, boost::size(lhs_qubits));
+    ::ket::addition_assignment_detail::addition_assignment(
+      parallel_policy, first, last, lhs_qubits, rhs_qubits_range, true);
   }
 
   template <
@@ -301,8 +252,8 @@ namespace ket
   adj_addition_assignment(
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range,
-    std::vector
-      typename boost::range_value<RandomAccessRange>::type,
+    std::vector<
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
     ::ket::adj_addition_assignment(
@@ -321,14 +272,8 @@ namespace ket
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range)
   {
-    using complex_type = std::iterator_traits<RandomAccessIterator>::value_type;
-    auto phase_coefficients
-      = ::ket::utility::generate_phase_coefficients<complex_type>(
-          std::distance(std::begin(lhs_qubits), std::end(lhs_qubits)));
-
-    ::ket::adj_addition_assignment(
-      parallel_policy,
-      first, last, lhs_qubits, rhs_qubits_range, phase_coefficients);
+    ::ket::addition_assignment_detail::addition_assignment(
+      parallel_policy, first, last, lhs_qubits, rhs_qubits_range, true);
   }
 
   template <
@@ -352,7 +297,7 @@ namespace ket
     inline RandomAccessRange& adj_addition_assignment(
       ParallelPolicy const parallel_policy, RandomAccessRange& state,
       Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range,
-      std::vector
+      std::vector<
         typename boost::range_value<RandomAccessRange>::type,
         PhaseCoefficientsAllocator>& phase_coefficients)
     {
@@ -363,7 +308,9 @@ namespace ket
       return state;
     }
 
-    template <typename RandomAccessRange, typename Qubits, typename QubitsRange>
+    template <
+      typename RandomAccessRange, typename Qubits, typename QubitsRange,
+      typename PhaseCoefficientsAllocator>
     inline typename std::enable_if<
       not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessRange>::value,
       RandomAccessRange&>::type
@@ -5,20 +5,77 @@
 # include <vector>
 # include <array>
 # include <iterator>
+# include <algorithm>
+# include <memory>
+# include <type_traits>
 
 # include <boost/range/value_type.hpp>
+# include <boost/math/constants/constants.hpp>
 
-# include <ket/spin_expectation_value.hpp>
 # include <ket/meta/bit_integer_of.hpp>
+# include <ket/meta/state_integer_of.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/per_thread.hpp>
+# include <ket/utility/integer_exp2.hpp>
 # include <ket/utility/integer_log2.hpp>
-# ifndef NDEBUG
-#   include <ket/utility/integer_exp2.hpp>
-# endif
 # include <ket/utility/meta/real_of.hpp>
 
 
 namespace ket
 {
+  namespace all_spin_expectation_values_detail
+  {
+    // spins of all qubits are computed tile by tile. A tile consists of amplitudes whose indices differ only in
+    // num_block_qubits bits, and it is copied to a buffer of each thread. The first tile covers qubits 0, ..., num_block_qubits-1,
+    // and the other tiles cover qubits 0, ..., num_contiguous_qubits-1 and (num_block_qubits - num_contiguous_qubits) higher qubits,
+    // so that copied runs are at least 2^num_contiguous_qubits amplitudes long
+    constexpr auto num_block_qubits = 12u;
+    constexpr auto num_contiguous_qubits = 4u;
+
+    // spins[p] += spin of the qubit at the p-th bit in the tile for p = first_position, ..., last_position-1.
+    // Sums in a tile are short, so they are taken in (at least) double precision instead of long double
+    template <typename Complex, typename StateInteger, typename HdSpins>
+    inline void accumulate_tile_spins(
+      Complex const* const tile, StateInteger const tile_size,
+      unsigned int const first_position, unsigned int const last_position, HdSpins& spins)
+    {
+      auto const half_tile_size = tile_size >> 1u;
+      for (auto position = first_position; position < last_position; ++position)
+      {
+        auto const mask = StateInteger{1u} << position;
+        auto const lower_bits_mask = mask - StateInteger{1u};
+        using real_type = typename ::ket::utility::meta::real_of<Complex>::type;
+        using sum_type = typename std::common_type<real_type, double>::type;
+        auto real_part = sum_type{0};
+        auto imag_part = sum_type{0};
+        auto difference = sum_type{0};
+
+        for (auto index_wo_qubit = StateInteger{0u}; index_wo_qubit < half_tile_size; ++index_wo_qubit)
+        {
+          auto const zero_index = ((index_wo_qubit bitand compl lower_bits_mask) << 1u) bitor (index_wo_qubit bitand lower_bits_mask);
+
+          // conj(zero_value) * one_value is expanded to avoid the overhead of complex multiplication
+          auto const zero_value = tile[zero_index];
+          auto const one_value = tile[zero_index bitor mask];
+          using std::real;
+          using std::imag;
+          auto const zero_real = static_cast<sum_type>(real(zero_value));
+          auto const zero_imag = static_cast<sum_type>(imag(zero_value));
+          auto const one_real = static_cast<sum_type>(real(one_value));
+          auto const one_imag = static_cast<sum_type>(imag(one_value));
+
+          real_part += zero_real * one_real + zero_imag * one_imag;
+          imag_part += zero_real * one_imag - zero_imag * one_real;
+          difference += (zero_real * zero_real + zero_imag * zero_imag) - (one_real * one_real + one_imag * one_imag);
+        }
+
+        spins[position][0u] += static_cast<long double>(real_part);
+        spins[position][1u] += static_cast<long double>(imag_part);
+        spins[position][2u] += static_cast<long double>(difference);
+      }
+    }
+  } // namespace all_spin_expectation_values_detail
+
   template <typename Qubit, typename ParallelPolicy, typename RandomAccessIterator>
   inline
   std::vector<
@@ -30,21 +87,113 @@ namespace ket
     RandomAccessIterator const first, RandomAccessIterator const last)
   {
     using bit_integer_type = typename ::ket::meta::bit_integer_of<Qubit>::type;
-    auto const num_qubits = ::ket::utility::integer_log2<bit_integer_type>(last - first);
+    using state_integer_type = typename ::ket::meta::state_integer_of<Qubit>::type;
+    auto const num_qubits
+      = static_cast<unsigned int>(::ket::utility::integer_log2<bit_integer_type>(last - first));
     assert(
-      ::ket::utility::integer_exp2<bit_integer_type>(num_qubits)
-        == static_cast<bit_integer_type>(last - first));
+      ::ket::utility::integer_exp2<state_integer_type>(num_qubits)
+        == static_cast<state_integer_type>(last - first));
+
+    auto const num_block_qubits
+      = std::min(num_qubits, ::ket::all_spin_expectation_values_detail::num_block_qubits);
+    auto const num_contiguous_qubits
+      = std::min(num_block_qubits, ::ket::all_spin_expectation_values_detail::num_contiguous_qubits);
+    auto const num_higher_qubits_in_block = num_block_qubits - num_contiguous_qubits;
+    auto const tile_size = state_integer_type{1u} << num_block_qubits;
+    auto const run_size = state_integer_type{1u} << num_contiguous_qubits;
 
     using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+    auto const num_threads = static_cast<state_integer_type>(::ket::utility::num_threads(parallel_policy));
+    auto tiles = std::vector<complex_type>(num_threads * tile_size);
+
+    using hd_spin_type = std::array<long double, 3u>;
+    auto hd_spins_in_threads
+      = ::ket::utility::make_per_thread(parallel_policy, std::vector<hd_spin_type>(num_qubits, hd_spin_type{}));
+
+    // the higher qubits of a tile are lowest_qubit, ..., lowest_qubit+num_qubits_in_group-1
+    auto lowest_qubit = num_contiguous_qubits;
+    auto num_qubits_in_group = num_higher_qubits_in_block;
+    while (lowest_qubit < num_qubits)
+    {
+      num_qubits_in_group = std::min(num_qubits_in_group, num_qubits - lowest_qubit);
+      auto const num_tile_qubits = num_contiguous_qubits + num_qubits_in_group;
+      auto const first_position = lowest_qubit == num_contiguous_qubits ? 0u : num_contiguous_qubits;
+      auto const group_tile_size = state_integer_type{1u} << num_tile_qubits;
+      auto const group_num_runs = state_integer_type{1u} << num_qubits_in_group;
+      auto const middle_bits_mask
+        = (state_integer_type{1u} << (lowest_qubit - num_contiguous_qubits)) - state_integer_type{1u};
+
+      ::ket::utility::loop_n(
+        parallel_policy,
+        ::ket::utility::integer_exp2<state_integer_type>(num_qubits - num_tile_qubits),
+        [first, &tiles, &hd_spins_in_threads, tile_size, run_size, group_tile_size, group_num_runs, middle_bits_mask,
+         num_contiguous_qubits, lowest_qubit, num_qubits_in_group, num_tile_qubits, first_position](
+          state_integer_type const tile_index, int const thread_index)
+        {
+          auto const base_index
+            = ((tile_index bitand middle_bits_mask) << num_contiguous_qubits)
+              bitor ((tile_index bitand compl middle_bits_mask) << num_tile_qubits);
+
+          auto const tile_first = std::addressof(tiles[static_cast<state_integer_type>(thread_index) * tile_size]);
+          for (auto run = state_integer_type{0u}; run < group_num_runs; ++run)
+          {
+            auto const run_first = first + (base_index bitor (run << lowest_qubit));
+            std::copy(run_first, run_first + run_size, tile_first + run * run_size);
+          }
+
+          auto& hd_spins = hd_spins_in_threads[thread_index];
+          auto tile_spins = std::array<hd_spin_type, ::ket::all_spin_expectation_values_detail::num_block_qubits>{};
+          ::ket::all_spin_expectation_values_detail::accumulate_tile_spins(
+            static_cast<complex_type const*>(tile_first), group_tile_size, first_position, num_tile_qubits, tile_spins);
+
+          for (auto position = first_position; position < num_tile_qubits; ++position)
+          {
+            auto& hd_spin
+              = hd_spins[position < num_contiguous_qubits ? position : lowest_qubit + (position - num_contiguous_qubits)];
+            hd_spin[0u] += tile_spins[position][0u];
+            hd_spin[1u] += tile_spins[position][1u];
+            hd_spin[2u] += tile_spins[position][2u];
+          }
+        });
+
+      lowest_qubit += num_qubits_in_group;
+    }
+
+    if (num_qubits == num_contiguous_qubits and num_qubits > 0u)
+    {
+      // all qubits are in the contiguous part, so the loop above is not executed
+      auto tile_spins = std::array<hd_spin_type, ::ket::all_spin_expectation_values_detail::num_block_qubits>{};
+      std::copy(first, last, tiles.begin());
+      ::ket::all_spin_expectation_values_detail::accumulate_tile_spins(
+        static_cast<complex_type const*>(tiles.data()), tile_size, 0u, num_qubits, tile_spins);
+      std::copy(tile_spins.begin(), tile_spins.begin() + num_qubits, hd_spins_in_threads.front().begin());
+    }
+
+    auto const hd_spins
+      = hd_spins_in_threads.reduce(
+          std::vector<hd_spin_type>(num_qubits, hd_spin_type{}),
+          [](std::vector<hd_spin_type> accumulated_spins, std::vector<hd_spin_type> const& spins)
+          {
+            for (auto qubit = std::size_t{0u}; qubit < spins.size(); ++qubit)
+            {
+              accumulated_spins[qubit][0u] += spins[qubit][0u];
+              accumulated_spins[qubit][1u] += spins[qubit][1u];
+              accumulated_spins[qubit][2u] += spins[qubit][2u];
+            }
+            return accumulated_spins;
+          });
+
     using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
     using spin_type = std::array<real_type, 3u>;
     auto result = std::vector<spin_type>{};
     result.reserve(num_qubits);
 
-    auto const last_qubit = Qubit{num_qubits};
-    for (auto qubit = Qubit{bit_integer_type{0u}}; qubit < last_qubit; ++qubit)
+    using boost::math::constants::half;
+    for (auto const& hd_spin: hd_spins)
       result.push_back(
-        ::ket::spin_expectation_value(parallel_policy, first, last, qubit));
+        spin_type{
+          static_cast<real_type>(hd_spin[0u]), static_cast<real_type>(hd_spin[1u]),
+          static_cast<real_type>(hd_spin[2u]) * half<real_type>()});
 
     return result;
   }
@@ -0,0 +1,116 @@
+#ifndef KET_CONSTANT_ADDITION_ASSIGNMENT_HPP
+# define KET_CONSTANT_ADDITION_ASSIGNMENT_HPP
+
+# include <iterator>
+# include <type_traits>
+
+# include <boost/range/size.hpp>
+# include <boost/range/value_type.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/addition_assignment.hpp>
+# include <ket/register_permutation.hpp>
+# include <ket/meta/state_integer_of.hpp>
+# include <ket/meta/bit_integer_of.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+
+
+namespace ket
+{
+  // x += constant modulo 2^n for a register x of n qubits, whose kth qubit is its kth bit
+  namespace constant_addition_assignment_detail
+  {
+    template <typename StateInteger>
+    class constant_addition_mappings
+    {
+      ::ket::addition_assignment_detail::addition_mapping<StateInteger> mapping_;
+
+     public:
+      constant_addition_mappings(StateInteger const constant, StateInteger const register_mask)
+        : mapping_{constant, register_mask}
+      { }
+
+      ::ket::addition_assignment_detail::addition_mapping<StateInteger> operator()(StateInteger const) const
+      { return mapping_; }
+    }; // class constant_addition_mappings<StateInteger>
+
+    template <typename Qubits>
+    inline ::ket::constant_addition_assignment_detail::constant_addition_mappings<
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type>
+    make_constant_addition_mappings(
+      Qubits const& qubits,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const constant)
+    {
+      using qubit_type = typename boost::range_value<Qubits>::type;
+      using state_integer_type = typename ::ket::meta::state_integer_of<qubit_type>::type;
+      static_assert(std::is_unsigned<state_integer_type>::value, "StateInteger should be unsigned");
+      static_assert(
+        std::is_unsigned<typename ::ket::meta::bit_integer_of<qubit_type>::type>::value,
+        "BitInteger should be unsigned");
+
+      return {constant, ::ket::utility::integer_exp2<state_integer_type>(boost::size(qubits)) - state_integer_type{1u}};
+    }
+  } // namespace constant_addition_assignment_detail
+
+  template <typename ParallelPolicy, typename RandomAccessIterator, typename Qubits>
+  inline typename std::enable_if<
+    ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+    void>::type
+  constant_addition_assignment(
+    ParallelPolicy const parallel_policy,
+    RandomAccessIterator const first, RandomAccessIterator const last,
+    Qubits const& qubits,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const constant)
+  {
+    ::ket::permutate_register(
+      parallel_policy, first, last, qubits,
+      ::ket::constant_addition_assignment_detail::make_constant_addition_mappings(qubits, constant));
+  }
+
+  template <typename RandomAccessIterator, typename Qubits>
+  inline typename std::enable_if<
+    not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessIterator>::value,
+    void>::type
+  constant_addition_assignment(
+    RandomAccessIterator const first, RandomAccessIterator const last,
+    Qubits const& qubits,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const constant)
+  {
+    ::ket::constant_addition_assignment(
+      ::ket::utility::policy::make_sequential(), first, last, qubits, constant);
+  }
+
+
+  namespace ranges
+  {
+    template <typename ParallelPolicy, typename RandomAccessRange, typename Qubits>
+    inline typename std::enable_if<
+      ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+      RandomAccessRange&>::type
+    constant_addition_assignment(
+      ParallelPolicy const parallel_policy, RandomAccessRange& state,
+      Qubits const& qubits,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const constant)
+    {
+      ::ket::constant_addition_assignment(
+        parallel_policy, std::begin(state), std::end(state), qubits, constant);
+      return state;
+    }
+
+    template <typename RandomAccessRange, typename Qubits>
+    inline typename std::enable_if<
+      not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessRange>::value,
+      RandomAccessRange&>::type
+    constant_addition_assignment(
+      RandomAccessRange& state, Qubits const& qubits,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const constant)
+    {
+      ::ket::constant_addition_assignment(std::begin(state), std::end(state), qubits, constant);
+      return state;
+    }
+  } // namespace ranges
+} // namespace ket
+
+
+#endif // KET_CONSTANT_ADDITION_ASSIGNMENT_HPP
@@ -3,9 +3,7 @@
 
 # include <cassert>
 # include <cmath>
-# include <vector>
 # include <iterator>
-# include <numeric>
 # include <utility>
 # include <type_traits>
 
@@ -14,6 +12,7 @@
 # include <ket/qubit.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
+# include <ket/utility/per_thread.hpp>
 # ifndef NDEBUG
 #   include <ket/utility/integer_log2.hpp>
 # endif
@@ -53,7 +52,7 @@ namespace ket
 
         using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
         using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-        auto zero_probabilities = std::vector<real_type>(::ket::utility::num_threads(parallel_policy), real_type{0});
+        auto zero_probabilities = ::ket::utility::make_per_thread(parallel_policy, real_type{0});
 
         using ::ket::utility::loop_n;
         loop_n(
@@ -76,7 +75,7 @@ namespace ket
 
         using std::pow;
         using boost::math::constants::half;
-        auto const multiplier = pow(std::accumulate(std::begin(zero_probabilities), std::end(zero_probabilities), real_type{0}), -half<real_type>());
+        auto const multiplier = pow(zero_probabilities.reduce(real_type{0}), -half<real_type>());
 
         loop_n(
           parallel_policy,
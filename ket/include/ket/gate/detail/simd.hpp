@@ -0,0 +1,364 @@
+#ifndef KET_GATE_DETAIL_SIMD_HPP
+# define KET_GATE_DETAIL_SIMD_HPP
+
+# include <complex>
+# include <iterator>
+# include <memory>
+# include <type_traits>
+# if defined(KET_USE_AVX2) || defined(KET_USE_AVX512)
+#   include <immintrin.h>
+# endif
+
+# include <ket/qubit.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+
+
+// Explicitly vectorized kernels of single-qubit gates for std::complex<double> state vectors.
+// They are enabled by defining KET_USE_AVX2 (requires -mavx2 -mfma) or KET_USE_AVX512 (requires -mavx512f),
+// and each function returns false if the kernel is not available for the given iterator.
+namespace ket
+{
+  namespace gate
+  {
+    namespace detail
+    {
+      namespace simd
+      {
+        // true if RandomAccessIterator points to a contiguous array of std::complex<double>
+        template <typename RandomAccessIterator>
+        struct is_vectorizable
+          : std::false_type
+        { };
+
+# if defined(KET_USE_AVX2) || defined(KET_USE_AVX512)
+        template <>
+        struct is_vectorizable<std::complex<double>*>
+          : std::true_type
+        { };
+
+#   ifdef __GLIBCXX__
+        // iterators of std::vector and std::basic_string in libstdc++
+        template <typename Container>
+        struct is_vectorizable< ::__gnu_cxx::__normal_iterator<std::complex<double>*, Container> >
+          : std::true_type
+        { };
+#   endif // __GLIBCXX__
+# endif // defined(KET_USE_AVX2) || defined(KET_USE_AVX512)
+
+        namespace dispatch
+        {
+          template <typename RandomAccessIterator, typename Enable = void>
+          struct single_qubit
+          {
+            template <typename ParallelPolicy, typename Complex, typename StateInteger, typename BitInteger>
+            static bool matrix(
+              ParallelPolicy const, RandomAccessIterator const, RandomAccessIterator const,
+              Complex const&, Complex const&, Complex const&, Complex const&,
+              ::ket::qubit<StateInteger, BitInteger> const)
+            { return false; }
+
+            template <typename ParallelPolicy, typename Complex, typename StateInteger, typename BitInteger>
+            static bool multiply_one(
+              ParallelPolicy const, RandomAccessIterator const, RandomAccessIterator const,
+              Complex const&, ::ket::qubit<StateInteger, BitInteger> const)
+            { return false; }
+          }; // struct single_qubit<RandomAccessIterator, Enable>
+
+# if defined(KET_USE_AVX512)
+          // one register holds four amplitudes. Pairs of amplitudes lie in one register if the qubit is 0 or 1
+          template <typename RandomAccessIterator>
+          struct single_qubit<RandomAccessIterator, typename std::enable_if< ::ket::gate::detail::simd::is_vectorizable<RandomAccessIterator>::value >::type>
+          {
+            // (a_r, a_i, ...) * (c_r, c_i, ...) lane by lane
+            static __m512d multiply(__m512d const value, __m512d const coefficient)
+            {
+              auto const coefficient_real = _mm512_unpacklo_pd(coefficient, coefficient);
+              auto const coefficient_imag = _mm512_unpackhi_pd(coefficient, coefficient);
+              return _mm512_fmaddsub_pd(value, coefficient_real, _mm512_mul_pd(_mm512_shuffle_pd(value, value, 0x55), coefficient_imag));
+            }
+
+            static __m512d broadcast(std::complex<double> const& value)
+            { return _mm512_setr_pd(value.real(), value.imag(), value.real(), value.imag(), value.real(), value.imag(), value.real(), value.imag()); }
+
+            static __m512d make_vector(
+              std::complex<double> const& value0, std::complex<double> const& value1,
+              std::complex<double> const& value2, std::complex<double> const& value3)
+            {
+              return _mm512_setr_pd(
+                value0.real(), value0.imag(), value1.real(), value1.imag(),
+                value2.real(), value2.imag(), value3.real(), value3.imag());
+            }
+
+            template <typename ParallelPolicy, typename StateInteger, typename BitInteger>
+            static bool matrix(
+              ParallelPolicy const parallel_policy,
+              RandomAccessIterator const first, RandomAccessIterator const last,
+              std::complex<double> const& m00, std::complex<double> const& m01,
+              std::complex<double> const& m10, std::complex<double> const& m11,
+              ::ket::qubit<StateInteger, BitInteger> const qubit)
+            {
+              auto const num_elements = static_cast<StateInteger>(last - first);
+              if (num_elements < StateInteger{4u})
+                return false;
+
+              auto const data = reinterpret_cast<double*>(std::addressof(*first));
+
+              using ::ket::utility::loop_n;
+              if (static_cast<BitInteger>(qubit) < BitInteger{2u})
+              {
+                // qubit 0: (a_0, a_1, a_2, a_3) => lower = (a_0, a_0, a_2, a_2), upper = (a_1, a_1, a_3, a_3)
+                // qubit 1: (a_0, a_1, a_2, a_3) => lower = (a_0, a_1, a_0, a_1), upper = (a_2, a_3, a_2, a_3)
+                auto const is_qubit0 = static_cast<BitInteger>(qubit) == BitInteger{0u};
+                auto const lower_coefficient = is_qubit0 ? make_vector(m00, m10, m00, m10) : make_vector(m00, m00, m10, m10);
+                auto const upper_coefficient = is_qubit0 ? make_vector(m01, m11, m01, m11) : make_vector(m01, m01, m11, m11);
+
+                loop_n(
+                  parallel_policy, num_elements >> 2u,
+                  [data, is_qubit0, lower_coefficient, upper_coefficient](StateInteger const index, int const)
+                  {
+                    auto const pointer = data + (index << 3u);
+                    auto const value = _mm512_loadu_pd(pointer);
+                    auto const lower = is_qubit0
+                      ? _mm512_shuffle_f64x2(value, value, _MM_SHUFFLE(2, 2, 0, 0))
+                      : _mm512_shuffle_f64x2(value, value, _MM_SHUFFLE(1, 0, 1, 0));
+                    auto const upper = is_qubit0
+                      ? _mm512_shuffle_f64x2(value, value, _MM_SHUFFLE(3, 3, 1, 1))
+                      : _mm512_shuffle_f64x2(value, value, _MM_SHUFFLE(3, 2, 3, 2));
+                    _mm512_storeu_pd(
+                      pointer, _mm512_add_pd(multiply(lower, lower_coefficient), multiply(upper, upper_coefficient)));
+                  });
+                return true;
+              }
+
+              auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
+              auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+              auto const upper_bits_mask = compl lower_bits_mask;
+              auto const coefficient00 = broadcast(m00);
+              auto const coefficient01 = broadcast(m01);
+              auto const coefficient10 = broadcast(m10);
+              auto const coefficient11 = broadcast(m11);
+
+              loop_n(
+                parallel_policy, num_elements >> 3u,
+                [data, qubit_mask, lower_bits_mask, upper_bits_mask, coefficient00, coefficient01, coefficient10, coefficient11](
+                  StateInteger const index, int const)
+                {
+                  auto const value_wo_qubit = index << 2u;
+                  // xxxxx0xxxx00
+                  auto const zero_index
+                    = ((value_wo_qubit bitand upper_bits_mask) << 1u) bitor (value_wo_qubit bitand lower_bits_mask);
+                  auto const zero_pointer = data + (zero_index << 1u);
+                  auto const one_pointer = data + ((zero_index bitor qubit_mask) << 1u);
+                  auto const zero_value = _mm512_loadu_pd(zero_pointer);
+                  auto const one_value = _mm512_loadu_pd(one_pointer);
+                  _mm512_storeu_pd(
+                    zero_pointer, _mm512_add_pd(multiply(zero_value, coefficient00), multiply(one_value, coefficient01)));
+                  _mm512_storeu_pd(
+                    one_pointer, _mm512_add_pd(multiply(zero_value, coefficient10), multiply(one_value, coefficient11)));
+                });
+              return true;
+            }
+
+            template <typename ParallelPolicy, typename StateInteger, typename BitInteger>
+            static bool multiply_one(
+              ParallelPolicy const parallel_policy,
+              RandomAccessIterator const first, RandomAccessIterator const last,
+              std::complex<double> const& coefficient, ::ket::qubit<StateInteger, BitInteger> const qubit)
+            {
+              auto const num_elements = static_cast<StateInteger>(last - first);
+              if (num_elements < StateInteger{4u})
+                return false;
+
+              auto const data = reinterpret_cast<double*>(std::addressof(*first));
+
+              using ::ket::utility::loop_n;
+              if (static_cast<BitInteger>(qubit) < BitInteger{2u})
+              {
+                auto const one = std::complex<double>{1.0};
+                auto const coefficients
+                  = static_cast<BitInteger>(qubit) == BitInteger{0u}
+                    ? make_vector(one, coefficient, one, coefficient)
+                    : make_vector(one, one, coefficient, coefficient);
+
+                loop_n(
+                  parallel_policy, num_elements >> 2u,
+                  [data, coefficients](StateInteger const index, int const)
+                  {
+                    auto const pointer = data + (index << 3u);
+                    _mm512_storeu_pd(pointer, multiply(_mm512_loadu_pd(pointer), coefficients));
+                  });
+                return true;
+              }
+
+              auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
+              auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+              auto const upper_bits_mask = compl lower_bits_mask;
+              auto const coefficients = broadcast(coefficient);
+
+              loop_n(
+                parallel_policy, num_elements >> 3u,
+                [data, qubit_mask, lower_bits_mask, upper_bits_mask, coefficients](StateInteger const index, int const)
+                {
+                  auto const value_wo_qubit = index << 2u;
+                  // xxxxx1xxxx00
+                  auto const one_index
+                    = ((value_wo_qubit bitand upper_bits_mask) << 1u) bitor (value_wo_qubit bitand lower_bits_mask) bitor qubit_mask;
+                  auto const pointer = data + (one_index << 1u);
+                  _mm512_storeu_pd(pointer, multiply(_mm512_loadu_pd(pointer), coefficients));
+                });
+              return true;
+            }
+          }; // struct single_qubit<RandomAccessIterator, typename std::enable_if<...>::type>
+# elif defined(KET_USE_AVX2)
+          // one register holds two amplitudes. Pairs of amplitudes lie in one register if the qubit is 0
+          template <typename RandomAccessIterator>
+          struct single_qubit<RandomAccessIterator, typename std::enable_if< ::ket::gate::detail::simd::is_vectorizable<RandomAccessIterator>::value >::type>
+          {
+            // (a_r, a_i, ...) * (c_r, c_i, ...) lane by lane
+            static __m256d multiply(__m256d const value, __m256d const coefficient)
+            {
+              auto const coefficient_real = _mm256_movedup_pd(coefficient);
+              auto const coefficient_imag = _mm256_permute_pd(coefficient, 0xF);
+              return _mm256_fmaddsub_pd(value, coefficient_real, _mm256_mul_pd(_mm256_permute_pd(value, 0x5), coefficient_imag));
+            }
+
+            static __m256d make_vector(std::complex<double> const& value0, std::complex<double> const& value1)
+            { return _mm256_setr_pd(value0.real(), value0.imag(), value1.real(), value1.imag()); }
+
+            template <typename ParallelPolicy, typename StateInteger, typename BitInteger>
+            static bool matrix(
+              ParallelPolicy const parallel_policy,
+              RandomAccessIterator const first, RandomAccessIterator const last,
+              std::complex<double> const& m00, std::complex<double> const& m01,
+              std::complex<double> const& m10, std::complex<double> const& m11,
+              ::ket::qubit<StateInteger, BitInteger> const qubit)
+            {
+              auto const num_elements = static_cast<StateInteger>(last - first);
+              auto const data = reinterpret_cast<double*>(std::addressof(*first));
+
+              using ::ket::utility::loop_n;
+              if (static_cast<BitInteger>(qubit) == BitInteger{0u})
+              {
+                // (a_0, a_1) => lower = (a_0, a_0), upper = (a_1, a_1)
+                auto const lower_coefficient = make_vector(m00, m10);
+                auto const upper_coefficient = make_vector(m01, m11);
+
+                loop_n(
+                  parallel_policy, num_elements >> 1u,
+                  [data, lower_coefficient, upper_coefficient](StateInteger const index, int const)
+                  {
+                    auto const pointer = data + (index << 2u);
+                    auto const value = _mm256_loadu_pd(pointer);
+                    auto const lower = _mm256_permute2f128_pd(value, value, 0x00);
+                    auto const upper = _mm256_permute2f128_pd(value, value, 0x11);
+                    _mm256_storeu_pd(
+                      pointer, _mm256_add_pd(multiply(lower, lower_coefficient), multiply(upper, upper_coefficient)));
+                  });
+                return true;
+              }
+
+              auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
+              auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+              auto const upper_bits_mask = compl lower_bits_mask;
+              auto const coefficient00 = make_vector(m00, m00);
+              auto const coefficient01 = make_vector(m01, m01);
+              auto const coefficient10 = make_vector(m10, m10);
+              auto const coefficient11 = make_vector(m11, m11);
+
+              loop_n(
+                parallel_policy, num_elements >> 2u,
+                [data, qubit_mask, lower_bits_mask, upper_bits_mask, coefficient00, coefficient01, coefficient10, coefficient11](
+                  StateInteger const index, int const)
+                {
+                  auto const value_wo_qubit = index << 1u;
+                  // xxxxx0xxxxx0
+                  auto const zero_index
+                    = ((value_wo_qubit bitand upper_bits_mask) << 1u) bitor (value_wo_qubit bitand lower_bits_mask);
+                  auto const zero_pointer = data + (zero_index << 1u);
+                  auto const one_pointer = data + ((zero_index bitor qubit_mask) << 1u);
+                  auto const zero_value = _mm256_loadu_pd(zero_pointer);
+                  auto const one_value = _mm256_loadu_pd(one_pointer);
+                  _mm256_storeu_pd(
+                    zero_pointer, _mm256_add_pd(multiply(zero_value, coefficient00), multiply(one_value, coefficient01)));
+                  _mm256_storeu_pd(
+                    one_pointer, _mm256_add_pd(multiply(zero_value, coefficient10), multiply(one_value, coefficient11)));
+                });
+              return true;
+            }
+
+            template <typename ParallelPolicy, typename StateInteger, typename BitInteger>
+            static bool multiply_one(
+              ParallelPolicy const parallel_policy,
+              RandomAccessIterator const first, RandomAccessIterator const last,
+              std::complex<double> const& coefficient, ::ket::qubit<StateInteger, BitInteger> const qubit)
+            {
+              auto const num_elements = static_cast<StateInteger>(last - first);
+              auto const data = reinterpret_cast<double*>(std::addressof(*first));
+
+              using ::ket::utility::loop_n;
+              if (static_cast<BitInteger>(qubit) == BitInteger{0u})
+              {
+                auto const coefficients = make_vector(std::complex<double>{1.0}, coefficient);
+
+                loop_n(
+                  parallel_policy, num_elements >> 1u,
+                  [data, coefficients](StateInteger const index, int const)
+                  {
+                    auto const pointer = data + (index << 2u);
+                    _mm256_storeu_pd(pointer, multiply(_mm256_loadu_pd(pointer), coefficients));
+                  });
+                return true;
+              }
+
+              auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
+              auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+              auto const upper_bits_mask = compl lower_bits_mask;
+              auto const coefficients = make_vector(coefficient, coefficient);
+
+              loop_n(
+                parallel_policy, num_elements >> 2u,
+                [data, qubit_mask, lower_bits_mask, upper_bits_mask, coefficients](StateInteger const index, int const)
+                {
+                  auto const value_wo_qubit = index << 1u;
+                  // xxxxx1xxxxx0
+                  auto const one_index
+                    = ((value_wo_qubit bitand upper_bits_mask) << 1u) bitor (value_wo_qubit bitand lower_bits_mask) bitor qubit_mask;
+                  auto const pointer = data + (one_index << 1u);
+                  _mm256_storeu_pd(pointer, multiply(_mm256_loadu_pd(pointer), coefficients));
+                });
+              return true;
+            }
+          }; // struct single_qubit<RandomAccessIterator, typename std::enable_if<...>::type>
+# endif // defined(KET_USE_AVX512)
+        } // namespace dispatch
+
+        // (a_0, a_1) => (m00 a_0 + m01 a_1, m10 a_0 + m11 a_1)
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename Complex, typename StateInteger, typename BitInteger>
+        inline bool matrix(
+          ParallelPolicy const parallel_policy,
+          RandomAccessIterator const first, RandomAccessIterator const last,
+          Complex const& m00, Complex const& m01, Complex const& m10, Complex const& m11,
+          ::ket::qubit<StateInteger, BitInteger> const qubit)
+        {
+          return ::ket::gate::detail::simd::dispatch::single_qubit<RandomAccessIterator>::matrix(
+            parallel_policy, first, last, m00, m01, m10, m11, qubit);
+        }
+
+        // (a_0, a_1) => (a_0, coefficient a_1)
+        template <typename ParallelPolicy, typename RandomAccessIterator, typename Complex, typename StateInteger, typename BitInteger>
+        inline bool multiply_one(
+          ParallelPolicy const parallel_policy,
+          RandomAccessIterator const first, RandomAccessIterator const last,
+          Complex const& coefficient, ::ket::qubit<StateInteger, BitInteger> const qubit)
+        {
+          return ::ket::gate::detail::simd::dispatch::single_qubit<RandomAccessIterator>::multiply_one(
+            parallel_policy, first, last, coefficient, qubit);
+        }
+      } // namespace simd
+    } // namespace detail
+  } // namespace gate
+} // namespace ket
+
+
+#endif // KET_GATE_DETAIL_SIMD_HPP
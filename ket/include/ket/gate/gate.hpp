@@ -141,13 +141,14 @@ namespace ket
       auto index_masks = std::array<state_integer_type, num_operated_qubits + 1u>{};
       ::ket::gate::gate_detail::make_index_masks(index_masks, std::forward<Qubit>(qubit), std::forward<Qubits>(qubits)...);
 
-      auto indices = std::array<state_integer_type, ::ket::utility::integer_exp2<std::size_t>(num_operated_qubits)>{};
       using ::ket::utility::loop_n;
       loop_n(
         parallel_policy,
         static_cast<state_integer_type>(last - first) >> num_operated_qubits,
-        [first, &function, &qubit_masks, &index_masks, &indices](state_integer_type const index_wo_qubits, int const thread_index)
+        [first, &function, &qubit_masks, &index_masks](state_integer_type const index_wo_qubits, int const thread_index)
         {
+          // indices is local to each call because loop_n may invoke this function concurrently
+          auto indices = std::array<state_integer_type, ::ket::utility::integer_exp2<std::size_t>(num_operated_qubits)>{};
           // ex. qubit_masks[0]=00000100000; qubit_masks[1]=00100000000; qubit_masks[2]=00000000100;
           // indices[0b000]=xx0xx0xx0xx; indices[0b001]=xx0xx1xx0xx; indices[0b010]=xx1xx0xx0xx; indices[0b011]=xx1xx1xx0xx;
           // indices[0b100]=xx0xx0xx1xx; indices[0b101]=xx0xx1xx1xx; indices[0b110]=xx1xx0xx1xx; indices[0b111]=xx1xx1xx1xx;
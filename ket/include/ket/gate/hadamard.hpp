@@ -13,6 +13,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
 # ifndef NDEBUG
@@ -40,6 +41,17 @@ namespace ket
         ::ket::utility::integer_exp2<StateInteger>(::ket::utility::integer_log2<BitInteger>(last - first))
         == static_cast<StateInteger>(last - first));
 
+# if defined(KET_USE_AVX2) || defined(KET_USE_AVX512)
+      {
+        using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+        using boost::math::constants::one_div_root_two;
+        auto const coefficient = complex_type{one_div_root_two<real_type>()};
+        if (::ket::gate::detail::simd::matrix(parallel_policy, first, last, coefficient, coefficient, coefficient, -coefficient, qubit))
+          return;
+      }
+# endif // defined(KET_USE_AVX2) || defined(KET_USE_AVX512)
+
       auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
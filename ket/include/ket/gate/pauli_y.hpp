@@ -11,6 +11,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/gate/meta/num_control_qubits.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
@@ -40,6 +41,16 @@ namespace ket
         ::ket::utility::integer_exp2<StateInteger>(::ket::utility::integer_log2<BitInteger>(last - first))
         == static_cast<StateInteger>(last - first));
 
+# if defined(KET_USE_AVX2) || defined(KET_USE_AVX512)
+      {
+        using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        auto const zero = complex_type{};
+        auto const imaginary_unit = ::ket::utility::imaginary_unit<complex_type>();
+        if (::ket::gate::detail::simd::matrix(parallel_policy, first, last, zero, -imaginary_unit, imaginary_unit, zero, qubit))
+          return;
+      }
+# endif // defined(KET_USE_AVX2) || defined(KET_USE_AVX512)
+
       auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
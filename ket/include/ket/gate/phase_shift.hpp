@@ -14,6 +14,7 @@
 # include <ket/qubit.hpp>
 # include <ket/control.hpp>
 # include <ket/gate/gate.hpp>
+# include <ket/gate/detail/simd.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
 # ifndef NDEBUG
@@ -48,6 +49,11 @@ namespace ket
         ::ket::utility::integer_exp2<StateInteger>(::ket::utility::integer_log2<BitInteger>(last - first))
         == static_cast<StateInteger>(last - first));
 
+# if defined(KET_USE_AVX2) || defined(KET_USE_AVX512)
+      if (::ket::gate::detail::simd::multiply_one(parallel_policy, first, last, phase_coefficient, qubit))
+        return;
+# endif // defined(KET_USE_AVX2) || defined(KET_USE_AVX512)
+
       auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(qubit);
       auto const lower_bits_mask = qubit_mask - StateInteger{1u};
       auto const upper_bits_mask = compl lower_bits_mask;
@@ -4,9 +4,7 @@
 # include <cassert>
 # include <cmath>
 # include <complex>
-# include <vector>
 # include <iterator>
-# include <numeric>
 # include <utility>
 # include <type_traits>
 
@@ -15,6 +13,7 @@
 # include <ket/qubit.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/integer_exp2.hpp>
+# include <ket/utility/per_thread.hpp>
 # ifndef NDEBUG
 #   include <ket/utility/integer_log2.hpp>
 # endif
@@ -48,8 +47,8 @@ namespace ket
         auto const lower_bits_mask = qubit_mask - StateInteger{1u};
         auto const upper_bits_mask = compl lower_bits_mask;
 
-        auto zero_probabilities = std::vector<long double>(::ket::utility::num_threads(parallel_policy), 0.0l);
-        auto one_probabilities = std::vector<long double>(::ket::utility::num_threads(parallel_policy), 0.0l);
+        auto zero_probabilities = ::ket::utility::make_per_thread(parallel_policy, 0.0l);
+        auto one_probabilities = ::ket::utility::make_per_thread(parallel_policy, 0.0l);
 
         using ::ket::utility::loop_n;
         loop_n(
@@ -74,8 +73,7 @@ namespace ket
         using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
         using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
         return std::make_pair(
-          static_cast<real_type>(std::accumulate(std::begin(zero_probabilities), std::end(zero_probabilities), 0.0l)),
-          static_cast<real_type>(std::accumulate(std::begin(one_probabilities), std::end(one_probabilities), 0.0l)));
+          static_cast<real_type>(zero_probabilities.reduce(0.0l)), static_cast<real_type>(one_probabilities.reduce(0.0l)));
       }
 
       template <
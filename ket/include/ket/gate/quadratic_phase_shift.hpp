@@ -0,0 +1,200 @@
+#ifndef KET_GATE_QUADRATIC_PHASE_SHIFT_HPP
+# define KET_GATE_QUADRATIC_PHASE_SHIFT_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <vector>
+# include <tuple>
+# include <utility>
+# include <algorithm>
+# include <iterator>
+# include <type_traits>
+
+# include <ket/qubit.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+# ifndef NDEBUG
+#   include <ket/utility/integer_log2.hpp>
+# endif
+
+
+namespace ket
+{
+  namespace gate
+  {
+    // quadratic_phase_shift_coeff
+    // QP(c, {a_i}, {b_ij}) |x> = c prod_i a_i^{x_i} prod_{ij} b_ij^{x_i x_j} |x>, where x_i is the value of qubit i.
+    // Any sequence of diagonal gates on at most two qubits is QP, and QP is applied in one pass over the state
+    namespace quadratic_phase_shift_detail
+    {
+      // qubits are divided into groups of consecutive qubits, and the product of coefficients of each group is tabulated
+      constexpr std::size_t max_num_grouped_qubits = 8u;
+    } // namespace quadratic_phase_shift_detail
+
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename Complex, typename StateInteger, typename BitInteger>
+    inline void quadratic_phase_shift_coeff(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      Complex const& global_phase_coefficient,
+      std::vector<std::pair< ::ket::qubit<StateInteger, BitInteger>, Complex >> const& linear_phase_coefficients,
+      std::vector<std::tuple< ::ket::qubit<StateInteger, BitInteger>, ::ket::qubit<StateInteger, BitInteger>, Complex >> const&
+        quadratic_phase_coefficients)
+    {
+      static_assert(std::is_unsigned<StateInteger>::value, "StateInteger should be unsigned");
+      static_assert(std::is_unsigned<BitInteger>::value, "BitInteger should be unsigned");
+      static_assert(
+        (std::is_same<Complex, typename std::iterator_traits<RandomAccessIterator>::value_type>::value),
+        "Complex must be the same to value_type of RandomAccessIterator");
+      assert(
+        ::ket::utility::integer_exp2<StateInteger>(::ket::utility::integer_log2<BitInteger>(last - first))
+        == static_cast<StateInteger>(last - first));
+
+      auto bits = std::vector<BitInteger>{};
+      bits.reserve(linear_phase_coefficients.size() + 2u * quadratic_phase_coefficients.size());
+      for (auto const& qubit_coefficient: linear_phase_coefficients)
+        bits.push_back(static_cast<BitInteger>(qubit_coefficient.first));
+      for (auto const& qubits_coefficient: quadratic_phase_coefficients)
+      {
+        assert(std::get<0u>(qubits_coefficient) != std::get<1u>(qubits_coefficient));
+        bits.push_back(static_cast<BitInteger>(std::get<0u>(qubits_coefficient)));
+        bits.push_back(static_cast<BitInteger>(std::get<1u>(qubits_coefficient)));
+      }
+      std::sort(std::begin(bits), std::end(bits));
+      bits.erase(std::unique(std::begin(bits), std::end(bits)), std::end(bits));
+      assert(bits.empty() or ::ket::utility::integer_exp2<StateInteger>(bits.back()) < static_cast<StateInteger>(last - first));
+
+      using ::ket::utility::loop_n;
+      if (bits.empty())
+      {
+        loop_n(
+          parallel_policy, static_cast<StateInteger>(last - first),
+          [first, &global_phase_coefficient](StateInteger const index, int const)
+          { *(first + index) *= global_phase_coefficient; });
+        return;
+      }
+
+      // tables[table_offsets[group] + v] is the product of coefficients of the group if the values of its qubits are v,
+      // where bits[max_num_grouped_qubits * group + k] is the kth bit of v
+      constexpr auto max_num_grouped_qubits = ::ket::gate::quadratic_phase_shift_detail::max_num_grouped_qubits;
+      auto const num_bits = bits.size();
+      auto const num_groups = (num_bits + max_num_grouped_qubits - 1u) / max_num_grouped_qubits;
+      auto table_offsets = std::vector<StateInteger>{};
+      table_offsets.reserve(num_groups + 1u);
+      table_offsets.push_back(StateInteger{0u});
+      for (auto group = std::size_t{0u}; group < num_groups; ++group)
+        table_offsets.push_back(
+          table_offsets.back()
+          + ::ket::utility::integer_exp2<StateInteger>(std::min(max_num_grouped_qubits, num_bits - group * max_num_grouped_qubits)));
+      auto tables = std::vector<Complex>(table_offsets.back(), Complex{1});
+      std::fill(std::begin(tables), std::next(std::begin(tables), table_offsets[1u]), global_phase_coefficient);
+
+      auto const position
+        = [&bits](BitInteger const bit)
+          { return static_cast<std::size_t>(std::lower_bound(std::begin(bits), std::end(bits), bit) - std::begin(bits)); };
+      for (auto const& qubit_coefficient: linear_phase_coefficients)
+      {
+        auto const bit_position = position(static_cast<BitInteger>(qubit_coefficient.first));
+        auto const group = bit_position / max_num_grouped_qubits;
+        auto const mask = ::ket::utility::integer_exp2<StateInteger>(bit_position % max_num_grouped_qubits);
+        for (auto value = StateInteger{0u}; value < table_offsets[group + 1u] - table_offsets[group]; ++value)
+          if ((value bitand mask) != StateInteger{0u})
+            tables[table_offsets[group] + value] *= qubit_coefficient.second;
+      }
+
+      // coefficients of pairs of qubits in different groups are multiplied if (index bitand mask) == mask
+      auto cross_group_masks = std::vector<StateInteger>{};
+      auto cross_group_coefficients = std::vector<Complex>{};
+      for (auto const& qubits_coefficient: quadratic_phase_coefficients)
+      {
+        auto const bit_position1 = position(static_cast<BitInteger>(std::get<0u>(qubits_coefficient)));
+        auto const bit_position2 = position(static_cast<BitInteger>(std::get<1u>(qubits_coefficient)));
+        auto const group = bit_position1 / max_num_grouped_qubits;
+        if (group != bit_position2 / max_num_grouped_qubits)
+        {
+          cross_group_masks.push_back(
+            ::ket::utility::integer_exp2<StateInteger>(std::get<0u>(qubits_coefficient))
+            bitor ::ket::utility::integer_exp2<StateInteger>(std::get<1u>(qubits_coefficient)));
+          cross_group_coefficients.push_back(std::get<2u>(qubits_coefficient));
+          continue;
+        }
+
+        auto const mask
+          = ::ket::utility::integer_exp2<StateInteger>(bit_position1 % max_num_grouped_qubits)
+            bitor ::ket::utility::integer_exp2<StateInteger>(bit_position2 % max_num_grouped_qubits);
+        for (auto value = StateInteger{0u}; value < table_offsets[group + 1u] - table_offsets[group]; ++value)
+          if ((value bitand mask) == mask)
+            tables[table_offsets[group] + value] *= std::get<2u>(qubits_coefficient);
+      }
+
+      auto const num_cross_group_coefficients = cross_group_coefficients.size();
+      loop_n(
+        parallel_policy, static_cast<StateInteger>(last - first),
+        [first, &bits, num_bits, &table_offsets, &tables, &cross_group_masks, &cross_group_coefficients, num_cross_group_coefficients](
+          StateInteger const index, int const)
+        {
+          auto coefficient = Complex{1};
+          auto group_first = std::size_t{0u};
+          for (auto group = std::size_t{0u}; group_first < num_bits; ++group, group_first += max_num_grouped_qubits)
+          {
+            auto const group_last = std::min(group_first + max_num_grouped_qubits, num_bits);
+            auto value = StateInteger{0u};
+            for (auto bit_position = group_first; bit_position < group_last; ++bit_position)
+              value |= ((index >> bits[bit_position]) bitand StateInteger{1u}) << (bit_position - group_first);
+            coefficient *= tables[table_offsets[group] + value];
+          }
+
+          for (auto term = std::size_t{0u}; term < num_cross_group_coefficients; ++term)
+            if ((index bitand cross_group_masks[term]) == cross_group_masks[term])
+              coefficient *= cross_group_coefficients[term];
+
+          *(first + index) *= coefficient;
+        });
+    }
+
+    template <typename RandomAccessIterator, typename Complex, typename StateInteger, typename BitInteger>
+    inline void quadratic_phase_shift_coeff(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      Complex const& global_phase_coefficient,
+      std::vector<std::pair< ::ket::qubit<StateInteger, BitInteger>, Complex >> const& linear_phase_coefficients,
+      std::vector<std::tuple< ::ket::qubit<StateInteger, BitInteger>, ::ket::qubit<StateInteger, BitInteger>, Complex >> const&
+        quadratic_phase_coefficients)
+    {
+      ::ket::gate::quadratic_phase_shift_coeff(
+        ::ket::utility::policy::make_sequential(), first, last,
+        global_phase_coefficient, linear_phase_coefficients, quadratic_phase_coefficients);
+    }
+
+    namespace ranges
+    {
+      template <typename ParallelPolicy, typename RandomAccessRange, typename Complex, typename StateInteger, typename BitInteger>
+      inline RandomAccessRange& quadratic_phase_shift_coeff(
+        ParallelPolicy const parallel_policy, RandomAccessRange& state,
+        Complex const& global_phase_coefficient,
+        std::vector<std::pair< ::ket::qubit<StateInteger, BitInteger>, Complex >> const& linear_phase_coefficients,
+        std::vector<std::tuple< ::ket::qubit<StateInteger, BitInteger>, ::ket::qubit<StateInteger, BitInteger>, Complex >> const&
+          quadratic_phase_coefficients)
+      {
+        ::ket::gate::quadratic_phase_shift_coeff(
+          parallel_policy, std::begin(state), std::end(state),
+          global_phase_coefficient, linear_phase_coefficients, quadratic_phase_coefficients);
+        return state;
+      }
+
+      template <typename RandomAccessRange, typename Complex, typename StateInteger, typename BitInteger>
+      inline RandomAccessRange& quadratic_phase_shift_coeff(
+        RandomAccessRange& state,
+        Complex const& global_phase_coefficient,
+        std::vector<std::pair< ::ket::qubit<StateInteger, BitInteger>, Complex >> const& linear_phase_coefficients,
+        std::vector<std::tuple< ::ket::qubit<StateInteger, BitInteger>, ::ket::qubit<StateInteger, BitInteger>, Complex >> const&
+          quadratic_phase_coefficients)
+      {
+        return ::ket::gate::ranges::quadratic_phase_shift_coeff(
+          ::ket::utility::policy::make_sequential(), state,
+          global_phase_coefficient, linear_phase_coefficients, quadratic_phase_coefficients);
+      }
+    } // namespace ranges
+  } // namespace gate
+} // namespace ket
+
+
+#endif // KET_GATE_QUADRATIC_PHASE_SHIFT_HPP
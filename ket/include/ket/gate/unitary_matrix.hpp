@@ -0,0 +1,504 @@
+#ifndef KET_GATE_UNITARY_MATRIX_HPP
+# define KET_GATE_UNITARY_MATRIX_HPP
+
+# include <cstddef>
+# include <cassert>
+# include <complex>
+# include <array>
+# include <vector>
+# include <iterator>
+# include <algorithm>
+# include <utility>
+# include <type_traits>
+
+# include <ket/qubit.hpp>
+# include <ket/control.hpp>
+# include <ket/gate/gate.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/per_thread.hpp>
+# include <ket/utility/integer_exp2.hpp>
+
+
+namespace ket
+{
+  namespace gate
+  {
+    // U_{i...j} (a_{0...0} |0...0> + ... + a_{1...1} |1...1>) = sum_{k,l} u_{kl} a_l |k>
+    //   matrix: row-major 2^n x 2^n matrix (u_{00}, u_{01}, ..., u_{2^n-1,2^n-1}). The 0th bit of k and l corresponds to qubit i
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename MatrixIterator, typename StateInteger, typename BitInteger, typename... Qubits>
+    inline void unitary_matrix(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+    {
+      static_assert(std::is_unsigned<StateInteger>::value, "StateInteger should be unsigned");
+      static_assert(std::is_unsigned<BitInteger>::value, "BitInteger should be unsigned");
+
+      constexpr auto num_indices = ::ket::utility::integer_exp2<std::size_t>(sizeof...(Qubits) + 1u);
+
+      ::ket::gate::gate(
+        parallel_policy, first, last,
+        [matrix_first](RandomAccessIterator const first, std::array<StateInteger, num_indices> const& indices, int const)
+        {
+          using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+          auto values = std::array<complex_type, num_indices>{};
+          for (auto i = std::size_t{0u}; i < num_indices; ++i)
+            values[i] = *(first + indices[i]);
+
+          for (auto i = std::size_t{0u}; i < num_indices; ++i)
+          {
+            auto const row_first = matrix_first + i * num_indices;
+            auto new_value = complex_type{};
+            for (auto j = std::size_t{0u}; j < num_indices; ++j)
+              new_value += *(row_first + j) * values[j];
+            *(first + indices[i]) = new_value;
+          }
+        },
+        qubit, qubits...);
+    }
+
+    template <typename RandomAccessIterator, typename MatrixIterator, typename StateInteger, typename BitInteger, typename... Qubits>
+    inline void unitary_matrix(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+    { ::ket::gate::unitary_matrix(::ket::utility::policy::make_sequential(), first, last, matrix_first, qubit, qubits...); }
+
+    namespace ranges
+    {
+      template <typename ParallelPolicy, typename RandomAccessRange, typename MatrixIterator, typename StateInteger, typename BitInteger, typename... Qubits>
+      inline RandomAccessRange& unitary_matrix(
+        ParallelPolicy const parallel_policy, RandomAccessRange& state,
+        MatrixIterator const matrix_first,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::gate::unitary_matrix(parallel_policy, std::begin(state), std::end(state), matrix_first, qubit, qubits...);
+        return state;
+      }
+
+      template <typename RandomAccessRange, typename MatrixIterator, typename StateInteger, typename BitInteger, typename... Qubits>
+      inline RandomAccessRange& unitary_matrix(
+        RandomAccessRange& state, MatrixIterator const matrix_first,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::gate::unitary_matrix(::ket::utility::policy::make_sequential(), std::begin(state), std::end(state), matrix_first, qubit, qubits...);
+        return state;
+      }
+    } // namespace ranges
+
+    // U+_{i...j} (a_{0...0} |0...0> + ... + a_{1...1} |1...1>) = sum_{k,l} u_{lk}^* a_l |k>
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename MatrixIterator, typename StateInteger, typename BitInteger, typename... Qubits>
+    inline void adj_unitary_matrix(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+    {
+      static_assert(std::is_unsigned<StateInteger>::value, "StateInteger should be unsigned");
+      static_assert(std::is_unsigned<BitInteger>::value, "BitInteger should be unsigned");
+
+      constexpr auto num_indices = ::ket::utility::integer_exp2<std::size_t>(sizeof...(Qubits) + 1u);
+
+      ::ket::gate::gate(
+        parallel_policy, first, last,
+        [matrix_first](RandomAccessIterator const first, std::array<StateInteger, num_indices> const& indices, int const)
+        {
+          using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+          auto values = std::array<complex_type, num_indices>{};
+          for (auto i = std::size_t{0u}; i < num_indices; ++i)
+            values[i] = *(first + indices[i]);
+
+          using std::conj;
+          for (auto i = std::size_t{0u}; i < num_indices; ++i)
+          {
+            auto new_value = complex_type{};
+            for (auto j = std::size_t{0u}; j < num_indices; ++j)
+              new_value += conj(*(matrix_first + j * num_indices + i)) * values[j];
+            *(first + indices[i]) = new_value;
+          }
+        },
+        qubit, qubits...);
+    }
+
+    template <typename RandomAccessIterator, typename MatrixIterator, typename StateInteger, typename BitInteger, typename... Qubits>
+    inline void adj_unitary_matrix(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+    { ::ket::gate::adj_unitary_matrix(::ket::utility::policy::make_sequential(), first, last, matrix_first, qubit, qubits...); }
+
+    namespace ranges
+    {
+      template <typename ParallelPolicy, typename RandomAccessRange, typename MatrixIterator, typename StateInteger, typename BitInteger, typename... Qubits>
+      inline RandomAccessRange& adj_unitary_matrix(
+        ParallelPolicy const parallel_policy, RandomAccessRange& state,
+        MatrixIterator const matrix_first,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::gate::adj_unitary_matrix(parallel_policy, std::begin(state), std::end(state), matrix_first, qubit, qubits...);
+        return state;
+      }
+
+      template <typename RandomAccessRange, typename MatrixIterator, typename StateInteger, typename BitInteger, typename... Qubits>
+      inline RandomAccessRange& adj_unitary_matrix(
+        RandomAccessRange& state, MatrixIterator const matrix_first,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::gate::adj_unitary_matrix(::ket::utility::policy::make_sequential(), std::begin(state), std::end(state), matrix_first, qubit, qubits...);
+        return state;
+      }
+    } // namespace ranges
+
+    namespace unitary_matrix_detail
+    {
+      template <bool is_adjoint>
+      struct matrix_element;
+
+      template <>
+      struct matrix_element<false>
+      {
+        template <typename MatrixIterator>
+        static typename std::iterator_traits<MatrixIterator>::value_type call(
+          MatrixIterator const matrix_first, std::size_t const dimension, std::size_t const row, std::size_t const column)
+        { return *(matrix_first + row * dimension + column); }
+      }; // struct matrix_element<false>
+
+      template <>
+      struct matrix_element<true>
+      {
+        template <typename MatrixIterator>
+        static typename std::iterator_traits<MatrixIterator>::value_type call(
+          MatrixIterator const matrix_first, std::size_t const dimension, std::size_t const row, std::size_t const column)
+        {
+          using std::conj;
+          return conj(*(matrix_first + column * dimension + row));
+        }
+      }; // struct matrix_element<true>
+
+      // applies the matrix onto the subspace of target qubits where all control qubits are 1
+      template <
+        bool is_adjoint, typename ParallelPolicy, typename RandomAccessIterator, typename MatrixIterator,
+        typename StateInteger, typename BitInteger, typename QubitAllocator, typename ControlQubitAllocator>
+      inline void generic_unitary_matrix(
+        ParallelPolicy const parallel_policy,
+        RandomAccessIterator const first, RandomAccessIterator const last,
+        MatrixIterator const matrix_first,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits,
+        std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> >, ControlQubitAllocator > const& control_qubits)
+      {
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto const num_target_qubits = static_cast<BitInteger>(target_qubits.size());
+        auto const num_operated_qubits = static_cast<BitInteger>(num_target_qubits + control_qubits.size());
+        auto const num_target_indices = ::ket::utility::integer_exp2<std::size_t>(num_target_qubits);
+
+        auto sorted_qubits = std::vector<qubit_type>{};
+        sorted_qubits.reserve(num_operated_qubits);
+        sorted_qubits.insert(sorted_qubits.end(), target_qubits.begin(), target_qubits.end());
+        auto control_mask = StateInteger{0u};
+        for (auto const& control_qubit: control_qubits)
+        {
+          sorted_qubits.push_back(control_qubit.qubit());
+          control_mask |= StateInteger{1u} << control_qubit.qubit();
+        }
+        std::sort(sorted_qubits.begin(), sorted_qubits.end());
+        assert(std::adjacent_find(sorted_qubits.begin(), sorted_qubits.end()) == sorted_qubits.end());
+
+        // target_offsets[0b01] = 00000100000, target_offsets[0b10] = 00100000000, target_offsets[0b11] = 00100100000, ...
+        auto target_offsets = std::vector<StateInteger>(num_target_indices);
+        for (auto i = std::size_t{0u}; i < num_target_indices; ++i)
+          for (auto target_index = BitInteger{0u}; target_index < num_target_qubits; ++target_index)
+            if (((i >> target_index) bitand std::size_t{1u}) == std::size_t{1u})
+              target_offsets[i] |= StateInteger{1u} << target_qubits[target_index];
+
+        using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        // each thread allocates its own buffer in its first iteration, so that buffers of different threads do not share cache lines
+        auto buffers = ::ket::utility::make_per_thread(parallel_policy, std::vector<complex_type>{});
+
+        using ::ket::utility::loop_n;
+        loop_n(
+          parallel_policy,
+          static_cast<StateInteger>(last - first) >> num_operated_qubits,
+          [first, matrix_first, num_target_indices, control_mask, &sorted_qubits, &target_offsets, &buffers](
+            StateInteger const index_wo_qubits, int const thread_index)
+          {
+            // xx0xx0xx0xx => xx1xx0xx1xx if the first and the third operated qubits are control qubits
+            auto base_index = index_wo_qubits;
+            for (auto const& qubit: sorted_qubits)
+            {
+              auto const lower_bits_mask = (StateInteger{1u} << qubit) - StateInteger{1u};
+              base_index = (base_index bitand lower_bits_mask) bitor ((base_index bitand compl lower_bits_mask) << 1u);
+            }
+            base_index |= control_mask;
+
+            auto& buffer = buffers[thread_index];
+            if (buffer.empty())
+              buffer.resize(num_target_indices);
+            auto const buffer_first = buffer.begin();
+            for (auto i = std::size_t{0u}; i < num_target_indices; ++i)
+              *(buffer_first + i) = *(first + (base_index bitor target_offsets[i]));
+
+            for (auto i = std::size_t{0u}; i < num_target_indices; ++i)
+            {
+              auto new_value = complex_type{};
+              for (auto j = std::size_t{0u}; j < num_target_indices; ++j)
+                new_value
+                  += ::ket::gate::unitary_matrix_detail::matrix_element<is_adjoint>::call(matrix_first, num_target_indices, i, j)
+                     * *(buffer_first + j);
+              *(first + (base_index bitor target_offsets[i])) = new_value;
+            }
+          });
+      }
+    } // namespace unitary_matrix_detail
+
+    // U_{ts...t's'} or C...CU_{ts...t's'c...c'} with runtime lists of qubits. The 0th bit of matrix indices corresponds to target_qubits[0]
+    template <
+      typename ParallelPolicy, typename RandomAccessIterator, typename MatrixIterator,
+      typename StateInteger, typename BitInteger, typename QubitAllocator, typename ControlQubitAllocator>
+    inline void unitary_matrix(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits,
+      std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> >, ControlQubitAllocator > const& control_qubits)
+    {
+      assert(not target_qubits.empty());
+
+      if (control_qubits.empty())
+        switch (target_qubits.size())
+        {
+         case 1u:
+          ::ket::gate::unitary_matrix(parallel_policy, first, last, matrix_first, target_qubits[0u]);
+          return;
+
+         case 2u:
+          ::ket::gate::unitary_matrix(parallel_policy, first, last, matrix_first, target_qubits[0u], target_qubits[1u]);
+          return;
+
+         case 3u:
+          ::ket::gate::unitary_matrix(parallel_policy, first, last, matrix_first, target_qubits[0u], target_qubits[1u], target_qubits[2u]);
+          return;
+
+         case 4u:
+          ::ket::gate::unitary_matrix(parallel_policy, first, last, matrix_first, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u]);
+          return;
+
+         default:
+          break;
+        }
+
+      ::ket::gate::unitary_matrix_detail::generic_unitary_matrix<false>(
+        parallel_policy, first, last, matrix_first, target_qubits, control_qubits);
+    }
+
+    template <
+      typename ParallelPolicy, typename RandomAccessIterator, typename MatrixIterator,
+      typename StateInteger, typename BitInteger, typename QubitAllocator>
+    inline void unitary_matrix(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits)
+    {
+      ::ket::gate::unitary_matrix(
+        parallel_policy, first, last, matrix_first, target_qubits,
+        std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> > >{});
+    }
+
+    template <
+      typename RandomAccessIterator, typename MatrixIterator,
+      typename StateInteger, typename BitInteger, typename QubitAllocator, typename ControlQubitAllocator>
+    inline void unitary_matrix(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits,
+      std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> >, ControlQubitAllocator > const& control_qubits)
+    { ::ket::gate::unitary_matrix(::ket::utility::policy::make_sequential(), first, last, matrix_first, target_qubits, control_qubits); }
+
+    template <
+      typename RandomAccessIterator, typename MatrixIterator,
+      typename StateInteger, typename BitInteger, typename QubitAllocator>
+    inline void unitary_matrix(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits)
+    { ::ket::gate::unitary_matrix(::ket::utility::policy::make_sequential(), first, last, matrix_first, target_qubits); }
+
+    namespace ranges
+    {
+      template <
+        typename ParallelPolicy, typename RandomAccessRange, typename MatrixIterator,
+        typename StateInteger, typename BitInteger, typename QubitAllocator, typename ControlQubitAllocator>
+      inline RandomAccessRange& unitary_matrix(
+        ParallelPolicy const parallel_policy, RandomAccessRange& state,
+        MatrixIterator const matrix_first,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits,
+        std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> >, ControlQubitAllocator > const& control_qubits)
+      {
+        ::ket::gate::unitary_matrix(parallel_policy, std::begin(state), std::end(state), matrix_first, target_qubits, control_qubits);
+        return state;
+      }
+
+      template <
+        typename ParallelPolicy, typename RandomAccessRange, typename MatrixIterator,
+        typename StateInteger, typename BitInteger, typename QubitAllocator>
+      inline RandomAccessRange& unitary_matrix(
+        ParallelPolicy const parallel_policy, RandomAccessRange& state,
+        MatrixIterator const matrix_first,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits)
+      {
+        ::ket::gate::unitary_matrix(parallel_policy, std::begin(state), std::end(state), matrix_first, target_qubits);
+        return state;
+      }
+
+      template <
+        typename RandomAccessRange, typename MatrixIterator,
+        typename StateInteger, typename BitInteger, typename QubitAllocator, typename ControlQubitAllocator>
+      inline RandomAccessRange& unitary_matrix(
+        RandomAccessRange& state, MatrixIterator const matrix_first,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits,
+        std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> >, ControlQubitAllocator > const& control_qubits)
+      {
+        ::ket::gate::unitary_matrix(::ket::utility::policy::make_sequential(), std::begin(state), std::end(state), matrix_first, target_qubits, control_qubits);
+        return state;
+      }
+
+      template <
+        typename RandomAccessRange, typename MatrixIterator,
+        typename StateInteger, typename BitInteger, typename QubitAllocator>
+      inline RandomAccessRange& unitary_matrix(
+        RandomAccessRange& state, MatrixIterator const matrix_first,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits)
+      {
+        ::ket::gate::unitary_matrix(::ket::utility::policy::make_sequential(), std::begin(state), std::end(state), matrix_first, target_qubits);
+        return state;
+      }
+    } // namespace ranges
+
+    template <
+      typename ParallelPolicy, typename RandomAccessIterator, typename MatrixIterator,
+      typename StateInteger, typename BitInteger, typename QubitAllocator, typename ControlQubitAllocator>
+    inline void adj_unitary_matrix(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits,
+      std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> >, ControlQubitAllocator > const& control_qubits)
+    {
+      assert(not target_qubits.empty());
+
+      if (control_qubits.empty())
+        switch (target_qubits.size())
+        {
+         case 1u:
+          ::ket::gate::adj_unitary_matrix(parallel_policy, first, last, matrix_first, target_qubits[0u]);
+          return;
+
+         case 2u:
+          ::ket::gate::adj_unitary_matrix(parallel_policy, first, last, matrix_first, target_qubits[0u], target_qubits[1u]);
+          return;
+
+         case 3u:
+          ::ket::gate::adj_unitary_matrix(parallel_policy, first, last, matrix_first, target_qubits[0u], target_qubits[1u], target_qubits[2u]);
+          return;
+
+         case 4u:
+          ::ket::gate::adj_unitary_matrix(parallel_policy, first, last, matrix_first, target_qubits[0u], target_qubits[1u], target_qubits[2u], target_qubits[3u]);
+          return;
+
+         default:
+          break;
+        }
+
+      ::ket::gate::unitary_matrix_detail::generic_unitary_matrix<true>(
+        parallel_policy, first, last, matrix_first, target_qubits, control_qubits);
+    }
+
+    template <
+      typename ParallelPolicy, typename RandomAccessIterator, typename MatrixIterator,
+      typename StateInteger, typename BitInteger, typename QubitAllocator>
+    inline void adj_unitary_matrix(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits)
+    {
+      ::ket::gate::adj_unitary_matrix(
+        parallel_policy, first, last, matrix_first, target_qubits,
+        std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> > >{});
+    }
+
+    template <
+      typename RandomAccessIterator, typename MatrixIterator,
+      typename StateInteger, typename BitInteger, typename QubitAllocator, typename ControlQubitAllocator>
+    inline void adj_unitary_matrix(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits,
+      std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> >, ControlQubitAllocator > const& control_qubits)
+    { ::ket::gate::adj_unitary_matrix(::ket::utility::policy::make_sequential(), first, last, matrix_first, target_qubits, control_qubits); }
+
+    template <
+      typename RandomAccessIterator, typename MatrixIterator,
+      typename StateInteger, typename BitInteger, typename QubitAllocator>
+    inline void adj_unitary_matrix(
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      MatrixIterator const matrix_first,
+      std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits)
+    { ::ket::gate::adj_unitary_matrix(::ket::utility::policy::make_sequential(), first, last, matrix_first, target_qubits); }
+
+    namespace ranges
+    {
+      template <
+        typename ParallelPolicy, typename RandomAccessRange, typename MatrixIterator,
+        typename StateInteger, typename BitInteger, typename QubitAllocator, typename ControlQubitAllocator>
+      inline RandomAccessRange& adj_unitary_matrix(
+        ParallelPolicy const parallel_policy, RandomAccessRange& state,
+        MatrixIterator const matrix_first,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits,
+        std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> >, ControlQubitAllocator > const& control_qubits)
+      {
+        ::ket::gate::adj_unitary_matrix(parallel_policy, std::begin(state), std::end(state), matrix_first, target_qubits, control_qubits);
+        return state;
+      }
+
+      template <
+        typename ParallelPolicy, typename RandomAccessRange, typename MatrixIterator,
+        typename StateInteger, typename BitInteger, typename QubitAllocator>
+      inline RandomAccessRange& adj_unitary_matrix(
+        ParallelPolicy const parallel_policy, RandomAccessRange& state,
+        MatrixIterator const matrix_first,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits)
+      {
+        ::ket::gate::adj_unitary_matrix(parallel_policy, std::begin(state), std::end(state), matrix_first, target_qubits);
+        return state;
+      }
+
+      template <
+        typename RandomAccessRange, typename MatrixIterator,
+        typename StateInteger, typename BitInteger, typename QubitAllocator, typename ControlQubitAllocator>
+      inline RandomAccessRange& adj_unitary_matrix(
+        RandomAccessRange& state, MatrixIterator const matrix_first,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits,
+        std::vector< ::ket::control< ::ket::qubit<StateInteger, BitInteger> >, ControlQubitAllocator > const& control_qubits)
+      {
+        ::ket::gate::adj_unitary_matrix(::ket::utility::policy::make_sequential(), std::begin(state), std::end(state), matrix_first, target_qubits, control_qubits);
+        return state;
+      }
+
+      template <
+        typename RandomAccessRange, typename MatrixIterator,
+        typename StateInteger, typename BitInteger, typename QubitAllocator>
+      inline RandomAccessRange& adj_unitary_matrix(
+        RandomAccessRange& state, MatrixIterator const matrix_first,
+        std::vector< ::ket::qubit<StateInteger, BitInteger>, QubitAllocator > const& target_qubits)
+      {
+        ::ket::gate::adj_unitary_matrix(::ket::utility::policy::make_sequential(), std::begin(state), std::end(state), matrix_first, target_qubits);
+        return state;
+      }
+    } // namespace ranges
+  } // namespace gate
+} // namespace ket
+
+
+#endif // KET_GATE_UNITARY_MATRIX_HPP
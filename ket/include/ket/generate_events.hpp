@@ -5,12 +5,131 @@
 # include <vector>
 # include <iterator>
 # include <algorithm>
+# include <numeric>
+# include <utility>
 
+# include <ket/utility/loop_n.hpp>
 # include <ket/utility/positive_random_value_upto.hpp>
+# include <ket/utility/meta/real_of.hpp>
 
 
 namespace ket
 {
+  namespace generate_events_detail
+  {
+    constexpr auto num_blocks_per_thread = 16u;
+
+    // sums of probabilities of consecutive blocks of [first, last). The number of blocks is a multiple of the number of threads
+    template <typename ParallelPolicy, typename RandomAccessIterator>
+    inline std::vector<
+      typename ::ket::utility::meta::real_of<
+        typename std::iterator_traits<RandomAccessIterator>::value_type>::type>
+    block_probabilities(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last)
+    {
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+      using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+
+      auto const state_size = last - first;
+      auto const num_blocks
+        = std::min(
+            static_cast<difference_type>(num_blocks_per_thread * ::ket::utility::num_threads(parallel_policy)),
+            state_size);
+      auto result = std::vector<real_type>(num_blocks);
+
+      ::ket::utility::loop_n(
+        parallel_policy, num_blocks,
+        [first, state_size, num_blocks, &result](difference_type const block_index, int const)
+        {
+          auto const block_first = first + state_size * block_index / num_blocks;
+          auto const block_last = first + state_size * (block_index + difference_type{1}) / num_blocks;
+
+          auto block_probability = real_type{0};
+          for (auto iter = block_first; iter != block_last; ++iter)
+          {
+            using std::norm;
+            block_probability += norm(*iter);
+          }
+          result[block_index] = block_probability;
+        });
+
+      return result;
+    }
+
+    // For each (variate, event_index) of sorted [variates_first, variates_last), result_first[event_index] is the index of
+    // the first amplitude at which the cumulative probability exceeds the variate, which is equivalent to what std::upper_bound
+    // returns on the prefix sums of probabilities up to rounding of the cumulative sums: they are summed block by block here,
+    // so a variate very close to a cumulative probability may fall on the neighbouring amplitude. Each block walks its amplitudes
+    // once, merging them with the variates which fall into the block, so that neither the prefix sums nor a binary search
+    // for each event are needed
+    template <
+      typename ParallelPolicy, typename RandomAccessIterator, typename Real, typename Allocator,
+      typename VariateIterator, typename ResultIterator>
+    inline void locate_events(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      std::vector<Real, Allocator> const& block_probabilities,
+      VariateIterator const variates_first, VariateIterator const variates_last,
+      ResultIterator const result_first)
+    {
+      using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+
+      auto const state_size = last - first;
+      auto const num_blocks = static_cast<difference_type>(block_probabilities.size());
+      if (num_blocks == difference_type{0})
+        return;
+
+      auto block_offsets = std::vector<Real>(num_blocks);
+      std::partial_sum(
+        std::begin(block_probabilities), std::prev(std::end(block_probabilities)), std::next(std::begin(block_offsets)));
+
+      using variate_type = typename std::iterator_traits<VariateIterator>::value_type;
+      auto const compare
+        = [](variate_type const& variate, Real const value) { return variate.first < value; };
+
+      ::ket::utility::loop_n(
+        parallel_policy, num_blocks,
+        [first, state_size, num_blocks, &block_offsets, variates_first, variates_last, result_first, compare](
+          difference_type const block_index, int const)
+        {
+          auto variate_iter
+            = std::lower_bound(variates_first, variates_last, block_offsets[block_index], compare);
+          // the last block also takes variates beyond the total probability caused by rounding errors
+          auto const block_variates_last
+            = block_index + difference_type{1} == num_blocks
+              ? variates_last
+              : std::lower_bound(variate_iter, variates_last, block_offsets[block_index + difference_type{1}], compare);
+          if (variate_iter == block_variates_last)
+            return;
+
+          auto const block_first = state_size * block_index / num_blocks;
+          auto const block_last = state_size * (block_index + difference_type{1}) / num_blocks;
+
+          auto cumulative_probability = block_offsets[block_index];
+          auto last_possible_index = block_last - difference_type{1};
+          for (auto index = block_first; index != block_last and variate_iter != block_variates_last; ++index)
+          {
+            using std::norm;
+            auto const probability = norm(*(first + index));
+            if (probability == Real{0})
+              continue;
+
+            cumulative_probability += probability;
+            last_possible_index = index;
+            for (; variate_iter != block_variates_last and variate_iter->first < cumulative_probability; ++variate_iter)
+              result_first[variate_iter->second] = index;
+          }
+
+          for (; variate_iter != block_variates_last; ++variate_iter)
+            result_first[variate_iter->second] = last_possible_index;
+        });
+    }
+  } // namespace generate_events_detail
+
+  // The amplitudes are not modified. The variates are drawn in the same order as in repeated std::upper_bound on prefix sums,
+  // sorted, and merged with the cumulative distribution in one parallel pass
   template <
     typename ParallelPolicy,
     typename StateInteger, typename Allocator,
@@ -23,32 +142,24 @@ namespace ket
     RandomNumberGenerator& random_number_generator)
   {
     result.clear();
-    result.reserve(num_events);
-
-    using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
-    ::ket::utility::transform_inclusive_scan(
-      parallel_policy, first, last, first,
-      [](complex_type const& lhs, complex_type const& rhs)
-      { using std::real; return static_cast<complex_type>(real(lhs) + real(rhs)); },
-      [](complex_type const& value)
-      { using std::norm; return static_cast<complex_type>(norm(value)); });
 
-    using std::real;
-    auto const total_probability = real(*std::prev(last));
+    auto const block_probabilities
+      = ::ket::generate_events_detail::block_probabilities(parallel_policy, first, last);
+    using real_type = typename decltype(block_probabilities)::value_type;
+    auto const total_probability
+      = std::accumulate(std::begin(block_probabilities), std::end(block_probabilities), real_type{0});
 
+    auto variates = std::vector<std::pair<real_type, int>>{};
+    variates.reserve(num_events);
     for (auto event_index = int{0}; event_index < num_events; ++event_index)
-    {
-      RandomAccessIterator const found
-        = std::upper_bound(
-            first, last,
-            static_cast<complex_type>(
-              ::ket::utility::positive_random_value_upto(
-                total_probability, random_number_generator)),
-            [](complex_type const& lhs, complex_type const& rhs)
-            { return real(lhs) < real(rhs); });
-
-      result.push_back(found - first);
-    }
+      variates.emplace_back(
+        ::ket::utility::positive_random_value_upto(total_probability, random_number_generator), event_index);
+    std::sort(std::begin(variates), std::end(variates));
+
+    result.resize(num_events);
+    ::ket::generate_events_detail::locate_events(
+      parallel_policy, first, last, block_probabilities,
+      std::begin(variates), std::end(variates), std::begin(result));
   }
 
   template <
@@ -0,0 +1,144 @@
+#ifndef KET_MODULAR_EXPONENTIATION_ASSIGNMENT_HPP
+# define KET_MODULAR_EXPONENTIATION_ASSIGNMENT_HPP
+
+# include <cassert>
+# include <iterator>
+# include <type_traits>
+
+# include <boost/range/size.hpp>
+# include <boost/range/value_type.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/shor_box.hpp>
+# include <ket/register_permutation.hpp>
+# include <ket/modular_multiplication_assignment.hpp>
+# include <ket/meta/state_integer_of.hpp>
+# include <ket/meta/bit_integer_of.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/bit_gatherer.hpp>
+
+
+namespace ket
+{
+  // x = base^e * x mod divisor for an exponent register e and a register x of n qubits, where the kth qubit of a register is its kth bit.
+  // Values of x not less than divisor are unchanged. base and divisor should be coprime, and divisor should be at most 2^n.
+  // divisor^2 should be representable by StateInteger.
+  // base^e mod divisor is calculated once for each value of the qubits other than x
+  namespace modular_exponentiation_assignment_detail
+  {
+    template <typename StateInteger, typename BitInteger>
+    class modular_exponentiation_mappings
+    {
+      ::ket::utility::bit_gatherer<StateInteger, BitInteger> exponent_gatherer_;
+      StateInteger base_;
+      StateInteger divisor_;
+
+     public:
+      modular_exponentiation_mappings(
+        ::ket::utility::bit_gatherer<StateInteger, BitInteger> const& exponent_gatherer,
+        StateInteger const base, StateInteger const divisor)
+        : exponent_gatherer_{exponent_gatherer}, base_{base}, divisor_{divisor}
+      { }
+
+      ::ket::modular_multiplication_assignment_detail::modular_multiplication_mapping<StateInteger> operator()(
+        StateInteger const qubit_value) const
+      {
+        return {
+          ::ket::shor_box_detail::modular_power(base_, exponent_gatherer_(qubit_value), divisor_),
+          divisor_};
+      }
+    }; // class modular_exponentiation_mappings<StateInteger, BitInteger>
+
+    template <typename ExponentQubits, typename Qubits>
+    inline ::ket::modular_exponentiation_assignment_detail::modular_exponentiation_mappings<
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type,
+      typename ::ket::meta::bit_integer_of<typename boost::range_value<Qubits>::type>::type>
+    make_modular_exponentiation_mappings(
+      ExponentQubits const& exponent_qubits, Qubits const& qubits,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const base,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+    {
+      using qubit_type = typename boost::range_value<Qubits>::type;
+      using state_integer_type = typename ::ket::meta::state_integer_of<qubit_type>::type;
+      using bit_integer_type = typename ::ket::meta::bit_integer_of<qubit_type>::type;
+      static_assert(std::is_unsigned<state_integer_type>::value, "StateInteger should be unsigned");
+      static_assert(std::is_unsigned<bit_integer_type>::value, "BitInteger should be unsigned");
+      static_assert(
+        std::is_same<qubit_type, typename boost::range_value<ExponentQubits>::type>::value,
+        "qubit types of exponent_qubits and qubits should be the same");
+      assert(
+        ::ket::modular_multiplication_assignment_detail::is_valid_divisor(
+          divisor, static_cast<bit_integer_type>(boost::size(qubits))));
+      assert(::ket::modular_multiplication_assignment_detail::greatest_common_divisor(base, divisor) == state_integer_type{1u});
+
+      return {::ket::utility::make_bit_gatherer(exponent_qubits), base, divisor};
+    }
+  } // namespace modular_exponentiation_assignment_detail
+
+  template <typename ParallelPolicy, typename RandomAccessIterator, typename ExponentQubits, typename Qubits>
+  inline typename std::enable_if<
+    ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+    void>::type
+  modular_exponentiation_assignment(
+    ParallelPolicy const parallel_policy,
+    RandomAccessIterator const first, RandomAccessIterator const last,
+    ExponentQubits const& exponent_qubits, Qubits const& qubits,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const base,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+  {
+    ::ket::permutate_register(
+      parallel_policy, first, last, qubits,
+      ::ket::modular_exponentiation_assignment_detail::make_modular_exponentiation_mappings(
+        exponent_qubits, qubits, base, divisor));
+  }
+
+  template <typename RandomAccessIterator, typename ExponentQubits, typename Qubits>
+  inline typename std::enable_if<
+    not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessIterator>::value,
+    void>::type
+  modular_exponentiation_assignment(
+    RandomAccessIterator const first, RandomAccessIterator const last,
+    ExponentQubits const& exponent_qubits, Qubits const& qubits,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const base,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+  {
+    ::ket::modular_exponentiation_assignment(
+      ::ket::utility::policy::make_sequential(), first, last, exponent_qubits, qubits, base, divisor);
+  }
+
+
+  namespace ranges
+  {
+    template <typename ParallelPolicy, typename RandomAccessRange, typename ExponentQubits, typename Qubits>
+    inline typename std::enable_if<
+      ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+      RandomAccessRange&>::type
+    modular_exponentiation_assignment(
+      ParallelPolicy const parallel_policy, RandomAccessRange& state,
+      ExponentQubits const& exponent_qubits, Qubits const& qubits,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const base,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+    {
+      ::ket::modular_exponentiation_assignment(
+        parallel_policy, std::begin(state), std::end(state), exponent_qubits, qubits, base, divisor);
+      return state;
+    }
+
+    template <typename RandomAccessRange, typename ExponentQubits, typename Qubits>
+    inline typename std::enable_if<
+      not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessRange>::value,
+      RandomAccessRange&>::type
+    modular_exponentiation_assignment(
+      RandomAccessRange& state, ExponentQubits const& exponent_qubits, Qubits const& qubits,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const base,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+    {
+      ::ket::modular_exponentiation_assignment(
+        std::begin(state), std::end(state), exponent_qubits, qubits, base, divisor);
+      return state;
+    }
+  } // namespace ranges
+} // namespace ket
+
+
+#endif // KET_MODULAR_EXPONENTIATION_ASSIGNMENT_HPP
@@ -0,0 +1,165 @@
+#ifndef KET_MODULAR_MULTIPLICATION_ASSIGNMENT_HPP
+# define KET_MODULAR_MULTIPLICATION_ASSIGNMENT_HPP
+
+# include <cassert>
+# include <iterator>
+# include <limits>
+# include <type_traits>
+
+# include <boost/range/size.hpp>
+# include <boost/range/value_type.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/register_permutation.hpp>
+# include <ket/meta/state_integer_of.hpp>
+# include <ket/meta/bit_integer_of.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+
+
+namespace ket
+{
+  // x = multiplier * x mod divisor for a register x of n qubits, whose kth qubit is its kth bit.
+  // Values of x not less than divisor are unchanged. multiplier and divisor should be coprime,
+  // so that the multiplication is a permutation of [0, divisor), and divisor should be at most 2^n.
+  // divisor^2 should be representable by StateInteger
+  namespace modular_multiplication_assignment_detail
+  {
+    template <typename StateInteger>
+    class modular_multiplication_mapping
+    {
+      StateInteger multiplier_;
+      StateInteger divisor_;
+
+     public:
+      modular_multiplication_mapping(StateInteger const multiplier, StateInteger const divisor)
+        : multiplier_{multiplier % divisor}, divisor_{divisor}
+      { }
+
+      StateInteger operator()(StateInteger const value) const
+      { return value < divisor_ ? (value * multiplier_) % divisor_ : value; }
+    }; // class modular_multiplication_mapping<StateInteger>
+
+    template <typename StateInteger>
+    class modular_multiplication_mappings
+    {
+      ::ket::modular_multiplication_assignment_detail::modular_multiplication_mapping<StateInteger> mapping_;
+
+     public:
+      modular_multiplication_mappings(StateInteger const multiplier, StateInteger const divisor)
+        : mapping_{multiplier, divisor}
+      { }
+
+      ::ket::modular_multiplication_assignment_detail::modular_multiplication_mapping<StateInteger> operator()(
+        StateInteger const) const
+      { return mapping_; }
+    }; // class modular_multiplication_mappings<StateInteger>
+
+    template <typename StateInteger>
+    inline StateInteger greatest_common_divisor(StateInteger lhs, StateInteger rhs)
+    {
+      while (rhs != StateInteger{0u})
+      {
+        auto const remainder = lhs % rhs;
+        lhs = rhs;
+        rhs = remainder;
+      }
+
+      return lhs;
+    }
+
+    template <typename StateInteger, typename BitInteger>
+    inline bool is_valid_divisor(StateInteger const divisor, BitInteger const num_qubits)
+    {
+      return divisor > StateInteger{0u}
+        and divisor <= ::ket::utility::integer_exp2<StateInteger>(num_qubits)
+        and divisor - StateInteger{1u} <= std::numeric_limits<StateInteger>::max() / divisor;
+    }
+
+    template <typename Qubits>
+    inline ::ket::modular_multiplication_assignment_detail::modular_multiplication_mappings<
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type>
+    make_modular_multiplication_mappings(
+      Qubits const& qubits,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const multiplier,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+    {
+      using qubit_type = typename boost::range_value<Qubits>::type;
+      using state_integer_type = typename ::ket::meta::state_integer_of<qubit_type>::type;
+      using bit_integer_type = typename ::ket::meta::bit_integer_of<qubit_type>::type;
+      static_assert(std::is_unsigned<state_integer_type>::value, "StateInteger should be unsigned");
+      static_assert(std::is_unsigned<bit_integer_type>::value, "BitInteger should be unsigned");
+      assert(
+        ::ket::modular_multiplication_assignment_detail::is_valid_divisor(
+          divisor, static_cast<bit_integer_type>(boost::size(qubits))));
+      assert(::ket::modular_multiplication_assignment_detail::greatest_common_divisor(multiplier, divisor) == state_integer_type{1u});
+
+      return {multiplier, divisor};
+    }
+  } // namespace modular_multiplication_assignment_detail
+
+  template <typename ParallelPolicy, typename RandomAccessIterator, typename Qubits>
+  inline typename std::enable_if<
+    ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+    void>::type
+  modular_multiplication_assignment(
+    ParallelPolicy const parallel_policy,
+    RandomAccessIterator const first, RandomAccessIterator const last,
+    Qubits const& qubits,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const multiplier,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+  {
+    ::ket::permutate_register(
+      parallel_policy, first, last, qubits,
+      ::ket::modular_multiplication_assignment_detail::make_modular_multiplication_mappings(qubits, multiplier, divisor));
+  }
+
+  template <typename RandomAccessIterator, typename Qubits>
+  inline typename std::enable_if<
+    not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessIterator>::value,
+    void>::type
+  modular_multiplication_assignment(
+    RandomAccessIterator const first, RandomAccessIterator const last,
+    Qubits const& qubits,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const multiplier,
+    typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+  {
+    ::ket::modular_multiplication_assignment(
+      ::ket::utility::policy::make_sequential(), first, last, qubits, multiplier, divisor);
+  }
+
+
+  namespace ranges
+  {
+    template <typename ParallelPolicy, typename RandomAccessRange, typename Qubits>
+    inline typename std::enable_if<
+      ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+      RandomAccessRange&>::type
+    modular_multiplication_assignment(
+      ParallelPolicy const parallel_policy, RandomAccessRange& state,
+      Qubits const& qubits,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const multiplier,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+    {
+      ::ket::modular_multiplication_assignment(
+        parallel_policy, std::begin(state), std::end(state), qubits, multiplier, divisor);
+      return state;
+    }
+
+    template <typename RandomAccessRange, typename Qubits>
+    inline typename std::enable_if<
+      not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessRange>::value,
+      RandomAccessRange&>::type
+    modular_multiplication_assignment(
+      RandomAccessRange& state, Qubits const& qubits,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const multiplier,
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type const divisor)
+    {
+      ::ket::modular_multiplication_assignment(std::begin(state), std::end(state), qubits, multiplier, divisor);
+      return state;
+    }
+  } // namespace ranges
+} // namespace ket
+
+
+#endif // KET_MODULAR_MULTIPLICATION_ASSIGNMENT_HPP
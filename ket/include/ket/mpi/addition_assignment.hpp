@@ -3,6 +3,7 @@
 
 # include <cassert>
 # include <cstddef>
+# include <array>
 # include <iterator>
 # include <type_traits>
 # include <vector>
@@ -14,10 +15,13 @@
 # include <yampi/environment.hpp>
 # include <yampi/datatype_base.hpp>
 
+# include <ket/qubit.hpp>
 # include <ket/control.hpp>
+# include <ket/addition_assignment.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/generate_phase_coefficients.hpp>
 # include <ket/mpi/swapped_fourier_transform.hpp>
+# include <ket/mpi/register_permutation.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/gate/controlled_phase_shift.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
@@ -1012,6 +1016,110 @@ namespace ket
         local_state, lhs_qubits, rhs_qubits_range, phase_coefficients, permutation,
         buffer, datatype, communicator, environment);
     }
+
+    // If lhs_qubits is given as std::array, the sum is calculated as a permutation of basis states by ::ket::mpi::permutate_register,
+    // which moves each amplitude once after lhs_qubits are made local. rhs qubits may be global
+    template <
+      typename MpiPolicy, typename ParallelPolicy, typename RandomAccessRange, typename QubitsRange,
+      typename StateInteger, typename BitInteger, std::size_t num_qubits,
+      typename Allocator, typename BufferAllocator>
+    inline typename std::enable_if<
+      ::ket::mpi::utility::policy::meta::is_mpi_policy<MpiPolicy>::value,
+      RandomAccessRange&>::type
+    addition_assignment(
+      MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+      RandomAccessRange& local_state,
+      std::array< ::ket::qubit<StateInteger, BitInteger>, num_qubits > const& lhs_qubits,
+      QubitsRange const& rhs_qubits_range,
+      ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+      std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+      yampi::communicator const& communicator, yampi::environment const& environment)
+    {
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Addition", environment};
+
+      return ::ket::mpi::permutate_register(
+        mpi_policy, parallel_policy, local_state, lhs_qubits,
+        ::ket::addition_assignment_detail::addition_mappings<StateInteger, BitInteger>{
+          static_cast<BitInteger>(num_qubits), rhs_qubits_range, false},
+        permutation, buffer, communicator, environment);
+    }
+
+    template <
+      typename MpiPolicy, typename ParallelPolicy, typename RandomAccessRange, typename QubitsRange,
+      typename StateInteger, typename BitInteger, std::size_t num_qubits,
+      typename Allocator, typename BufferAllocator, typename DerivedDatatype>
+    inline typename std::enable_if<
+      ::ket::mpi::utility::policy::meta::is_mpi_policy<MpiPolicy>::value,
+      RandomAccessRange&>::type
+    addition_assignment(
+      MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+      RandomAccessRange& local_state,
+      std::array< ::ket::qubit<StateInteger, BitInteger>, num_qubits > const& lhs_qubits,
+      QubitsRange const& rhs_qubits_range,
+      ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+      std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+      yampi::datatype_base<DerivedDatatype> const& datatype,
+      yampi::communicator const& communicator, yampi::environment const& environment)
+    {
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Addition", environment};
+
+      return ::ket::mpi::permutate_register(
+        mpi_policy, parallel_policy, local_state, lhs_qubits,
+        ::ket::addition_assignment_detail::addition_mappings<StateInteger, BitInteger>{
+          static_cast<BitInteger>(num_qubits), rhs_qubits_range, false},
+        permutation, buffer, datatype, communicator, environment);
+    }
+
+    template <
+      typename MpiPolicy, typename ParallelPolicy, typename RandomAccessRange, typename QubitsRange,
+      typename StateInteger, typename BitInteger, std::size_t num_qubits,
+      typename Allocator, typename BufferAllocator>
+    inline typename std::enable_if<
+      ::ket::mpi::utility::policy::meta::is_mpi_policy<MpiPolicy>::value,
+      RandomAccessRange&>::type
+    adj_addition_assignment(
+      MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+      RandomAccessRange& local_state,
+      std::array< ::ket::qubit<StateInteger, BitInteger>, num_qubits > const& lhs_qubits,
+      QubitsRange const& rhs_qubits_range,
+      ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+      std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+      yampi::communicator const& communicator, yampi::environment const& environment)
+    {
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Adj(Addition)", environment};
+
+      return ::ket::mpi::permutate_register(
+        mpi_policy, parallel_policy, local_state, lhs_qubits,
+        ::ket::addition_assignment_detail::addition_mappings<StateInteger, BitInteger>{
+          static_cast<BitInteger>(num_qubits), rhs_qubits_range, true},
+        permutation, buffer, communicator, environment);
+    }
+
+    template <
+      typename MpiPolicy, typename ParallelPolicy, typename RandomAccessRange, typename QubitsRange,
+      typename StateInteger, typename BitInteger, std::size_t num_qubits,
+      typename Allocator, typename BufferAllocator, typename DerivedDatatype>
+    inline typename std::enable_if<
+      ::ket::mpi::utility::policy::meta::is_mpi_policy<MpiPolicy>::value,
+      RandomAccessRange&>::type
+    adj_addition_assignment(
+      MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+      RandomAccessRange& local_state,
+      std::array< ::ket::qubit<StateInteger, BitInteger>, num_qubits > const& lhs_qubits,
+      QubitsRange const& rhs_qubits_range,
+      ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+      std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+      yampi::datatype_base<DerivedDatatype> const& datatype,
+      yampi::communicator const& communicator, yampi::environment const& environment)
+    {
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Adj(Addition)", environment};
+
+      return ::ket::mpi::permutate_register(
+        mpi_policy, parallel_policy, local_state, lhs_qubits,
+        ::ket::addition_assignment_detail::addition_mappings<StateInteger, BitInteger>{
+          static_cast<BitInteger>(num_qubits), rhs_qubits_range, true},
+        permutation, buffer, datatype, communicator, environment);
+    }
   } // namespace mpi
 } // namespace ket
 
@@ -1,9 +1,15 @@
 #ifndef KET_MPI_ALL_EXPECTATION_VALUES_HPP
 # define KET_MPI_ALL_EXPECTATION_VALUES_HPP
 
+# include <cstddef>
+# include <vector>
 # include <array>
+# include <iterator>
+# include <algorithm>
 # include <type_traits>
 
+# include <boost/config.hpp>
+
 # include <boost/optional.hpp>
 
 # include <boost/range/value_type.hpp>
@@ -11,19 +17,153 @@
 # include <yampi/environment.hpp>
 # include <yampi/datatype_base.hpp>
 # include <yampi/communicator.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/all_reduce.hpp>
+# include <yampi/reduce.hpp>
+# include <yampi/binary_operation.hpp>
 
 # include <ket/qubit.hpp>
+# include <ket/all_spin_expectation_values.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/meta/real_of.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/spin_expectation_value.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/for_each_local_range.hpp>
+# include <ket/mpi/utility/logger.hpp>
 
 
 namespace ket
 {
   namespace mpi
   {
+    namespace all_spin_expectation_values_detail
+    {
+# ifdef BOOST_NO_CXX14_GENERIC_LAMBDAS
+      template <typename Qubit, typename ParallelPolicy, typename Spins>
+      struct accumulate_range_spins
+      {
+        ParallelPolicy parallel_policy_;
+        Spins& spins_;
+
+        accumulate_range_spins(ParallelPolicy const parallel_policy, Spins& spins)
+          : parallel_policy_{parallel_policy}, spins_{spins}
+        { }
+
+        template <typename RandomAccessIterator>
+        void operator()(RandomAccessIterator const first, RandomAccessIterator const last) const
+        {
+          auto const range_spins = ::ket::all_spin_expectation_values<Qubit>(parallel_policy_, first, last);
+          spins_.resize(range_spins.size());
+          for (auto position = std::size_t{0u}; position < range_spins.size(); ++position)
+          {
+            spins_[position][0u] += range_spins[position][0u];
+            spins_[position][1u] += range_spins[position][1u];
+            spins_[position][2u] += range_spins[position][2u];
+          }
+        }
+      }; // struct accumulate_range_spins<Qubit, ParallelPolicy, Spins>
+
+      template <typename Qubit, typename ParallelPolicy, typename Spins>
+      inline accumulate_range_spins<Qubit, ParallelPolicy, Spins> make_accumulate_range_spins(
+        ParallelPolicy const parallel_policy, Spins& spins)
+      { return accumulate_range_spins<Qubit, ParallelPolicy, Spins>{parallel_policy, spins}; }
+# endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
+
+      // spins of all qubits summed over the amplitudes in this process, flattened as {x0, y0, z0, x1, y1, z1, ...}
+      // so that they are reduced by one collective operation.
+      // Spins of qubits in local ranges are computed in one sweep over the local state. Only the other qubits, which are
+      // global qubits or page qubits, are brought into local ranges and computed one by one
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename LocalState, typename StateInteger, typename BitInteger,
+        typename Allocator, typename BufferAllocator, typename... ComplexDatatype>
+      inline std::vector<
+        typename ::ket::utility::meta::real_of<
+          typename boost::range_value<LocalState>::type>::type>
+      local_spin_expectation_values(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        LocalState& local_state,
+        ::ket::mpi::qubit_permutation<
+          StateInteger, BitInteger, Allocator>& permutation,
+        BitInteger const num_qubits,
+        std::vector<typename boost::range_value<LocalState>::type, BufferAllocator>& buffer,
+        yampi::communicator const& communicator,
+        yampi::environment const& environment,
+        ComplexDatatype const&... complex_datatype)
+      {
+        using complex_type = typename boost::range_value<LocalState>::type;
+        using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+        using spin_type = std::array<real_type, 3u>;
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+
+        // range_spins[b]: the spin of the qubit at the permutated bit b, for b = 0, ..., (the number of qubits in a local range)-1
+        auto range_spins = std::vector<spin_type>{};
+# ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
+        ::ket::mpi::utility::for_each_local_range(
+          mpi_policy, local_state, communicator, environment,
+          [parallel_policy, &range_spins](auto const first, auto const last)
+          {
+            auto const spins = ::ket::all_spin_expectation_values<qubit_type>(parallel_policy, first, last);
+            range_spins.resize(spins.size());
+            for (auto position = std::size_t{0u}; position < spins.size(); ++position)
+            {
+              range_spins[position][0u] += spins[position][0u];
+              range_spins[position][1u] += spins[position][1u];
+              range_spins[position][2u] += spins[position][2u];
+            }
+          });
+# else // BOOST_NO_CXX14_GENERIC_LAMBDAS
+        ::ket::mpi::utility::for_each_local_range(
+          mpi_policy, local_state, communicator, environment,
+          ::ket::mpi::all_spin_expectation_values_detail::make_accumulate_range_spins<qubit_type>(parallel_policy, range_spins));
+# endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
+        auto const num_range_qubits = static_cast<BitInteger>(range_spins.size());
+
+        auto result = std::vector<real_type>(3u * num_qubits);
+        auto const last_qubit = qubit_type{num_qubits};
+        for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
+        {
+          if (permutation[qubit].qubit() >= qubit_type{num_range_qubits})
+            continue;
+
+          auto const& spin = range_spins[static_cast<BitInteger>(permutation[qubit].qubit())];
+          std::copy(std::begin(spin), std::end(spin), std::begin(result) + 3u * static_cast<BitInteger>(qubit));
+        }
+
+        // interchanges of qubits below do not affect spins in result because they are computed from the same state
+        for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
+        {
+          if (permutation[qubit].qubit() < qubit_type{num_range_qubits})
+            continue;
+
+          auto qubits = std::array<qubit_type, 1u>{qubit};
+          ::ket::mpi::utility::maybe_interchange_qubits(
+            mpi_policy, parallel_policy,
+            local_state, qubits, permutation, buffer, complex_datatype..., communicator, environment);
+
+          auto const local_spin
+            = ::ket::mpi::spin_expectation_value_detail::local_spin_expectation_value(
+                mpi_policy, parallel_policy, local_state, permutation[qubit], communicator, environment);
+          std::copy(std::begin(local_spin), std::end(local_spin), std::begin(result) + 3u * static_cast<BitInteger>(qubit));
+        }
+
+        return result;
+      }
+
+      template <typename SpinsAllocator, typename Real>
+      inline std::vector<std::array<Real, 3u>, SpinsAllocator> to_spins(std::vector<Real> const& flattened_spins)
+      {
+        auto result = std::vector<std::array<Real, 3u>, SpinsAllocator>{};
+        result.reserve(flattened_spins.size() / 3u);
+
+        for (auto iter = std::begin(flattened_spins), last = std::end(flattened_spins); iter != last; iter += 3)
+          result.push_back(std::array<Real, 3u>{iter[0], iter[1], iter[2]});
+
+        return result;
+      }
+    } // namespace all_spin_expectation_values_detail
+
     // all_reduce version
     template <
       typename SpinsAllocator,
@@ -46,21 +186,19 @@ namespace ket
       yampi::communicator const& communicator,
       yampi::environment const& environment)
     {
-      using complex_type = typename boost::range_value<LocalState>::type;
-      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      using spin_type = std::array<real_type, 3u>;
-      auto result = std::vector<spin_type, SpinsAllocator>{};
-      result.reserve(num_qubits);
-
-      using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
-      auto const last_qubit = qubit_type{num_qubits};
-      for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
-        result.push_back(
-          ::ket::mpi::spin_expectation_value(
-            mpi_policy, parallel_policy, local_state, qubit, permutation, buffer,
-            communicator, environment));
-
-      return result;
+      ::ket::mpi::utility::log_with_time_guard<char> print{"All Spins", environment};
+
+      auto const local_spins
+        = ::ket::mpi::all_spin_expectation_values_detail::local_spin_expectation_values(
+            mpi_policy, parallel_policy, local_state, permutation, num_qubits, buffer, communicator, environment);
+
+      auto spins = std::vector<typename decltype(local_spins)::value_type>(local_spins.size());
+      yampi::all_reduce(
+        yampi::make_buffer(std::begin(local_spins), std::end(local_spins)),
+        std::begin(spins), yampi::binary_operation(::yampi::plus_t()),
+        communicator, environment);
+
+      return ::ket::mpi::all_spin_expectation_values_detail::to_spins<SpinsAllocator>(spins);
     }
 
     template <
@@ -87,21 +225,19 @@ namespace ket
       yampi::communicator const& communicator,
       yampi::environment const& environment)
     {
-      using complex_type = typename boost::range_value<LocalState>::type;
-      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      using spin_type = std::array<real_type, 3u>;
-      auto result = std::vector<spin_type, SpinsAllocator>{};
-      result.reserve(num_qubits);
-
-      using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
-      auto const last_qubit = qubit_type{num_qubits};
-      for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
-        result.push_back(
-          ::ket::mpi::spin_expectation_value(
-            mpi_policy, parallel_policy, local_state, qubit, permutation, buffer,
-            real_datatype, complex_datatype, communicator, environment));
-
-      return result;
+      ::ket::mpi::utility::log_with_time_guard<char> print{"All Spins", environment};
+
+      auto const local_spins
+        = ::ket::mpi::all_spin_expectation_values_detail::local_spin_expectation_values(
+            mpi_policy, parallel_policy, local_state, permutation, num_qubits, buffer, communicator, environment, complex_datatype);
+
+      auto spins = std::vector<typename decltype(local_spins)::value_type>(local_spins.size());
+      yampi::all_reduce(
+        yampi::make_buffer(std::begin(local_spins), std::end(local_spins), real_datatype),
+        std::begin(spins), yampi::binary_operation(::yampi::plus_t()),
+        communicator, environment);
+
+      return ::ket::mpi::all_spin_expectation_values_detail::to_spins<SpinsAllocator>(spins);
     }
 
     template <
@@ -417,32 +553,25 @@ namespace ket
       yampi::communicator const& communicator,
       yampi::environment const& environment)
     {
-      auto const is_root = communicator.rank(environment) == root;
+      ::ket::mpi::utility::log_with_time_guard<char> print{"All Spins", environment};
 
-      using complex_type = typename boost::range_value<LocalState>::type;
-      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      using spin_type = std::array<real_type, 3u>;
-      auto result = std::vector<spin_type, SpinsAllocator>{};
-      if (is_root)
-        result.reserve(num_qubits);
+      auto const local_spins
+        = ::ket::mpi::all_spin_expectation_values_detail::local_spin_expectation_values(
+            mpi_policy, parallel_policy, local_state, permutation, num_qubits, buffer, communicator, environment);
 
-      using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
-      auto const last_qubit = qubit_type{num_qubits};
-      for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
-      {
-        auto const maybe_expectation_value
-          = ::ket::mpi::spin_expectation_value(
-              mpi_policy, parallel_policy, local_state, qubit, permutation, buffer,
-              root, communicator, environment);
+      auto const is_root = communicator.rank(environment) == root;
+      auto spins = std::vector<typename decltype(local_spins)::value_type>{};
+      if (is_root)
+        spins.resize(local_spins.size());
 
-        if (is_root and maybe_expectation_value)
-          result.push_back(*maybe_expectation_value);
-      }
+      yampi::reduce(
+        yampi::make_buffer(std::begin(local_spins), std::end(local_spins)), std::begin(spins), yampi::binary_operation(yampi::plus_t()),
+        root, communicator, environment);
 
       if (not is_root)
         return boost::none;
 
-      return result;
+      return ::ket::mpi::all_spin_expectation_values_detail::to_spins<SpinsAllocator>(spins);
     }
 
     template <
@@ -471,32 +600,25 @@ namespace ket
       yampi::communicator const& communicator,
       yampi::environment const& environment)
     {
-      auto const is_root = communicator.rank(environment) == root;
+      ::ket::mpi::utility::log_with_time_guard<char> print{"All Spins", environment};
 
-      using complex_type = typename boost::range_value<LocalState>::type;
-      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      using spin_type = std::array<real_type, 3u>;
-      auto result = std::vector<spin_type, SpinsAllocator>{};
-      if (is_root)
-        result.reserve(num_qubits);
+      auto const local_spins
+        = ::ket::mpi::all_spin_expectation_values_detail::local_spin_expectation_values(
+            mpi_policy, parallel_policy, local_state, permutation, num_qubits, buffer, communicator, environment, complex_datatype);
 
-      using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
-      auto const last_qubit = qubit_type{num_qubits};
-      for (auto qubit = qubit_type{BitInteger{0u}}; qubit < last_qubit; ++qubit)
-      {
-        auto const maybe_expectation_value
-          = ::ket::mpi::spin_expectation_value(
-              mpi_policy, parallel_policy, local_state, qubit, permutation, buffer,
-              real_datatype, complex_datatype, root, communicator, environment);
+      auto const is_root = communicator.rank(environment) == root;
+      auto spins = std::vector<typename decltype(local_spins)::value_type>{};
+      if (is_root)
+        spins.resize(local_spins.size());
 
-        if (is_root and maybe_expectation_value)
-          result.push_back(*maybe_expectation_value);
-      }
+      yampi::reduce(
+        yampi::make_buffer(std::begin(local_spins), std::end(local_spins), real_datatype), std::begin(spins), yampi::binary_operation(yampi::plus_t()),
+        root, communicator, environment);
 
       if (not is_root)
         return boost::none;
 
-      return result;
+      return ::ket::mpi::all_spin_expectation_values_detail::to_spins<SpinsAllocator>(spins);
     }
 
     template <
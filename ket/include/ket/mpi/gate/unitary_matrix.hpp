@@ -0,0 +1,202 @@
+#ifndef KET_MPI_GATE_UNITARY_MATRIX_HPP
+# define KET_MPI_GATE_UNITARY_MATRIX_HPP
+
+# include <string>
+# include <vector>
+# include <array>
+# include <iterator>
+
+# include <boost/range/value_type.hpp>
+
+# include <yampi/environment.hpp>
+# include <yampi/datatype_base.hpp>
+# include <yampi/communicator.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/gate/unitary_matrix.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/logger.hpp>
+# include <ket/mpi/gate/detail/append_qubits_string.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace gate
+    {
+      namespace unitary_matrix_detail
+      {
+        template <
+          typename MpiPolicy, typename ParallelPolicy,
+          typename RandomAccessRange, typename StateInteger, typename BitInteger,
+          typename Allocator, typename MatrixIterator, typename... Qubits>
+        inline RandomAccessRange& do_unitary_matrix(
+          MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+          RandomAccessRange& local_state,
+          ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+          yampi::communicator const& communicator, yampi::environment const& environment,
+          MatrixIterator const matrix_first,
+          ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+        {
+          auto const data_block_size
+            = ::ket::mpi::utility::policy::data_block_size(mpi_policy, local_state, communicator, environment);
+          auto const num_data_blocks
+            = ::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment);
+
+          auto const first = std::begin(local_state);
+          for (auto data_block_index = decltype(num_data_blocks){0u}; data_block_index < num_data_blocks; ++data_block_index)
+            ::ket::gate::unitary_matrix(
+              parallel_policy,
+              first + data_block_index * data_block_size,
+              first + (data_block_index + 1u) * data_block_size,
+              matrix_first, permutation[qubit].qubit(), permutation[qubits].qubit()...);
+
+          return local_state;
+        }
+
+        template <
+          typename MpiPolicy, typename ParallelPolicy,
+          typename RandomAccessRange, typename StateInteger, typename BitInteger,
+          typename Allocator, typename MatrixIterator, typename... Qubits>
+        inline RandomAccessRange& do_adj_unitary_matrix(
+          MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+          RandomAccessRange& local_state,
+          ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+          yampi::communicator const& communicator, yampi::environment const& environment,
+          MatrixIterator const matrix_first,
+          ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+        {
+          auto const data_block_size
+            = ::ket::mpi::utility::policy::data_block_size(mpi_policy, local_state, communicator, environment);
+          auto const num_data_blocks
+            = ::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment);
+
+          auto const first = std::begin(local_state);
+          for (auto data_block_index = decltype(num_data_blocks){0u}; data_block_index < num_data_blocks; ++data_block_index)
+            ::ket::gate::adj_unitary_matrix(
+              parallel_policy,
+              first + data_block_index * data_block_size,
+              first + (data_block_index + 1u) * data_block_size,
+              matrix_first, permutation[qubit].qubit(), permutation[qubits].qubit()...);
+
+          return local_state;
+        }
+      } // namespace unitary_matrix_detail
+
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename StateInteger, typename BitInteger,
+        typename Allocator, typename BufferAllocator, typename MatrixIterator, typename... Qubits>
+      inline RandomAccessRange& unitary_matrix(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixIterator const matrix_first,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string(sizeof...(Qubits) + 1u, 'U'), qubit, qubits...),
+          environment};
+
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto qubit_array = std::array<qubit_type, sizeof...(Qubits) + 1u>{qubit, qubits...};
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, qubit_array, permutation, buffer, communicator, environment);
+
+        return ::ket::mpi::gate::unitary_matrix_detail::do_unitary_matrix(
+          mpi_policy, parallel_policy, local_state, permutation, communicator, environment, matrix_first, qubit, qubits...);
+      }
+
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename StateInteger, typename BitInteger,
+        typename Allocator, typename BufferAllocator, typename DerivedDatatype, typename MatrixIterator, typename... Qubits>
+      inline RandomAccessRange& unitary_matrix(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixIterator const matrix_first,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string(sizeof...(Qubits) + 1u, 'U'), qubit, qubits...),
+          environment};
+
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto qubit_array = std::array<qubit_type, sizeof...(Qubits) + 1u>{qubit, qubits...};
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, qubit_array, permutation, buffer, datatype, communicator, environment);
+
+        return ::ket::mpi::gate::unitary_matrix_detail::do_unitary_matrix(
+          mpi_policy, parallel_policy, local_state, permutation, communicator, environment, matrix_first, qubit, qubits...);
+      }
+
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename StateInteger, typename BitInteger,
+        typename Allocator, typename BufferAllocator, typename MatrixIterator, typename... Qubits>
+      inline RandomAccessRange& adj_unitary_matrix(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixIterator const matrix_first,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string{"Adj("}.append(sizeof...(Qubits) + 1u, 'U').append(")"), qubit, qubits...),
+          environment};
+
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto qubit_array = std::array<qubit_type, sizeof...(Qubits) + 1u>{qubit, qubits...};
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, qubit_array, permutation, buffer, communicator, environment);
+
+        return ::ket::mpi::gate::unitary_matrix_detail::do_adj_unitary_matrix(
+          mpi_policy, parallel_policy, local_state, permutation, communicator, environment, matrix_first, qubit, qubits...);
+      }
+
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename StateInteger, typename BitInteger,
+        typename Allocator, typename BufferAllocator, typename DerivedDatatype, typename MatrixIterator, typename... Qubits>
+      inline RandomAccessRange& adj_unitary_matrix(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+        yampi::datatype_base<DerivedDatatype> const& datatype,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        MatrixIterator const matrix_first,
+        ::ket::qubit<StateInteger, BitInteger> const qubit, Qubits const... qubits)
+      {
+        ::ket::mpi::utility::log_with_time_guard<char> print{
+          ::ket::mpi::gate::detail::append_qubits_string(std::string{"Adj("}.append(sizeof...(Qubits) + 1u, 'U').append(")"), qubit, qubits...),
+          environment};
+
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto qubit_array = std::array<qubit_type, sizeof...(Qubits) + 1u>{qubit, qubits...};
+        ::ket::mpi::utility::maybe_interchange_qubits(
+          mpi_policy, parallel_policy,
+          local_state, qubit_array, permutation, buffer, datatype, communicator, environment);
+
+        return ::ket::mpi::gate::unitary_matrix_detail::do_adj_unitary_matrix(
+          mpi_policy, parallel_policy, local_state, permutation, communicator, environment, matrix_first, qubit, qubits...);
+      }
+    } // namespace gate
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_GATE_UNITARY_MATRIX_HPP
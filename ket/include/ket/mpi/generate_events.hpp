@@ -2,8 +2,12 @@
 # define KET_MPI_GENERATE_EVENTS_HPP
 
 # include <cmath>
+# include <cstddef>
 # include <vector>
 # include <iterator>
+# include <algorithm>
+# include <numeric>
+# include <utility>
 
 # include <boost/range/size.hpp>
 # include <boost/range/value_type.hpp>
@@ -15,25 +19,97 @@
 # include <yampi/buffer.hpp>
 # include <yampi/gather.hpp>
 # include <yampi/broadcast.hpp>
-# include <yampi/message_envelope.hpp>
-# include <yampi/algorithm/transform.hpp>
+# include <yampi/all_reduce.hpp>
+# include <yampi/binary_operation.hpp>
 
+# include <ket/generate_events.hpp>
 # include <ket/utility/loop_n.hpp>
 # include <ket/utility/positive_random_value_upto.hpp>
 # include <ket/utility/meta/real_of.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
 # include <ket/mpi/utility/logger.hpp>
-# include <ket/mpi/utility/fill.hpp>
-# include <ket/mpi/utility/transform_inclusive_scan_self.hpp>
-# include <ket/mpi/utility/upper_bound.hpp>
 
 
 namespace ket
 {
   namespace mpi
   {
-    // generate_events
+    namespace generate_events_detail
+    {
+      // variates drawn by the root process, sorted together with the indices of the events
+      template <typename Real, typename RandomNumberGenerator>
+      inline void generate_sorted_variates(
+        std::vector<Real>& variates, std::vector<int>& event_indices,
+        Real const total_probability, int const num_events,
+        RandomNumberGenerator& random_number_generator)
+      {
+        auto sorted_variates = std::vector<std::pair<Real, int>>{};
+        sorted_variates.reserve(num_events);
+        for (auto event_index = int{0}; event_index < num_events; ++event_index)
+          sorted_variates.emplace_back(
+            ::ket::utility::positive_random_value_upto(total_probability, random_number_generator), event_index);
+        std::sort(std::begin(sorted_variates), std::end(sorted_variates));
+
+        variates.clear();
+        variates.reserve(num_events);
+        event_indices.clear();
+        event_indices.reserve(num_events);
+        for (auto const& variate: sorted_variates)
+        {
+          variates.push_back(variate.first);
+          event_indices.push_back(variate.second);
+        }
+      }
+
+      // events whose variates fall into the amplitudes of this process, other elements are zero so that
+      // the results of all processes are combined by summation
+      template <
+        typename StateInteger, typename MpiPolicy, typename ParallelPolicy, typename LocalState, typename Real,
+        typename BitInteger, typename Allocator>
+      inline std::vector<StateInteger> local_events(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        LocalState const& local_state,
+        std::vector<Real> const& block_probabilities, std::vector<Real> const& total_probabilities,
+        std::vector<Real> const& variates, std::vector<int> const& event_indices,
+        ::ket::mpi::qubit_permutation<
+          StateInteger, BitInteger, Allocator> const& permutation,
+        yampi::rank const present_rank)
+      {
+        auto const rank_index = present_rank.mpi_rank();
+        auto const rank_offset = rank_index == 0 ? Real{0} : total_probabilities[rank_index - 1];
+        // the last process also takes variates beyond the total probability caused by rounding errors
+        auto const variates_first = std::lower_bound(std::begin(variates), std::end(variates), rank_offset);
+        auto const variates_last
+          = static_cast<std::size_t>(rank_index + 1) == total_probabilities.size()
+            ? std::end(variates)
+            : std::lower_bound(variates_first, std::end(variates), total_probabilities[rank_index]);
+
+        auto local_variates = std::vector<std::pair<Real, int>>{};
+        local_variates.reserve(variates_last - variates_first);
+        for (auto iter = variates_first; iter != variates_last; ++iter)
+          local_variates.emplace_back(*iter - rank_offset, event_indices[iter - std::begin(variates)]);
+
+        auto result = std::vector<StateInteger>(event_indices.size());
+        ::ket::generate_events_detail::locate_events(
+          parallel_policy, std::begin(local_state), std::end(local_state), block_probabilities,
+          std::begin(local_variates), std::end(local_variates), std::begin(result));
+
+        using ::ket::mpi::utility::rank_index_to_qubit_value;
+        using ::ket::mpi::inverse_permutate_bits;
+        for (auto const& local_variate: local_variates)
+          result[local_variate.second]
+            = inverse_permutate_bits(
+                permutation,
+                rank_index_to_qubit_value(mpi_policy, local_state, present_rank, result[local_variate.second]));
+
+        return result;
+      }
+    } // namespace generate_events_detail
+
+    // generate_events. The amplitudes are not modified. The root process draws all variates at once, and each process
+    // locates the variates which fall into its amplitudes in one parallel pass, so that a fixed number of collective
+    // operations is needed independently of the number of events
     template <
       typename MpiPolicy, typename ParallelPolicy,
       typename ResultAllocator,
@@ -52,88 +128,54 @@ namespace ket
     {
       ket::mpi::utility::log_with_time_guard<char> print{"Generate Events", environment};
 
-      result.clear();
-      result.reserve(num_events);
-
-      using complex_type = typename boost::range_value<LocalState>::type;
-      using std::real;
+      auto const block_probabilities
+        = ::ket::generate_events_detail::block_probabilities(
+            parallel_policy, std::begin(local_state), std::end(local_state));
+      using real_type = typename decltype(block_probabilities)::value_type;
       auto const total_probability
-        = real(::ket::mpi::utility::transform_inclusive_scan_self(
-            parallel_policy, local_state,
-            [](complex_type const& lhs, complex_type const& rhs)
-            { using std::real; return static_cast<complex_type>(real(lhs) + real(rhs)); },
-            [](complex_type const& value)
-            { using std::norm; return static_cast<complex_type>(norm(value)); },
-            environment));
+        = std::accumulate(std::begin(block_probabilities), std::end(block_probabilities), real_type{0});
 
       auto const present_rank = communicator.rank(environment);
       constexpr auto root_rank = yampi::rank{0};
 
-      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      auto total_probabilities = std::vector<real_type>{};
-      if (present_rank == root_rank)
-        total_probabilities.resize(communicator.size(environment));
-
+      auto total_probabilities = std::vector<real_type>(communicator.size(environment));
       yampi::gather(
         yampi::make_buffer(total_probability), std::begin(total_probabilities),
         root_rank, communicator, environment);
 
+      auto variates = std::vector<real_type>{};
+      auto event_indices = std::vector<int>{};
       if (present_rank == root_rank)
+      {
         ::ket::utility::ranges::inclusive_scan(
           total_probabilities, std::begin(total_probabilities));
-
-      for (auto event_index = 0; event_index < num_events; ++event_index)
+        ::ket::mpi::generate_events_detail::generate_sorted_variates(
+          variates, event_indices, total_probabilities.back(), num_events, random_number_generator);
+      }
+      else
       {
-        auto random_value = real_type{};
-        auto result_rank = yampi::rank{};
-        if (present_rank == root_rank)
-        {
-          random_value
-            = ::ket::utility::positive_random_value_upto(
-                total_probabilities.back(), random_number_generator);
-          result_rank
-            = static_cast<yampi::rank>(static_cast<StateInteger>(
-                std::upper_bound(
-                  std::begin(total_probabilities),
-                  std::end(total_probabilities), random_value)
-                - std::begin(total_probabilities)));
-        }
-
-        auto result_mpi_rank = result_rank.mpi_rank();
-        yampi::broadcast(yampi::make_buffer(result_mpi_rank), root_rank, communicator, environment);
-        result_rank = static_cast<yampi::rank>(result_mpi_rank);
-
-        yampi::algorithm::transform(
-          yampi::ignore_status,
-          yampi::make_buffer(random_value),
-          yampi::make_buffer(random_value),
-          [&total_probabilities, result_rank](real_type const random_value)
-          { return random_value - total_probabilities[result_rank.mpi_rank() - 1]; },
-          ::yampi::message_envelope(root_rank, result_rank, communicator),
-          environment);
-
-        auto permutated_result = StateInteger{};
-        if (present_rank == result_rank)
-        {
-          auto const local_result
-            = static_cast<StateInteger>(
-                ::ket::mpi::utility::upper_bound(
-                  local_state, static_cast<complex_type>(random_value),
-                  [](complex_type const& lhs, complex_type const& rhs)
-                  { using std::real; return real(lhs) < real(rhs); },
-                  environment));
-
-          using ::ket::mpi::utility::rank_index_to_qubit_value;
-          permutated_result
-            = rank_index_to_qubit_value(
-                mpi_policy, local_state, result_rank, local_result);
-        }
-
-        yampi::broadcast(yampi::make_buffer(permutated_result), result_rank, communicator, environment);
-
-        using ::ket::mpi::inverse_permutate_bits;
-        result.push_back(inverse_permutate_bits(permutation, permutated_result));
+        variates.resize(num_events);
+        event_indices.resize(num_events);
       }
+
+      yampi::broadcast(
+        yampi::make_buffer(std::begin(total_probabilities), std::end(total_probabilities)),
+        root_rank, communicator, environment);
+      yampi::broadcast(
+        yampi::make_buffer(std::begin(variates), std::end(variates)), root_rank, communicator, environment);
+      yampi::broadcast(
+        yampi::make_buffer(std::begin(event_indices), std::end(event_indices)), root_rank, communicator, environment);
+
+      auto const local_events
+        = ::ket::mpi::generate_events_detail::local_events<StateInteger>(
+            mpi_policy, parallel_policy, local_state, block_probabilities, total_probabilities,
+            variates, event_indices, permutation, present_rank);
+
+      result.assign(num_events, StateInteger{0u});
+      yampi::all_reduce(
+        yampi::make_buffer(std::begin(local_events), std::end(local_events)),
+        std::begin(result), yampi::binary_operation(::yampi::plus_t()),
+        communicator, environment);
     }
 
     template <
@@ -157,88 +199,54 @@ namespace ket
     {
       ket::mpi::utility::log_with_time_guard<char> print{"Generate Events", environment};
 
-      result.clear();
-      result.reserve(num_events);
-
-      using complex_type = typename boost::range_value<LocalState>::type;
-      using std::real;
+      auto const block_probabilities
+        = ::ket::generate_events_detail::block_probabilities(
+            parallel_policy, std::begin(local_state), std::end(local_state));
+      using real_type = typename decltype(block_probabilities)::value_type;
       auto const total_probability
-        = real(::ket::mpi::utility::transform_inclusive_scan_self(
-            parallel_policy, local_state,
-            [](complex_type const& lhs, complex_type const& rhs)
-            { using std::real; return static_cast<complex_type>(real(lhs) + real(rhs)); },
-            [](complex_type const& value)
-            { using std::norm; return static_cast<complex_type>(norm(value)); },
-            environment));
+        = std::accumulate(std::begin(block_probabilities), std::end(block_probabilities), real_type{0});
 
       auto const present_rank = communicator.rank(environment);
       constexpr auto root_rank = yampi::rank{0};
 
-      using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
-      auto total_probabilities = std::vector<real_type>{};
-      if (present_rank == root_rank)
-        total_probabilities.resize(communicator.size(environment));
-
+      auto total_probabilities = std::vector<real_type>(communicator.size(environment));
       yampi::gather(
         yampi::make_buffer(total_probability, real_datatype), std::begin(total_probabilities),
         root_rank, communicator, environment);
 
+      auto variates = std::vector<real_type>{};
+      auto event_indices = std::vector<int>{};
       if (present_rank == root_rank)
+      {
         ::ket::utility::ranges::inclusive_scan(
           total_probabilities, std::begin(total_probabilities));
-
-      for (auto event_index = 0; event_index < num_events; ++event_index)
+        ::ket::mpi::generate_events_detail::generate_sorted_variates(
+          variates, event_indices, total_probabilities.back(), num_events, random_number_generator);
+      }
+      else
       {
-        auto random_value = real_type{};
-        auto result_rank = yampi::rank{};
-        if (present_rank == root_rank)
-        {
-          random_value
-            = ::ket::utility::positive_random_value_upto(
-                total_probabilities.back(), random_number_generator);
-          result_rank
-            = static_cast<yampi::rank>(static_cast<StateInteger>(
-                std::upper_bound(
-                  std::begin(total_probabilities),
-                  std::end(total_probabilities), random_value)
-                - std::begin(total_probabilities)));
-        }
-
-        auto result_mpi_rank = result_rank.mpi_rank();
-        yampi::broadcast(yampi::make_buffer(result_mpi_rank), root_rank, communicator, environment);
-        result_rank = static_cast<yampi::rank>(result_mpi_rank);
-
-        yampi::algorithm::transform(
-          yampi::ignore_status,
-          yampi::make_buffer(random_value, real_datatype),
-          yampi::make_buffer(random_value, real_datatype),
-          [&total_probabilities, result_rank](real_type const random_value)
-          { return random_value - total_probabilities[result_rank.mpi_rank() - 1]; },
-          ::yampi::message_envelope(root_rank, result_rank, communicator),
-          environment);
-
-        StateInteger permutated_result;
-        if (present_rank == result_rank)
-        {
-          StateInteger const local_result
-            = static_cast<StateInteger>(
-                ::ket::mpi::utility::upper_bound(
-                  local_state, static_cast<complex_type>(random_value),
-                  [](complex_type const& lhs, complex_type const& rhs)
-                  { using std::real; return real(lhs) < real(rhs); },
-                  environment));
-
-          using ::ket::mpi::utility::rank_index_to_qubit_value;
-          permutated_result
-            = rank_index_to_qubit_value(
-                mpi_policy, local_state, result_rank, local_result);
-        }
-
-        yampi::broadcast(yampi::make_buffer(permutated_result, state_integer_datatype), result_rank, communicator, environment);
-
-        using ::ket::mpi::inverse_permutate_bits;
-        result.push_back(inverse_permutate_bits(permutation, permutated_result));
+        variates.resize(num_events);
+        event_indices.resize(num_events);
       }
+
+      yampi::broadcast(
+        yampi::make_buffer(std::begin(total_probabilities), std::end(total_probabilities), real_datatype),
+        root_rank, communicator, environment);
+      yampi::broadcast(
+        yampi::make_buffer(std::begin(variates), std::end(variates), real_datatype), root_rank, communicator, environment);
+      yampi::broadcast(
+        yampi::make_buffer(std::begin(event_indices), std::end(event_indices)), root_rank, communicator, environment);
+
+      auto const local_events
+        = ::ket::mpi::generate_events_detail::local_events<StateInteger>(
+            mpi_policy, parallel_policy, local_state, block_probabilities, total_probabilities,
+            variates, event_indices, permutation, present_rank);
+
+      result.assign(num_events, StateInteger{0u});
+      yampi::all_reduce(
+        yampi::make_buffer(std::begin(local_events), std::end(local_events), state_integer_datatype),
+        std::begin(result), yampi::binary_operation(::yampi::plus_t()),
+        communicator, environment);
     }
 
     template <
@@ -0,0 +1,80 @@
+#ifndef KET_MPI_MODULAR_MULTIPLICATION_ASSIGNMENT_HPP
+# define KET_MPI_MODULAR_MULTIPLICATION_ASSIGNMENT_HPP
+
+# include <cstddef>
+# include <array>
+# include <vector>
+# include <type_traits>
+
+# include <boost/range/value_type.hpp>
+
+# include <yampi/environment.hpp>
+# include <yampi/datatype_base.hpp>
+# include <yampi/communicator.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/modular_multiplication_assignment.hpp>
+# include <ket/mpi/register_permutation.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/logger.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    // x = multiplier * x mod divisor. See ::ket::modular_multiplication_assignment
+    template <
+      typename MpiPolicy, typename ParallelPolicy, typename RandomAccessRange,
+      typename StateInteger, typename BitInteger, std::size_t num_qubits,
+      typename Allocator, typename BufferAllocator>
+    inline typename std::enable_if<
+      ::ket::mpi::utility::policy::meta::is_mpi_policy<MpiPolicy>::value,
+      RandomAccessRange&>::type
+    modular_multiplication_assignment(
+      MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+      RandomAccessRange& local_state,
+      std::array< ::ket::qubit<StateInteger, BitInteger>, num_qubits > const& qubits,
+      StateInteger const multiplier, StateInteger const divisor,
+      ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+      std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+      yampi::communicator const& communicator, yampi::environment const& environment)
+    {
+      ::ket::mpi::utility::log_with_time_guard<char> print{"ModularMultiplication", environment};
+
+      return ::ket::mpi::permutate_register(
+        mpi_policy, parallel_policy, local_state, qubits,
+        ::ket::modular_multiplication_assignment_detail::make_modular_multiplication_mappings(qubits, multiplier, divisor),
+        permutation, buffer, communicator, environment);
+    }
+
+    template <
+      typename MpiPolicy, typename ParallelPolicy, typename RandomAccessRange,
+      typename StateInteger, typename BitInteger, std::size_t num_qubits,
+      typename Allocator, typename BufferAllocator, typename DerivedDatatype>
+    inline typename std::enable_if<
+      ::ket::mpi::utility::policy::meta::is_mpi_policy<MpiPolicy>::value,
+      RandomAccessRange&>::type
+    modular_multiplication_assignment(
+      MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+      RandomAccessRange& local_state,
+      std::array< ::ket::qubit<StateInteger, BitInteger>, num_qubits > const& qubits,
+      StateInteger const multiplier, StateInteger const divisor,
+      ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+      std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+      yampi::datatype_base<DerivedDatatype> const& datatype,
+      yampi::communicator const& communicator, yampi::environment const& environment)
+    {
+      ::ket::mpi::utility::log_with_time_guard<char> print{"ModularMultiplication", environment};
+
+      return ::ket::mpi::permutate_register(
+        mpi_policy, parallel_policy, local_state, qubits,
+        ::ket::modular_multiplication_assignment_detail::make_modular_multiplication_mappings(qubits, multiplier, divisor),
+        permutation, buffer, datatype, communicator, environment);
+    }
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_MODULAR_MULTIPLICATION_ASSIGNMENT_HPP
@@ -1,15 +1,14 @@
 #ifndef KET_MPI_PAGE_SPIN_EXPECTATION_VALUE_HPP
 # define KET_MPI_PAGE_SPIN_EXPECTATION_VALUE_HPP
 
-# include <vector>
 # include <array>
-# include <numeric>
 # include <iterator>
 
 # include <boost/math/constants/constants.hpp>
 # include <boost/range/value_type.hpp>
 
 # include <ket/qubit.hpp>
+# include <ket/utility/per_thread.hpp>
 # include <ket/utility/meta/real_of.hpp>
 # include <ket/mpi/state.hpp>
 # include <ket/mpi/permutated.hpp>
@@ -54,9 +53,9 @@ namespace ket
         template <typename HdSpin>
         struct spin_expectation_value
         {
-          std::vector<HdSpin>& spins_in_threads_;
+          ::ket::utility::per_thread<HdSpin>& spins_in_threads_;
 
-          explicit spin_expectation_value(std::vector<HdSpin>& spins_in_threads)
+          explicit spin_expectation_value(::ket::utility::per_thread<HdSpin>& spins_in_threads)
             : spins_in_threads_{spins_in_threads}
           { }
 
@@ -80,7 +79,7 @@ namespace ket
 
         template <typename HdSpin>
         inline ::ket::mpi::page::spin_expectation_value_detail::spin_expectation_value<HdSpin>
-        make_spin_expectation_value(std::vector<HdSpin>& spins_in_threads)
+        make_spin_expectation_value(::ket::utility::per_thread<HdSpin>& spins_in_threads)
         { return ::ket::mpi::page::spin_expectation_value_detail::spin_expectation_value<HdSpin>{spins_in_threads}; }
 # endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
       } // namespace spin_expectation_value_detail
@@ -97,8 +96,7 @@ namespace ket
       {
         using hd_spin_type = std::array<long double, 3u>;
         constexpr auto zero_spin = hd_spin_type{ };
-        auto spins_in_threads
-          = std::vector<hd_spin_type>(::ket::utility::num_threads(parallel_policy), zero_spin);
+        auto spins_in_threads = ::ket::utility::make_per_thread(parallel_policy, zero_spin);
 
 # ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
         ::ket::mpi::gate::page::detail::one_page_qubit_gate<0u>(
@@ -125,8 +123,8 @@ namespace ket
 # endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
 
         auto const hd_spin
-          = std::accumulate(
-              std::begin(spins_in_threads), std::end(spins_in_threads), zero_spin,
+          = spins_in_threads.reduce(
+              zero_spin,
               [](hd_spin_type accumulated_spin, hd_spin_type const& spin)
               {
                 accumulated_spin[0u] += spin[0u];
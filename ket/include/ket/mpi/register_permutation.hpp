@@ -0,0 +1,149 @@
+#ifndef KET_MPI_REGISTER_PERMUTATION_HPP
+# define KET_MPI_REGISTER_PERMUTATION_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <array>
+# include <iterator>
+# include <utility>
+# include <vector>
+# include <type_traits>
+
+# include <boost/range/value_type.hpp>
+
+# include <yampi/environment.hpp>
+# include <yampi/datatype_base.hpp>
+# include <yampi/communicator.hpp>
+# include <yampi/rank.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/register_permutation.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/utility/simple_mpi.hpp>
+# include <ket/mpi/utility/logger.hpp>
+# ifndef NDEBUG
+#   include <ket/utility/is_unique_if_sorted.hpp>
+# endif
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    // The qubits of the register are made local by interchanges of qubits before the permutation, and the other qubits,
+    // whose values are passed to make_mapping, may be global.
+    // make_mapping receives unpermutated qubit values as in ::ket::permutate_register
+    namespace register_permutation_detail
+    {
+      template <
+        typename MpiPolicy, typename ParallelPolicy, typename RandomAccessRange,
+        typename StateInteger, typename BitInteger, std::size_t num_qubits, typename Allocator, typename MakeMapping>
+      inline void permutate_register(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state,
+        std::array< ::ket::qubit<StateInteger, BitInteger>, num_qubits > const& qubits, MakeMapping&& make_mapping,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator> const& permutation,
+        yampi::communicator const& communicator, yampi::environment const& environment)
+      {
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto permutated_target_bits = std::vector<BitInteger>{};
+        permutated_target_bits.reserve(num_qubits);
+        for (auto const& qubit: qubits)
+          permutated_target_bits.push_back(static_cast<BitInteger>(permutation[qubit].qubit()));
+
+        // the kth bit of an unpermutated qubit value is the (permutation[k])th bit of a permutated qubit value
+        auto const num_total_qubits = static_cast<BitInteger>(permutation.size());
+        auto permutated_bits = std::vector<BitInteger>{};
+        permutated_bits.reserve(num_total_qubits);
+        for (auto bit = BitInteger{0u}; bit < num_total_qubits; ++bit)
+          permutated_bits.push_back(static_cast<BitInteger>(permutation[qubit_type{bit}].qubit()));
+        auto const unpermutate
+          = ::ket::utility::bit_gatherer<StateInteger, BitInteger>{permutated_bits};
+
+        auto const data_block_size
+          = static_cast<StateInteger>(::ket::mpi::utility::policy::data_block_size(mpi_policy, local_state, communicator, environment));
+        auto const num_data_blocks
+          = static_cast<StateInteger>(::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment));
+        auto const present_rank = communicator.rank(environment);
+        auto const first = std::begin(local_state);
+        for (auto data_block_index = StateInteger{0u}; data_block_index < num_data_blocks; ++data_block_index)
+        {
+          auto const first_qubit_value
+            = static_cast<StateInteger>(
+                ::ket::mpi::utility::rank_index_to_qubit_value(
+                  mpi_policy, local_state, present_rank, data_block_index * data_block_size));
+          auto const data_block_first = first + data_block_index * data_block_size;
+
+          ::ket::register_permutation_detail::permutate_register<StateInteger>(
+            parallel_policy, data_block_first, data_block_first + data_block_size, permutated_target_bits,
+            [first_qubit_value, &unpermutate](StateInteger const index) { return unpermutate(first_qubit_value + index); },
+            make_mapping);
+        }
+      }
+    } // namespace register_permutation_detail
+
+    template <
+      typename MpiPolicy, typename ParallelPolicy, typename RandomAccessRange,
+      typename StateInteger, typename BitInteger, std::size_t num_qubits, typename MakeMapping,
+      typename Allocator, typename BufferAllocator>
+    inline typename std::enable_if<
+      ::ket::mpi::utility::policy::meta::is_mpi_policy<MpiPolicy>::value,
+      RandomAccessRange&>::type
+    permutate_register(
+      MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+      RandomAccessRange& local_state,
+      std::array< ::ket::qubit<StateInteger, BitInteger>, num_qubits > const& qubits, MakeMapping&& make_mapping,
+      ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+      std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+      yampi::communicator const& communicator, yampi::environment const& environment)
+    {
+      static_assert(std::is_unsigned<StateInteger>::value, "StateInteger should be unsigned");
+      static_assert(std::is_unsigned<BitInteger>::value, "BitInteger should be unsigned");
+      assert(::ket::utility::ranges::is_unique_if_sorted(qubits));
+
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Permutation", environment};
+
+      ::ket::mpi::utility::maybe_interchange_qubits(
+        mpi_policy, parallel_policy, local_state, qubits, permutation, buffer, communicator, environment);
+
+      ::ket::mpi::register_permutation_detail::permutate_register(
+        mpi_policy, parallel_policy, local_state, qubits, std::forward<MakeMapping>(make_mapping),
+        permutation, communicator, environment);
+      return local_state;
+    }
+
+    template <
+      typename MpiPolicy, typename ParallelPolicy, typename RandomAccessRange,
+      typename StateInteger, typename BitInteger, std::size_t num_qubits, typename MakeMapping,
+      typename Allocator, typename BufferAllocator, typename DerivedDatatype>
+    inline typename std::enable_if<
+      ::ket::mpi::utility::policy::meta::is_mpi_policy<MpiPolicy>::value,
+      RandomAccessRange&>::type
+    permutate_register(
+      MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+      RandomAccessRange& local_state,
+      std::array< ::ket::qubit<StateInteger, BitInteger>, num_qubits > const& qubits, MakeMapping&& make_mapping,
+      ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+      std::vector<typename boost::range_value<RandomAccessRange>::type, BufferAllocator>& buffer,
+      yampi::datatype_base<DerivedDatatype> const& datatype,
+      yampi::communicator const& communicator, yampi::environment const& environment)
+    {
+      static_assert(std::is_unsigned<StateInteger>::value, "StateInteger should be unsigned");
+      static_assert(std::is_unsigned<BitInteger>::value, "BitInteger should be unsigned");
+      assert(::ket::utility::ranges::is_unique_if_sorted(qubits));
+
+      ::ket::mpi::utility::log_with_time_guard<char> print{"Permutation", environment};
+
+      ::ket::mpi::utility::maybe_interchange_qubits(
+        mpi_policy, parallel_policy, local_state, qubits, permutation, buffer, datatype, communicator, environment);
+
+      ::ket::mpi::register_permutation_detail::permutate_register(
+        mpi_policy, parallel_policy, local_state, qubits, std::forward<MakeMapping>(make_mapping),
+        permutation, communicator, environment);
+      return local_state;
+    }
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_REGISTER_PERMUTATION_HPP
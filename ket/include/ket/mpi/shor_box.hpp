@@ -2,6 +2,7 @@
 # define KET_MPI_SHOR_BOX_HPP
 
 # include <cassert>
+# include <vector>
 # include <iterator>
 # include <type_traits>
 
@@ -70,34 +71,52 @@ namespace ket
 
       auto const num_exponent_qubits = static_cast<BitInteger>(boost::size(exponent_qubits));
       auto const num_exponents = ::ket::utility::integer_exp2<StateInteger>(num_exponent_qubits);
-      auto modular_exponentiation_value = StateInteger{1u};
 
       using std::pow;
       auto const constant_coefficient
         = static_cast<complex_type>(static_cast<real_type>(pow(static_cast<real_type>(num_exponents), -0.5)));
 
+      // Amplitudes of each data block, 2^L consecutive permutated qubit values, are stored consecutively in one process.
+      // local_offsets[i] is the index in local_state of the first amplitude of the ith data block,
+      // or the size of local_state if the data block is in another process.
+      // This is computed in advance because MPI functions cannot be called in the parallel loop below
+      auto const data_block_size
+        = static_cast<StateInteger>(::ket::mpi::utility::policy::data_block_size(mpi_policy, local_state, communicator, environment));
+      auto const local_state_size = static_cast<StateInteger>(boost::size(local_state));
+      auto const num_data_blocks
+        = ::ket::utility::integer_exp2<StateInteger>(static_cast<BitInteger>(permutation.size())) / data_block_size;
+      auto local_offsets = std::vector<StateInteger>(num_data_blocks, local_state_size);
+
       auto const present_rank = communicator.rank(environment);
-      auto const first = std::begin(local_state);
-      for (auto exponent = StateInteger{0u}; exponent < num_exponents; ++exponent)
+      for (auto data_block_index = StateInteger{0u}; data_block_index < num_data_blocks; ++data_block_index)
       {
-        auto const qubit_value
-          = ::ket::shor_box_detail::calculate_index(
-              ::ket::shor_box_detail::reverse_bits(exponent, num_exponent_qubits), exponent_qubits,
-              modular_exponentiation_value, modular_exponentiation_qubits);
-
-        using ::ket::mpi::permutate_bits;
         auto const rank_index
           = ::ket::mpi::utility::qubit_value_to_rank_index(
-              mpi_policy, local_state, permutate_bits(permutation, qubit_value),
-              communicator, environment);
+              mpi_policy, local_state, data_block_index * data_block_size, communicator, environment);
 
         if (rank_index.first == present_rank)
-          *(first + rank_index.second) = constant_coefficient;
-
-        modular_exponentiation_value *= base;
-        modular_exponentiation_value %= divisor;
+          local_offsets[data_block_index] = rank_index.second;
       }
 
+      auto const first = std::begin(local_state);
+      ::ket::shor_box_detail::loop_exponents(
+        parallel_policy, base, divisor, num_exponents,
+        [first, num_exponent_qubits, &exponent_qubits, &modular_exponentiation_qubits, &permutation,
+         data_block_size, local_state_size, &local_offsets, constant_coefficient](
+          StateInteger const exponent, StateInteger const modular_exponentiation_value)
+        {
+          auto const qubit_value
+            = ::ket::shor_box_detail::calculate_index(
+                ::ket::shor_box_detail::reverse_bits(exponent, num_exponent_qubits), exponent_qubits,
+                modular_exponentiation_value, modular_exponentiation_qubits);
+
+          using ::ket::mpi::permutate_bits;
+          auto const permutated_qubit_value = permutate_bits(permutation, qubit_value);
+          auto const local_offset = local_offsets[permutated_qubit_value / data_block_size];
+          if (local_offset != local_state_size)
+            *(first + (local_offset + permutated_qubit_value % data_block_size)) = constant_coefficient;
+        });
+
       return local_state;
     }
 
@@ -69,6 +69,48 @@ namespace ket
         ParallelPolicy const parallel_policy, ::ket::mpi::permutated<Qubit> const permutated_qubit, Spin& spin)
       { return call_spin_expectation_value<ParallelPolicy, Qubit, Spin>{parallel_policy, permutated_qubit, spin}; }
 # endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
+
+      // the spin of permutated_qubit summed over the amplitudes in this process
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename LocalState, typename StateInteger, typename BitInteger>
+      inline std::array<
+        typename ::ket::utility::meta::real_of<
+          typename boost::range_value<LocalState>::type>::type, 3u>
+      local_spin_expectation_value(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        LocalState& local_state,
+        ::ket::mpi::permutated< ::ket::qubit<StateInteger, BitInteger> > const permutated_qubit,
+        yampi::communicator const& communicator,
+        yampi::environment const& environment)
+      {
+        if (::ket::mpi::page::is_on_page(permutated_qubit, local_state))
+          return ::ket::mpi::page::spin_expectation_value(parallel_policy, local_state, permutated_qubit);
+
+        using complex_type = typename boost::range_value<LocalState>::type;
+        using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
+        using spin_type = std::array<real_type, 3u>;
+        auto spin = spin_type{};
+# ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
+        ::ket::mpi::utility::for_each_local_range(
+          mpi_policy, local_state, communicator, environment,
+          [parallel_policy, permutated_qubit, &spin](auto const first, auto const last)
+          {
+            auto const local_spin
+              = ::ket::spin_expectation_value(parallel_policy, first, last, permutated_qubit.qubit());
+            spin[0u] += local_spin[0u];
+            spin[1u] += local_spin[1u];
+            spin[2u] += local_spin[2u];
+          });
+# else // BOOST_NO_CXX14_GENERIC_LAMBDAS
+        ::ket::mpi::utility::for_each_local_range(
+          mpi_policy, local_state, communicator, environment,
+          ::ket::mpi::spin_expectation_value_detail::make_call_spin_expectation_value(
+            parallel_policy, permutated_qubit, spin));
+# endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
+
+        return spin;
+      }
     } // namespace spin_expectation_value_detail
 
     // all_reduce version
@@ -102,32 +144,9 @@ namespace ket
       using complex_type = typename boost::range_value<LocalState>::type;
       using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
       using spin_type = std::array<real_type, 3u>;
-      auto spin = spin_type{};
-
-      auto const permutated_qubit = permutation[qubit];
-      if (::ket::mpi::page::is_on_page(permutated_qubit, local_state))
-        spin
-          = ::ket::mpi::page::spin_expectation_value(parallel_policy, local_state, permutated_qubit);
-      else
-      {
-# ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
-        ::ket::mpi::utility::for_each_local_range(
-          mpi_policy, local_state, communicator, environment,
-          [parallel_policy, permutated_qubit, &spin](auto const first, auto const last)
-          {
-            auto const local_spin
-              = ::ket::spin_expectation_value(parallel_policy, first, last, permutated_qubit.qubit());
-            spin[0u] += local_spin[0u];
-            spin[1u] += local_spin[1u];
-            spin[2u] += local_spin[2u];
-          });
-# else // BOOST_NO_CXX14_GENERIC_LAMBDAS
-        ::ket::mpi::utility::for_each_local_range(
-          mpi_policy, local_state, communicator, environment,
-          ::ket::mpi::spin_expectation_value_detail::make_call_spin_expectation_value(
-            parallel_policy, permutated_qubit, spin));
-# endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
-      }
+      auto const spin
+        = ::ket::mpi::spin_expectation_value_detail::local_spin_expectation_value(
+            mpi_policy, parallel_policy, local_state, permutation[qubit], communicator, environment);
 
       auto result = spin_type{};
       yampi::all_reduce(
@@ -171,33 +190,9 @@ namespace ket
       using complex_type = typename boost::range_value<LocalState>::type;
       using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
       using spin_type = std::array<real_type, 3u>;
-      auto spin = spin_type{};
-
-      auto const permutated_qubit = permutation[qubit];
-      if (::ket::mpi::page::is_on_page(permutated_qubit, local_state))
-        spin
-          = ::ket::mpi::page::spin_expectation_value(
-              parallel_policy, local_state, permutated_qubit);
-      else
-      {
-# ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
-        ::ket::mpi::utility::for_each_local_range(
-          mpi_policy, local_state, communicator, environment,
-          [parallel_policy, permutated_qubit, &spin](auto const first, auto const last)
-          {
-            auto const local_spin
-              = ::ket::spin_expectation_value(parallel_policy, first, last, permutated_qubit.qubit());
-            spin[0u] += local_spin[0u];
-            spin[1u] += local_spin[1u];
-            spin[2u] += local_spin[2u];
-          });
-# else // BOOST_NO_CXX14_GENERIC_LAMBDAS
-        ::ket::mpi::utility::for_each_local_range(
-          mpi_policy, local_state, communicator, environment,
-          ::ket::mpi::spin_expectation_value_detail::make_call_spin_expectation_value(
-            parallel_policy, permutated_qubit, spin));
-# endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
-      }
+      auto const spin
+        = ::ket::mpi::spin_expectation_value_detail::local_spin_expectation_value(
+            mpi_policy, parallel_policy, local_state, permutation[qubit], communicator, environment);
 
       auto result = spin_type{};
       yampi::all_reduce(
@@ -346,32 +341,9 @@ namespace ket
       using complex_type = typename boost::range_value<LocalState>::type;
       using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
       using spin_type = std::array<real_type, 3u>;
-      auto spin = spin_type{};
-
-      auto const permutated_qubit = permutation[qubit];
-      if (::ket::mpi::page::is_on_page(permutated_qubit, local_state))
-        spin
-          = ::ket::mpi::page::spin_expectation_value(parallel_policy, local_state, permutated_qubit);
-      else
-      {
-# ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
-        ::ket::mpi::utility::for_each_local_range(
-          mpi_policy, local_state, communicator, environment,
-          [parallel_policy, permutated_qubit, &spin](auto const first, auto const last)
-          {
-            auto const local_spin
-              = ::ket::spin_expectation_value(parallel_policy, first, last, permutated_qubit.qubit());
-            spin[0u] += local_spin[0u];
-            spin[1u] += local_spin[1u];
-            spin[2u] += local_spin[2u];
-          });
-# else // BOOST_NO_CXX14_GENERIC_LAMBDAS
-        ::ket::mpi::utility::for_each_local_range(
-          mpi_policy, local_state, communicator, environment,
-          ::ket::mpi::spin_expectation_value_detail::make_call_spin_expectation_value(
-            parallel_policy, permutated_qubit, spin));
-# endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
-      }
+      auto const spin
+        = ::ket::mpi::spin_expectation_value_detail::local_spin_expectation_value(
+            mpi_policy, parallel_policy, local_state, permutation[qubit], communicator, environment);
 
       auto result = spin_type{};
       yampi::reduce(
@@ -419,32 +391,9 @@ namespace ket
       using complex_type = typename boost::range_value<LocalState>::type;
       using real_type = typename ::ket::utility::meta::real_of<complex_type>::type;
       using spin_type = std::array<real_type, 3u>;
-      auto spin = spin_type{};
-
-      auto const permutated_qubit = permutation[qubit];
-      if (::ket::mpi::page::is_on_page(permutated_qubit, local_state))
-        spin
-          = ::ket::mpi::page::spin_expectation_value(parallel_policy, local_state, permutated_qubit);
-      else
-      {
-# ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
-        ::ket::mpi::utility::for_each_local_range(
-          mpi_policy, local_state, communicator, environment,
-          [parallel_policy, permutated_qubit, &spin](auto const first, auto const last)
-          {
-            auto const local_spin
-              = ::ket::spin_expectation_value(parallel_policy, first, last, permutated_qubit.qubit());
-            spin[0u] += local_spin[0u];
-            spin[1u] += local_spin[1u];
-            spin[2u] += local_spin[2u];
-          });
-# else // BOOST_NO_CXX14_GENERIC_LAMBDAS
-        ::ket::mpi::utility::for_each_local_range(
-          mpi_policy, local_state, communicator, environment,
-          ::ket::mpi::spin_expectation_value_detail::make_call_spin_expectation_value(
-            parallel_policy, permutated_qubit, spin));
-# endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
-      }
+      auto const spin
+        = ::ket::mpi::spin_expectation_value_detail::local_spin_expectation_value(
+            mpi_policy, parallel_policy, local_state, permutation[qubit], communicator, environment);
 
       auto result = spin_type{};
       yampi::reduce(
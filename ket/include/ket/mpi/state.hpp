@@ -36,6 +36,7 @@
 # include <ket/control.hpp>
 # include <ket/utility/integer_exp2.hpp>
 # include <ket/utility/loop_n.hpp>
+# include <ket/utility/per_thread.hpp>
 # include <ket/mpi/permutated.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/page/is_on_page.hpp>
@@ -504,9 +505,11 @@ namespace ket
 
         assert(state_size % (num_pages * num_data_blocks) == 0);
 
-        data.clear();
+        // memory is reallocated so that allocators which leave freshly allocated zeros untouched (e.g. ::ket::utility::zero_page_allocator)
+        // do not have to write zeros into it
+        data_type{data.get_allocator()}.swap(data);
         data.reserve(data_size);
-        data.assign(state_size, value_type{0});
+        data.resize(state_size);
 
         using ::ket::mpi::permutate_bits;
         auto const rank_index
@@ -806,8 +809,9 @@ namespace ket
       struct interchange_qubits
       {
         template <
-          typename Allocator, typename Complex, typename Allocator_, typename StateInteger>
+          typename ParallelPolicy, typename Allocator, typename Complex, typename Allocator_, typename StateInteger>
         static void call(
+          ParallelPolicy const,
           ::ket::mpi::state<Complex, has_page_qubits, Allocator>& local_state,
           std::vector<Complex, Allocator_>&,
           StateInteger const data_block_index, StateInteger const data_block_size,
@@ -836,9 +840,10 @@ namespace ket
         }
 
         template <
-          typename Allocator, typename Complex, typename Allocator_, typename StateInteger,
+          typename ParallelPolicy, typename Allocator, typename Complex, typename Allocator_, typename StateInteger,
           typename DerivedDatatype>
         static void call(
+          ParallelPolicy const,
           ::ket::mpi::state<Complex, has_page_qubits, Allocator>& local_state,
           std::vector<Complex, Allocator_>&,
           StateInteger const data_block_index, StateInteger const data_block_size,
@@ -1387,7 +1392,7 @@ namespace ket
           auto const num_pages = local_state.num_pages();
           auto const num_data_blocks = local_state.num_data_blocks();
           auto const num_threads = static_cast<unsigned int>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums = std::vector<Complex>(num_threads * num_data_blocks * num_pages);
+          auto partial_sums = ::ket::utility::per_thread<Complex>(num_threads * num_data_blocks * num_pages);
 
 #   ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
           ::ket::utility::execute(
@@ -1462,7 +1467,7 @@ namespace ket
           auto const num_pages = local_state.num_pages();
           auto const num_data_blocks = local_state.num_data_blocks();
           auto const num_threads = static_cast<unsigned int>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums = std::vector<Complex>(num_threads * num_data_blocks * num_pages);
+          auto partial_sums = ::ket::utility::per_thread<Complex>(num_threads * num_data_blocks * num_pages);
 
 #   ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
           ::ket::utility::execute(
@@ -1950,7 +1955,7 @@ namespace ket
           auto const num_threads = static_cast<unsigned int>(::ket::utility::num_threads(parallel_policy));
           auto const num_pages = local_state.num_pages();
           auto const num_data_blocks = local_state.num_data_blocks();
-          auto partial_sums = std::vector<Complex>(num_threads * num_data_blocks * num_pages);
+          auto partial_sums = ::ket::utility::per_thread<Complex>(num_threads * num_data_blocks * num_pages);
 
 #   ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
           ::ket::utility::execute(
@@ -2018,7 +2023,7 @@ namespace ket
           auto const num_threads = static_cast<unsigned int>(::ket::utility::num_threads(parallel_policy));
           auto const num_pages = local_state.num_pages();
           auto const num_data_blocks = local_state.num_data_blocks();
-          auto partial_sums = std::vector<Complex>(num_threads * num_data_blocks * num_pages);
+          auto partial_sums = ::ket::utility::per_thread<Complex>(num_threads * num_data_blocks * num_pages);
 
 #   ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
           ::ket::utility::execute(
@@ -2411,10 +2416,11 @@ namespace ket
         yampi::communicator const& communicator,
         yampi::environment const& environment) const
       {
-        data.assign(
+        // See the comment in the same function of the primary template
+        data_type{data.get_allocator()}.swap(data);
+        data.resize(
           ::ket::utility::integer_exp2<std::size_t>(num_local_qubits)
-            * ::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment),
-          value_type{0});
+            * ::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment));
 
         using ::ket::mpi::permutate_bits;
         auto const rank_index
@@ -2500,8 +2506,9 @@ namespace ket
       struct interchange_qubits<false>
       {
         template <
-          typename Allocator, typename Complex, typename Allocator_, typename StateInteger>
+          typename ParallelPolicy, typename Allocator, typename Complex, typename Allocator_, typename StateInteger>
         static void call(
+          ParallelPolicy const parallel_policy,
           ::ket::mpi::state<Complex, false, Allocator>& local_state,
           std::vector<Complex, Allocator_>& buffer,
           StateInteger const data_block_index, StateInteger const data_block_size,
@@ -2514,15 +2521,16 @@ namespace ket
           assert(data_block_size == ::ket::utility::integer_exp2<std::size_t>(local_state.num_local_qubits()));
 
           ::ket::mpi::utility::detail::interchange_qubits(
-            local_state.data(), buffer, data_block_index, data_block_size,
+            parallel_policy, local_state.data(), buffer, data_block_index, data_block_size,
             source_local_first_index, source_local_last_index,
             target_rank, communicator, environment);
         }
 
         template <
-          typename Allocator, typename Complex, typename Allocator_, typename StateInteger,
+          typename ParallelPolicy, typename Allocator, typename Complex, typename Allocator_, typename StateInteger,
           typename DerivedDatatype>
         static void call(
+          ParallelPolicy const parallel_policy,
           ::ket::mpi::state<Complex, false, Allocator>& local_state,
           std::vector<Complex, Allocator_>& buffer,
           StateInteger const data_block_index, StateInteger const data_block_size,
@@ -2535,7 +2543,7 @@ namespace ket
           assert(data_block_size == ::ket::utility::integer_exp2<std::size_t>(local_state.num_local_qubits()));
 
           ::ket::mpi::utility::detail::interchange_qubits(
-            local_state.data(), buffer, data_block_index, data_block_size,
+            parallel_policy, local_state.data(), buffer, data_block_index, data_block_size,
             source_local_first_index, source_local_last_index,
             datatype, target_rank, communicator, environment);
         }
@@ -2778,8 +2786,9 @@ namespace ket
         template <typename Complex, bool has_page_qubits, typename Allocator>
         struct interchange_qubits< ::ket::mpi::state<Complex, has_page_qubits, Allocator> >
         {
-          template <typename Allocator_, typename StateInteger>
+          template <typename ParallelPolicy, typename Allocator_, typename StateInteger>
           static void call(
+            ParallelPolicy const parallel_policy,
             ::ket::mpi::state<Complex, has_page_qubits, Allocator>& local_state,
             std::vector<Complex, Allocator_>& buffer,
             StateInteger const data_block_index, StateInteger const data_block_size,
@@ -2789,13 +2798,14 @@ namespace ket
             yampi::communicator const& communicator, yampi::environment const& environment)
           {
             ::ket::mpi::state_detail::interchange_qubits<has_page_qubits>::call(
-              local_state, buffer, data_block_index, data_block_size,
+              parallel_policy, local_state, buffer, data_block_index, data_block_size,
               source_local_first_index, source_local_last_index,
               target_rank, communicator, environment);
           }
 
-          template <typename Allocator_, typename StateInteger, typename DerivedDatatype>
+          template <typename ParallelPolicy, typename Allocator_, typename StateInteger, typename DerivedDatatype>
           static void call(
+            ParallelPolicy const parallel_policy,
             ::ket::mpi::state<Complex, has_page_qubits, Allocator>& local_state,
             std::vector<Complex, Allocator_>& buffer,
             StateInteger const data_block_index, StateInteger const data_block_size,
@@ -2805,7 +2815,7 @@ namespace ket
             yampi::communicator const& communicator, yampi::environment const& environment)
           {
             ::ket::mpi::state_detail::interchange_qubits<has_page_qubits>::call(
-              local_state, buffer, data_block_index, data_block_size,
+              parallel_policy, local_state, buffer, data_block_index, data_block_size,
               source_local_first_index, source_local_last_index,
               datatype, target_rank, communicator, environment);
           }
@@ -3,6 +3,7 @@
 
 # include <cassert>
 # include <cstddef>
+# include <array>
 # include <iterator>
 # include <type_traits>
 # include <vector>
@@ -13,18 +14,16 @@
 # include <yampi/environment.hpp>
 # include <yampi/datatype_base.hpp>
 # include <yampi/communicator.hpp>
+# include <yampi/rank.hpp>
 
 # include <ket/qubit.hpp>
-# include <ket/control.hpp>
+# include <ket/swapped_fourier_transform.hpp>
 # include <ket/utility/generate_phase_coefficients.hpp>
 # include <ket/utility/loop_n.hpp>
-# include <ket/utility/meta/real_of.hpp>
+# include <ket/utility/bit_gatherer.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
-# include <ket/mpi/gate/hadamard.hpp>
-# include <ket/mpi/gate/controlled_phase_shift.hpp>
 # include <ket/mpi/utility/simple_mpi.hpp>
 # include <ket/mpi/utility/logger.hpp>
-# include <ket/utility/integer_exp2.hpp>
 # ifndef NDEBUG
 #   include <ket/utility/is_unique_if_sorted.hpp>
 # endif
@@ -34,6 +33,77 @@ namespace ket
 {
   namespace mpi
   {
+    namespace swapped_fourier_transform_detail
+    {
+      // Each pass of ::ket::swapped_fourier_transform needs its target qubit to be local, which is done by interchange_qubit.
+      // Lower qubits, whose values determine the combined phase factor, may be global
+      template <
+        typename MpiPolicy, typename ParallelPolicy,
+        typename RandomAccessRange, typename Qubits,
+        typename StateInteger, typename BitInteger, typename Allocator, typename InterchangeQubit>
+      inline void swapped_fourier_transform(
+        MpiPolicy const& mpi_policy, ParallelPolicy const parallel_policy,
+        RandomAccessRange& local_state, Qubits const& qubits,
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator> const& permutation,
+        yampi::communicator const& communicator, yampi::environment const& environment,
+        bool const is_adjoint, InterchangeQubit&& interchange_qubit)
+      {
+        auto const num_qubits = static_cast<BitInteger>(boost::size(qubits));
+        if (num_qubits == BitInteger{0u})
+          return;
+
+        using complex_type = typename boost::range_value<RandomAccessRange>::type;
+        auto const phase_factors
+          = ::ket::swapped_fourier_transform_detail::phase_factors<complex_type, StateInteger, BitInteger>{num_qubits};
+
+        // first_qubit_values[i] is the permutated qubit value of the first amplitude of the ith local data block,
+        // which does not change by interchanges of qubits
+        auto const data_block_size
+          = static_cast<StateInteger>(::ket::mpi::utility::policy::data_block_size(mpi_policy, local_state, communicator, environment));
+        auto const num_data_blocks
+          = static_cast<StateInteger>(::ket::mpi::utility::policy::num_data_blocks(mpi_policy, communicator, environment));
+        auto const present_rank = communicator.rank(environment);
+        auto first_qubit_values = std::vector<StateInteger>{};
+        first_qubit_values.reserve(num_data_blocks);
+        for (auto data_block_index = StateInteger{0u}; data_block_index < num_data_blocks; ++data_block_index)
+          first_qubit_values.push_back(
+            ::ket::mpi::utility::rank_index_to_qubit_value(
+              mpi_policy, local_state, present_rank, data_block_index * data_block_size));
+
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto const qubits_first = std::begin(qubits);
+        auto permutated_bits = std::vector<BitInteger>(num_qubits);
+        auto const first = std::begin(local_state);
+        for (auto index = BitInteger{0u}; index < num_qubits; ++index)
+        {
+          auto const target_bit = is_adjoint ? index : num_qubits - index - BitInteger{1u};
+          interchange_qubit(qubit_type{qubits_first[target_bit]});
+
+          for (auto bit_index = BitInteger{0u}; bit_index < num_qubits; ++bit_index)
+            permutated_bits[bit_index] = static_cast<BitInteger>(permutation[qubit_type{qubits_first[bit_index]}].qubit());
+          auto const lower_bit_gatherer
+            = ::ket::utility::bit_gatherer<StateInteger, BitInteger>{permutated_bits, target_bit};
+          auto const phase_shift = static_cast<BitInteger>(num_qubits - target_bit - BitInteger{1u});
+          auto const permutated_target_qubit = qubit_type{permutated_bits[target_bit]};
+
+          for (auto data_block_index = StateInteger{0u}; data_block_index < num_data_blocks; ++data_block_index)
+          {
+            auto const data_block_first = first + data_block_index * data_block_size;
+            if (is_adjoint)
+              ::ket::swapped_fourier_transform_detail::adj_transform_qubit(
+                parallel_policy, data_block_first, data_block_first + data_block_size,
+                first_qubit_values[data_block_index], permutated_target_qubit,
+                lower_bit_gatherer, phase_shift, phase_factors);
+            else
+              ::ket::swapped_fourier_transform_detail::transform_qubit(
+                parallel_policy, data_block_first, data_block_first + data_block_size,
+                first_qubit_values[data_block_index], permutated_target_qubit,
+                lower_bit_gatherer, phase_shift, phase_factors);
+          }
+        }
+      }
+    } // namespace swapped_fourier_transform_detail
+
     template <
       typename MpiPolicy, typename ParallelPolicy,
       typename RandomAccessRange, typename Qubits, typename PhaseCoefficientsAllocator,
@@ -63,34 +133,18 @@ namespace ket
 
       ::ket::mpi::utility::log_with_time_guard<char> print{"Fourier", environment};
 
-      auto const num_qubits = boost::size(qubits);
-      ::ket::utility::generate_phase_coefficients(phase_coefficients, num_qubits);
-
-      auto const qubits_first = std::begin(qubits);
-
-      for (auto index = decltype(num_qubits){0u}; index < num_qubits; ++index)
-      {
-        auto target_bit = num_qubits - index - decltype(num_qubits){1u};
-
-        using ::ket::mpi::gate::hadamard;
-        hadamard(
-          mpi_policy, parallel_policy,
-          local_state, qubits_first[target_bit], permutation,
-          buffer, communicator, environment);
+      ::ket::utility::generate_phase_coefficients(phase_coefficients, boost::size(qubits));
 
-        for (auto phase_exponent = decltype(num_qubits){2u};
-             phase_exponent <= num_qubits - index; ++phase_exponent)
+      using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+      ::ket::mpi::swapped_fourier_transform_detail::swapped_fourier_transform(
+        mpi_policy, parallel_policy, local_state, qubits, permutation, communicator, environment, false,
+        [&mpi_policy, parallel_policy, &local_state, &permutation, &buffer, &communicator, &environment](
+          qubit_type const qubit)
         {
-          auto const control_bit = target_bit - (phase_exponent - decltype(phase_exponent){1u});
-
-          using ::ket::mpi::gate::controlled_phase_shift_coeff;
-          controlled_phase_shift_coeff(
+          ::ket::mpi::utility::maybe_interchange_qubits(
             mpi_policy, parallel_policy,
-            local_state, phase_coefficients[phase_exponent],
-            qubits_first[target_bit], ::ket::make_control(qubits_first[control_bit]),
-            permutation, buffer, communicator, environment);
-        }
-      }
+            local_state, std::array<qubit_type, 1u>{qubit}, permutation, buffer, communicator, environment);
+        });
 
       return local_state;
     }
@@ -126,34 +180,18 @@ namespace ket
 
       ::ket::mpi::utility::log_with_time_guard<char> print{"Fourier", environment};
 
-      auto const num_qubits = boost::size(qubits);
-      ::ket::utility::generate_phase_coefficients(phase_coefficients, num_qubits);
-
-      auto const qubits_first = std::begin(qubits);
-
-      for (auto index = decltype(num_qubits){0u}; index < num_qubits; ++index)
-      {
-        auto target_bit = num_qubits - index - decltype(num_qubits){1u};
-
-        using ::ket::mpi::gate::hadamard;
-        hadamard(
-          mpi_policy, parallel_policy,
-          local_state, qubits_first[target_bit], permutation,
-          buffer, datatype, communicator, environment);
+      ::ket::utility::generate_phase_coefficients(phase_coefficients, boost::size(qubits));
 
-        for (auto phase_exponent = decltype(num_qubits){2u};
-             phase_exponent <= num_qubits - index; ++phase_exponent)
+      using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+      ::ket::mpi::swapped_fourier_transform_detail::swapped_fourier_transform(
+        mpi_policy, parallel_policy, local_state, qubits, permutation, communicator, environment, false,
+        [&mpi_policy, parallel_policy, &local_state, &permutation, &buffer, &datatype, &communicator, &environment](
+          qubit_type const qubit)
         {
-          auto const control_bit = target_bit - (phase_exponent - decltype(phase_exponent){1u});
-
-          using ::ket::mpi::gate::controlled_phase_shift_coeff;
-          controlled_phase_shift_coeff(
+          ::ket::mpi::utility::maybe_interchange_qubits(
             mpi_policy, parallel_policy,
-            local_state, phase_coefficients[phase_exponent],
-            qubits_first[target_bit], ::ket::make_control(qubits_first[control_bit]),
-            permutation, buffer, datatype, communicator, environment);
-        }
-      }
+            local_state, std::array<qubit_type, 1u>{qubit}, permutation, buffer, datatype, communicator, environment);
+        });
 
       return local_state;
     }
@@ -468,32 +506,18 @@ namespace ket
 
       ::ket::mpi::utility::log_with_time_guard<char> print{"Adj(Fourier)", environment};
 
-      auto const num_qubits = boost::size(qubits);
-      ::ket::utility::generate_phase_coefficients(phase_coefficients, num_qubits);
+      ::ket::utility::generate_phase_coefficients(phase_coefficients, boost::size(qubits));
 
-      auto const qubits_first = std::begin(qubits);
-
-      for (auto target_bit = decltype(num_qubits){0u}; target_bit < num_qubits; ++target_bit)
-      {
-        for (auto index = decltype(target_bit){0u}; index < target_bit; ++index)
+      using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+      ::ket::mpi::swapped_fourier_transform_detail::swapped_fourier_transform(
+        mpi_policy, parallel_policy, local_state, qubits, permutation, communicator, environment, true,
+        [&mpi_policy, parallel_policy, &local_state, &permutation, &buffer, &communicator, &environment](
+          qubit_type const qubit)
         {
-          auto const phase_exponent = decltype(target_bit){1u} + target_bit - index;
-          auto const control_bit = target_bit - (phase_exponent - decltype(phase_exponent){1u});
-
-          using ::ket::mpi::gate::adj_controlled_phase_shift_coeff;
-          adj_controlled_phase_shift_coeff(
+          ::ket::mpi::utility::maybe_interchange_qubits(
             mpi_policy, parallel_policy,
-            local_state, phase_coefficients[phase_exponent], qubits_first[target_bit],
-            ::ket::make_control(qubits_first[control_bit]),
-            permutation, buffer, communicator, environment);
-        }
-
-        using ::ket::mpi::gate::adj_hadamard;
-        adj_hadamard(
-          mpi_policy, parallel_policy,
-          local_state, qubits_first[target_bit], permutation,
-          buffer, communicator, environment);
-      }
+            local_state, std::array<qubit_type, 1u>{qubit}, permutation, buffer, communicator, environment);
+        });
 
       return local_state;
     }
@@ -529,32 +553,18 @@ namespace ket
 
       ::ket::mpi::utility::log_with_time_guard<char> print{"Adj(Fourier)", environment};
 
-      auto const num_qubits = boost::size(qubits);
-      ::ket::utility::generate_phase_coefficients(phase_coefficients, num_qubits);
+      ::ket::utility::generate_phase_coefficients(phase_coefficients, boost::size(qubits));
 
-      auto const qubits_first = std::begin(qubits);
-
-      for (auto target_bit = decltype(num_qubits){0u}; target_bit < num_qubits; ++target_bit)
-      {
-        for (auto index = decltype(target_bit){0u}; index < target_bit; ++index)
+      using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+      ::ket::mpi::swapped_fourier_transform_detail::swapped_fourier_transform(
+        mpi_policy, parallel_policy, local_state, qubits, permutation, communicator, environment, true,
+        [&mpi_policy, parallel_policy, &local_state, &permutation, &buffer, &datatype, &communicator, &environment](
+          qubit_type const qubit)
         {
-          auto const phase_exponent = decltype(target_bit){1u} + target_bit - index;
-          auto const control_bit = target_bit - (phase_exponent - decltype(phase_exponent){1u});
-
-          using ::ket::mpi::gate::adj_controlled_phase_shift_coeff;
-          adj_controlled_phase_shift_coeff(
+          ::ket::mpi::utility::maybe_interchange_qubits(
             mpi_policy, parallel_policy,
-            local_state, phase_coefficients[phase_exponent], qubits_first[target_bit],
-            ::ket::make_control(qubits_first[control_bit]),
-            permutation, buffer, datatype, communicator, environment);
-        }
-
-        using ::ket::mpi::gate::adj_hadamard;
-        adj_hadamard(
-          mpi_policy, parallel_policy,
-          local_state, qubits_first[target_bit], permutation,
-          buffer, datatype, communicator, environment);
-      }
+            local_state, std::array<qubit_type, 1u>{qubit}, permutation, buffer, datatype, communicator, environment);
+        });
 
       return local_state;
     }
@@ -0,0 +1,263 @@
+#ifndef KET_MPI_UTILITY_COMPRESSED_INTERCHANGE_HPP
+# define KET_MPI_UTILITY_COMPRESSED_INTERCHANGE_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <cstdint>
+# include <cstring>
+# include <cmath>
+# include <complex>
+# include <vector>
+# include <algorithm>
+# include <iterator>
+# include <type_traits>
+# include <limits>
+
+# include <yampi/environment.hpp>
+# include <yampi/communicator.hpp>
+# include <yampi/buffer.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/status.hpp>
+# include <yampi/algorithm/swap.hpp>
+
+# include <ket/utility/loop_n.hpp>
+
+# ifndef KET_COMPRESSED_INTERCHANGE_CHUNK_SIZE
+#   define KET_COMPRESSED_INTERCHANGE_CHUNK_SIZE 65536
+# endif // KET_COMPRESSED_INTERCHANGE_CHUNK_SIZE
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      // numbers of bytes sent by this process in interchanges of qubits with and without compression
+      struct compressed_interchange_bytes
+      {
+        std::size_t num_compressed_bytes;
+        std::size_t num_uncompressed_bytes;
+      }; // struct compressed_interchange_bytes
+
+      inline ::ket::mpi::utility::compressed_interchange_bytes& compressed_interchange_statistics()
+      {
+        static auto result = ::ket::mpi::utility::compressed_interchange_bytes{0u, 0u};
+        return result;
+      }
+
+      // amplitudes whose real and imaginary parts are not larger than this value in magnitude are sent as zeros.
+      // Compression is lossless if this value is 0
+      inline double& compressed_interchange_tolerance()
+      {
+        static auto result = 0.0;
+        return result;
+      }
+
+      namespace compressed_interchange_detail
+      {
+        // Compressed data are a sequence of segments. Each segment consists of the number of literal amplitudes, the number of zeros,
+        // and the literal amplitudes
+        using count_type = std::uint64_t;
+
+        template <typename Value>
+        constexpr std::ptrdiff_t min_num_zeros_in_segment()
+        { return static_cast<std::ptrdiff_t>(std::size_t{1u} + 2u * sizeof(count_type) / sizeof(Value)); }
+
+        // Every segment but the last one has more bytes of zeros than those of its counts, so that only the counts of the last segment
+        // may make compressed data larger than uncompressed ones
+        template <typename Value>
+        constexpr std::size_t max_num_compressed_bytes(std::size_t const num_values)
+        { return 2u * sizeof(count_type) + num_values * sizeof(Value); }
+
+        // returns the number of bytes written to bytes
+        template <typename RandomAccessIterator>
+        inline std::size_t compress(
+          RandomAccessIterator const first, RandomAccessIterator const last, double const tolerance, char* const bytes)
+        {
+          using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+          static_assert(std::is_trivially_copyable<value_type>::value, "value_type should be trivially copyable");
+          constexpr auto min_num_zeros = ::ket::mpi::utility::compressed_interchange_detail::min_num_zeros_in_segment<value_type>();
+
+          auto const is_zero
+            = [tolerance](value_type const& value)
+              {
+                using std::real;
+                using std::imag;
+                using std::abs;
+                return abs(real(value)) <= tolerance and abs(imag(value)) <= tolerance;
+              };
+
+          auto byte_iter = bytes;
+          for (auto literal_first = first; literal_first != last; )
+          {
+            // short runs of zeros are sent as literal amplitudes because they are not larger than counts
+            auto literal_last = literal_first;
+            auto zero_last = literal_first;
+            while (literal_last != last)
+            {
+              zero_last = std::find_if_not(literal_last, last, is_zero);
+              if (zero_last - literal_last >= min_num_zeros or zero_last == last)
+                break;
+
+              literal_last = std::find_if(zero_last, last, is_zero);
+              zero_last = literal_last;
+            }
+
+            auto const num_literals = static_cast<count_type>(literal_last - literal_first);
+            auto const num_zeros = static_cast<count_type>(zero_last - literal_last);
+            std::memcpy(byte_iter, std::addressof(num_literals), sizeof(count_type));
+            byte_iter += sizeof(count_type);
+            std::memcpy(byte_iter, std::addressof(num_zeros), sizeof(count_type));
+            byte_iter += sizeof(count_type);
+            // [literal_first, literal_last) may be not contiguous
+            for (auto iter = literal_first; iter != literal_last; ++iter, byte_iter += sizeof(value_type))
+              std::memcpy(byte_iter, std::addressof(*iter), sizeof(value_type));
+
+            literal_first = zero_last;
+          }
+
+          return static_cast<std::size_t>(byte_iter - bytes);
+        }
+
+        template <typename RandomAccessIterator>
+        inline void decompress(
+          char const* const bytes, std::size_t const num_bytes, RandomAccessIterator const first, RandomAccessIterator const last)
+        {
+          using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+          auto byte_iter = bytes;
+          auto iter = first;
+          while (iter != last)
+          {
+            auto num_literals = count_type{};
+            std::memcpy(std::addressof(num_literals), byte_iter, sizeof(count_type));
+            byte_iter += sizeof(count_type);
+            auto num_zeros = count_type{};
+            std::memcpy(std::addressof(num_zeros), byte_iter, sizeof(count_type));
+            byte_iter += sizeof(count_type);
+
+            for (auto count = count_type{0u}; count < num_literals; ++count, ++iter, byte_iter += sizeof(value_type))
+              std::memcpy(std::addressof(*iter), byte_iter, sizeof(value_type));
+
+            iter = std::fill_n(iter, num_zeros, value_type{});
+          }
+          assert(byte_iter == bytes + num_bytes);
+          static_cast<void>(num_bytes);
+        }
+      } // namespace compressed_interchange_detail
+
+      // Exchanges [first, last) with [first, last) of target_rank. Both sides are compressed independently, so that their sizes may differ.
+      // [first, last) is split into chunks of KET_COMPRESSED_INTERCHANGE_CHUNK_SIZE amplitudes, which are compressed and decompressed in parallel.
+      // Compressed data are put into buffer, and they are sent in messages of at most INT_MAX bytes
+      template <typename ParallelPolicy, typename RandomAccessIterator, typename Value, typename Allocator>
+      inline void compressed_swap(
+        ParallelPolicy const parallel_policy,
+        RandomAccessIterator const first, RandomAccessIterator const last, std::vector<Value, Allocator>& buffer,
+        yampi::rank const target_rank, yampi::communicator const& communicator, yampi::environment const& environment)
+      {
+        using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        using count_type = ::ket::mpi::utility::compressed_interchange_detail::count_type;
+
+        auto const num_values = static_cast<std::size_t>(last - first);
+        constexpr auto chunk_size = std::size_t{KET_COMPRESSED_INTERCHANGE_CHUNK_SIZE};
+        auto const num_chunks = (num_values + chunk_size - std::size_t{1u}) / chunk_size;
+        constexpr auto max_num_chunk_bytes = ::ket::mpi::utility::compressed_interchange_detail::max_num_compressed_bytes<value_type>(chunk_size);
+
+        // Compressed data begin with the number of bytes of each chunk. Compressed chunks are put at intervals of max_num_chunk_bytes bytes
+        // at first, and then they are packed. Received data are put just after sent data
+        auto const num_header_bytes = num_chunks * sizeof(count_type);
+        auto const max_num_bytes = num_header_bytes + num_chunks * max_num_chunk_bytes;
+        auto const to_buffer_size = [](std::size_t const num_bytes) { return (num_bytes + sizeof(Value) - std::size_t{1u}) / sizeof(Value); };
+        buffer.reserve(to_buffer_size(2u * max_num_bytes));
+        buffer.resize(to_buffer_size(max_num_bytes));
+
+        auto const send_bytes = reinterpret_cast<char*>(buffer.data());
+        auto const tolerance = ::ket::mpi::utility::compressed_interchange_tolerance();
+        ::ket::utility::loop_n(
+          parallel_policy, num_chunks,
+          [first, last, num_chunks, num_header_bytes, send_bytes, tolerance](std::size_t const chunk_index, int const)
+          {
+            auto const chunk_first = first + static_cast<std::ptrdiff_t>(chunk_index * chunk_size);
+            auto const chunk_last = chunk_index + std::size_t{1u} == num_chunks ? last : chunk_first + static_cast<std::ptrdiff_t>(chunk_size);
+            auto const num_chunk_bytes
+              = static_cast<count_type>(::ket::mpi::utility::compressed_interchange_detail::compress(
+                  chunk_first, chunk_last, tolerance, send_bytes + num_header_bytes + chunk_index * max_num_chunk_bytes));
+            std::memcpy(send_bytes + chunk_index * sizeof(count_type), std::addressof(num_chunk_bytes), sizeof(count_type));
+          });
+
+        auto num_send_bytes = static_cast<count_type>(num_header_bytes);
+        for (auto chunk_index = std::size_t{0u}; chunk_index < num_chunks; ++chunk_index)
+        {
+          auto num_chunk_bytes = count_type{};
+          std::memcpy(std::addressof(num_chunk_bytes), send_bytes + chunk_index * sizeof(count_type), sizeof(count_type));
+          std::memmove(send_bytes + num_send_bytes, send_bytes + num_header_bytes + chunk_index * max_num_chunk_bytes, num_chunk_bytes);
+          num_send_bytes += num_chunk_bytes;
+        }
+
+        auto num_receive_bytes = count_type{};
+        yampi::algorithm::swap(
+          yampi::ignore_status,
+          yampi::make_buffer(std::addressof(num_send_bytes), std::addressof(num_send_bytes) + 1),
+          yampi::make_buffer(std::addressof(num_receive_bytes), std::addressof(num_receive_bytes) + 1),
+          target_rank, communicator, environment);
+        assert(num_receive_bytes <= max_num_bytes);
+
+        // buffer is not reallocated because its capacity is enough
+        buffer.resize(to_buffer_size(static_cast<std::size_t>(num_send_bytes + num_receive_bytes)));
+        assert(reinterpret_cast<char*>(buffer.data()) == send_bytes);
+        auto const receive_bytes = send_bytes + num_send_bytes;
+
+        // MPI counts are int
+        constexpr auto max_num_message_bytes = static_cast<count_type>(std::numeric_limits<int>::max());
+        for (auto offset = count_type{0u}; offset < std::max(num_send_bytes, num_receive_bytes); offset += max_num_message_bytes)
+        {
+          auto const send_offset = std::min(offset, num_send_bytes);
+          auto const receive_offset = std::min(offset, num_receive_bytes);
+          auto const num_message_send_bytes = std::min(max_num_message_bytes, num_send_bytes - send_offset);
+          auto const num_message_receive_bytes = std::min(max_num_message_bytes, num_receive_bytes - receive_offset);
+          yampi::algorithm::swap(
+            yampi::ignore_status,
+            yampi::make_buffer(send_bytes + send_offset, send_bytes + send_offset + num_message_send_bytes),
+            yampi::make_buffer(receive_bytes + receive_offset, receive_bytes + receive_offset + num_message_receive_bytes),
+            target_rank, communicator, environment);
+        }
+
+        // the number of bytes of each chunk in the header is replaced with its position
+        auto chunk_offset = static_cast<count_type>(num_header_bytes);
+        for (auto chunk_index = std::size_t{0u}; chunk_index < num_chunks; ++chunk_index)
+        {
+          auto num_chunk_bytes = count_type{};
+          std::memcpy(std::addressof(num_chunk_bytes), receive_bytes + chunk_index * sizeof(count_type), sizeof(count_type));
+          std::memcpy(receive_bytes + chunk_index * sizeof(count_type), std::addressof(chunk_offset), sizeof(count_type));
+          chunk_offset += num_chunk_bytes;
+        }
+        assert(chunk_offset == num_receive_bytes);
+
+        ::ket::utility::loop_n(
+          parallel_policy, num_chunks,
+          [first, last, num_chunks, num_receive_bytes, receive_bytes](std::size_t const chunk_index, int const)
+          {
+            auto const chunk_first = first + static_cast<std::ptrdiff_t>(chunk_index * chunk_size);
+            auto const chunk_last = chunk_index + std::size_t{1u} == num_chunks ? last : chunk_first + static_cast<std::ptrdiff_t>(chunk_size);
+
+            auto chunk_offset = count_type{};
+            std::memcpy(std::addressof(chunk_offset), receive_bytes + chunk_index * sizeof(count_type), sizeof(count_type));
+            auto chunk_end = num_receive_bytes;
+            if (chunk_index + std::size_t{1u} < num_chunks)
+              std::memcpy(std::addressof(chunk_end), receive_bytes + (chunk_index + std::size_t{1u}) * sizeof(count_type), sizeof(count_type));
+
+            ::ket::mpi::utility::compressed_interchange_detail::decompress(
+              receive_bytes + chunk_offset, static_cast<std::size_t>(chunk_end - chunk_offset), chunk_first, chunk_last);
+          });
+
+        auto& statistics = ::ket::mpi::utility::compressed_interchange_statistics();
+        statistics.num_compressed_bytes += sizeof(count_type) + static_cast<std::size_t>(num_send_bytes);
+        statistics.num_uncompressed_bytes += num_values * sizeof(value_type);
+      }
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_COMPRESSED_INTERCHANGE_HPP
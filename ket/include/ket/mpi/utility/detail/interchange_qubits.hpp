@@ -2,11 +2,15 @@
 # define KET_MPI_UTILITY_DETAIL_INTERCHANGE_QUBITS_HPP
 
 # include <cassert>
+# include <cstddef>
 # include <vector>
+# include <algorithm>
 # include <iterator>
 # include <utility>
 # include <type_traits>
 
+# include <boost/config.hpp>
+
 # include <boost/range/value_type.hpp>
 
 # include <yampi/environment.hpp>
@@ -16,6 +20,19 @@
 # include <yampi/rank.hpp>
 # include <yampi/status.hpp>
 # include <yampi/algorithm/swap.hpp>
+# ifdef KET_USE_COMPRESSED_INTERCHANGE
+#   include <ket/mpi/utility/compressed_interchange.hpp>
+# endif // KET_USE_COMPRESSED_INTERCHANGE
+# ifdef KET_USE_PIPELINED_INTERCHANGE
+#   include <yampi/request.hpp>
+#   include <yampi/tag.hpp>
+# endif // KET_USE_PIPELINED_INTERCHANGE
+
+# ifdef KET_USE_PIPELINED_INTERCHANGE
+#   ifndef KET_PIPELINED_INTERCHANGE_CHUNK_SIZE
+#     define KET_PIPELINED_INTERCHANGE_CHUNK_SIZE 65536
+#   endif // KET_PIPELINED_INTERCHANGE_CHUNK_SIZE
+# endif // KET_USE_PIPELINED_INTERCHANGE
 
 
 namespace ket
@@ -24,13 +41,108 @@ namespace ket
   {
     namespace utility
     {
+# ifdef KET_USE_PIPELINED_INTERCHANGE
+      namespace interchange_qubits_detail
+      {
+        // the number of chunks which are sent and received at the same time
+        constexpr std::size_t num_chunks_in_flight = 4u;
+
+        // exchanges [first, last) with target_rank in chunks of KET_PIPELINED_INTERCHANGE_CHUNK_SIZE elements.
+        // Each received chunk is copied from buffer to [first, last) while later chunks are still in flight
+        template <typename RandomAccessIterator, typename BufferIterator, typename MakeBuffer>
+        inline void pipelined_swap(
+          RandomAccessIterator const first, RandomAccessIterator const last, BufferIterator const buffer_first,
+          yampi::rank const target_rank, yampi::communicator const& communicator, yampi::environment const& environment,
+          MakeBuffer make_buffer)
+        {
+          using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+          auto const size = last - first;
+          auto const chunk_size = static_cast<difference_type>(KET_PIPELINED_INTERCHANGE_CHUNK_SIZE);
+          auto const num_chunks = (size + chunk_size - difference_type{1}) / chunk_size;
+
+          // messages with the same tag are received in the order they are sent, so the k-th receive always matches the k-th send
+          auto send_requests = std::vector<yampi::request>(num_chunks_in_flight);
+          auto receive_requests = std::vector<yampi::request>(num_chunks_in_flight);
+          auto const start_chunk
+            = [first, buffer_first, size, chunk_size, target_rank, &communicator, &environment, &make_buffer, &send_requests, &receive_requests](
+                difference_type const chunk_index)
+              {
+                auto const chunk_first = chunk_index * chunk_size;
+                auto const chunk_last = std::min(chunk_first + chunk_size, size);
+                auto const request_index = static_cast<std::size_t>(chunk_index) % num_chunks_in_flight;
+
+                receive_requests[request_index]
+                  = yampi::request{
+                      yampi::tags::immediate_receive, make_buffer(buffer_first + chunk_first, buffer_first + chunk_last),
+                      target_rank, yampi::tag{0}, communicator, environment};
+                send_requests[request_index]
+                  = yampi::request{
+                      yampi::tags::immediate_send, make_buffer(first + chunk_first, first + chunk_last),
+                      target_rank, yampi::tag{0}, communicator, environment};
+              };
+
+          auto const num_first_chunks = std::min(num_chunks, static_cast<difference_type>(num_chunks_in_flight));
+          for (auto chunk_index = difference_type{0}; chunk_index < num_first_chunks; ++chunk_index)
+            start_chunk(chunk_index);
+
+          for (auto chunk_index = difference_type{0}; chunk_index < num_chunks; ++chunk_index)
+          {
+            auto const request_index = static_cast<std::size_t>(chunk_index) % num_chunks_in_flight;
+            receive_requests[request_index].wait(yampi::ignore_status, environment);
+            // the chunk in [first, last) must not be overwritten until it has been sent
+            send_requests[request_index].wait(yampi::ignore_status, environment);
+
+            auto const chunk_first = chunk_index * chunk_size;
+            auto const chunk_last = std::min(chunk_first + chunk_size, size);
+            std::copy(buffer_first + chunk_first, buffer_first + chunk_last, first + chunk_first);
+
+            auto const next_chunk_index = chunk_index + static_cast<difference_type>(num_chunks_in_flight);
+            if (next_chunk_index < num_chunks)
+              start_chunk(next_chunk_index);
+          }
+        }
+
+#   ifdef BOOST_NO_CXX14_GENERIC_LAMBDAS
+        struct buffer_maker
+        {
+          template <typename Iterator>
+          auto operator()(Iterator const buffer_first, Iterator const buffer_last) const
+          -> decltype(yampi::make_buffer(buffer_first, buffer_last))
+          { return yampi::make_buffer(buffer_first, buffer_last); }
+        }; // struct buffer_maker
+
+        template <typename DerivedDatatype>
+        class datatype_buffer_maker
+        {
+          yampi::datatype_base<DerivedDatatype> const& datatype_;
+
+         public:
+          explicit datatype_buffer_maker(yampi::datatype_base<DerivedDatatype> const& datatype)
+            : datatype_{datatype}
+          { }
+
+          template <typename Iterator>
+          auto operator()(Iterator const buffer_first, Iterator const buffer_last) const
+          -> decltype(yampi::make_buffer(buffer_first, buffer_last, datatype_))
+          { return yampi::make_buffer(buffer_first, buffer_last, datatype_); }
+        }; // class datatype_buffer_maker<DerivedDatatype>
+
+        template <typename DerivedDatatype>
+        inline ::ket::mpi::utility::interchange_qubits_detail::datatype_buffer_maker<DerivedDatatype>
+        make_datatype_buffer_maker(yampi::datatype_base<DerivedDatatype> const& datatype)
+        { return ::ket::mpi::utility::interchange_qubits_detail::datatype_buffer_maker<DerivedDatatype>{datatype}; }
+#   endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
+      } // namespace interchange_qubits_detail
+
+# endif // KET_USE_PIPELINED_INTERCHANGE
       namespace dispatch
       {
         template <typename LocalState_>
         struct interchange_qubits
         {
-          template <typename LocalState, typename Allocator, typename StateInteger>
+          template <typename ParallelPolicy, typename LocalState, typename Allocator, typename StateInteger>
           static void call(
+            ParallelPolicy const parallel_policy,
             LocalState&& local_state,
             std::vector<typename boost::range_value<LocalState>::type, Allocator>& buffer,
             StateInteger const data_block_index, StateInteger const data_block_size,
@@ -45,6 +157,20 @@ namespace ket
             auto const last = std::begin(local_state) + data_block_index * data_block_size + source_local_last_index;
 
 #ifndef BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
+# ifdef KET_USE_COMPRESSED_INTERCHANGE
+            ::ket::mpi::utility::compressed_swap(parallel_policy, first, last, buffer, target_rank, communicator, environment);
+# elif defined(KET_USE_PIPELINED_INTERCHANGE)
+            buffer.resize(source_local_last_index - source_local_first_index);
+#   ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
+            ::ket::mpi::utility::interchange_qubits_detail::pipelined_swap(
+              first, last, std::begin(buffer), target_rank, communicator, environment,
+              [](auto const buffer_first, auto const buffer_last) { return yampi::make_buffer(buffer_first, buffer_last); });
+#   else // BOOST_NO_CXX14_GENERIC_LAMBDAS
+            ::ket::mpi::utility::interchange_qubits_detail::pipelined_swap(
+              first, last, std::begin(buffer), target_rank, communicator, environment,
+              ::ket::mpi::utility::interchange_qubits_detail::buffer_maker{});
+#   endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
+# else // KET_USE_COMPRESSED_INTERCHANGE
             buffer.resize(source_local_last_index - source_local_first_index);
             yampi::algorithm::swap(
               yampi::ignore_status,
@@ -52,6 +178,7 @@ namespace ket
               yampi::make_buffer(std::begin(buffer), std::end(buffer)),
               target_rank, communicator, environment);
             std::copy(std::begin(buffer), std::end(buffer), first);
+# endif // KET_USE_COMPRESSED_INTERCHANGE
 #else // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
             if (buffer.empty())
             {
@@ -95,8 +222,9 @@ namespace ket
 #endif // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
           }
 
-          template <typename LocalState, typename Allocator, typename StateInteger, typename DerivedDatatype>
+          template <typename ParallelPolicy, typename LocalState, typename Allocator, typename StateInteger, typename DerivedDatatype>
           static void call(
+            ParallelPolicy const parallel_policy,
             LocalState&& local_state,
             std::vector<typename boost::range_value<LocalState>::type, Allocator>& buffer,
             StateInteger const data_block_index, StateInteger const data_block_size,
@@ -111,6 +239,22 @@ namespace ket
             auto const last = std::begin(local_state) + data_block_index * data_block_size + source_local_last_index;
 
 #ifndef BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
+# ifdef KET_USE_COMPRESSED_INTERCHANGE
+            // compressed amplitudes are sent as bytes, so that datatype is not used
+            ::ket::mpi::utility::compressed_swap(parallel_policy, first, last, buffer, target_rank, communicator, environment);
+# elif defined(KET_USE_PIPELINED_INTERCHANGE)
+            buffer.resize(source_local_last_index - source_local_first_index);
+#   ifndef BOOST_NO_CXX14_GENERIC_LAMBDAS
+            ::ket::mpi::utility::interchange_qubits_detail::pipelined_swap(
+              first, last, std::begin(buffer), target_rank, communicator, environment,
+              [&datatype](auto const buffer_first, auto const buffer_last)
+              { return yampi::make_buffer(buffer_first, buffer_last, datatype); });
+#   else // BOOST_NO_CXX14_GENERIC_LAMBDAS
+            ::ket::mpi::utility::interchange_qubits_detail::pipelined_swap(
+              first, last, std::begin(buffer), target_rank, communicator, environment,
+              ::ket::mpi::utility::interchange_qubits_detail::make_datatype_buffer_maker(datatype));
+#   endif // BOOST_NO_CXX14_GENERIC_LAMBDAS
+# else // KET_USE_COMPRESSED_INTERCHANGE
             buffer.resize(source_local_last_index - source_local_first_index);
             yampi::algorithm::swap(
               yampi::ignore_status,
@@ -118,6 +262,7 @@ namespace ket
               yampi::make_buffer(std::begin(buffer), std::end(buffer), datatype),
               target_rank, communicator, environment);
             std::copy(std::begin(buffer), std::end(buffer), first);
+# endif // KET_USE_COMPRESSED_INTERCHANGE
 #else // BRAKET_ENABLE_MULTIPLE_USES_OF_BUFFER_FOR_ONE_DATA_TRANSFER_IF_NO_PAGE_EXISTS
             if (buffer.empty())
             {
@@ -165,8 +310,9 @@ namespace ket
 
       namespace detail
       {
-        template <typename LocalState, typename Allocator, typename StateInteger>
+        template <typename ParallelPolicy, typename LocalState, typename Allocator, typename StateInteger>
         inline void interchange_qubits(
+          ParallelPolicy const parallel_policy,
           LocalState&& local_state,
           std::vector<typename boost::range_value<LocalState>::type, Allocator>& buffer,
           StateInteger const data_block_index, StateInteger const data_block_size,
@@ -178,14 +324,15 @@ namespace ket
           using interchange_qubits_
             = ::ket::mpi::utility::dispatch::interchange_qubits<typename std::remove_cv<typename std::remove_reference<LocalState>::type>::type>;
           interchange_qubits_::call(
-            std::forward<LocalState>(local_state), buffer,
+            parallel_policy, std::forward<LocalState>(local_state), buffer,
             data_block_index, data_block_size,
             source_local_first_index, source_local_last_index,
             target_rank, communicator, environment);
         }
 
-        template <typename LocalState, typename Allocator, typename StateInteger, typename DerivedDatatype>
+        template <typename ParallelPolicy, typename LocalState, typename Allocator, typename StateInteger, typename DerivedDatatype>
         inline void interchange_qubits(
+          ParallelPolicy const parallel_policy,
           LocalState&& local_state,
           std::vector<typename boost::range_value<LocalState>::type, Allocator>& buffer,
           StateInteger const data_block_index, StateInteger const data_block_size,
@@ -197,7 +344,7 @@ namespace ket
           using interchange_qubits_
             = ::ket::mpi::utility::dispatch::interchange_qubits<typename std::remove_cv<typename std::remove_reference<LocalState>::type>::type>;
           interchange_qubits_::call(
-            std::forward<LocalState>(local_state), buffer,
+            parallel_policy, std::forward<LocalState>(local_state), buffer,
             data_block_index, data_block_size,
             source_local_first_index, source_local_last_index,
             datatype, target_rank, communicator, environment);
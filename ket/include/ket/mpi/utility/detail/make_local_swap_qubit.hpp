@@ -1,8 +1,6 @@
 #ifndef KET_MPI_UTILITY_DETAIL_MAKE_LOCAL_SWAP_QUBIT_HPP
 # define KET_MPI_UTILITY_DETAIL_MAKE_LOCAL_SWAP_QUBIT_HPP
 
-# include <algorithm>
-# include <iterator>
 # include <type_traits>
 
 # include <boost/range/value_type.hpp>
@@ -11,10 +9,10 @@
 # include <yampi/environment.hpp>
 
 # include <ket/qubit.hpp>
-# include <ket/utility/contains.hpp>
 # include <ket/mpi/permutated.hpp>
 # include <ket/mpi/qubit_permutation.hpp>
 # include <ket/mpi/utility/detail/swap_permutated_local_qubits.hpp>
+# include <ket/mpi/utility/detail/swappable_permutated_qubit.hpp>
 
 
 namespace ket
@@ -46,26 +44,16 @@ namespace ket
                qubit_type>::value),
             "value_type of UnswappableQubits must be the same to qubit_type");
 
+          auto const permutated_other_qubit
+            = ::ket::mpi::utility::detail::swappable_permutated_qubit(
+                permutation, unswappable_qubits, permutated_local_swap_qubit);
+
           using ::ket::mpi::inverse;
           auto const local_swap_qubit = inverse(permutation)[permutated_local_swap_qubit];
-
-          if (not ::ket::utility::contains(
-                std::begin(unswappable_qubits), std::end(unswappable_qubits),
-                local_swap_qubit))
+          if (permutated_other_qubit == permutated_local_swap_qubit)
             return local_swap_qubit;
 
-          auto permutated_other_qubit = permutated_local_swap_qubit;
-          auto other_qubit = qubit_type{};
-          do
-          {
-            --permutated_other_qubit;
-            using ::ket::mpi::inverse;
-            other_qubit = inverse(permutation)[permutated_other_qubit];
-          }
-          while (
-            ::ket::utility::contains(
-              std::begin(unswappable_qubits), std::end(unswappable_qubits),
-              other_qubit));
+          auto const other_qubit = inverse(permutation)[permutated_other_qubit];
 
           ::ket::mpi::utility::detail::swap_permutated_local_qubits(
             parallel_policy, local_state,
@@ -0,0 +1,43 @@
+#ifndef KET_MPI_UTILITY_DETAIL_SWAPPABLE_PERMUTATED_QUBIT_HPP
+# define KET_MPI_UTILITY_DETAIL_SWAPPABLE_PERMUTATED_QUBIT_HPP
+
+# include <iterator>
+
+# include <ket/qubit.hpp>
+# include <ket/utility/contains.hpp>
+# include <ket/mpi/permutated.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      namespace detail
+      {
+        // the highest permutated qubit not above permutated_qubit whose qubit is not in unswappable_qubits.
+        // make_local_swap_qubit exchanges the qubit at permutated_qubit with it before interchanging a global qubit
+        template <typename StateInteger, typename BitInteger, typename Allocator, typename UnswappableQubits>
+        inline ::ket::mpi::permutated< ::ket::qubit<StateInteger, BitInteger> >
+        swappable_permutated_qubit(
+          ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator> const& permutation,
+          UnswappableQubits const& unswappable_qubits,
+          ::ket::mpi::permutated< ::ket::qubit<StateInteger, BitInteger> > permutated_qubit)
+        {
+          using ::ket::mpi::inverse;
+          while (::ket::utility::contains(
+                   std::begin(unswappable_qubits), std::end(unswappable_qubits),
+                   inverse(permutation)[permutated_qubit]))
+            --permutated_qubit;
+
+          return permutated_qubit;
+        }
+      } // namespace detail
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_DETAIL_SWAPPABLE_PERMUTATED_QUBIT_HPP
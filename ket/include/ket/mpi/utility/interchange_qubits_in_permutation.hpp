@@ -0,0 +1,68 @@
+#ifndef KET_MPI_UTILITY_INTERCHANGE_QUBITS_IN_PERMUTATION_HPP
+# define KET_MPI_UTILITY_INTERCHANGE_QUBITS_IN_PERMUTATION_HPP
+
+# include <cstddef>
+# include <vector>
+
+# include <ket/qubit.hpp>
+# include <ket/mpi/permutated.hpp>
+# include <ket/mpi/qubit_permutation.hpp>
+# include <ket/mpi/utility/detail/swappable_permutated_qubit.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      // Updates permutation as maybe_interchange_qubits of simple_mpi policy does
+      // without touching any state, and returns the number of global qubits interchanged.
+      // Local qubits in qubits are kept as they are, and the i-th global qubit is
+      // interchanged with the qubit at (least_global_permutated_qubit - (i + 1)).
+      template <typename StateInteger, typename BitInteger, typename Allocator, typename Qubits>
+      inline std::size_t interchange_qubits_in_permutation(
+        ::ket::mpi::qubit_permutation<StateInteger, BitInteger, Allocator>& permutation,
+        ::ket::mpi::permutated< ::ket::qubit<StateInteger, BitInteger> > const least_global_permutated_qubit,
+        Qubits const& qubits)
+      {
+        using qubit_type = ::ket::qubit<StateInteger, BitInteger>;
+        auto unswappable_qubits = std::vector<qubit_type>{};
+        auto global_swap_qubits = std::vector<qubit_type>{};
+        for (auto const qubit: qubits)
+          if (permutation[qubit] < least_global_permutated_qubit)
+            unswappable_qubits.push_back(qubit);
+          else
+            global_swap_qubits.push_back(qubit);
+
+        auto const num_global_swap_qubits = global_swap_qubits.size();
+        auto local_swap_qubits = std::vector<qubit_type>(num_global_swap_qubits);
+
+        using ::ket::mpi::inverse;
+        using ::ket::mpi::permutate;
+        for (auto index = std::size_t{0u}; index < num_global_swap_qubits; ++index)
+        {
+          auto const permutated_local_swap_qubit
+            = least_global_permutated_qubit - static_cast<BitInteger>(std::size_t{1u} + index);
+          auto const permutated_other_qubit
+            = ::ket::mpi::utility::detail::swappable_permutated_qubit(
+                permutation, unswappable_qubits, permutated_local_swap_qubit);
+          if (permutated_other_qubit != permutated_local_swap_qubit)
+            permutate(
+              permutation,
+              inverse(permutation)[permutated_local_swap_qubit], inverse(permutation)[permutated_other_qubit]);
+
+          local_swap_qubits[index] = inverse(permutation)[permutated_local_swap_qubit];
+        }
+
+        for (auto index = std::size_t{0u}; index < num_global_swap_qubits; ++index)
+          permutate(permutation, global_swap_qubits[index], local_swap_qubits[index]);
+
+        return num_global_swap_qubits;
+      }
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_INTERCHANGE_QUBITS_IN_PERMUTATION_HPP
@@ -0,0 +1,72 @@
+#ifndef KET_MPI_UTILITY_MAKE_NODE_AWARE_COMMUNICATOR_HPP
+# define KET_MPI_UTILITY_MAKE_NODE_AWARE_COMMUNICATOR_HPP
+
+# include <mpi.h>
+
+# include <yampi/communicator.hpp>
+# include <yampi/environment.hpp>
+# include <yampi/rank.hpp>
+# include <yampi/error.hpp>
+
+
+namespace ket
+{
+  namespace mpi
+  {
+    namespace utility
+    {
+      namespace make_node_aware_communicator_detail
+      {
+        inline void check_error_code(int const error_code, yampi::environment const& environment)
+        {
+          if (error_code != MPI_SUCCESS)
+            throw yampi::error(error_code, "ket::mpi::utility::make_node_aware_communicator", environment);
+        }
+      } // namespace make_node_aware_communicator_detail
+
+      // Renumbers processes so that processes sharing memory on the same node have consecutive ranks, keeping the order of nodes
+      // and the order of processes on each node. Each unit of ::ket::mpi::utility::policy::unit_mpi consists of consecutive ranks,
+      // so every unit is on one node and exchanges of unit qubits are sent within the node if the number of processes on each node
+      // is a multiple of the number of processes in each unit. Only ranks are reordered: amplitudes are still sent by MPI messages,
+      // not through shared memory windows. The process of rank 0 keeps rank 0
+      inline yampi::communicator make_node_aware_communicator(
+        yampi::communicator const& communicator, yampi::environment const& environment)
+      {
+        using ::ket::mpi::utility::make_node_aware_communicator_detail::check_error_code;
+        auto const rank = communicator.rank(environment);
+
+        // yampi does not wrap MPI_Comm_split_type
+        auto node_mpi_communicator = MPI_Comm{};
+        check_error_code(
+            MPI_Comm_split_type(communicator.mpi_comm(), MPI_COMM_TYPE_SHARED, rank.mpi_rank(), MPI_INFO_NULL, &node_mpi_communicator), environment);
+        auto rank_in_node = 0;
+        check_error_code(MPI_Comm_rank(node_mpi_communicator, &rank_in_node), environment);
+        auto num_processes_in_node = 0;
+        check_error_code(MPI_Comm_size(node_mpi_communicator, &num_processes_in_node), environment);
+
+        // the first rank of processes on this node is the sum of numbers of processes on nodes whose least ranks are less than that of this node
+        auto first_rank_in_node = 0;
+        auto const is_least_rank_in_node = rank_in_node == 0;
+        auto least_rank_mpi_communicator = MPI_Comm{};
+        check_error_code(
+            MPI_Comm_split(
+              communicator.mpi_comm(), is_least_rank_in_node ? 0 : MPI_UNDEFINED, rank.mpi_rank(), &least_rank_mpi_communicator), environment);
+        if (is_least_rank_in_node)
+        {
+          check_error_code(MPI_Exscan(&num_processes_in_node, &first_rank_in_node, 1, MPI_INT, MPI_SUM, least_rank_mpi_communicator), environment);
+          // the result of MPI_Exscan is undefined in the first process
+          if (rank.mpi_rank() == 0)
+            first_rank_in_node = 0;
+          check_error_code(MPI_Comm_free(&least_rank_mpi_communicator), environment);
+        }
+        check_error_code(MPI_Bcast(&first_rank_in_node, 1, MPI_INT, 0, node_mpi_communicator), environment);
+        check_error_code(MPI_Comm_free(&node_mpi_communicator), environment);
+
+        return yampi::communicator{communicator, yampi::color{0}, first_rank_in_node + rank_in_node, environment};
+      }
+    } // namespace utility
+  } // namespace mpi
+} // namespace ket
+
+
+#endif // KET_MPI_UTILITY_MAKE_NODE_AWARE_COMMUNICATOR_HPP
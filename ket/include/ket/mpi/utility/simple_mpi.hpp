@@ -332,7 +332,7 @@ namespace ket
               mpi_policy, parallel_policy, local_state,
               least_global_permutated_qubit, permutated_global_swap_qubits,
               qubits, unswappable_qubits, permutation, communicator, environment,
-              [&buffer](
+              [parallel_policy, &buffer](
                 LocalState& local_state,
                 StateInteger const data_block_index, StateInteger const data_block_size,
                 StateInteger const source_local_first_index, StateInteger const source_local_last_index,
@@ -340,7 +340,7 @@ namespace ket
                 yampi::communicator const& communicator, yampi::environment const& environment)
               {
                 ::ket::mpi::utility::detail::interchange_qubits(
-                  local_state, buffer,
+                  parallel_policy, local_state, buffer,
                   data_block_index, data_block_size,
                   source_local_first_index, source_local_last_index,
                   target_rank, communicator, environment);
@@ -352,7 +352,7 @@ namespace ket
               mpi_policy, parallel_policy, local_state,
               least_global_permutated_qubit, permutated_global_swap_qubits,
               qubits, unswappable_qubits, permutation, communicator, environment,
-              [&buffer](
+              [parallel_policy, &buffer](
                 LocalState& local_state,
                 StateInteger const data_block_index, StateInteger const data_block_size,
                 StateInteger const source_local_first_index, StateInteger const source_local_last_index,
@@ -360,7 +360,7 @@ namespace ket
                 yampi::communicator const& communicator, yampi::environment const& environment)
               {
                 ::ket::mpi::utility::detail::interchange_qubits(
-                  local_state, buffer,
+                  parallel_policy, local_state, buffer,
                   data_block_index, data_block_size,
                   source_local_first_index, source_local_last_index,
                   target_rank, communicator, environment);
@@ -404,7 +404,7 @@ namespace ket
             for (auto index = std::size_t{0u}; index < num_qubits_of_operation; ++index)
             {
               if (permutated_global_swap_qubits[index] >= least_global_permutated_qubit)
-                return;
+                continue;
 
               call_lower_maybe_interchange_qubits(
                 index,
@@ -418,7 +418,7 @@ namespace ket
               mpi_policy, parallel_policy, local_state,
               least_global_permutated_qubit, permutated_global_swap_qubits,
               qubits, unswappable_qubits, permutation, communicator, environment,
-              [&buffer, &datatype](
+              [parallel_policy, &buffer, &datatype](
                 LocalState& local_state,
                 StateInteger const data_block_index, StateInteger const data_block_size,
                 StateInteger const source_local_first_index, StateInteger const source_local_last_index,
@@ -426,7 +426,7 @@ namespace ket
                 yampi::communicator const& communicator, yampi::environment const& environment)
               {
                 ::ket::mpi::utility::detail::interchange_qubits(
-                  local_state, buffer,
+                  parallel_policy, local_state, buffer,
                   data_block_index, data_block_size,
                   source_local_first_index, source_local_last_index,
                   datatype, target_rank, communicator, environment);
@@ -438,7 +438,7 @@ namespace ket
               mpi_policy, parallel_policy, local_state,
               least_global_permutated_qubit, permutated_global_swap_qubits,
               qubits, unswappable_qubits, permutation, communicator, environment,
-              [&buffer, &datatype](
+              [parallel_policy, &buffer, &datatype](
                 LocalState& local_state,
                 StateInteger const data_block_index, StateInteger const data_block_size,
                 StateInteger const source_local_first_index, StateInteger const source_local_last_index,
@@ -446,7 +446,7 @@ namespace ket
                 yampi::communicator const& communicator, yampi::environment const& environment)
               {
                 ::ket::mpi::utility::detail::interchange_qubits(
-                  local_state, buffer,
+                  parallel_policy, local_state, buffer,
                   data_block_index, data_block_size,
                   source_local_first_index, source_local_last_index,
                   datatype, target_rank, communicator, environment);
@@ -573,9 +573,12 @@ namespace ket
               std::next(global_qubit_value_masks.rbegin()), global_qubit_value_masks.rbegin(),
               std::minus<StateInteger>{});
 
+            // key == b''b'b for global_qubit_value == xxbxb'xb''xx, so that the local rank of this process is equal to the index of
+            // the chunk (0000000|)b''b'b(00000000) of each process which is sent to this process by one all-to-all communication
             auto key = StateInteger{0u};
             for (auto index = std::size_t{0u}; index < num_qubits_of_operation; ++index)
-              key &= (((global_qubit_value bitand permutated_global_qubit_masks[index]) << least_global_permutated_qubit) >> permutated_global_swap_qubits[index]) << permutated_local_swap_qubits[index];
+              key |= (((global_qubit_value bitand permutated_global_qubit_masks[index]) << least_global_permutated_qubit) >> permutated_global_swap_qubits[index]) << permutated_local_swap_qubits[index];
+            key = key >> (least_global_permutated_qubit - static_cast<BitInteger>(num_qubits_of_operation));
 
             auto color_integer = StateInteger{0u};
             for (auto index = std::size_t{0u}; index <= num_qubits_of_operation; ++index)
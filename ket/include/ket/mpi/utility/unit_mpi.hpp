@@ -545,7 +545,7 @@ namespace ket
               mpi_policy, parallel_policy, local_state,
               least_unit_permutated_qubit, permutated_nonlocal_swap_qubits,
               qubits, unswappable_qubits, permutation, communicator, environment,
-              [&buffer](
+              [parallel_policy, &buffer](
                 LocalState& local_state,
                 StateInteger const data_block_index, StateInteger const data_block_size,
                 StateInteger const source_local_first_index, StateInteger const source_local_last_index,
@@ -553,7 +553,7 @@ namespace ket
                 yampi::communicator const& communicator, yampi::environment const& environment)
               {
                 ::ket::mpi::utility::detail::interchange_qubits(
-                  local_state, buffer,
+                  parallel_policy, local_state, buffer,
                   data_block_index, data_block_size,
                   source_local_first_index, source_local_last_index,
                   target_rank, communicator, environment);
@@ -576,7 +576,7 @@ namespace ket
               mpi_policy, parallel_policy, local_state,
               least_unit_permutated_qubit, permutated_nonlocal_swap_qubits,
               qubits, unswappable_qubits, permutation, communicator, environment,
-              [&buffer](
+              [parallel_policy, &buffer](
                 LocalState& local_state,
                 StateInteger const data_block_index, StateInteger const data_block_size,
                 StateInteger const source_local_first_index, StateInteger const source_local_last_index,
@@ -584,7 +584,7 @@ namespace ket
                 yampi::communicator const& communicator, yampi::environment const& environment)
               {
                 ::ket::mpi::utility::detail::interchange_qubits(
-                  local_state, buffer,
+                  parallel_policy, local_state, buffer,
                   data_block_index, data_block_size,
                   source_local_first_index, source_local_last_index,
                   target_rank, communicator, environment);
@@ -642,7 +642,7 @@ namespace ket
               mpi_policy, parallel_policy, local_state,
               least_unit_permutated_qubit, permutated_nonlocal_swap_qubits,
               qubits, unswappable_qubits, permutation, communicator, environment,
-              [&buffer, &datatype](
+              [parallel_policy, &buffer, &datatype](
                 LocalState& local_state,
                 StateInteger const data_block_index, StateInteger const data_block_size,
                 StateInteger const source_local_first_index, StateInteger const source_local_last_index,
@@ -650,7 +650,7 @@ namespace ket
                 yampi::communicator const& communicator, yampi::environment const& environment)
               {
                 ::ket::mpi::utility::detail::interchange_qubits(
-                  local_state, buffer,
+                  parallel_policy, local_state, buffer,
                   data_block_index, data_block_size,
                   source_local_first_index, source_local_last_index,
                   datatype, target_rank, communicator, environment);
@@ -673,7 +673,7 @@ namespace ket
               mpi_policy, parallel_policy, local_state,
               least_unit_permutated_qubit, permutated_nonlocal_swap_qubits,
               qubits, unswappable_qubits, permutation, communicator, environment,
-              [&buffer, &datatype](
+              [parallel_policy, &buffer, &datatype](
                 LocalState& local_state,
                 StateInteger const data_block_index, StateInteger const data_block_size,
                 StateInteger const source_local_first_index, StateInteger const source_local_last_index,
@@ -681,7 +681,7 @@ namespace ket
                 yampi::communicator const& communicator, yampi::environment const& environment)
               {
                 ::ket::mpi::utility::detail::interchange_qubits(
-                  local_state, buffer,
+                  parallel_policy, local_state, buffer,
                   data_block_index, data_block_size,
                   source_local_first_index, source_local_last_index,
                   datatype, target_rank, communicator, environment);
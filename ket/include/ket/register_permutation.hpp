@@ -0,0 +1,172 @@
+#ifndef KET_REGISTER_PERMUTATION_HPP
+# define KET_REGISTER_PERMUTATION_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <algorithm>
+# include <iterator>
+# include <vector>
+# include <utility>
+# include <type_traits>
+
+# include <boost/range/size.hpp>
+# include <boost/range/value_type.hpp>
+
+# include <ket/qubit.hpp>
+# include <ket/meta/state_integer_of.hpp>
+# include <ket/meta/bit_integer_of.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/integer_exp2.hpp>
+# include <ket/utility/per_thread.hpp>
+# include <ket/utility/bit_gatherer.hpp>
+# ifndef NDEBUG
+#   include <ket/utility/integer_log2.hpp>
+#   include <ket/utility/is_unique_if_sorted.hpp>
+# endif
+
+
+namespace ket
+{
+  // Arithmetic on a register of n qubits, e.g. addition modulo 2^n, maps each basis state to another basis state.
+  // For each value of the other qubits, the 2^n amplitudes of the register are gathered into a buffer in the permutated order
+  // and scattered back, so that each amplitude is read and written once instead of passing over the state for every gate
+  // of an arithmetic circuit.
+  // make_mapping(qubit_value) is called once for each value of the other qubits, where qubit_value is the qubit value whose
+  // bits of the register are zeros, and returns a function object which maps a value of the register to another one.
+  // The function object should be a bijection on [0, 2^n). The kth qubit of the register is the kth bit of its value
+  namespace register_permutation_detail
+  {
+    // target_bits[k] is the bit position in [first, last) of the kth qubit of the register.
+    // to_qubit_value(index) converts an index of [first, last) into the qubit value passed to make_mapping
+    template <
+      typename StateInteger, typename ParallelPolicy, typename RandomAccessIterator,
+      typename BitInteger, typename ToQubitValue, typename MakeMapping>
+    inline void permutate_register(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      std::vector<BitInteger> const& target_bits, ToQubitValue to_qubit_value, MakeMapping make_mapping)
+    {
+      auto const num_target_bits = static_cast<BitInteger>(target_bits.size());
+      assert(
+        ::ket::utility::integer_exp2<StateInteger>(::ket::utility::integer_log2<BitInteger>(last - first))
+        == static_cast<StateInteger>(last - first));
+      assert(::ket::utility::integer_exp2<StateInteger>(num_target_bits) <= static_cast<StateInteger>(last - first));
+
+      // offsets[v] is the index offset of the amplitude whose register value is v
+      auto const register_size = ::ket::utility::integer_exp2<StateInteger>(num_target_bits);
+      auto offsets = std::vector<StateInteger>(register_size);
+      offsets[0u] = StateInteger{0u};
+      for (auto bit_index = BitInteger{0u}; bit_index < num_target_bits; ++bit_index)
+      {
+        auto const value_mask = ::ket::utility::integer_exp2<StateInteger>(bit_index);
+        auto const offset_mask = ::ket::utility::integer_exp2<StateInteger>(target_bits[bit_index]);
+        for (auto value = StateInteger{0u}; value < value_mask; ++value)
+          offsets[value bitor value_mask] = offsets[value] bitor offset_mask;
+      }
+
+      // zeros of the register are inserted into an index of the other qubits from the lowest bit position
+      auto sorted_target_bits = target_bits;
+      std::sort(std::begin(sorted_target_bits), std::end(sorted_target_bits));
+      auto lower_bits_masks = std::vector<StateInteger>{};
+      lower_bits_masks.reserve(num_target_bits);
+      for (auto const target_bit: sorted_target_bits)
+        lower_bits_masks.push_back(::ket::utility::integer_exp2<StateInteger>(target_bit) - StateInteger{1u});
+
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      auto buffers = ::ket::utility::make_per_thread(parallel_policy, std::vector<complex_type>(register_size));
+
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy,
+        static_cast<StateInteger>(last - first) >> num_target_bits,
+        [first, register_size, &offsets, &lower_bits_masks, &buffers, &to_qubit_value, &make_mapping](
+          StateInteger const value_wo_register, int const thread_index)
+        {
+          auto base_index = value_wo_register;
+          for (auto const lower_bits_mask: lower_bits_masks)
+            base_index = ((base_index bitand compl lower_bits_mask) << 1u) bitor (base_index bitand lower_bits_mask);
+
+          auto const mapping = make_mapping(to_qubit_value(base_index));
+          auto& buffer = buffers[thread_index];
+          auto const base_iter = first + base_index;
+          for (auto value = StateInteger{0u}; value < register_size; ++value)
+          {
+            auto const mapped_value = static_cast<StateInteger>(mapping(value));
+            assert(mapped_value < register_size);
+            buffer[mapped_value] = base_iter[offsets[value]];
+          }
+
+          for (auto value = StateInteger{0u}; value < register_size; ++value)
+            base_iter[offsets[value]] = buffer[value];
+        });
+    }
+  } // namespace register_permutation_detail
+
+  template <typename ParallelPolicy, typename RandomAccessIterator, typename Qubits, typename MakeMapping>
+  inline typename std::enable_if<
+    ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+    void>::type
+  permutate_register(
+    ParallelPolicy const parallel_policy,
+    RandomAccessIterator const first, RandomAccessIterator const last,
+    Qubits const& qubits, MakeMapping&& make_mapping)
+  {
+    using qubit_type = typename boost::range_value<Qubits>::type;
+    using state_integer_type = typename ::ket::meta::state_integer_of<qubit_type>::type;
+    using bit_integer_type = typename ::ket::meta::bit_integer_of<qubit_type>::type;
+    static_assert(std::is_unsigned<state_integer_type>::value, "StateInteger should be unsigned");
+    static_assert(std::is_unsigned<bit_integer_type>::value, "BitInteger should be unsigned");
+    assert(::ket::utility::ranges::is_unique_if_sorted(qubits));
+
+    auto target_bits = std::vector<bit_integer_type>{};
+    target_bits.reserve(boost::size(qubits));
+    for (auto const& qubit: qubits)
+      target_bits.push_back(static_cast<bit_integer_type>(qubit));
+
+    ::ket::register_permutation_detail::permutate_register<state_integer_type>(
+      parallel_policy, first, last, target_bits,
+      [](state_integer_type const index) { return index; }, std::forward<MakeMapping>(make_mapping));
+  }
+
+  template <typename RandomAccessIterator, typename Qubits, typename MakeMapping>
+  inline typename std::enable_if<
+    not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessIterator>::value,
+    void>::type
+  permutate_register(
+    RandomAccessIterator const first, RandomAccessIterator const last,
+    Qubits const& qubits, MakeMapping&& make_mapping)
+  {
+    ::ket::permutate_register(
+      ::ket::utility::policy::make_sequential(), first, last, qubits, std::forward<MakeMapping>(make_mapping));
+  }
+
+
+  namespace ranges
+  {
+    template <typename ParallelPolicy, typename RandomAccessRange, typename Qubits, typename MakeMapping>
+    inline typename std::enable_if<
+      ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
+      RandomAccessRange&>::type
+    permutate_register(
+      ParallelPolicy const parallel_policy, RandomAccessRange& state,
+      Qubits const& qubits, MakeMapping&& make_mapping)
+    {
+      ::ket::permutate_register(
+        parallel_policy, std::begin(state), std::end(state), qubits, std::forward<MakeMapping>(make_mapping));
+      return state;
+    }
+
+    template <typename RandomAccessRange, typename Qubits, typename MakeMapping>
+    inline typename std::enable_if<
+      not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessRange>::value,
+      RandomAccessRange&>::type
+    permutate_register(RandomAccessRange& state, Qubits const& qubits, MakeMapping&& make_mapping)
+    {
+      ::ket::permutate_register(std::begin(state), std::end(state), qubits, std::forward<MakeMapping>(make_mapping));
+      return state;
+    }
+  } // namespace ranges
+} // namespace ket
+
+
+#endif // KET_REGISTER_PERMUTATION_HPP
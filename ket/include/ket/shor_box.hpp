@@ -2,8 +2,8 @@
 # define KET_SHOR_BOX_HPP
 
 # include <cmath>
-//# include <vector>
 # include <iterator>
+# include <algorithm>
 # include <type_traits>
 
 # include <boost/range/size.hpp>
@@ -13,6 +13,7 @@
 # include <ket/meta/state_integer_of.hpp>
 # include <ket/meta/bit_integer_of.hpp>
 # include <ket/utility/integer_exp2.hpp>
+# include <ket/utility/loop_n.hpp>
 # include <ket/utility/meta/real_of.hpp>
 
 
@@ -54,6 +55,59 @@ namespace ket
         ::ket::shor_box_detail::make_filtered_integer(exponent, exponent_qubits)
         bitor ::ket::shor_box_detail::make_filtered_integer(modular_exponentiation_value, modular_exponentiation_qubits);
     }
+
+    // base^exponent mod divisor by square-and-multiply. The result is 1 if exponent is 0 as in the sequential loop of ::ket::shor_box
+    template <typename StateInteger>
+    inline StateInteger modular_power(StateInteger base, StateInteger exponent, StateInteger const divisor)
+    {
+      auto result = StateInteger{1u};
+      base %= divisor;
+
+      while (exponent != StateInteger{0u})
+      {
+        if ((exponent bitand StateInteger{1u}) != StateInteger{0u})
+          result = (result * base) % divisor;
+        base = (base * base) % divisor;
+        exponent >>= 1u;
+      }
+
+      return result;
+    }
+
+    constexpr auto num_blocks_per_thread = 16u;
+
+    // calls function(exponent, base^exponent mod divisor) for each exponent in [0, num_exponents).
+    // [0, num_exponents) is split into blocks, and each block is seeded by ::ket::shor_box_detail::modular_power
+    // and walked by multiplying base one step at a time, so that blocks are processed in parallel
+    template <typename ParallelPolicy, typename StateInteger, typename Function>
+    inline void loop_exponents(
+      ParallelPolicy const parallel_policy,
+      StateInteger const base, StateInteger const divisor, StateInteger const num_exponents,
+      Function&& function)
+    {
+      auto const num_blocks
+        = std::min(
+            static_cast<StateInteger>(num_blocks_per_thread * ::ket::utility::num_threads(parallel_policy)),
+            num_exponents);
+
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy, num_blocks,
+        [base, divisor, num_exponents, num_blocks, &function](StateInteger const block_index, int const)
+        {
+          auto const first_exponent = num_exponents * block_index / num_blocks;
+          auto const last_exponent = num_exponents * (block_index + StateInteger{1u}) / num_blocks;
+
+          auto modular_exponentiation_value = ::ket::shor_box_detail::modular_power(base, first_exponent, divisor);
+          for (auto exponent = first_exponent; exponent < last_exponent; ++exponent)
+          {
+            function(exponent, modular_exponentiation_value);
+
+            modular_exponentiation_value *= base;
+            modular_exponentiation_value %= divisor;
+          }
+        });
+    }
   } // namespace shor_box_detail
 
 
@@ -82,85 +136,22 @@ namespace ket
 
     auto const num_exponent_qubits = static_cast<bit_integer_type>(boost::size(exponent_qubits));
     auto const num_exponents = ::ket::utility::integer_exp2<StateInteger>(num_exponent_qubits);
-    auto modular_exponentiation_value = StateInteger{1u};
 
     using std::pow;
     auto const constant_coefficient = complex_type{pow(static_cast<real_type>(num_exponents), real_type{-0.5})};
 
-    for (auto exponent = StateInteger{0u}; exponent < num_exponents; ++exponent)
-    {
-      auto const index
-        = ::ket::shor_box_detail::calculate_index(
-            ::ket::shor_box_detail::reverse_bits(exponent, num_exponent_qubits), exponent_qubits,
-            modular_exponentiation_value, modular_exponentiation_qubits);
-
-      *(first + index) = constant_coefficient;
-
-      modular_exponentiation_value *= base;
-      modular_exponentiation_value %= divisor;
-    }
-
-
-    /*
-    // preliminary implement of parallel shor box
-    auto const num_exponent_qubits = boost::size(exponent_qubits);
-    auto const num_modular_exponentiation_qubits = boost::size(modular_exponentiation_qubits);
-
-    using qubit_type = typename boost::range_value<Qubits>::type;
-
-    static_assert(std::is_unsigned<StateInteger>::value, "StateInteger should be unsigned");
-    static_assert(
-      std::is_unsigned<typename ::ket::meta::bit_integer_of<qubit_type>::type>::value,
-      "BitInteger should be unsigned");
-
-    auto modular_squares = std::vector<StateInteger>{};
-    modular_squares.reserve(num_exponent_qubits);
-    modular_squares.push_back(base);
-    using ::ket::utility::loop_n;
-    loop_n(
-      ::ket::utility::policy::make_sequential(), num_exponent_qubits - decltype(num_exponent_qubits){1u},
-      [&modular_squares, divisor](decltype(num_exponent_qubits) const, int const)
-      { modular_squares.push_back((modular_squares.back() * modular_squares.back()) % divisor); });
-
-    auto modular_exponentiation_values = std::vector<StateInteger>{};
-    modular_exponentiation_values.reserve(::ket::utility::num_threads());
-
-    using ::ket::utility::loop_n;
-    loop_n(
-      parallel_policy, static_cast<StateInteger>(boost::size(state)),
-      [first](StateInteger const index, int const)
-      { *(first + index) = complex_type{real_type{0}}; });
-
-    using std::pow;
-    auto const constant_coefficient = complex_type{pow(num_exponents, -0.5)};
-    auto const num_exponents = ::ket::utility::integer_exp2<StateInteger>(num_exponent_qubits);
-    auto modular_exponentiation_value = StateInteger{1u};
-    auto const num_threads = ::ket::utility::num_threads();
-    loop_n(
-      parallel_policy, num_exponents,
-      [](StateInteger const exponent, int const thread_index)
+    ::ket::shor_box_detail::loop_exponents(
+      parallel_policy, base, divisor, num_exponents,
+      [first, num_exponent_qubits, &exponent_qubits, &modular_exponentiation_qubits, constant_coefficient](
+        StateInteger const exponent, StateInteger const modular_exponentiation_value)
       {
-        a
-      });
+        auto const index
+          = ::ket::shor_box_detail::calculate_index(
+              ::ket::shor_box_detail::reverse_bits(exponent, num_exponent_qubits), exponent_qubits,
+              modular_exponentiation_value, modular_exponentiation_qubits);
 
-
-    using std::pow;
-    auto const constant_coefficient = complex_type{pow(num_exponents, -0.5)};
-    auto const num_exponents = ::ket::utility::integer_exp2<StateInteger>(num_exponent_qubits);
-    auto modular_exponentiation_value = StateInteger{1u};
-    for (auto exponent = StateInteger{0u}; exponent < num_exponents; ++exponent)
-    {
-      auto const index
-        = ::ket::shor_box_detail::reverse_bits(exponent, num_exponent_qubits)
-          bitor (modular_exponentiation_value << num_exponent_qubits);
-
-      *(first + convert(index, exponent_qubits, modular_exponentiation_qubits))
-        = constant_coefficient;
-
-      modular_exponentiation_value *= base;
-      modular_exponentiation_value %= divisor;
-    }
-    */
+        *(first + index) = constant_coefficient;
+      });
   }
 
   template <typename RandomAccessIterator, typename StateInteger, typename Qubits>
@@ -4,9 +4,7 @@
 # include <boost/config.hpp>
 
 # include <array>
-# include <vector>
 # include <iterator>
-# include <numeric>
 
 # include <boost/range/value_type.hpp>
 # include <boost/math/constants/constants.hpp>
@@ -14,6 +12,7 @@
 # include <ket/qubit.hpp>
 # include <ket/gate/gate.hpp>
 # include <ket/utility/loop_n.hpp>
+# include <ket/utility/per_thread.hpp>
 # include <ket/utility/meta/real_of.hpp>
 
 
@@ -31,8 +30,7 @@ namespace ket
     using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
     using hd_spin_type = std::array<long double, 3u>;
     constexpr auto zero_spin = hd_spin_type{ };
-    auto spins_in_threads
-      = std::vector<hd_spin_type>(::ket::utility::num_threads(parallel_policy), zero_spin);
+    auto spins_in_threads = ::ket::utility::make_per_thread(parallel_policy, zero_spin);
 
     ::ket::gate::gate(
       parallel_policy, first, last,
@@ -59,8 +57,8 @@ namespace ket
       qubit);
 
     auto const hd_spin
-      = std::accumulate(
-          std::begin(spins_in_threads), std::end(spins_in_threads), zero_spin,
+      = spins_in_threads.reduce(
+          zero_spin,
           [](hd_spin_type accumulated_spin, hd_spin_type const& spin)
           {
             accumulated_spin[0u] += spin[0u];
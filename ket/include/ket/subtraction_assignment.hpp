@@ -2,6 +2,7 @@
 # define KET_SUBTRACTION_ASSIGNMENT_HPP
 
 # include <cstddef>
+# include <iterator>
 # include <vector>
 # include <type_traits>
 
@@ -22,9 +23,9 @@ namespace ket
   inline void subtraction_assignment(
     ParallelPolicy const parallel_policy,
     RandomAccessIterator const first, RandomAccessIterator const last,
-    Qubits const& lhs_qubits, Qubits const& rhs_qubits_range,
+    Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range,
     std::vector<
-      typename boost::range_value<RandomAccessRange>::type,
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
     ::ket::adj_addition_assignment(
@@ -41,7 +42,7 @@ namespace ket
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range,
     std::vector<
-      typename boost::range_value<RandomAccessRange>::type,
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
     ::ket::adj_addition_assignment(
@@ -57,7 +58,7 @@ namespace ket
   subtraction_assignment(
     ParallelPolicy const parallel_policy,
     RandomAccessIterator const first, RandomAccessIterator const last,
-    Qubits const& lhs_qubits, Qubits const& rhs_qubits_range)
+    Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range)
   {
     ::ket::adj_addition_assignment(
       parallel_policy, first, last, lhs_qubits, rhs_qubits_range);
@@ -78,12 +79,12 @@ namespace ket
       typename PhaseCoefficientsAllocator>
     inline RandomAccessRange& subtraction_assignment(
       ParallelPolicy const parallel_policy, RandomAccessRange& state,
-      Qubits const& lhs_qubits, Qubits const& rhs_qubits_range,
+      Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range,
       std::vector<
         typename boost::range_value<RandomAccessRange>::type,
         PhaseCoefficientsAllocator>& phase_coefficients)
     {
-      return ::ket::adj_addition_assignment(
+      return ::ket::ranges::adj_addition_assignment(
         parallel_policy, state, lhs_qubits, rhs_qubits_range, phase_coefficients);
     }
 
@@ -100,7 +101,7 @@ namespace ket
         typename boost::range_value<RandomAccessRange>::type,
         PhaseCoefficientsAllocator>& phase_coefficients)
     {
-      return ::ket::adj_addition_assignment(
+      return ::ket::ranges::adj_addition_assignment(
         state, lhs_qubits, rhs_qubits_range, phase_coefficients);
     }
 
@@ -112,9 +113,9 @@ namespace ket
       RandomAccessRange&>::type
     subtraction_assignment(
       ParallelPolicy const parallel_policy, RandomAccessRange& state,
-      Qubits const& lhs_qubits, Qubits const& rhs_qubits_range)
+      Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range)
     {
-      return ::ket::adj_addition_assignment(
+      return ::ket::ranges::adj_addition_assignment(
         parallel_policy, state, lhs_qubits, rhs_qubits_range);
     }
 
@@ -123,7 +124,7 @@ namespace ket
     inline RandomAccessRange& subtraction_assignment(
       RandomAccessRange& state,
       Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range)
-    { return ::ket::adj_addition_assignment(state, lhs_qubits, rhs_qubits_range); }
+    { return ::ket::ranges::adj_addition_assignment(state, lhs_qubits, rhs_qubits_range); }
   } // namespace ranges
 
 
@@ -134,9 +135,9 @@ namespace ket
   inline void adj_subtraction_assignment(
     ParallelPolicy const parallel_policy,
     RandomAccessIterator const first, RandomAccessIterator const last,
-    Qubits const& lhs_qubits, Qubits const& rhs_qubits_range,
+    Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range,
     std::vector<
-      typename boost::range_value<RandomAccessRange>::type,
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
     ::ket::addition_assignment(
@@ -153,7 +154,7 @@ namespace ket
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range,
     std::vector<
-      typename boost::range_value<RandomAccessRange>::type,
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
     ::ket::addition_assignment(
@@ -169,7 +170,7 @@ namespace ket
   adj_subtraction_assignment(
     ParallelPolicy const parallel_policy,
     RandomAccessIterator const first, RandomAccessIterator const last,
-    Qubits const& lhs_qubits, Qubits const& rhs_qubits_range)
+    Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range)
   {
     ::ket::addition_assignment(
       parallel_policy, first, last, lhs_qubits, rhs_qubits_range);
@@ -190,12 +191,12 @@ namespace ket
       typename PhaseCoefficientsAllocator>
     inline RandomAccessRange& adj_subtraction_assignment(
       ParallelPolicy const parallel_policy, RandomAccessRange& state,
-      Qubits const& lhs_qubits, Qubits const& rhs_qubits_range,
+      Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range,
       std::vector<
         typename boost::range_value<RandomAccessRange>::type,
         PhaseCoefficientsAllocator>& phase_coefficients)
     {
-      return ::ket::addition_assignment(
+      return ::ket::ranges::addition_assignment(
         parallel_policy, state, lhs_qubits, rhs_qubits_range, phase_coefficients);
     }
 
@@ -212,7 +213,7 @@ namespace ket
         typename boost::range_value<RandomAccessRange>::type,
         PhaseCoefficientsAllocator>& phase_coefficients)
     {
-      return ::ket::addition_assignment(
+      return ::ket::ranges::addition_assignment(
         state, lhs_qubits, rhs_qubits_range, phase_coefficients);
     }
 
@@ -224,9 +225,9 @@ namespace ket
       RandomAccessRange&>::type
     adj_subtraction_assignment(
       ParallelPolicy const parallel_policy, RandomAccessRange& state,
-      Qubits const& lhs_qubits, Qubits const& rhs_qubits_range)
+      Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range)
     {
-      return ::ket::addition_assignment(
+      return ::ket::ranges::addition_assignment(
         parallel_policy, state, lhs_qubits, rhs_qubits_range);
     }
 
@@ -235,7 +236,7 @@ namespace ket
     inline RandomAccessRange& adj_subtraction_assignment(
       RandomAccessRange& state,
       Qubits const& lhs_qubits, QubitsRange const& rhs_qubits_range)
-    { return ::ket::addition_assignment(state, lhs_qubits, rhs_qubits_range); }
+    { return ::ket::ranges::addition_assignment(state, lhs_qubits, rhs_qubits_range); }
   } // namespace ranges
 } // namespace ket
 
@@ -3,110 +3,278 @@
 
 # include <cassert>
 # include <cstddef>
-# include <cmath>
+# include <complex>
 # include <iterator>
+# include <vector>
 # include <type_traits>
 
+# include <boost/math/constants/constants.hpp>
 # include <boost/range/size.hpp>
 # include <boost/range/value_type.hpp>
 
-# include <ket/control.hpp>
-# include <ket/gate/hadamard.hpp>
-# include <ket/gate/controlled_phase_shift.hpp>
+# include <ket/qubit.hpp>
 # include <ket/meta/state_integer_of.hpp>
 # include <ket/meta/bit_integer_of.hpp>
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/exp_i.hpp>
 # include <ket/utility/integer_exp2.hpp>
+# include <ket/utility/bit_gatherer.hpp>
 # ifndef NDEBUG
+#   include <ket/utility/integer_log2.hpp>
 #   include <ket/utility/is_unique_if_sorted.hpp>
 # endif
 # include <ket/utility/generate_phase_coefficients.hpp>
+# include <ket/utility/meta/real_of.hpp>
 
 
 namespace ket
 {
-  template <
-    typename ParallelPolicy, typename RandomAccessIterator, typename Qubits,
-    typename PhaseCoefficientsAllocator>>
-  inline void swapped_fourier_transform(
-    ParallelPolicy const parallel_policy,
-    RandomAccessIterator const first, RandomAccessIterator const last,
-    Qubits const& qubits,
-    std::vector<
-      typename boost::range_value<RandomAccessRange>::type,
-      PhaseCoefficientsAllocator>& phase_coefficients)
+  // The swapped Fourier transform is the textbook circuit of the quantum Fourier transform without the final swaps:
+  // for each target qubit from the highest one, the Hadamard gate followed by controlled phase shifts
+  // exp(2 pi i / 2^(k+1)) controlled by the qubits k bits below the target qubit.
+  // The controlled phase shifts with the same target qubit are diagonal, so that they are combined into one phase factor
+  // exp(2 pi i v / 2^(t+1)) for the t-th qubit, where v is the value of the lower t qubits.
+  // Each target qubit is transformed by one pass over the state like a butterfly of the decimation-in-frequency FFT,
+  // which needs n passes instead of n(n+1)/2 passes of the gate-by-gate circuit
+  namespace swapped_fourier_transform_detail
   {
-    auto const num_qubits = boost::size(qubits);
-    ::ket::utility::generate_phase_coefficients(phase_coefficients, num_qubits);
+    // exp(2 pi i m / 2^n) for 0 <= m < 2^(n-1) is the product of two factors taken from tables of about 2^(n/2) elements
+    template <typename Complex, typename StateInteger, typename BitInteger>
+    class phase_factors
+    {
+      BitInteger num_lower_bits_;
+      StateInteger lower_bits_mask_;
+      std::vector<Complex> lower_factors_;
+      std::vector<Complex> upper_factors_;
+
+     public:
+      explicit phase_factors(BitInteger const num_qubits)
+        : num_lower_bits_{static_cast<BitInteger>((num_qubits - BitInteger{1u}) / BitInteger{2u})},
+          lower_bits_mask_{::ket::utility::integer_exp2<StateInteger>(num_lower_bits_) - StateInteger{1u}},
+          lower_factors_(::ket::utility::integer_exp2<std::size_t>(num_lower_bits_)),
+          upper_factors_(::ket::utility::integer_exp2<std::size_t>(num_qubits - BitInteger{1u} - num_lower_bits_))
+      {
+        assert(num_qubits >= BitInteger{1u});
+
+        using real_type = typename ::ket::utility::meta::real_of<Complex>::type;
+        using boost::math::constants::two_pi;
+        auto const unit_phase
+          = two_pi<real_type>() / static_cast<real_type>(::ket::utility::integer_exp2<StateInteger>(num_qubits));
+
+        auto const num_lower_factors = lower_factors_.size();
+        for (auto index = std::size_t{0u}; index < num_lower_factors; ++index)
+          lower_factors_[index] = ::ket::utility::exp_i<Complex>(unit_phase * static_cast<real_type>(index));
+
+        auto const num_upper_factors = upper_factors_.size();
+        for (auto index = std::size_t{0u}; index < num_upper_factors; ++index)
+          upper_factors_[index]
+            = ::ket::utility::exp_i<Complex>(
+                unit_phase * static_cast<real_type>(index << num_lower_bits_));
+      }
 
-    using qubit_type = typename boost::range_value<Qubits>::type;
+      Complex operator()(StateInteger const value) const
+      { return lower_factors_[value bitand lower_bits_mask_] * upper_factors_[value >> num_lower_bits_]; }
+    }; // class phase_factors<Complex, StateInteger, BitInteger>
+
+    // Transforms the target qubit of [first, last), where first_qubit_value is the qubit value of *first.
+    // Combined phase factors are exp(2 pi i (v << phase_shift) / 2^n), where v is extracted from qubit values by lower_bit_gatherer
+    template <
+      typename ParallelPolicy, typename RandomAccessIterator,
+      typename StateInteger, typename BitInteger, typename Complex>
+    inline void transform_qubit(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      StateInteger const first_qubit_value, ::ket::qubit<StateInteger, BitInteger> const target_qubit,
+      ::ket::utility::bit_gatherer<StateInteger, BitInteger> const& lower_bit_gatherer,
+      BitInteger const phase_shift,
+      ::ket::swapped_fourier_transform_detail::phase_factors<Complex, StateInteger, BitInteger> const& phase_factors)
+    {
+      assert(::ket::utility::integer_exp2<StateInteger>(target_qubit) < static_cast<StateInteger>(last - first));
+      assert(
+        ::ket::utility::integer_exp2<StateInteger>(::ket::utility::integer_log2<BitInteger>(last - first))
+        == static_cast<StateInteger>(last - first));
 
-    static_assert(
-      std::is_unsigned<typename ::ket::meta::state_integer_of<qubit_type>::type>::value,
-      "StateInteger should be unsigned");
-    static_assert(
-      std::is_unsigned<typename ::ket::meta::bit_integer_of<qubit_type>::type>::value,
-      "BitInteger should be unsigned");
-    assert(
-      ::ket::utility::integer_exp2<typename ::ket::meta::state_integer_of<qubit_type>::type>(num_qubits)
-        <= static_cast<typename ::ket::meta::state_integer_of<qubit_type>::type>(boost::size(state))
-      and ::ket::utility::ranges::is_unique_if_sorted(qubits));
+      auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(target_qubit);
+      auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+      auto const upper_bits_mask = compl lower_bits_mask;
 
-    auto const qubits_first = std::begin(qubits);
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy,
+        static_cast<StateInteger>(last - first) >> 1u,
+        [first, first_qubit_value, qubit_mask, lower_bits_mask, upper_bits_mask,
+         &lower_bit_gatherer, phase_shift, &phase_factors](
+          StateInteger const value_wo_qubit, int const)
+        {
+          // xxxxx0xxxxxx
+          auto const zero_index
+            = ((value_wo_qubit bitand upper_bits_mask) << 1u)
+              bitor (value_wo_qubit bitand lower_bits_mask);
+          // xxxxx1xxxxxx
+          auto const one_index = zero_index bitor qubit_mask;
+          auto const zero_iter = first + zero_index;
+          auto const one_iter = first + one_index;
+          auto const zero_iter_value = *zero_iter;
+
+          using real_type = typename ::ket::utility::meta::real_of<Complex>::type;
+          using boost::math::constants::one_div_root_two;
+          *zero_iter += *one_iter;
+          *zero_iter *= one_div_root_two<real_type>();
+          *one_iter = zero_iter_value - *one_iter;
+          *one_iter
+            *= one_div_root_two<real_type>()
+               * phase_factors(
+                   lower_bit_gatherer(first_qubit_value + zero_index) << phase_shift);
+        });
+    }
 
-    for (auto index = std::size_t{0u}; index < num_qubits; ++index)
+    // inverse of transform_qubit
+    template <
+      typename ParallelPolicy, typename RandomAccessIterator,
+      typename StateInteger, typename BitInteger, typename Complex>
+    inline void adj_transform_qubit(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      StateInteger const first_qubit_value, ::ket::qubit<StateInteger, BitInteger> const target_qubit,
+      ::ket::utility::bit_gatherer<StateInteger, BitInteger> const& lower_bit_gatherer,
+      BitInteger const phase_shift,
+      ::ket::swapped_fourier_transform_detail::phase_factors<Complex, StateInteger, BitInteger> const& phase_factors)
     {
-      auto target_bit = num_qubits - index - std::size_t{1u};
+      assert(::ket::utility::integer_exp2<StateInteger>(target_qubit) < static_cast<StateInteger>(last - first));
+      assert(
+        ::ket::utility::integer_exp2<StateInteger>(::ket::utility::integer_log2<BitInteger>(last - first))
+        == static_cast<StateInteger>(last - first));
 
-      ::ket::gate::hadamard(parallel_policy, first, last, qubits_first[target_bit]);
+      auto const qubit_mask = ::ket::utility::integer_exp2<StateInteger>(target_qubit);
+      auto const lower_bits_mask = qubit_mask - StateInteger{1u};
+      auto const upper_bits_mask = compl lower_bits_mask;
 
-      for (auto phase_exponent = std::size_t{2u};
-           phase_exponent <= num_qubits - index; ++phase_exponent)
-      {
-        auto const control_bit = target_bit - (phase_exponent - std::size_t{1u});
+      using ::ket::utility::loop_n;
+      loop_n(
+        parallel_policy,
+        static_cast<StateInteger>(last - first) >> 1u,
+        [first, first_qubit_value, qubit_mask, lower_bits_mask, upper_bits_mask,
+         &lower_bit_gatherer, phase_shift, &phase_factors](
+          StateInteger const value_wo_qubit, int const)
+        {
+          // xxxxx0xxxxxx
+          auto const zero_index
+            = ((value_wo_qubit bitand upper_bits_mask) << 1u)
+              bitor (value_wo_qubit bitand lower_bits_mask);
+          // xxxxx1xxxxxx
+          auto const one_index = zero_index bitor qubit_mask;
+          auto const zero_iter = first + zero_index;
+          auto const one_iter = first + one_index;
+
+          using std::conj;
+          *one_iter
+            *= conj(
+                 phase_factors(
+                   lower_bit_gatherer(first_qubit_value + zero_index) << phase_shift));
+          auto const zero_iter_value = *zero_iter;
+
+          using real_type = typename ::ket::utility::meta::real_of<Complex>::type;
+          using boost::math::constants::one_div_root_two;
+          *zero_iter += *one_iter;
+          *zero_iter *= one_div_root_two<real_type>();
+          *one_iter = zero_iter_value - *one_iter;
+          *one_iter *= one_div_root_two<real_type>();
+        });
+    }
 
-        ::ket::gate::controlled_phase_shift(
-          parallel_policy,
-          first, last, phase_coefficients[phase_exponent],
-          qubits_first[target_bit], ::ket::make_control(qubits_first[control_bit]));
+    template <typename ParallelPolicy, typename RandomAccessIterator, typename Qubits>
+    inline void swapped_fourier_transform(
+      ParallelPolicy const parallel_policy,
+      RandomAccessIterator const first, RandomAccessIterator const last,
+      Qubits const& qubits, bool const is_adjoint)
+    {
+      using qubit_type = typename boost::range_value<Qubits>::type;
+      using state_integer_type = typename ::ket::meta::state_integer_of<qubit_type>::type;
+      using bit_integer_type = typename ::ket::meta::bit_integer_of<qubit_type>::type;
+      static_assert(std::is_unsigned<state_integer_type>::value, "StateInteger should be unsigned");
+      static_assert(std::is_unsigned<bit_integer_type>::value, "BitInteger should be unsigned");
+
+      auto const num_qubits = static_cast<bit_integer_type>(boost::size(qubits));
+      assert(
+        ::ket::utility::integer_exp2<state_integer_type>(num_qubits)
+          <= static_cast<state_integer_type>(last - first)
+        and ::ket::utility::ranges::is_unique_if_sorted(qubits));
+      if (num_qubits == bit_integer_type{0u})
+        return;
+
+      auto bits = std::vector<bit_integer_type>{};
+      bits.reserve(num_qubits);
+      for (auto const& qubit: qubits)
+        bits.push_back(static_cast<bit_integer_type>(qubit));
+
+      using complex_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+      auto const phase_factors
+        = ::ket::swapped_fourier_transform_detail::phase_factors<complex_type, state_integer_type, bit_integer_type>{num_qubits};
+
+      auto const qubits_first = std::begin(qubits);
+      for (auto index = bit_integer_type{0u}; index < num_qubits; ++index)
+      {
+        auto const target_bit = is_adjoint ? index : num_qubits - index - bit_integer_type{1u};
+        auto const lower_bit_gatherer = ::ket::utility::bit_gatherer<state_integer_type, bit_integer_type>{bits, target_bit};
+        auto const phase_shift = static_cast<bit_integer_type>(num_qubits - target_bit - bit_integer_type{1u});
+
+        if (is_adjoint)
+          ::ket::swapped_fourier_transform_detail::adj_transform_qubit(
+            parallel_policy, first, last, state_integer_type{0u}, qubit_type{qubits_first[target_bit]},
+            lower_bit_gatherer, phase_shift, phase_factors);
+        else
+          ::ket::swapped_fourier_transform_detail::transform_qubit(
+            parallel_policy, first, last, state_integer_type{0u}, qubit_type{qubits_first[target_bit]},
+            lower_bit_gatherer, phase_shift, phase_factors);
       }
     }
+  } // namespace swapped_fourier_transform_detail
+
+  template <
+    typename ParallelPolicy, typename RandomAccessIterator, typename Qubits,
+    typename PhaseCoefficientsAllocator>
+  inline void swapped_fourier_transform(
+    ParallelPolicy const parallel_policy,
+    RandomAccessIterator const first, RandomAccessIterator const last,
+    Qubits const& qubits,
+    std::vector<
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
+      PhaseCoefficientsAllocator>& phase_coefficients)
+  {
+    ::ket::utility::generate_phase_coefficients(phase_coefficients, boost::size(qubits));
+    ::ket::swapped_fourier_transform_detail::swapped_fourier_transform(
+      parallel_policy, first, last, qubits, false);
   }
 
   template <typename RandomAccessIterator, typename Qubits, typename PhaseCoefficientsAllocator>
   inline typename std::enable_if<
-    not ::ket::utility::policy::is_loop_n_policy<RandomAccessIterator>::value,
+    not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessIterator>::value,
     void>::type
   swapped_fourier_transform(
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& qubits,
     std::vector<
-      typename boost::range_value<RandomAccessRange>::type,
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
     ::ket::swapped_fourier_transform(
       ::ket::utility::policy::make_sequential(), first, last, qubits, phase_coefficients);
   }
 
-  template <
-    typename ParallelPolicy, typename RandomAccessIterator, typename Qubits>
+  template <typename ParallelPolicy, typename RandomAccessIterator, typename Qubits>
   inline typename std::enable_if<
-    ::ket::utility::policy::is_loop_n_policy<ParallelPolicy>::value,
+    ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
     void>::type
   swapped_fourier_transform(
     ParallelPolicy const parallel_policy,
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& qubits)
   {
-    using complex_type = std::iterator_traits<RandomAccessIterator>::value_type;
-    auto phase_coefficients
-      = ::ket::utility::generate_phase_coefficients<complex_type>(boost::size(lhs_qubits));
-
-    ::ket::swapped_fourier_transform(
-      parallel_policy, first, last, qubits, phase_coefficients);
+    ::ket::swapped_fourier_transform_detail::swapped_fourier_transform(
+      parallel_policy, first, last, qubits, false);
   }
 
-  template <
-    typename ParallelPolicy, typename RandomAccessIterator, typename Qubits>
+  template <typename RandomAccessIterator, typename Qubits>
   inline void swapped_fourier_transform(
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& qubits)
@@ -120,7 +288,7 @@ namespace ket
   {
     template <
       typename ParallelPolicy, typename RandomAccessRange, typename Qubits,
-      typename PhaseCoefficientsAllocator>>
+      typename PhaseCoefficientsAllocator>
     inline RandomAccessRange& swapped_fourier_transform(
       ParallelPolicy const parallel_policy, RandomAccessRange& state,
       Qubits const& qubits,
@@ -136,7 +304,7 @@ namespace ket
 
     template <typename RandomAccessRange, typename Qubits, typename PhaseCoefficientsAllocator>
     inline typename std::enable_if<
-      not ::ket::utility::policy::is_loop_n_policy<RandomAccessRange>::value,
+      not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessRange>::value,
       RandomAccessRange&>::type
     swapped_fourier_transform(
       RandomAccessRange& state, Qubits const& qubits,
@@ -149,10 +317,9 @@ namespace ket
       return state;
     }
 
-    template <
-      typename ParallelPolicy, typename RandomAccessRange, typename Qubits>
+    template <typename ParallelPolicy, typename RandomAccessRange, typename Qubits>
     inline typename std::enable_if<
-      ::ket::utility::policy::is_loop_n_policy<ParallelPolicy>::value,
+      ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
       RandomAccessRange&>::type
     swapped_fourier_transform(
       ParallelPolicy const parallel_policy, RandomAccessRange& state,
@@ -163,7 +330,7 @@ namespace ket
       return state;
     }
 
-    template <typename RandomAccessRange, typename Qubits, typename PhaseCoefficientsAllocator>
+    template <typename RandomAccessRange, typename Qubits>
     inline RandomAccessRange& swapped_fourier_transform(
       RandomAccessRange& state, Qubits const& qubits)
     {
@@ -175,85 +342,49 @@ namespace ket
 
   template <
     typename ParallelPolicy, typename RandomAccessIterator, typename Qubits,
-    typename PhaseCoefficientsAllocator>>
+    typename PhaseCoefficientsAllocator>
   inline void adj_swapped_fourier_transform(
     ParallelPolicy const parallel_policy,
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& qubits,
     std::vector<
-      typename boost::range_value<RandomAccessRange>::type,
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
-    auto const num_qubits = boost::size(qubits);
-    ::ket::utility::generate_phase_coefficients(phase_coefficients, num_qubits);
-
-    using qubit_type = typename boost::range_value<Qubits>::type;
-
-    static_assert(
-      std::is_unsigned<typename ::ket::meta::state_integer_of<qubit_type>::type>::value,
-      "StateInteger should be unsigned");
-    static_assert(
-      std::is_unsigned<typename ::ket::meta::bit_integer_of<qubit_type>::type>::value,
-      "BitInteger should be unsigned");
-    assert(
-      ::ket::utility::integer_exp2<typename ::ket::meta::state_integer_of<qubit_type>::type>(num_qubits)
-        <= static_cast<typename ::ket::meta::state_integer_of<qubit_type>::type>(boost::size(state))
-      and ::ket::utility::ranges::is_unique_if_sorted(qubits));
-
-    auto const qubits_first = std::begin(qubits);
-
-    for (auto target_bit = std::size_t{0u}; target_bit < num_qubits; ++target_bit)
-    {
-      for (auto index = std::size_t{0u}; index < target_bit; ++index)
-      {
-        auto const phase_exponent = std::size_t{1u} + target_bit - index;
-        auto const control_bit = target_bit - (phase_exponent - std::size_t{1u});
-
-        ::ket::gate::adj_controlled_phase_shift(
-          parallel_policy,
-          first, last, phase_coefficients[phase_exponent], qubits_first[target_bit],
-          ::ket::make_control(qubits_first[control_bit]));
-      }
-
-      ::ket::gate::adj_hadamard(parallel_policy, first, last, qubits_first[target_bit]);
-    }
+    ::ket::utility::generate_phase_coefficients(phase_coefficients, boost::size(qubits));
+    ::ket::swapped_fourier_transform_detail::swapped_fourier_transform(
+      parallel_policy, first, last, qubits, true);
   }
 
   template <typename RandomAccessIterator, typename Qubits, typename PhaseCoefficientsAllocator>
   inline typename std::enable_if<
-    not ::ket::utility::policy::is_loop_n_policy<RandomAccessIterator>::value,
+    not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessIterator>::value,
     void>::type
   adj_swapped_fourier_transform(
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& qubits,
     std::vector<
-      typename boost::range_value<RandomAccessRange>::type,
+      typename std::iterator_traits<RandomAccessIterator>::value_type,
       PhaseCoefficientsAllocator>& phase_coefficients)
   {
     ::ket::adj_swapped_fourier_transform(
       ::ket::utility::policy::make_sequential(), first, last, qubits, phase_coefficients);
   }
 
-  template <
-    typename ParallelPolicy, typename RandomAccessIterator, typename Qubits>
+  template <typename ParallelPolicy, typename RandomAccessIterator, typename Qubits>
   inline typename std::enable_if<
-    ::ket::utility::policy::is_loop_n_policy<ParallelPolicy>::value,
+    ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
     void>::type
   adj_swapped_fourier_transform(
     ParallelPolicy const parallel_policy,
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& qubits)
   {
-    using complex_type = std::iterator_traits<RandomAccessIterator>::value_type;
-    auto phase_coefficients
-      = ::ket::utility::generate_phase_coefficients<complex_type>(boost::size(lhs_qubits));
-
-    ::ket::adj_swapped_fourier_transform(
-      parallel_policy, first, last, qubits, phase_coefficients);
+    ::ket::swapped_fourier_transform_detail::swapped_fourier_transform(
+      parallel_policy, first, last, qubits, true);
   }
 
-  template <
-    typename ParallelPolicy, typename RandomAccessIterator, typename Qubits>
+  template <typename RandomAccessIterator, typename Qubits>
   inline void adj_swapped_fourier_transform(
     RandomAccessIterator const first, RandomAccessIterator const last,
     Qubits const& qubits)
@@ -283,7 +414,7 @@ namespace ket
 
     template <typename RandomAccessRange, typename Qubits, typename PhaseCoefficientsAllocator>
     inline typename std::enable_if<
-      not ::ket::utility::policy::is_loop_n_policy<RandomAccessRange>::value,
+      not ::ket::utility::policy::meta::is_loop_n_policy<RandomAccessRange>::value,
       RandomAccessRange&>::type
     adj_swapped_fourier_transform(
       RandomAccessRange& state, Qubits const& qubits,
@@ -296,10 +427,9 @@ namespace ket
       return state;
     }
 
-    template <
-      typename ParallelPolicy, typename RandomAccessRange, typename Qubits>
+    template <typename ParallelPolicy, typename RandomAccessRange, typename Qubits>
     inline typename std::enable_if<
-      ::ket::utility::policy::is_loop_n_policy<ParallelPolicy>::value,
+      ::ket::utility::policy::meta::is_loop_n_policy<ParallelPolicy>::value,
       RandomAccessRange&>::type
     adj_swapped_fourier_transform(
       ParallelPolicy const parallel_policy, RandomAccessRange& state,
@@ -310,7 +440,7 @@ namespace ket
       return state;
     }
 
-    template <typename RandomAccessRange, typename Qubits, typename PhaseCoefficientsAllocator>
+    template <typename RandomAccessRange, typename Qubits>
     inline RandomAccessRange& adj_swapped_fourier_transform(
       RandomAccessRange& state, Qubits const& qubits)
     {
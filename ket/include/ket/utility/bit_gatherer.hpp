@@ -0,0 +1,86 @@
+#ifndef KET_UTILITY_BIT_GATHERER_HPP
+# define KET_UTILITY_BIT_GATHERER_HPP
+
+# include <cassert>
+# include <vector>
+
+# include <boost/range/size.hpp>
+# include <boost/range/value_type.hpp>
+
+# include <ket/meta/state_integer_of.hpp>
+# include <ket/meta/bit_integer_of.hpp>
+
+
+namespace ket
+{
+  namespace utility
+  {
+    // The kth bit of a gathered value is the source_bits[k]th bit of a qubit value.
+    // Bits consecutive in both of a qubit value and a gathered value are extracted at once
+    template <typename StateInteger, typename BitInteger>
+    class bit_gatherer
+    {
+      struct bit_run
+      {
+        BitInteger source_bit;
+        BitInteger destination_bit;
+        StateInteger mask;
+      }; // struct bit_run
+
+      std::vector<bit_run> bit_runs_;
+
+     public:
+      explicit bit_gatherer(std::vector<BitInteger> const& source_bits)
+        : bit_gatherer{source_bits, static_cast<BitInteger>(source_bits.size())}
+      { }
+
+      // only the first num_bits elements of source_bits are gathered
+      bit_gatherer(std::vector<BitInteger> const& source_bits, BitInteger const num_bits)
+        : bit_runs_{}
+      {
+        assert(num_bits <= source_bits.size());
+
+        for (auto bit_index = BitInteger{0u}; bit_index < num_bits; ++bit_index)
+        {
+          if (not bit_runs_.empty()
+              and bit_runs_.back().source_bit + (bit_index - bit_runs_.back().destination_bit) == source_bits[bit_index])
+          {
+            bit_runs_.back().mask = (bit_runs_.back().mask << 1u) bitor StateInteger{1u};
+            continue;
+          }
+
+          bit_runs_.push_back(bit_run{source_bits[bit_index], bit_index, StateInteger{1u}});
+        }
+      }
+
+      StateInteger operator()(StateInteger const qubit_value) const
+      {
+        auto result = StateInteger{0u};
+        for (auto const& bit_run: bit_runs_)
+          result |= ((qubit_value >> bit_run.source_bit) bitand bit_run.mask) << bit_run.destination_bit;
+        return result;
+      }
+    }; // class bit_gatherer<StateInteger, BitInteger>
+
+    // the kth bit of a gathered value is the value of qubits[k]
+    template <typename Qubits>
+    inline ::ket::utility::bit_gatherer<
+      typename ::ket::meta::state_integer_of<typename boost::range_value<Qubits>::type>::type,
+      typename ::ket::meta::bit_integer_of<typename boost::range_value<Qubits>::type>::type>
+    make_bit_gatherer(Qubits const& qubits)
+    {
+      using qubit_type = typename boost::range_value<Qubits>::type;
+      using state_integer_type = typename ::ket::meta::state_integer_of<qubit_type>::type;
+      using bit_integer_type = typename ::ket::meta::bit_integer_of<qubit_type>::type;
+
+      auto bits = std::vector<bit_integer_type>{};
+      bits.reserve(boost::size(qubits));
+      for (auto const& qubit: qubits)
+        bits.push_back(static_cast<bit_integer_type>(qubit));
+      return ::ket::utility::bit_gatherer<state_integer_type, bit_integer_type>{bits};
+    }
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_BIT_GATHERER_HPP
@@ -0,0 +1,148 @@
+#ifndef KET_UTILITY_HUGE_PAGE_ALLOCATOR_HPP
+# define KET_UTILITY_HUGE_PAGE_ALLOCATOR_HPP
+
+# include <cstddef>
+# include <memory>
+# include <utility>
+# include <new>
+
+# include <sys/mman.h>
+
+
+namespace ket
+{
+  namespace utility
+  {
+    // whether memory of ::ket::utility::huge_page_allocator is allocated with huge pages
+    inline bool& uses_huge_pages()
+    {
+      static auto result = false;
+      return result;
+    }
+
+    namespace huge_page_allocator_detail
+    {
+      constexpr std::size_t huge_page_size() { return std::size_t{1u} << 21u; }
+      constexpr std::size_t gigantic_page_size() { return std::size_t{1u} << 30u; }
+
+      inline std::size_t num_mapped_bytes(std::size_t const num_bytes)
+      {
+        constexpr auto page_size = ::ket::utility::huge_page_allocator_detail::huge_page_size();
+        return (num_bytes + page_size - std::size_t{1u}) / page_size * page_size;
+      }
+    } // namespace huge_page_allocator_detail
+
+    // Allocates memory with 1 GiB or 2 MiB pages of hugetlbfs if they are reserved, or with transparent huge pages otherwise, so that
+    // TLB misses are reduced. Elements constructed without arguments are left untouched (they are zeros in freshly allocated memory),
+    // so that the thread which first writes each page determines its NUMA node.
+    // Memory is allocated by Allocator if ::ket::utility::uses_huge_pages() was false when this allocator was constructed
+    template <typename Value, typename Allocator = std::allocator<Value>>
+    class huge_page_allocator
+    {
+      Allocator allocator_;
+      bool uses_huge_pages_;
+
+      template <typename Value_, typename Allocator_>
+      friend class huge_page_allocator;
+
+     public:
+      using value_type = Value;
+      using pointer = Value*;
+      using const_pointer = Value const*;
+      using reference = Value&;
+      using const_reference = Value const&;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+
+      template <typename Value_>
+      struct rebind
+      {
+        using other
+          = ::ket::utility::huge_page_allocator<
+              Value_, typename std::allocator_traits<Allocator>::template rebind_alloc<Value_>>;
+      }; // struct rebind<Value_>
+
+      huge_page_allocator()
+        : allocator_{}, uses_huge_pages_{::ket::utility::uses_huge_pages()}
+      { }
+
+      template <typename Value_, typename Allocator_>
+      huge_page_allocator(::ket::utility::huge_page_allocator<Value_, Allocator_> const& other)
+        : allocator_{other.allocator_}, uses_huge_pages_{other.uses_huge_pages_}
+      { }
+
+      bool uses_huge_pages() const noexcept { return uses_huge_pages_; }
+
+      Value* allocate(std::size_t const num_values)
+      {
+        if (not uses_huge_pages_)
+          return std::allocator_traits<Allocator>::allocate(allocator_, num_values);
+        if (num_values == std::size_t{0u})
+          return nullptr;
+
+        auto const num_bytes = ::ket::utility::huge_page_allocator_detail::num_mapped_bytes(num_values * sizeof(Value));
+        auto result = MAP_FAILED;
+# ifdef MAP_HUGETLB
+#   ifdef MAP_HUGE_1GB
+        if (num_bytes % ::ket::utility::huge_page_allocator_detail::gigantic_page_size() == std::size_t{0u})
+          result = ::mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_1GB, -1, 0);
+#   endif // MAP_HUGE_1GB
+        if (result == MAP_FAILED)
+          result = ::mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+# endif // MAP_HUGETLB
+
+        // no huge pages are reserved
+        if (result == MAP_FAILED)
+        {
+          result = ::mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+          if (result == MAP_FAILED)
+            throw std::bad_alloc{};
+# ifdef MADV_HUGEPAGE
+          ::madvise(result, num_bytes, MADV_HUGEPAGE);
+# endif // MADV_HUGEPAGE
+        }
+
+        return static_cast<Value*>(result);
+      }
+
+      void deallocate(Value* const pointer, std::size_t const num_values)
+      {
+        if (not uses_huge_pages_)
+          return std::allocator_traits<Allocator>::deallocate(allocator_, pointer, num_values);
+        if (pointer == nullptr)
+          return;
+
+        ::munmap(pointer, ::ket::utility::huge_page_allocator_detail::num_mapped_bytes(num_values * sizeof(Value)));
+      }
+
+      template <typename Value_>
+      void construct(Value_* const pointer)
+      {
+        if (not uses_huge_pages_)
+          std::allocator_traits<Allocator>::construct(allocator_, pointer);
+      }
+
+      template <typename Value_, typename Argument, typename... Arguments>
+      void construct(Value_* const pointer, Argument&& argument, Arguments&&... arguments)
+      {
+        std::allocator_traits<Allocator>::construct(
+          allocator_, pointer, std::forward<Argument>(argument), std::forward<Arguments>(arguments)...);
+      }
+
+      template <typename Value_>
+      void destroy(Value_* const pointer)
+      { std::allocator_traits<Allocator>::destroy(allocator_, pointer); }
+
+      template <typename Value_, typename Allocator_>
+      bool operator==(::ket::utility::huge_page_allocator<Value_, Allocator_> const& other) const
+      { return uses_huge_pages_ == other.uses_huge_pages_; }
+
+      template <typename Value_, typename Allocator_>
+      bool operator!=(::ket::utility::huge_page_allocator<Value_, Allocator_> const& other) const
+      { return not (*this == other); }
+    }; // class huge_page_allocator<Value, Allocator>
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_HUGE_PAGE_ALLOCATOR_HPP
@@ -0,0 +1,131 @@
+#ifndef KET_UTILITY_MAPPED_FILE_ALLOCATOR_HPP
+# define KET_UTILITY_MAPPED_FILE_ALLOCATOR_HPP
+
+# include <cstddef>
+# include <cstdlib>
+# include <string>
+# include <vector>
+# include <memory>
+# include <utility>
+# include <new>
+
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+
+
+namespace ket
+{
+  namespace utility
+  {
+    // directory of files onto which memory of ::ket::utility::mapped_file_allocator is mapped.
+    // Memory is allocated in the usual way if this value is empty
+    inline std::string& mapped_file_directory()
+    {
+      static auto result = std::string{};
+      return result;
+    }
+
+    // Allocates memory mapped onto a temporary file in ::ket::utility::mapped_file_directory(), so that the operating system
+    // pages amplitudes in and out of RAM and a state may be larger than RAM. The file is removed as soon as it is mapped.
+    // Memory is allocated by Allocator if the directory was empty when this allocator was constructed
+    template <typename Value, typename Allocator = std::allocator<Value>>
+    class mapped_file_allocator
+    {
+      Allocator allocator_;
+      std::string directory_;
+
+      template <typename Value_, typename Allocator_>
+      friend class mapped_file_allocator;
+
+     public:
+      using value_type = Value;
+      using pointer = Value*;
+      using const_pointer = Value const*;
+      using reference = Value&;
+      using const_reference = Value const&;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+
+      template <typename Value_>
+      struct rebind
+      {
+        using other
+          = ::ket::utility::mapped_file_allocator<
+              Value_, typename std::allocator_traits<Allocator>::template rebind_alloc<Value_>>;
+      }; // struct rebind<Value_>
+
+      mapped_file_allocator()
+        : allocator_{}, directory_{::ket::utility::mapped_file_directory()}
+      { }
+
+      template <typename Value_, typename Allocator_>
+      mapped_file_allocator(::ket::utility::mapped_file_allocator<Value_, Allocator_> const& other)
+        : allocator_{other.allocator_}, directory_{other.directory_}
+      { }
+
+      std::string const& directory() const noexcept { return directory_; }
+
+      Value* allocate(std::size_t const num_values)
+      {
+        if (directory_.empty())
+          return std::allocator_traits<Allocator>::allocate(allocator_, num_values);
+        if (num_values == std::size_t{0u})
+          return nullptr;
+
+        auto path = std::vector<char>(std::begin(directory_), std::end(directory_));
+        auto const file_name = std::string{"/ket_state_XXXXXX"};
+        path.insert(std::end(path), std::begin(file_name), std::end(file_name));
+        path.push_back('\0');
+
+        auto const file_descriptor = ::mkstemp(path.data());
+        if (file_descriptor == -1)
+          throw std::bad_alloc{};
+        ::unlink(path.data());
+
+        auto const num_bytes = num_values * sizeof(Value);
+        if (::ftruncate(file_descriptor, static_cast< ::off_t >(num_bytes)) != 0)
+        {
+          ::close(file_descriptor);
+          throw std::bad_alloc{};
+        }
+
+        auto const result = ::mmap(nullptr, num_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+        ::close(file_descriptor);
+        if (result == MAP_FAILED)
+          throw std::bad_alloc{};
+
+        return static_cast<Value*>(result);
+      }
+
+      void deallocate(Value* const pointer, std::size_t const num_values)
+      {
+        if (directory_.empty())
+          return std::allocator_traits<Allocator>::deallocate(allocator_, pointer, num_values);
+        if (pointer == nullptr)
+          return;
+
+        ::munmap(pointer, num_values * sizeof(Value));
+      }
+
+      template <typename Value_, typename... Arguments>
+      void construct(Value_* const pointer, Arguments&&... arguments)
+      { std::allocator_traits<Allocator>::construct(allocator_, pointer, std::forward<Arguments>(arguments)...); }
+
+      template <typename Value_>
+      void destroy(Value_* const pointer)
+      { std::allocator_traits<Allocator>::destroy(allocator_, pointer); }
+
+      template <typename Value_, typename Allocator_>
+      bool operator==(::ket::utility::mapped_file_allocator<Value_, Allocator_> const& other) const
+      { return directory_ == other.directory_; }
+
+      template <typename Value_, typename Allocator_>
+      bool operator!=(::ket::utility::mapped_file_allocator<Value_, Allocator_> const& other) const
+      { return not (*this == other); }
+    }; // class mapped_file_allocator<Value, Allocator>
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_MAPPED_FILE_ALLOCATOR_HPP
@@ -0,0 +1,74 @@
+#ifndef KET_UTILITY_PARALLEL_BUSY_TIMES_HPP
+# define KET_UTILITY_PARALLEL_BUSY_TIMES_HPP
+
+# include <cstddef>
+# include <vector>
+# include <memory>
+# include <atomic>
+# include <chrono>
+
+
+namespace ket
+{
+  namespace utility
+  {
+    // accumulated time which each thread spends in ::ket::utility::loop_n with ::ket::utility::policy::parallel.
+    // Each counter occupies its own cache line because it is updated by a different thread
+    class busy_times
+    {
+     public:
+      using clock_type = std::chrono::steady_clock;
+      using duration = clock_type::duration;
+
+     private:
+      using count_type = duration::rep;
+      static constexpr std::size_t cache_line_size = 64u;
+
+      struct padded_count
+      {
+        std::atomic<count_type> value;
+        char padding[cache_line_size - sizeof(std::atomic<count_type>)];
+      }; // struct padded_count
+
+      unsigned int num_threads_;
+      std::unique_ptr<padded_count[]> counts_;
+
+     public:
+      explicit busy_times(unsigned int const num_threads)
+        : num_threads_{num_threads}, counts_{new padded_count[num_threads]()}
+      { }
+
+      unsigned int num_threads() const noexcept { return num_threads_; }
+
+      void add(int const thread_index, duration const time) noexcept
+      {
+        if (thread_index < 0 or static_cast<unsigned int>(thread_index) >= num_threads_)
+          return;
+
+        counts_[thread_index].value.fetch_add(time.count(), std::memory_order_relaxed);
+      }
+
+      duration operator[](unsigned int const thread_index) const noexcept
+      { return duration{counts_[thread_index].value.load(std::memory_order_relaxed)}; }
+
+      std::vector<duration> durations() const
+      {
+        auto result = std::vector<duration>{};
+        result.reserve(num_threads_);
+        for (auto thread_index = 0u; thread_index < num_threads_; ++thread_index)
+          result.push_back((*this)[thread_index]);
+
+        return result;
+      }
+
+      void reset() noexcept
+      {
+        for (auto thread_index = 0u; thread_index < num_threads_; ++thread_index)
+          counts_[thread_index].value.store(count_type{0}, std::memory_order_relaxed);
+      }
+    }; // class busy_times
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_PARALLEL_BUSY_TIMES_HPP
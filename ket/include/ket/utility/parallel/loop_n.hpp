@@ -2,10 +2,14 @@
 # define KET_UTILITY_PARALLEL_LOOP_N_HPP
 
 # include <cassert>
+# include <cstddef>
 # include <vector>
 # include <iterator>
 # include <numeric>
 # include <utility>
+# include <memory>
+# include <atomic>
+# include <chrono>
 # include <mutex> // lock_guard and unique_lock; mutex unless using OpenMP
 # if defined(_OPENMP) && defined(KET_USE_OPENMP)
 #   include <stdexcept>
@@ -23,6 +27,11 @@
 # endif // defined(_OPENMP) && defined(KET_USE_OPENMP)
 
 # include <ket/utility/loop_n.hpp>
+# include <ket/utility/per_thread.hpp>
+# include <ket/utility/parallel/busy_times.hpp>
+# if !defined(_OPENMP) || !defined(KET_USE_OPENMP)
+#   include <ket/utility/parallel/thread_pool.hpp>
+# endif // !defined(_OPENMP) || !defined(KET_USE_OPENMP)
 
 
 namespace ket
@@ -35,37 +44,64 @@ namespace ket
       class parallel
       {
         NumThreads num_threads_;
+        // the number of iterations in each chunk which idle threads take from other threads in loop_n.
+        // Iterations are split statically if 0
+        std::size_t chunk_size_;
+        // null unless record_busy_times() is called, and shared by copies of this policy made after that
+        std::shared_ptr< ::ket::utility::busy_times > busy_times_;
 
        public:
 # if defined(_OPENMP) && defined(KET_USE_OPENMP)
         parallel() noexcept
-          : num_threads_(static_cast<NumThreads>(omp_get_max_threads()))
+          : num_threads_(static_cast<NumThreads>(omp_get_max_threads())),
+            chunk_size_{0u},
+            busy_times_{}
         { }
 
-        explicit parallel(NumThreads const num_threads)
+        explicit parallel(NumThreads const num_threads, std::size_t const chunk_size = 0u)
           : num_threads_(
               num_threads <= NumThreads{0}
               ? NumThreads{1}
               : num_threads > static_cast<NumThreads>(omp_get_max_threads())
                 ? static_cast<NumThreads>(omp_get_max_threads())
-                : num_threads)
+                : num_threads),
+            chunk_size_{chunk_size},
+            busy_times_{}
         { omp_set_num_threads(static_cast<int>(num_threads_)); }
 # else // defined(_OPENMP) && defined(KET_USE_OPENMP)
         parallel() noexcept
-          : num_threads_(static_cast<NumThreads>(std::thread::hardware_concurrency()))
+          : num_threads_(static_cast<NumThreads>(std::thread::hardware_concurrency())),
+            chunk_size_{0u},
+            busy_times_{}
         { }
 
-        explicit parallel(NumThreads const num_threads) noexcept
+        explicit parallel(NumThreads const num_threads, std::size_t const chunk_size = 0u) noexcept
           : num_threads_(
               num_threads <= NumThreads{0}
               ? NumThreads{1}
               : num_threads >= static_cast<NumThreads>(std::thread::hardware_concurrency())
                 ? static_cast<NumThreads>(std::thread::hardware_concurrency())
-                : num_threads)
+                : num_threads),
+            chunk_size_{chunk_size},
+            busy_times_{}
         { }
 # endif // defined(_OPENMP) && defined(KET_USE_OPENMP)
 
         NumThreads num_threads() const noexcept { return num_threads_; }
+        std::size_t chunk_size() const noexcept { return chunk_size_; }
+        void chunk_size(std::size_t const chunk_size) noexcept { chunk_size_ = chunk_size; }
+        // loop_n reads the clock only after this is called
+        void record_busy_times()
+        {
+          if (not busy_times_)
+            busy_times_ = std::make_shared< ::ket::utility::busy_times >(static_cast<unsigned int>(num_threads_));
+        }
+        // returns nullptr if busy times are not recorded
+        ::ket::utility::busy_times* busy_times() const noexcept { return busy_times_.get(); }
+# if !defined(_OPENMP) || !defined(KET_USE_OPENMP)
+        // all policies share the same thread pool, whose workers are started on demand
+        ::ket::utility::thread_pool& thread_pool() const noexcept { return ::ket::utility::thread_pool::instance(); }
+# endif // !defined(_OPENMP) || !defined(KET_USE_OPENMP)
 
 # if defined(_OPENMP) && defined(KET_USE_OPENMP)
         void num_threads(NumThreads const num_threads) const noexcept
@@ -96,6 +132,11 @@ namespace ket
       make_parallel(NumThreads const num_threads) noexcept
       { return ::ket::utility::policy::parallel<NumThreads>(num_threads); }
 
+      template <typename NumThreads>
+      inline constexpr ::ket::utility::policy::parallel<NumThreads> make_parallel(
+        NumThreads const num_threads, std::size_t const chunk_size) noexcept
+      { return ::ket::utility::policy::parallel<NumThreads>(num_threads, chunk_size); }
+
       namespace meta
       {
         template <typename NumThreads>
@@ -120,6 +161,66 @@ namespace ket
 
     namespace parallel_loop_n_detail
     {
+      // [0, n) is split into chunks of chunk_size iterations, and the chunks are distributed to threads as in the static scheduling.
+      // A thread which has finished its own chunks takes the remaining chunks of the other threads
+      template <typename Integer>
+      class work_stealing_chunks
+      {
+        static constexpr std::size_t cache_line_size = 64u;
+
+        // the next chunk of each thread, which is incremented by its owner and by idle threads
+        struct padded_chunk
+        {
+          std::atomic<Integer> value;
+          char padding[cache_line_size - sizeof(std::atomic<Integer>)];
+        }; // struct padded_chunk
+
+        Integer n_;
+        Integer chunk_size_;
+        unsigned int num_threads_;
+        Integer num_chunks_;
+        std::unique_ptr<padded_chunk[]> next_chunks_;
+
+       public:
+        work_stealing_chunks(Integer const n, Integer const chunk_size, unsigned int const num_threads)
+          : n_{n}, chunk_size_{chunk_size}, num_threads_{num_threads},
+            num_chunks_{(n + chunk_size - Integer{1}) / chunk_size},
+            next_chunks_{new padded_chunk[num_threads]}
+        {
+          for (auto thread_index = 0u; thread_index < num_threads_; ++thread_index)
+            next_chunks_[thread_index].value.store(first_chunk(thread_index), std::memory_order_relaxed);
+        }
+
+        template <typename Function>
+        void run(int const thread_index, Function& function)
+        {
+          for (auto offset = 0u; offset < num_threads_; ++offset)
+          {
+            auto const victim_index = (static_cast<unsigned int>(thread_index) + offset) % num_threads_;
+            auto const last_chunk = first_chunk(victim_index + 1u);
+
+            for (auto chunk = next_chunks_[victim_index].value.fetch_add(Integer{1}, std::memory_order_relaxed);
+                 chunk < last_chunk;
+                 chunk = next_chunks_[victim_index].value.fetch_add(Integer{1}, std::memory_order_relaxed))
+            {
+              auto const first_count = chunk * chunk_size_;
+              auto const last_count = std::min(first_count + chunk_size_, n_);
+              for (auto count = first_count; count < last_count; ++count)
+                function(count, thread_index);
+            }
+          }
+        }
+
+       private:
+        Integer first_chunk(unsigned int const thread_index) const noexcept
+        {
+          auto const num_threads = static_cast<Integer>(num_threads_);
+          auto const local_num_chunks = num_chunks_ / num_threads;
+          auto const remainder = num_chunks_ % num_threads;
+          return local_num_chunks * static_cast<Integer>(thread_index) + std::min(remainder, static_cast<Integer>(thread_index));
+        }
+      }; // class work_stealing_chunks<Integer>
+
 # if defined(_OPENMP) && defined(KET_USE_OPENMP)
       class omp_mutex
       {
@@ -169,14 +270,23 @@ namespace ket
           using mutex_type = ::ket::utility::parallel_loop_n_detail::omp_mutex;
           mutex_type mutex;
 
-#   pragma omp parallel reduction(||:is_nonstandard_exception_thrown)
+          using clock_type = ::ket::utility::busy_times::clock_type;
+          auto const busy_times = parallel_policy.busy_times();
+
+          if (parallel_policy.chunk_size() > 0u)
           {
-            auto const thread_index = static_cast<int>(omp_get_thread_num());
-#   pragma omp for
-            for (auto count = Integer{0}; count < n; ++count)
+            auto const num_threads = ::ket::utility::num_threads(parallel_policy);
+            auto chunks
+              = ::ket::utility::parallel_loop_n_detail::work_stealing_chunks<Integer>{
+                  n, static_cast<Integer>(parallel_policy.chunk_size()), num_threads};
+
+#   pragma omp parallel num_threads(static_cast<int>(num_threads)) reduction(||:is_nonstandard_exception_thrown)
+            {
+              auto const thread_index = static_cast<int>(omp_get_thread_num());
+              auto const first_time = busy_times != nullptr ? clock_type::now() : clock_type::time_point{};
               try
               {
-                function(count, thread_index);
+                chunks.run(thread_index, function);
               }
               catch (std::exception& error)
               {
@@ -189,6 +299,36 @@ namespace ket
               {
                 is_nonstandard_exception_thrown = true;
               }
+              if (busy_times != nullptr)
+                busy_times->add(thread_index, clock_type::now() - first_time);
+            }
+          }
+          else
+          {
+#   pragma omp parallel reduction(||:is_nonstandard_exception_thrown)
+            {
+              auto const thread_index = static_cast<int>(omp_get_thread_num());
+              auto const first_time = busy_times != nullptr ? clock_type::now() : clock_type::time_point{};
+#   pragma omp for nowait
+              for (auto count = Integer{0}; count < n; ++count)
+                try
+                {
+                  function(count, thread_index);
+                }
+                catch (std::exception& error)
+                {
+                  std::lock_guard<mutex_type> lock{mutex};
+
+                  if (!maybe_error)
+                    maybe_error = error;
+                }
+                catch (...)
+                {
+                  is_nonstandard_exception_thrown = true;
+                }
+              if (busy_times != nullptr)
+                busy_times->add(thread_index, clock_type::now() - first_time);
+            }
           }
 
           if (is_nonstandard_exception_thrown)
@@ -211,41 +351,82 @@ namespace ket
 
           auto const num_threads
             = static_cast<NumThreads>(::ket::utility::num_threads(parallel_policy));
-          auto const num_futures = num_threads - NumThreads{1u};
-          auto futures = std::vector<std::future<void>>{};
-          futures.reserve(num_futures);
 
-          auto const local_num_counts = static_cast<NumThreads>(n) / num_threads;
-          auto const remainder = static_cast<NumThreads>(n) % num_threads;
-          auto first_count = Integer{0};
+          using clock_type = ::ket::utility::busy_times::clock_type;
+          auto const busy_times = parallel_policy.busy_times();
 
-          for (auto thread_index = NumThreads{0u}; thread_index < num_futures; ++thread_index)
+          if (parallel_policy.chunk_size() > 0u)
           {
-            auto const last_count
-              = static_cast<Integer>(
-                  local_num_counts * (thread_index + NumThreads{1u})
-                  + std::min(remainder, thread_index + NumThreads{1u}));
+            auto chunks
+              = ::ket::utility::parallel_loop_n_detail::work_stealing_chunks<Integer>{
+                  n, static_cast<Integer>(parallel_policy.chunk_size()), static_cast<unsigned int>(num_threads)};
+            auto run_chunks
+              = [&function, &chunks, busy_times](int const thread_index)
+                {
+                  auto const first_time = busy_times != nullptr ? clock_type::now() : clock_type::time_point{};
+                  chunks.run(thread_index, function);
+                  if (busy_times != nullptr)
+                    busy_times->add(thread_index, clock_type::now() - first_time);
+                };
+            call_in_threads(parallel_policy, num_threads, run_chunks);
+            return;
+          }
 
-            futures.push_back(std::async(
-              std::launch::async,
-              [&function, first_count, last_count, thread_index]
+          auto const local_num_counts = static_cast<NumThreads>(n) / num_threads;
+          auto const remainder = static_cast<NumThreads>(n) % num_threads;
+
+          auto run_counts
+            = [&function, busy_times, local_num_counts, remainder](int const thread_index)
               {
+                auto const first_time = busy_times != nullptr ? clock_type::now() : clock_type::time_point{};
+                auto const first_count
+                  = static_cast<Integer>(
+                      local_num_counts * static_cast<NumThreads>(thread_index)
+                      + std::min(remainder, static_cast<NumThreads>(thread_index)));
+                auto const last_count
+                  = static_cast<Integer>(
+                      local_num_counts * static_cast<NumThreads>(thread_index + 1)
+                      + std::min(remainder, static_cast<NumThreads>(thread_index + 1)));
+
                 for (auto count = first_count; count < last_count; ++count)
-                  function(count, static_cast<int>(thread_index));
-              }));
+                  function(count, thread_index);
+                if (busy_times != nullptr)
+                  busy_times->add(thread_index, clock_type::now() - first_time);
+              };
+          call_in_threads(parallel_policy, num_threads, run_counts);
+        }
 
-            first_count = last_count;
+       private:
+        template <typename Function>
+        static void call_in_threads(
+          ::ket::utility::policy::parallel<NumThreads> const parallel_policy,
+          NumThreads const num_threads, Function& function)
+        {
+          if (parallel_policy.thread_pool().try_run(static_cast<unsigned int>(num_threads), function))
+            return;
+
+          // loop_n is called in a job of the thread pool, e.g. in another loop_n, whose threads are already busy
+          if (::ket::utility::thread_pool::is_in_job())
+          {
+            for (auto thread_index = NumThreads{0u}; thread_index < num_threads; ++thread_index)
+              function(static_cast<int>(thread_index));
+            return;
           }
 
-          auto const last_count
-            = static_cast<Integer>(
-                local_num_counts * num_threads + std::min(remainder, num_threads));
+          // the thread pool is used by another thread
+          auto const num_futures = num_threads - NumThreads{1u};
+          auto futures = std::vector<std::future<void>>{};
+          futures.reserve(num_futures);
 
-          for (auto count = first_count; count < last_count; ++count)
-            std::forward<Function>(function)(count, static_cast<int>(num_futures));
+          for (auto thread_index = NumThreads{0u}; thread_index < num_futures; ++thread_index)
+            futures.push_back(std::async(
+              std::launch::async,
+              [&function, thread_index] { function(static_cast<int>(thread_index)); }));
 
-          for (auto const& future: futures)
-            future.wait();
+          function(static_cast<int>(num_futures));
+
+          for (auto& future: futures)
+            future.get();
         }
       }; // struct loop_n< ::ket::utility::policy::parallel<NumThreads>, Integer >
 # endif // defined(_OPENMP) && defined(KET_USE_OPENMP)
@@ -368,6 +549,12 @@ namespace ket
             = static_cast<NumThreads>(::ket::utility::num_threads(parallel_policy));
           barrier_counters_.push_back(num_threads);
 
+          auto run_function = [&function, this](int const thread_index) { function(thread_index, *this); };
+          if (parallel_policy.thread_pool().try_run(static_cast<unsigned int>(num_threads), run_function))
+            return;
+
+          // the thread pool is busy, e.g. execute is called in loop_n. Threads are spawned even if execute is nested
+          // because function may wait at barriers for the other threads
           auto const num_futures = num_threads - NumThreads{1u};
           auto futures = std::vector<std::future<void>>{};
           futures.reserve(num_futures);
@@ -480,6 +667,43 @@ namespace ket
     } // namespace dispatch
 
 
+    namespace parallel_loop_n_detail
+    {
+      // fill, reduce and scans below assume that each thread processes one contiguous range of iterations
+      // and that the ranges are ordered by thread indices, so that work stealing is disabled in them
+      template <typename NumThreads>
+      inline ::ket::utility::policy::parallel<NumThreads> static_policy(
+        ::ket::utility::policy::parallel<NumThreads> parallel_policy) noexcept
+      {
+        parallel_policy.chunk_size(0u);
+        return parallel_policy;
+      }
+
+      // calls function(first_count, last_count, range_index) for each of num_threads contiguous ranges of [0, n),
+      // so that reductions keep partial sums in local variables and store them once per range
+      template <typename NumThreads, typename Integer, typename Function>
+      inline void loop_ranges(
+        ::ket::utility::policy::parallel<NumThreads> const parallel_policy, Integer const n, Function function)
+      {
+        auto const num_ranges = static_cast<Integer>(::ket::utility::num_threads(parallel_policy));
+        auto const local_num_counts = n / num_ranges;
+        auto const remainder = n % num_ranges;
+
+        using ::ket::utility::loop_n;
+        loop_n(
+          ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), num_ranges,
+          [function, local_num_counts, remainder](Integer const range_index, int)
+          {
+            auto const first_count
+              = local_num_counts * range_index + (range_index < remainder ? range_index : remainder);
+            auto const last_count = first_count + local_num_counts + (range_index < remainder ? Integer{1} : Integer{0});
+            if (first_count < last_count)
+              function(first_count, last_count, range_index);
+          });
+      }
+    } // namespace parallel_loop_n_detail
+
+
     // fill
     namespace dispatch
     {
@@ -497,7 +721,7 @@ namespace ket
                 static_cast<int>(::ket::utility::num_threads(parallel_policy)),
                 static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
           auto is_calleds_first = std::begin(is_calleds);
           auto iters_first = std::begin(iters);
 
@@ -505,7 +729,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<ForwardIterator>::difference_type;
           loop_n(
-            parallel_policy, std::distance(first, last),
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), std::distance(first, last),
             [first, &value, is_calleds_first, iters_first](
               difference_type const n, int const thread_index)
             {
@@ -529,7 +753,7 @@ namespace ket
             = typename std::iterator_traits<RandomAccessIterator>::difference_type;
           using ::ket::utility::loop_n;
           loop_n(
-            parallel_policy, last - first,
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), last - first,
             [first, &value](difference_type const n, int) { first[n] = value; });
         }
       }; // struct fill< ::ket::utility::policy::parallel<NumThreads> >
@@ -548,37 +772,21 @@ namespace ket
           ForwardIterator const first, ForwardIterator const last,
           std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
           using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
-          auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
+          auto partial_sums = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<ForwardIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<ForwardIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, std::distance(first, last),
-            [first, is_calleds_first, iters_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters_first[thread_index] = first;
-                std::advance(iters_first[thread_index], n);
-
-                partial_sums_first[thread_index] = *iters_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index] += *iters_first[thread_index]++;
+              auto iter = std::next(first, first_count);
+              auto partial_sum = static_cast<value_type>(*iter);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum += *++iter;
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(std::next(partial_sums_first), std::end(partial_sums), *partial_sums_first);
@@ -590,31 +798,20 @@ namespace ket
           RandomAccessIterator const first, RandomAccessIterator const last,
           std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          using value_type
-            = typename std::iterator_traits<RandomAccessIterator>::value_type;
-          auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
+          using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+          auto partial_sums = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<RandomAccessIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, last - first,
-            [first, is_calleds_first, partial_sums_first](difference_type const n, int const thread_index)
+            [first, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                partial_sums_first[thread_index] = first[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index] += first[n];
+              auto partial_sum = static_cast<value_type>(first[first_count]);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum += first[count];
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(std::next(partial_sums_first), std::end(partial_sums), *partial_sums_first);
@@ -626,35 +823,20 @@ namespace ket
           ForwardIterator const first, ForwardIterator const last, Value const initial_value,
           std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<ForwardIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<ForwardIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, std::distance(first, last),
-            [first, is_calleds_first, iters_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters_first[thread_index] = first;
-                std::advance(iters_first[thread_index], n);
-
-                partial_sums_first[thread_index] = *iters_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index] += *iters_first[thread_index]++;
+              auto iter = std::next(first, first_count);
+              auto partial_sum = static_cast<Value>(*iter);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum += *++iter;
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
@@ -666,29 +848,19 @@ namespace ket
           RandomAccessIterator const first, RandomAccessIterator const last, Value const initial_value,
           std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<RandomAccessIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, last - first,
-            [first, is_calleds_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                partial_sums_first[thread_index] = first[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index] += first[n];
+              auto partial_sum = static_cast<Value>(first[first_count]);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum += first[count];
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
@@ -701,38 +873,20 @@ namespace ket
           Value const initial_value, BinaryOperation binary_operation,
           std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<ForwardIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<ForwardIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, std::distance(first, last),
-            [first, initial_value, binary_operation,
-             is_calleds_first, iters_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first, binary_operation, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters_first[thread_index] = first;
-                std::advance(iters_first[thread_index], n);
-
-                partial_sums_first[thread_index] = *iters_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index]
-                  = binary_operation(
-                      partial_sums_first[thread_index], *iters_first[thread_index]++);
+              auto iter = std::next(first, first_count);
+              auto partial_sum = static_cast<Value>(*iter);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum = binary_operation(partial_sum, *++iter);
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_operation);
@@ -745,30 +899,19 @@ namespace ket
           Value const initial_value, BinaryOperation binary_operation,
           std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<RandomAccessIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, last - first,
-            [first, binary_operation, is_calleds_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first, binary_operation, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                partial_sums_first[thread_index] = first[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index]
-                  = binary_operation(partial_sums_first[thread_index], first[n]);
+              auto partial_sum = static_cast<Value>(first[first_count]);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum = binary_operation(partial_sum, first[count]);
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_operation);
@@ -790,42 +933,21 @@ namespace ket
           ForwardIterator2 const first2, Value const initial_value,
           std::forward_iterator_tag const, std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters1
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
-          auto iters2
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters1_first = std::begin(iters1);
-          auto iters2_first = std::begin(iters2);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<ForwardIterator1>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<ForwardIterator1>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, std::distance(first1, last1),
-            [first1, first2, is_calleds_first, iters1_first, iters2_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first1, first2, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters1_first[thread_index] = first1;
-                std::advance(iters1_first[thread_index], n);
-
-                iters2_first[thread_index] = first2;
-                std::advance(iters2_first[thread_index], n);
-
-                partial_sums_first[thread_index] = *iters1_first[thread_index]++ * *iters2_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index] += *iters1_first[thread_index]++ * *iters2_first[thread_index]++;
+              auto iter1 = std::next(first1, first_count);
+              auto iter2 = std::next(first2, first_count);
+              auto partial_sum = static_cast<Value>(*iter1 * *iter2);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum += *++iter1 * *++iter2;
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
@@ -838,36 +960,20 @@ namespace ket
           ForwardIterator const first2, Value const initial_value,
           std::random_access_iterator_tag const, std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters2
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters2_first = std::begin(iters2);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<RandomAccessIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, last1 - first1,
-            [first1, first2, is_calleds_first, iters2_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first1, first2, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters2_first[thread_index] = first2;
-                std::advance(iters2_first[thread_index], n);
-
-                partial_sums_first[thread_index] = first1[n] * *iters2_first[thread_index]++;
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index] += first1[n] * *iters2_first[thread_index]++;
+              auto iter2 = std::next(first2, first_count);
+              auto partial_sum = static_cast<Value>(first1[first_count] * *iter2);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum += first1[count] * *++iter2;
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
@@ -880,36 +986,20 @@ namespace ket
           RandomAccessIterator const first2, Value const initial_value,
           std::forward_iterator_tag const, std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters1
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters1_first = std::begin(iters1);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<ForwardIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<ForwardIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, std::distance(first1, last1),
-            [first1, first2, is_calleds_first, iters1_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first1, first2, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters1_first[thread_index] = first1;
-                std::advance(iters1_first[thread_index], n);
-
-                partial_sums_first[thread_index] = *iters1_first[thread_index]++ * first2[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index] += *iters1_first[thread_index]++ * first2[n];
+              auto iter1 = std::next(first1, first_count);
+              auto partial_sum = static_cast<Value>(*iter1 * first2[first_count]);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum += *++iter1 * first2[count];
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
@@ -922,30 +1012,19 @@ namespace ket
           RandomAccessIterator2 const first2, Value const initial_value,
           std::random_access_iterator_tag const, std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, last1 - first1,
-            [first1, first2, is_calleds_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first1, first2, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                partial_sums_first[thread_index] = first1[n] * first2[n];
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index] += first1[n] * first2[n];
+              auto partial_sum = static_cast<Value>(first1[first_count] * first2[first_count]);
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum += first1[count] * first2[count];
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value);
@@ -962,49 +1041,21 @@ namespace ket
           BinaryTransformOperation binary_transform_operation,
           std::forward_iterator_tag const, std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters1
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
-          auto iters2
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters1_first = std::begin(iters1);
-          auto iters2_first = std::begin(iters2);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<ForwardIterator1>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<ForwardIterator1>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, std::distance(first1, last1),
-            [first1, first2, binary_reduction_operation, binary_transform_operation,
-             is_calleds_first, iters1_first, iters2_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first1, first2, binary_reduction_operation, binary_transform_operation, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters1_first[thread_index] = first1;
-                std::advance(iters1_first[thread_index], n);
-
-                iters2_first[thread_index] = first2;
-                std::advance(iters2_first[thread_index], n);
-
-                partial_sums_first[thread_index]
-                  = binary_transform_operation(
-                      *iters1_first[thread_index]++, *iters2_first[thread_index]++);
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index]
-                  = binary_reduction_operation(
-                      partial_sums_first[thread_index],
-                      binary_transform_operation(
-                        *iters1_first[thread_index]++, *iters2_first[thread_index]++));
+              auto iter1 = std::next(first1, first_count);
+              auto iter2 = std::next(first2, first_count);
+              auto partial_sum = static_cast<Value>(binary_transform_operation(*iter1, *iter2));
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum = binary_reduction_operation(partial_sum, binary_transform_operation(*++iter1, *++iter2));
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
@@ -1021,41 +1072,20 @@ namespace ket
           BinaryTransformOperation binary_transform_operation,
           std::random_access_iterator_tag const, std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters2
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters2_first = std::begin(iters2);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<RandomAccessIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, last1 - first1,
-            [first1, first2, binary_reduction_operation, binary_transform_operation,
-             is_calleds_first, iters2_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first1, first2, binary_reduction_operation, binary_transform_operation, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters2_first[thread_index] = first2;
-                std::advance(iters2_first[thread_index], n);
-
-                partial_sums_first[thread_index]
-                  = binary_transform_operation(first1[n], *iters2_first[thread_index]++);
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index]
-                  = binary_reduction_operation(
-                      partial_sums_first[thread_index],
-                      binary_transform_operation(first1[n], *iters2_first[thread_index]++));
+              auto iter2 = std::next(first2, first_count);
+              auto partial_sum = static_cast<Value>(binary_transform_operation(first1[first_count], *iter2));
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum = binary_reduction_operation(partial_sum, binary_transform_operation(first1[count], *++iter2));
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
@@ -1072,41 +1102,20 @@ namespace ket
           BinaryTransformOperation binary_transform_operation,
           std::forward_iterator_tag const, std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters1
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters1_first = std::begin(iters1);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<ForwardIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<ForwardIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, std::distance(first1, last1),
-            [first1, first2, binary_reduction_operation, binary_transform_operation,
-             is_calleds_first, iters1_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first1, first2, binary_reduction_operation, binary_transform_operation, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters1_first[thread_index] = first1;
-                std::advance(iters1_first[thread_index], n);
-
-                partial_sums_first[thread_index]
-                  = binary_transform_operation(*iters1_first[thread_index]++, first2[n]);
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index]
-                  = binary_reduction_operation(
-                      partial_sums_first[thread_index],
-                      binary_transform_operation(*iters1_first[thread_index]++, first2[n]));
+              auto iter1 = std::next(first1, first_count);
+              auto partial_sum = static_cast<Value>(binary_transform_operation(*iter1, first2[first_count]));
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum = binary_reduction_operation(partial_sum, binary_transform_operation(*++iter1, first2[count]));
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
@@ -1123,34 +1132,19 @@ namespace ket
           BinaryTransformOperation binary_transform_operation,
           std::random_access_iterator_tag const, std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, last1 - first1,
-            [first1, first2, binary_reduction_operation, binary_transform_operation,
-             is_calleds_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first1, first2, binary_reduction_operation, binary_transform_operation, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                partial_sums_first[thread_index] = binary_transform_operation(first1[n], first2[n]);
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index]
-                  = binary_reduction_operation(
-                      partial_sums_first[thread_index],
-                      binary_transform_operation(first1[n], first2[n]));
+              auto partial_sum = static_cast<Value>(binary_transform_operation(first1[first_count], first2[first_count]));
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum = binary_reduction_operation(partial_sum, binary_transform_operation(first1[count], first2[count]));
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
@@ -1167,41 +1161,20 @@ namespace ket
           UnaryTransformOperation unary_transform_operation,
           std::forward_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto iters
-            = std::vector<ForwardIterator>(::ket::utility::num_threads(parallel_policy));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
-          auto iters_first = std::begin(iters);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<ForwardIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<ForwardIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, std::distance(first, last),
-            [first, binary_reduction_operation, unary_transform_operation,
-             is_calleds_first, iters_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first, binary_reduction_operation, unary_transform_operation, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                iters_first[thread_index] = first;
-                std::advance(iters_first[thread_index], n);
-
-                partial_sums_first[thread_index]
-                  = unary_transform_operation(*iters_first[thread_index]++);
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index]
-                  = binary_reduction_operation(
-                      partial_sums_first[thread_index],
-                      unary_transform_operation(*iters_first[thread_index]++));
+              auto iter = std::next(first, first_count);
+              auto partial_sum = static_cast<Value>(unary_transform_operation(*iter));
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum = binary_reduction_operation(partial_sum, unary_transform_operation(*++iter));
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
@@ -1218,33 +1191,19 @@ namespace ket
           UnaryTransformOperation unary_transform_operation,
           std::random_access_iterator_tag const)
         {
-          auto is_calleds
-            = std::vector<int>(
-                ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
-          auto partial_sums
-            = std::vector<Value>(::ket::utility::num_threads(parallel_policy));
-
-          auto is_calleds_first = std::begin(is_calleds);
+          auto partial_sums = ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy));
           auto partial_sums_first = std::begin(partial_sums);
 
-          using ::ket::utility::loop_n;
-          using difference_type
-            = typename std::iterator_traits<RandomAccessIterator>::difference_type;
-          loop_n(
+          using difference_type = typename std::iterator_traits<RandomAccessIterator>::difference_type;
+          ::ket::utility::parallel_loop_n_detail::loop_ranges(
             parallel_policy, last - first,
-            [first, binary_reduction_operation, unary_transform_operation,
-             is_calleds_first, partial_sums_first](
-              difference_type const n, int const thread_index)
+            [first, binary_reduction_operation, unary_transform_operation, partial_sums_first](
+              difference_type const first_count, difference_type const last_count, difference_type const range_index)
             {
-              if (not is_calleds_first[thread_index])
-              {
-                partial_sums_first[thread_index] = unary_transform_operation(first[n]);
-                is_calleds_first[thread_index] = static_cast<int>(true);
-              }
-              else
-                partial_sums_first[thread_index]
-                  = binary_reduction_operation(
-                      partial_sums_first[thread_index], unary_transform_operation(first[n]));
+              auto partial_sum = static_cast<Value>(unary_transform_operation(first[first_count]));
+              for (auto count = first_count + difference_type{1}; count < last_count; ++count)
+                partial_sum = binary_reduction_operation(partial_sum, unary_transform_operation(first[count]));
+              partial_sums_first[range_index] = partial_sum;
             });
 
           return std::accumulate(partial_sums_first, std::end(partial_sums), initial_value, binary_reduction_operation);
@@ -1259,13 +1218,13 @@ namespace ket
       template <
         typename ParallelPolicy,
         typename RangeSize, typename ForwardIterator, typename BinaryOperation,
-        typename Allocator1, typename Value, typename Allocator2, typename Allocator3>
+        typename Allocator, typename Value>
       inline void post_inclusive_scan(
         ParallelPolicy const parallel_policy,
         RangeSize const range_size, ForwardIterator d_first, BinaryOperation binary_operation,
-        std::vector<int, Allocator1>& is_calleds,
-        std::vector<Value, Allocator2>& partial_sums,
-        std::vector<ForwardIterator, Allocator3>& outs)
+        std::vector<int, Allocator>& is_calleds,
+        ::ket::utility::per_thread<Value>& partial_sums,
+        ::ket::utility::per_thread<ForwardIterator>& outs)
       {
         auto is_calleds_first = std::begin(is_calleds);
         auto partial_sums_first = std::begin(partial_sums);
@@ -1279,7 +1238,7 @@ namespace ket
 
         using ::ket::utility::loop_n;
         loop_n(
-          parallel_policy, range_size,
+          ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), range_size,
           [d_first, binary_operation, is_calleds_first, partial_sums_first, outs_first](
             RangeSize const n, int const thread_index)
           {
@@ -1302,11 +1261,11 @@ namespace ket
       template <
         typename ParallelPolicy,
         typename RangeSize, typename RandomAccessIterator, typename BinaryOperation,
-        typename Value, typename Allocator>
+        typename Value>
       inline void post_inclusive_scan(
         ParallelPolicy const parallel_policy,
         RangeSize const range_size, RandomAccessIterator d_first, BinaryOperation binary_operation,
-        std::vector<Value, Allocator>& partial_sums)
+        ::ket::utility::per_thread<Value>& partial_sums)
       {
         auto partial_sums_first = std::begin(partial_sums);
 
@@ -1316,7 +1275,7 @@ namespace ket
 
         using ::ket::utility::loop_n;
         loop_n(
-          parallel_policy, range_size,
+          ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), range_size,
           [d_first, binary_operation, partial_sums_first](
             RangeSize const n, int const thread_index)
           {
@@ -1345,12 +1304,12 @@ namespace ket
             = std::vector<int>(
                 ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto iters_first = std::begin(iters);
@@ -1361,7 +1320,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<ForwardIterator1>::difference_type;
           loop_n(
-            parallel_policy, std::distance(first, last),
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), std::distance(first, last),
             [first, d_first, is_calleds_first, iters_first, outs_first, partial_sums_first](
               difference_type const n, int const thread_index)
             {
@@ -1387,7 +1346,7 @@ namespace ket
             is_calleds_first, std::end(is_calleds), static_cast<int>(false));
 
           loop_n(
-            parallel_policy, std::distance(first, last),
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), std::distance(first, last),
             [d_first, is_calleds_first, outs_first, partial_sums_first](
               difference_type const n, int const thread_index)
             {
@@ -1419,7 +1378,7 @@ namespace ket
                 ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
           using value_type
             = typename std::iterator_traits<RandomAccessIterator1>::value_type;
-          auto partial_sums = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+          auto partial_sums = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto partial_sums_first = std::begin(partial_sums);
@@ -1428,7 +1387,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
           loop_n(
-            parallel_policy, last - first,
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), last - first,
             [first, d_first, is_calleds_first, partial_sums_first](
               difference_type const n, int const thread_index)
             {
@@ -1447,7 +1406,7 @@ namespace ket
             partial_sums_first, std::end(partial_sums), partial_sums_first);
 
           loop_n(
-            parallel_policy, last - first,
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), last - first,
             [d_first, partial_sums_first](
               difference_type const n, int const thread_index)
             {
@@ -1474,12 +1433,12 @@ namespace ket
             = std::vector<int>(
                 ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto iters_first = std::begin(iters);
@@ -1490,7 +1449,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<ForwardIterator1>::difference_type;
           loop_n(
-            parallel_policy, std::distance(first, last),
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), std::distance(first, last),
             [first, d_first, binary_operation,
              is_calleds_first, iters_first, outs_first, partial_sums_first](
               difference_type const n, int const thread_index)
@@ -1536,7 +1495,7 @@ namespace ket
           using value_type
             = typename std::iterator_traits<RandomAccessIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto partial_sums_first = std::begin(partial_sums);
@@ -1545,7 +1504,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
           loop_n(
-            parallel_policy, last - first,
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), last - first,
             [first, d_first, binary_operation, is_calleds_first, partial_sums_first](
               difference_type const n, int const thread_index)
             {
@@ -1581,12 +1540,12 @@ namespace ket
             = std::vector<int>(
                 ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto iters_first = std::begin(iters);
@@ -1597,7 +1556,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<ForwardIterator1>::difference_type;
           loop_n(
-            parallel_policy, std::distance(first, last),
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), std::distance(first, last),
             [first, d_first, binary_operation, initial_value,
              is_calleds_first, iters_first, outs_first, partial_sums_first](
               difference_type const n, int const thread_index)
@@ -1645,7 +1604,7 @@ namespace ket
                 ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
           using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto partial_sums_first = std::begin(partial_sums);
@@ -1654,7 +1613,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
           loop_n(
-            parallel_policy, last - first,
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), last - first,
             [first, d_first, binary_operation, initial_value, is_calleds_first, partial_sums_first](
               difference_type const n, int const thread_index)
             {
@@ -1702,12 +1661,12 @@ namespace ket
             = std::vector<int>(
                 ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto iters_first = std::begin(iters);
@@ -1718,7 +1677,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<ForwardIterator1>::difference_type;
           loop_n(
-            parallel_policy, std::distance(first, last),
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), std::distance(first, last),
             [first, d_first, binary_operation, unary_operation,
              is_calleds_first, iters_first, outs_first, partial_sums_first](
               difference_type const n, int const thread_index)
@@ -1765,7 +1724,7 @@ namespace ket
                 ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
           using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto partial_sums_first = std::begin(partial_sums);
@@ -1774,7 +1733,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
           loop_n(
-            parallel_policy, last - first,
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), last - first,
             [first, d_first, binary_operation, unary_operation,
              is_calleds_first, partial_sums_first](
               difference_type const n, int const thread_index)
@@ -1813,12 +1772,12 @@ namespace ket
             = std::vector<int>(
                 ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
           auto iters
-            = std::vector<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator1>(::ket::utility::num_threads(parallel_policy));
           auto outs
-            = std::vector<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<ForwardIterator2>(::ket::utility::num_threads(parallel_policy));
           using value_type = typename std::iterator_traits<ForwardIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto iters_first = std::begin(iters);
@@ -1830,7 +1789,7 @@ namespace ket
             typename std::iterator_traits<ForwardIterator1>::difference_type
             difference_type;
           loop_n(
-            parallel_policy, std::distance(first, last),
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), std::distance(first, last),
             [first, d_first, binary_operation, unary_operation, initial_value,
              is_calleds_first, iters_first, outs_first, partial_sums_first](
               difference_type const n, int const thread_index)
@@ -1881,7 +1840,7 @@ namespace ket
                 ::ket::utility::num_threads(parallel_policy), static_cast<int>(false));
           using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
           auto partial_sums
-            = std::vector<value_type>(::ket::utility::num_threads(parallel_policy));
+            = ::ket::utility::per_thread<value_type>(::ket::utility::num_threads(parallel_policy));
 
           auto is_calleds_first = std::begin(is_calleds);
           auto partial_sums_first = std::begin(partial_sums);
@@ -1890,7 +1849,7 @@ namespace ket
           using difference_type
             = typename std::iterator_traits<RandomAccessIterator1>::difference_type;
           loop_n(
-            parallel_policy, last - first,
+            ::ket::utility::parallel_loop_n_detail::static_policy(parallel_policy), last - first,
             [first, d_first, binary_operation, unary_operation,
              initial_value, is_calleds_first, partial_sums_first](
               difference_type const n, int const thread_index)
@@ -0,0 +1,221 @@
+#ifndef KET_UTILITY_PARALLEL_THREAD_POOL_HPP
+# define KET_UTILITY_PARALLEL_THREAD_POOL_HPP
+
+# include <cassert>
+# include <vector>
+# include <memory>
+# include <atomic>
+# include <thread>
+# include <mutex>
+# include <condition_variable>
+# include <exception>
+# include <utility>
+
+
+namespace ket
+{
+  namespace utility
+  {
+    // persistent worker threads used by ::ket::utility::policy::parallel unless OpenMP is used.
+    // try_run(num_threads, function) calls function(thread_index) for thread_index = 0, ..., num_threads-1 in parallel,
+    // where the calling thread takes thread_index = num_threads-1, and returns after all calls are finished.
+    // Workers are started on the first job which needs them, and the pool is shared in the process (see instance())
+    class thread_pool
+    {
+      // the number of checks of the shared state before sleeping. Each check yields to other threads
+      static constexpr unsigned int num_spins = 1024u;
+
+      std::vector<std::thread> workers_;
+
+      std::mutex mutex_;
+      std::condition_variable start_condition_;
+      std::condition_variable finish_condition_;
+
+      // locked while a job runs so that concurrent or nested jobs can fall back to other ways
+      std::mutex job_mutex_;
+
+      std::atomic<unsigned int> generation_;
+      std::atomic<unsigned int> num_running_workers_;
+      bool is_terminated_;
+
+      unsigned int num_job_threads_;
+      void (*invoker_)(void*, int);
+      void* function_;
+      std::exception_ptr exception_;
+
+      // true while the current thread runs a job of some thread pool
+      static bool& is_in_job_ref() noexcept
+      {
+        static thread_local bool result = false;
+        return result;
+      }
+
+      class job_guard
+      {
+       public:
+        job_guard() noexcept { is_in_job_ref() = true; }
+        ~job_guard() noexcept { is_in_job_ref() = false; }
+
+        job_guard(job_guard const&) = delete;
+        job_guard& operator=(job_guard const&) = delete;
+        job_guard(job_guard&&) = delete;
+        job_guard& operator=(job_guard&&) = delete;
+      }; // class job_guard
+
+     public:
+      thread_pool() noexcept
+        : workers_{}, mutex_{}, start_condition_{}, finish_condition_{}, job_mutex_{},
+          generation_{0u}, num_running_workers_{0u}, is_terminated_{false},
+          num_job_threads_{0u}, invoker_{nullptr}, function_{nullptr}, exception_{}
+      { }
+
+      // the thread pool shared by all parallel policies. No thread is started here
+      static thread_pool& instance() noexcept
+      {
+        static thread_pool result{};
+        return result;
+      }
+
+      // true if the current thread is running a job of a thread pool, i.e. try_run is called from a job
+      static bool is_in_job() noexcept { return is_in_job_ref(); }
+
+      ~thread_pool()
+      {
+        {
+          std::lock_guard<std::mutex> lock{mutex_};
+          is_terminated_ = true;
+          generation_.fetch_add(1u, std::memory_order_release);
+        }
+        start_condition_.notify_all();
+
+        for (auto& worker: workers_)
+          worker.join();
+      }
+
+      thread_pool(thread_pool const&) = delete;
+      thread_pool& operator=(thread_pool const&) = delete;
+      thread_pool(thread_pool&&) = delete;
+      thread_pool& operator=(thread_pool&&) = delete;
+
+      // returns false without calling function if it is called from a job, or another job is running
+      template <typename Function>
+      bool try_run(unsigned int const num_threads, Function& function)
+      {
+        assert(num_threads > 0u);
+        // job_mutex_ may be owned by this thread if this is a nested call, so it must not be touched here
+        if (is_in_job())
+          return false;
+
+        auto lock = std::unique_lock<std::mutex>{job_mutex_, std::try_to_lock};
+        if (not lock.owns_lock())
+          return false;
+
+        job_guard const guard{};
+        if (num_threads == 1u)
+        {
+          function(0);
+          return true;
+        }
+
+        // workers_ is modified only while job_mutex_ is owned and no worker runs a job
+        if (workers_.size() < num_threads - 1u)
+        {
+          workers_.reserve(num_threads - 1u);
+          auto const generation = generation_.load(std::memory_order_acquire);
+          for (auto worker_index = static_cast<unsigned int>(workers_.size()); worker_index < num_threads - 1u; ++worker_index)
+            workers_.emplace_back([this, worker_index, generation] { work(static_cast<int>(worker_index), generation); });
+        }
+
+        {
+          std::lock_guard<std::mutex> lock{mutex_};
+          num_job_threads_ = num_threads;
+          invoker_ = [](void* function, int const thread_index) { (*static_cast<Function*>(function))(thread_index); };
+          function_ = std::addressof(function);
+          exception_ = nullptr;
+          num_running_workers_.store(static_cast<unsigned int>(workers_.size()), std::memory_order_relaxed);
+          generation_.fetch_add(1u, std::memory_order_release);
+        }
+        start_condition_.notify_all();
+
+        try
+        {
+          function(static_cast<int>(num_threads - 1u));
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock{mutex_};
+          if (not exception_)
+            exception_ = std::current_exception();
+        }
+
+        for (auto spin = 0u; spin < num_spins and num_running_workers_.load(std::memory_order_acquire) != 0u; ++spin)
+          std::this_thread::yield();
+
+        if (num_running_workers_.load(std::memory_order_acquire) != 0u)
+        {
+          auto lock = std::unique_lock<std::mutex>{mutex_};
+          finish_condition_.wait(lock, [this] { return num_running_workers_.load(std::memory_order_acquire) == 0u; });
+        }
+
+        if (exception_)
+          std::rethrow_exception(exception_);
+
+        return true;
+      }
+
+     private:
+      void work(int const worker_index, unsigned int last_generation)
+      {
+        job_guard const guard{};
+        while (true)
+        {
+          // spin for a while because jobs are usually submitted one after another
+          for (auto spin = 0u; spin < num_spins and generation_.load(std::memory_order_acquire) == last_generation; ++spin)
+            std::this_thread::yield();
+
+          if (generation_.load(std::memory_order_acquire) == last_generation)
+          {
+            auto lock = std::unique_lock<std::mutex>{mutex_};
+            start_condition_.wait(
+              lock, [this, last_generation] { return generation_.load(std::memory_order_acquire) != last_generation; });
+          }
+
+          auto num_job_threads = 0u;
+          auto invoker = static_cast<void (*)(void*, int)>(nullptr);
+          auto function = static_cast<void*>(nullptr);
+          {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (is_terminated_)
+              return;
+
+            last_generation = generation_.load(std::memory_order_acquire);
+            num_job_threads = num_job_threads_;
+            invoker = invoker_;
+            function = function_;
+          }
+
+          if (static_cast<unsigned int>(worker_index) + 1u < num_job_threads)
+            try
+            {
+              invoker(function, worker_index);
+            }
+            catch (...)
+            {
+              std::lock_guard<std::mutex> lock{mutex_};
+              if (not exception_)
+                exception_ = std::current_exception();
+            }
+
+          if (num_running_workers_.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+          {
+            std::lock_guard<std::mutex> lock{mutex_};
+            finish_condition_.notify_one();
+          }
+        }
+      }
+    }; // class thread_pool
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_PARALLEL_THREAD_POOL_HPP
@@ -0,0 +1,108 @@
+#ifndef KET_UTILITY_PER_THREAD_HPP
+# define KET_UTILITY_PER_THREAD_HPP
+
+# include <cstddef>
+# include <vector>
+# include <iterator>
+# include <numeric>
+# include <utility>
+
+# include <boost/iterator/iterator_facade.hpp>
+
+# include <ket/utility/loop_n.hpp>
+
+
+namespace ket
+{
+  namespace utility
+  {
+    namespace per_thread_detail
+    {
+      template <typename Value, typename BaseIterator>
+      class strided_iterator
+        : public boost::iterators::iterator_facade<
+            strided_iterator<Value, BaseIterator>, Value, std::random_access_iterator_tag>
+      {
+        BaseIterator base_;
+        std::ptrdiff_t stride_;
+
+        friend class boost::iterators::iterator_core_access;
+
+       public:
+        strided_iterator()
+          : base_{}, stride_{1}
+        { }
+
+        strided_iterator(BaseIterator const base, std::ptrdiff_t const stride)
+          : base_{base}, stride_{stride}
+        { }
+
+        // boost::iterators::iterator_facade::operator[] may return a proxy object
+        Value& operator[](std::ptrdiff_t const n) const { return *(base_ + n * stride_); }
+
+       private:
+        Value& dereference() const { return *base_; }
+        bool equal(strided_iterator const& other) const { return base_ == other.base_; }
+        void increment() { base_ += stride_; }
+        void decrement() { base_ -= stride_; }
+        void advance(std::ptrdiff_t const n) { base_ += n * stride_; }
+        std::ptrdiff_t distance_to(strided_iterator const& other) const { return (other.base_ - base_) / stride_; }
+      }; // class strided_iterator<Value, BaseIterator>
+    } // namespace per_thread_detail
+
+    // one value for each thread, e.g. partial sums of a reduction. Adjacent values are separated by at least one cache line,
+    // so that a thread updating its value in every iteration of ::ket::utility::loop_n does not invalidate cache lines of other threads
+    template <typename Value>
+    class per_thread
+    {
+      static constexpr std::size_t cache_line_size = 64u;
+      static constexpr std::size_t stride = std::size_t{1u} + (cache_line_size + sizeof(Value) - std::size_t{1u}) / sizeof(Value);
+
+      using data_type = std::vector<Value>;
+      data_type data_;
+      std::size_t size_;
+
+     public:
+      using value_type = Value;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = value_type&;
+      using const_reference = value_type const&;
+      using iterator = ::ket::utility::per_thread_detail::strided_iterator<value_type, typename data_type::iterator>;
+      using const_iterator
+        = ::ket::utility::per_thread_detail::strided_iterator<value_type const, typename data_type::const_iterator>;
+
+      explicit per_thread(size_type const num_threads, value_type const& value = value_type{})
+        : data_(num_threads * stride, value), size_{num_threads}
+      { }
+
+      size_type size() const noexcept { return size_; }
+
+      reference operator[](size_type const index) { return data_[index * stride]; }
+      const_reference operator[](size_type const index) const { return data_[index * stride]; }
+      reference front() { return data_.front(); }
+      const_reference front() const { return data_.front(); }
+      reference back() { return data_[(size_ - size_type{1u}) * stride]; }
+      const_reference back() const { return data_[(size_ - size_type{1u}) * stride]; }
+
+      iterator begin() { return iterator{data_.begin(), static_cast<difference_type>(stride)}; }
+      const_iterator begin() const { return const_iterator{data_.cbegin(), static_cast<difference_type>(stride)}; }
+      iterator end() { return iterator{data_.begin() + size_ * stride, static_cast<difference_type>(stride)}; }
+      const_iterator end() const { return const_iterator{data_.cbegin() + size_ * stride, static_cast<difference_type>(stride)}; }
+
+      template <typename BinaryOperation>
+      value_type reduce(value_type const& initial_value, BinaryOperation binary_operation) const
+      { return std::accumulate(begin(), end(), initial_value, binary_operation); }
+
+      value_type reduce(value_type const& initial_value) const
+      { return std::accumulate(begin(), end(), initial_value); }
+    }; // class per_thread<Value>
+
+    template <typename Value, typename ParallelPolicy>
+    inline ::ket::utility::per_thread<Value> make_per_thread(ParallelPolicy const parallel_policy, Value const& value)
+    { return ::ket::utility::per_thread<Value>(::ket::utility::num_threads(parallel_policy), value); }
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_PER_THREAD_HPP
@@ -0,0 +1,48 @@
+#ifndef KET_UTILITY_RESIZE_WITH_ZEROS_HPP
+# define KET_UTILITY_RESIZE_WITH_ZEROS_HPP
+
+# include <cassert>
+# include <cstddef>
+# include <vector>
+# include <iterator>
+
+# include <ket/utility/loop_n.hpp>
+# include <ket/utility/huge_page_allocator.hpp>
+# include <ket/utility/zero_page_allocator.hpp>
+
+
+namespace ket
+{
+  namespace utility
+  {
+    // Resizes empty data to num_values zeros, which are allocated by ::ket::utility::huge_page_allocator and
+    // ::ket::utility::zero_page_allocator.
+    // If ::ket::utility::uses_huge_pages(), each thread first touches the pages which it processes in loop_n, even if
+    // ::ket::utility::uses_zero_pages(), so that every page is placed on the NUMA node of the thread applying gates to it.
+    // Otherwise, if ::ket::utility::uses_zero_pages(), amplitudes are left untouched and the operating system fills each page
+    // with zeros when it is touched first
+    template <typename ParallelPolicy, typename Value, typename Allocator>
+    inline void resize_with_zeros(
+      ParallelPolicy const parallel_policy, std::vector<Value, Allocator>& data, std::size_t const num_values)
+    {
+      assert(data.empty());
+
+      if (::ket::utility::uses_huge_pages())
+      {
+        // amplitudes are left untouched by resize
+        data.resize(num_values);
+        auto const first = std::begin(data);
+        ::ket::utility::loop_n(
+          parallel_policy, num_values,
+          [first](std::size_t const index, int const) { first[index] = Value{}; });
+      }
+      else if (::ket::utility::uses_zero_pages())
+        data.resize(num_values);
+      else
+        data.assign(num_values, Value{});
+    }
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_RESIZE_WITH_ZEROS_HPP
@@ -0,0 +1,115 @@
+#ifndef KET_UTILITY_ZERO_PAGE_ALLOCATOR_HPP
+# define KET_UTILITY_ZERO_PAGE_ALLOCATOR_HPP
+
+# include <cstddef>
+# include <cstdlib>
+# include <memory>
+# include <utility>
+# include <new>
+
+
+namespace ket
+{
+  namespace utility
+  {
+    // whether memory of ::ket::utility::zero_page_allocator is allocated with pages which are filled with zeros on first touch
+    inline bool& uses_zero_pages()
+    {
+      static auto result = false;
+      return result;
+    }
+
+    // Allocates memory with std::calloc, which maps large blocks of fresh anonymous pages instead of writing zeros into them.
+    // Elements constructed without arguments are left untouched (they are zeros already), so that creating a state only reserves
+    // address space and each page is filled with zeros by the operating system when a gate first touches it.
+    // Memory is allocated by Allocator if ::ket::utility::uses_zero_pages() was false when this allocator was constructed
+    template <typename Value, typename Allocator = std::allocator<Value>>
+    class zero_page_allocator
+    {
+      Allocator allocator_;
+      bool uses_zero_pages_;
+
+      template <typename Value_, typename Allocator_>
+      friend class zero_page_allocator;
+
+     public:
+      using value_type = Value;
+      using pointer = Value*;
+      using const_pointer = Value const*;
+      using reference = Value&;
+      using const_reference = Value const&;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+
+      template <typename Value_>
+      struct rebind
+      {
+        using other
+          = ::ket::utility::zero_page_allocator<
+              Value_, typename std::allocator_traits<Allocator>::template rebind_alloc<Value_>>;
+      }; // struct rebind<Value_>
+
+      zero_page_allocator()
+        : allocator_{}, uses_zero_pages_{::ket::utility::uses_zero_pages()}
+      { }
+
+      template <typename Value_, typename Allocator_>
+      zero_page_allocator(::ket::utility::zero_page_allocator<Value_, Allocator_> const& other)
+        : allocator_{other.allocator_}, uses_zero_pages_{other.uses_zero_pages_}
+      { }
+
+      bool uses_zero_pages() const noexcept { return uses_zero_pages_; }
+
+      Value* allocate(std::size_t const num_values)
+      {
+        if (not uses_zero_pages_)
+          return std::allocator_traits<Allocator>::allocate(allocator_, num_values);
+        if (num_values == std::size_t{0u})
+          return nullptr;
+
+        auto const result = std::calloc(num_values, sizeof(Value));
+        if (result == nullptr)
+          throw std::bad_alloc{};
+
+        return static_cast<Value*>(result);
+      }
+
+      void deallocate(Value* const pointer, std::size_t const num_values)
+      {
+        if (not uses_zero_pages_)
+          return std::allocator_traits<Allocator>::deallocate(allocator_, pointer, num_values);
+
+        std::free(pointer);
+      }
+
+      template <typename Value_>
+      void construct(Value_* const pointer)
+      {
+        if (not uses_zero_pages_)
+          std::allocator_traits<Allocator>::construct(allocator_, pointer);
+      }
+
+      template <typename Value_, typename Argument, typename... Arguments>
+      void construct(Value_* const pointer, Argument&& argument, Arguments&&... arguments)
+      {
+        std::allocator_traits<Allocator>::construct(
+          allocator_, pointer, std::forward<Argument>(argument), std::forward<Arguments>(arguments)...);
+      }
+
+      template <typename Value_>
+      void destroy(Value_* const pointer)
+      { std::allocator_traits<Allocator>::destroy(allocator_, pointer); }
+
+      template <typename Value_, typename Allocator_>
+      bool operator==(::ket::utility::zero_page_allocator<Value_, Allocator_> const& other) const
+      { return uses_zero_pages_ == other.uses_zero_pages_; }
+
+      template <typename Value_, typename Allocator_>
+      bool operator!=(::ket::utility::zero_page_allocator<Value_, Allocator_> const& other) const
+      { return not (*this == other); }
+    }; // class zero_page_allocator<Value, Allocator>
+  } // namespace utility
+} // namespace ket
+
+
+#endif // KET_UTILITY_ZERO_PAGE_ALLOCATOR_HPP